@@ -0,0 +1,637 @@
+/**
+ * @file stl_bench.cpp
+ * @brief 読み込み・変換処理のマイクロベンチマーク（Google Benchmark）
+ * @author STL Viewer Team
+ * @version 1.0
+ *
+ * ウィンドウを開かずにコアライブラリ（stl_core）の処理を計測する。
+ * 計測対象のメッシュは合成メッシュ（mesh_synthetic.h、三角形数を正確に指定できる格子状の波面）を生成し、
+ * ファイル読み込みの計測用には各形式で書き出したファイルを作業ディレクトリに保存して再利用する。
+ * 三角形数は 1K〜50M（--max-triangles で上限を変更可能）、スループットは
+ * triangles/s（カウンター）と bytes/s（SetBytesProcessed）で出力する。
+ * 作業配列の確保先を比較する段階（名前の末尾が /arena のものはアリーナに確保）では、反復あたりの
+ * operator new の呼び出し回数（allocs）とページフォルト数（page_faults）も出力する。
+ *
+ * 使用例:
+ *   stl_bench --benchmark_filter=LoadFile --max-triangles=1000000 --corpus-dir=D:/bench_corpus
+ */
+
+#include <benchmark/benchmark.h>
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "mesh_bvh.h"
+#include "mesh_interference.h"
+#include "mesh_orientation.h"
+#include "mesh_repair.h"
+#include "mesh_shells.h"
+#include "mesh_slicer.h"
+#include "mesh_synthetic.h"
+#include "mesh_thickness.h"
+#include "mesh_topology.h"
+#include "mesh_vertices.h"
+#include "mesh_voxelizer.h"
+#include "model_loader.h"
+#include "process_memory.h"
+
+// 内部定数定義
+namespace
+{
+/// プロセス全体の operator new の呼び出し回数（アリーナの有無による確保回数の比較用）
+std::atomic<std::uint64_t> allocationCount{0};
+
+/**
+ * @brief 確保回数を数えてから malloc 系の関数で確保する
+ *
+ * @param alignment 0 の場合は malloc の既定のアライメント
+ */
+void *countedAllocate(std::size_t size, std::size_t alignment)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    size = std::max<std::size_t>(size, 1);
+#if defined(_WIN32)
+    auto *pointer = alignment > 0 ? _aligned_malloc(size, alignment) : std::malloc(size);
+#else
+    auto *pointer = alignment > 0 ? std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)
+                                  : std::malloc(size);
+#endif
+    if (!pointer)
+    {
+        throw std::bad_alloc{};
+    }
+    return pointer;
+}
+
+/**
+ * @brief countedAllocate() で確保した領域を解放する
+ */
+void countedFree(void *pointer, bool aligned) noexcept
+{
+#if defined(_WIN32)
+    aligned ? _aligned_free(pointer) : std::free(pointer);
+#else
+    static_cast<void>(aligned);
+    std::free(pointer);
+#endif
+}
+} // namespace
+
+void *operator new(std::size_t size)
+{
+    return countedAllocate(size, 0);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    return countedAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *pointer) noexcept
+{
+    countedFree(pointer, false);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    countedFree(pointer, false);
+}
+
+void operator delete(void *pointer, std::align_val_t) noexcept
+{
+    countedFree(pointer, true);
+}
+
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept
+{
+    countedFree(pointer, true);
+}
+
+namespace
+{
+// 計測する三角形数（1K〜50M）
+constexpr std::array<std::int64_t, 6> TRIANGLE_COUNTS{1'000, 10'000, 100'000, 1'000'000, 10'000'000, 50'000'000};
+constexpr std::int64_t MAX_ASCII_STL_TRIANGLES{10'000'000}; // ASCII STL は1三角形あたり約250バイトのため上限を抑える
+constexpr int TRIANGLE_VERTICES{3};                          // 三角形の頂点数
+constexpr float MODEL_COLOR{0.8f};                           // 頂点配列に設定する色（ビューアーと同じ灰色）
+constexpr std::int64_t MAX_ANALYSIS_TRIANGLES{10'000'000};   // 解析（溶接後の処理）を計測する三角形数の上限
+constexpr std::size_t SLICE_LAYERS{1000};                    // スライスの層数
+constexpr std::uint32_t VOXEL_RESOLUTION{1024};              // ボクセル化の解像度（最長辺方向のボクセル数）
+constexpr float INTERFERENCE_OFFSET{0.5f};                   // 干渉の計測で複製を X 方向にずらす量（格子のセル幅の半分）
+constexpr std::string_view MAX_TRIANGLES_OPTION{"--max-triangles="};
+constexpr std::string_view CORPUS_DIR_OPTION{"--corpus-dir="};
+
+/**
+ * @brief ベンチマーク固有のコマンドライン設定
+ */
+struct BenchOptions {
+    std::int64_t maxTriangles = TRIANGLE_COUNTS.back();                                       // 計測する三角形数の上限
+    std::filesystem::path corpusDirectory = std::filesystem::temp_directory_path() / "stl_bench"; // 入力ファイルの保存先
+};
+
+/**
+ * @brief 読み込みを計測するファイル形式
+ */
+struct FileFormat {
+    const char *name;           // ベンチマーク名に付ける形式名（stl_corpus の標準コーパスのファイル名と共通）
+    SyntheticFormat format;     // 書き出し形式
+    std::int64_t maxTriangles;  // 計測する三角形数の上限
+};
+
+const std::array<FileFormat, 5> FILE_FORMATS{{
+    {"stl_binary", SyntheticFormat::BinaryStl, TRIANGLE_COUNTS.back()},
+    {"stl_ascii", SyntheticFormat::AsciiStl, MAX_ASCII_STL_TRIANGLES},
+    {"obj", SyntheticFormat::Obj, TRIANGLE_COUNTS.back()},
+    {"ply_binary", SyntheticFormat::BinaryPly, TRIANGLE_COUNTS.back()},
+    {"glb", SyntheticFormat::Glb, TRIANGLE_COUNTS.back()},
+}};
+
+/**
+ * @brief 三角形数から計測用の合成メッシュの設定を作成する（既定のシード・頂点を全て共有する1シェル）
+ */
+SyntheticSettings gridSettings(std::int64_t triangles)
+{
+    auto settings = SyntheticSettings{};
+    settings.triangleCount = static_cast<std::uint64_t>(triangles);
+    return settings;
+}
+
+/**
+ * @brief 計測用の入力ファイルを取得する（無ければ生成して保存する）
+ *
+ * ファイル名には syntheticSettingsTag() でシードを含む生成設定を全て付けるため、名前が一致する既存のファイル
+ * （stl_corpus --corpus-dir で事前に生成したものを含む）は同じ内容としてそのまま再利用する。
+ * 途中で中断しても壊れたファイルが残らないよう、一時ファイルに書き出してから名前を変更する。
+ */
+std::filesystem::path corpusFile(const BenchOptions &options, const FileFormat &format, std::int64_t triangles)
+{
+    auto settings = gridSettings(triangles);
+    auto path = options.corpusDirectory / ("grid_" + std::to_string(triangles) + "_" + format.name + "_" +
+                                           syntheticSettingsTag(settings) +
+                                           std::string{syntheticFormatExtension(format.format)});
+    auto error = std::error_code{};
+    if (std::filesystem::exists(path, error))
+    {
+        return path;
+    }
+
+    std::filesystem::create_directories(options.corpusDirectory, error);
+    auto temporary = path;
+    temporary += ".tmp";
+    auto errorMessage = std::string{};
+    if (!writeSyntheticMesh(SyntheticMesh{settings}, format.format, temporary, errorMessage))
+    {
+        return {};
+    }
+    std::filesystem::rename(temporary, path, error);
+    return error ? std::filesystem::path{} : path;
+}
+
+/**
+ * @brief メモリ上で処理する段階の計測用メッシュを取得する
+ *
+ * 50M三角形のメッシュは数GBになるため、直前に生成した1つのみを保持する。
+ */
+ModelMesh &cachedMesh(std::int64_t triangles)
+{
+    static auto cachedTriangles = std::int64_t{-1};
+    static auto mesh = std::unique_ptr<ModelMesh>{};
+    if (cachedTriangles != triangles)
+    {
+        mesh.reset();
+        mesh = std::make_unique<ModelMesh>();
+        expandSyntheticMesh(SyntheticMesh{gridSettings(triangles)}, *mesh);
+        cachedTriangles = triangles;
+    }
+    return *mesh;
+}
+
+/**
+ * @brief 解析を計測するための溶接・向き修正済みのメッシュを取得する
+ *
+ * cachedMesh() と同じく、直前に生成した1つのみを保持する。
+ */
+const IndexedMesh &cachedIndexedMesh(std::int64_t triangles)
+{
+    static auto cachedTriangles = std::int64_t{-1};
+    static auto indexed = std::unique_ptr<IndexedMesh>{};
+    if (cachedTriangles != triangles)
+    {
+        indexed.reset();
+        indexed = std::make_unique<IndexedMesh>();
+        auto shells = ShellDecomposition{};
+        auto edges = EdgeTable{};
+        weldAndOrientMesh(cachedMesh(triangles), 0.0f, *indexed, shells, edges);
+        cachedTriangles = triangles;
+    }
+    return *indexed;
+}
+
+/**
+ * @brief 三角形数とバイト数からスループットのカウンターを設定する
+ *
+ * @param triangles 1回の処理で扱う三角形数（triangles/s として出力）
+ * @param bytes 1回の処理で読み書きするバイト数（bytes/s として出力）
+ */
+void setThroughput(benchmark::State &state, std::int64_t triangles, std::int64_t bytes)
+{
+    state.counters["triangles/s"] =
+        benchmark::Counter(static_cast<double>(triangles), benchmark::Counter::kIsIterationInvariantRate);
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+/**
+ * @brief 計測区間の確保回数とページフォルト数を反復あたりのカウンターとして出力する
+ *
+ * 計測ループの直前に生成し、ループの直後に report() を呼ぶ。
+ */
+class AllocationProbe {
+public:
+    AllocationProbe() : allocations{allocationCount.load()}, faults{pageFaultCount()} {}
+
+    void report(benchmark::State &state) const
+    {
+        state.counters["allocs"] = benchmark::Counter(static_cast<double>(allocationCount.load() - allocations),
+                                                      benchmark::Counter::kAvgIterations);
+        state.counters["page_faults"] =
+            benchmark::Counter(static_cast<double>(pageFaultCount() - faults), benchmark::Counter::kAvgIterations);
+    }
+
+private:
+    std::uint64_t allocations;  ///< 計測開始時の確保回数
+    std::uint64_t faults;       ///< 計測開始時のページフォルト数
+};
+
+/**
+ * @brief ModelLoader::loadFile() 全体（Assimpの読み込み・後処理・修復・ハッシュ）を計測する
+ *
+ * ファイルは2回目以降の反復ではOSのキャッシュから読まれるため、ディスク速度ではなくパース性能を表す。
+ */
+void loadFileBenchmark(benchmark::State &state, const BenchOptions &options, const FileFormat &format)
+{
+    auto triangles = state.range(0);
+    auto path = corpusFile(options, format, triangles);
+    if (path.empty())
+    {
+        state.SkipWithError("Failed to write the input file");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        auto loader = ModelLoader{};
+        auto mesh = ModelMesh{};
+        if (!loader.loadFile(path.string(), mesh))
+        {
+            state.SkipWithError(loader.getErrorMessage().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(mesh.triangles.data());
+    }
+    setThroughput(state, triangles, static_cast<std::int64_t>(std::filesystem::file_size(path)));
+}
+
+/**
+ * @brief ModelLoader::processScene()（Assimpのシーンから三角形配列への変換）のみを計測する
+ *
+ * Assimpの読み込みは反復の外で1回だけ行う。出力の三角形配列の確保・解放を含む。
+ */
+void processSceneBenchmark(benchmark::State &state, const BenchOptions &options)
+{
+    auto triangles = state.range(0);
+    auto path = corpusFile(options, FILE_FORMATS[0], triangles);
+    auto importer = Assimp::Importer{};
+    auto scene = path.empty() ? nullptr : importer.ReadFile(path.string(), ModelLoader::importFlags());
+    if (!scene)
+    {
+        state.SkipWithError("Failed to import the input file");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        auto loader = ModelLoader{};
+        auto mesh = ModelMesh{};
+        loader.processScene(scene, mesh);
+        benchmark::DoNotOptimize(mesh.triangles.data());
+    }
+    setThroughput(state, triangles, triangles * static_cast<std::int64_t>(sizeof(ModelTriangle)));
+}
+
+/**
+ * @brief ModelLoader::calculateBounds()（全頂点の走査）を計測する
+ */
+void calculateBoundsBenchmark(benchmark::State &state)
+{
+    auto triangles = state.range(0);
+    auto &mesh = cachedMesh(triangles);
+    auto loader = ModelLoader{};
+    for (auto _ : state)
+    {
+        loader.calculateBounds(mesh);
+        benchmark::DoNotOptimize(mesh.min_bounds);
+        benchmark::DoNotOptimize(mesh.max_bounds);
+    }
+    setThroughput(state, triangles, triangles * TRIANGLE_VERTICES * static_cast<std::int64_t>(sizeof(glm::vec3)));
+}
+
+/**
+ * @brief ModelLoader::calculateCenterAndScale() を計測する
+ *
+ * バウンディングボックスのみから計算するため三角形数に依存しない（三角形数が増えても
+ * 時間が一定であることを確認する回帰検出用）。スループットは読み込み全体の三角形数で換算する。
+ */
+void calculateCenterAndScaleBenchmark(benchmark::State &state)
+{
+    auto triangles = state.range(0);
+    auto &mesh = cachedMesh(triangles);
+    auto loader = ModelLoader{};
+    loader.calculateBounds(mesh);
+    for (auto _ : state)
+    {
+        loader.calculateCenterAndScale(mesh);
+        benchmark::DoNotOptimize(mesh.center);
+        benchmark::DoNotOptimize(mesh.scale);
+    }
+    setThroughput(state, triangles, static_cast<std::int64_t>(2 * sizeof(glm::vec3)));
+}
+
+/**
+ * @brief STLViewer::convertSTLToVertices() の本体（createInterleavedVertices()）を計測する
+ *
+ * 溶接しない場合の頂点バッファ転送前の変換。出力配列の確保・解放を含む。
+ * useArena が true の場合は出力配列をアリーナに確保する（既定のリソースとの比較用）。
+ */
+void interleavedVerticesBenchmark(benchmark::State &state, bool useArena)
+{
+    auto triangles = state.range(0);
+    const auto &mesh = cachedMesh(triangles);
+    auto color = glm::vec3{MODEL_COLOR};
+    auto probe = AllocationProbe{};
+    for (auto _ : state)
+    {
+        // ビューアーの転送段階と同じく、反復ごとにアリーナを作って破棄する
+        auto arena = std::pmr::monotonic_buffer_resource{};
+        auto vertices = createInterleavedVertices(mesh, color, useArena ? &arena : std::pmr::get_default_resource());
+        benchmark::DoNotOptimize(vertices.data());
+    }
+    probe.report(state);
+    setThroughput(state, triangles,
+                  triangles * TRIANGLE_VERTICES * INTERLEAVED_VERTEX_COMPONENTS * static_cast<std::int64_t>(sizeof(float)));
+}
+
+/**
+ * @brief repairMesh()（分類・重複検出・法線の修復）を計測する
+ *
+ * 合成メッシュには不正な三角形が無いため、反復しても入力は変わらない。
+ * useArena が true の場合は作業配列をアリーナに確保する（読み込み段階と同じ使い方、既定のリソースとの比較用）。
+ */
+void repairBenchmark(benchmark::State &state, bool useArena)
+{
+    auto triangles = state.range(0);
+    auto &mesh = cachedMesh(triangles);
+    auto probe = AllocationProbe{};
+    for (auto _ : state)
+    {
+        auto arena = std::pmr::monotonic_buffer_resource{};
+        auto stats = repairMesh(mesh, useArena ? &arena : std::pmr::get_default_resource());
+        benchmark::DoNotOptimize(stats);
+    }
+    probe.report(state);
+    setThroughput(state, triangles, triangles * static_cast<std::int64_t>(sizeof(ModelTriangle)));
+}
+
+/**
+ * @brief analyzeTopology()（辺の分類と頂点ごとの扇の数え上げ）を計測する
+ *
+ * 辺テーブルの構築は反復の外で1回だけ行う。
+ */
+void topologyBenchmark(benchmark::State &state)
+{
+    auto triangles = state.range(0);
+    const auto &mesh = cachedIndexedMesh(triangles);
+    auto edges = buildEdgeTable(mesh);
+    for (auto _ : state)
+    {
+        auto report = analyzeTopology(mesh, edges);
+        benchmark::DoNotOptimize(report.nonManifoldVertices);
+    }
+    setThroughput(state, triangles, static_cast<std::int64_t>(mesh.indices.size() * sizeof(std::uint32_t)));
+}
+
+/**
+ * @brief sliceMesh()（SLICE_LAYERS 層の輪郭の抽出）を計測する
+ *
+ * 合成メッシュはほぼ平らな XY 平面上の格子で、そのままでは全ての層が全ての三角形と交わるため、
+ * Y と Z を入れ替えて立てた複製をスライスする（部品の側壁のように各三角形が少数の層とのみ交わる）。
+ */
+void sliceBenchmark(benchmark::State &state)
+{
+    auto triangles = state.range(0);
+    auto mesh = cachedIndexedMesh(triangles);
+    for (auto &position : mesh.positions)
+    {
+        std::swap(position.y, position.z);
+    }
+    for (auto _ : state)
+    {
+        auto layers = sliceMesh(mesh, SLICE_LAYERS);
+        benchmark::DoNotOptimize(layers.data());
+    }
+    setThroughput(state, triangles, static_cast<std::int64_t>(mesh.indices.size() * sizeof(std::uint32_t)));
+}
+
+/**
+ * @brief voxelizeDense()（解像度 VOXEL_RESOLUTION の表面と内部）を計測する
+ *
+ * 合成メッシュは閉じていないため内部の塗りつぶしの結果に意味は無いが、処理量は閉じたメッシュと同じ。
+ */
+void voxelizeBenchmark(benchmark::State &state)
+{
+    auto triangles = state.range(0);
+    const auto &mesh = cachedMesh(triangles);
+    auto settings = VoxelizeSettings{};
+    settings.resolution = VOXEL_RESOLUTION;
+    for (auto _ : state)
+    {
+        auto grid = voxelizeDense(mesh, settings);
+        benchmark::DoNotOptimize(grid.words.data());
+    }
+    setThroughput(state, triangles, triangles * static_cast<std::int64_t>(sizeof(ModelTriangle)));
+}
+
+/**
+ * @brief computeWallThickness()（三角形ごとに1本の光線）を計測する
+ *
+ * BVH の構築は反復の外で1回だけ行う。triangles/s が光線数/s に等しい。
+ */
+void wallThicknessBenchmark(benchmark::State &state)
+{
+    auto triangles = state.range(0);
+    const auto &mesh = cachedIndexedMesh(triangles);
+    auto bvh = buildMeshBvh(mesh);
+    for (auto _ : state)
+    {
+        auto thickness = computeWallThickness(mesh, bvh);
+        benchmark::DoNotOptimize(thickness.triangleThickness.data());
+    }
+    setThroughput(state, triangles, triangles * static_cast<std::int64_t>(sizeof(float)));
+}
+
+/**
+ * @brief findTriangleContacts()（X 方向にずらした複製との交線）を計測する
+ *
+ * 波打つ格子を半セルずらすと高さの揺らぎが食い違い、全体にわたって交線ができる。BVH の構築は反復の外で行う。
+ */
+void interferenceBenchmark(benchmark::State &state)
+{
+    auto triangles = state.range(0);
+    const auto &mesh = cachedIndexedMesh(triangles);
+    auto shifted = mesh;
+    for (auto &position : shifted.positions)
+    {
+        position.x += INTERFERENCE_OFFSET;
+    }
+    auto first = buildMeshBvh(mesh);
+    auto second = buildMeshBvh(shifted);
+    for (auto _ : state)
+    {
+        auto contacts = findTriangleContacts(first, second);
+        benchmark::DoNotOptimize(contacts.data());
+    }
+    setThroughput(state, triangles, 2 * triangles * static_cast<std::int64_t>(sizeof(ModelTriangle)));
+}
+
+/**
+ * @brief 三角形数ごとのベンチマークを登録する
+ *
+ * 内部で並列処理を行う段階があるため、CPU時間ではなく経過時間で計測する。
+ */
+void registerBenchmarks(const BenchOptions &options)
+{
+    auto configure = [](benchmark::internal::Benchmark *benchmark, std::int64_t triangles) {
+        benchmark->Arg(triangles)->Unit(benchmark::kMillisecond)->UseRealTime();
+    };
+
+    // メモリ上の段階は三角形数ごとにまとめて実行し、計測用メッシュの再生成を避ける
+    for (auto triangles : TRIANGLE_COUNTS)
+    {
+        if (triangles > options.maxTriangles)
+        {
+            continue;
+        }
+        configure(benchmark::RegisterBenchmark("CalculateBounds", calculateBoundsBenchmark), triangles);
+        configure(benchmark::RegisterBenchmark("CalculateCenterAndScale", calculateCenterAndScaleBenchmark), triangles);
+        for (auto useArena : {false, true})
+        {
+            auto suffix = std::string{useArena ? "/arena" : ""};
+            configure(benchmark::RegisterBenchmark(("ConvertSTLToVertices" + suffix).c_str(),
+                                                   [useArena](benchmark::State &state) {
+                                                       interleavedVerticesBenchmark(state, useArena);
+                                                   }),
+                      triangles);
+            configure(benchmark::RegisterBenchmark(("Repair" + suffix).c_str(),
+                                                   [useArena](benchmark::State &state) {
+                                                       repairBenchmark(state, useArena);
+                                                   }),
+                      triangles);
+        }
+        if (triangles <= MAX_ANALYSIS_TRIANGLES)
+        {
+            configure(benchmark::RegisterBenchmark("Topology", topologyBenchmark), triangles);
+            configure(benchmark::RegisterBenchmark("Voxelize", voxelizeBenchmark), triangles);
+            configure(benchmark::RegisterBenchmark("Slice", sliceBenchmark), triangles);
+            configure(benchmark::RegisterBenchmark("WallThickness", wallThicknessBenchmark), triangles);
+            configure(benchmark::RegisterBenchmark("Interference", interferenceBenchmark), triangles);
+        }
+    }
+
+    for (auto triangles : TRIANGLE_COUNTS)
+    {
+        if (triangles > options.maxTriangles)
+        {
+            continue;
+        }
+        configure(benchmark::RegisterBenchmark(
+                      "ProcessScene", [&options](benchmark::State &state) { processSceneBenchmark(state, options); }),
+                  triangles);
+        for (const auto &format : FILE_FORMATS)
+        {
+            if (triangles > format.maxTriangles)
+            {
+                continue;
+            }
+            auto name = std::string{"LoadFile/"} + format.name;
+            configure(benchmark::RegisterBenchmark(
+                          name.c_str(),
+                          [&options, &format](benchmark::State &state) { loadFileBenchmark(state, options, format); }),
+                      triangles);
+        }
+    }
+}
+
+/**
+ * @brief Google Benchmark が解釈しなかった引数からベンチマーク固有の設定を読み取る
+ *
+ * @return 全ての引数を解釈できた場合はtrue
+ */
+bool parseOptions(int argc, char **argv, BenchOptions &options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        auto argument = std::string_view{argv[i]};
+        if (argument.starts_with(MAX_TRIANGLES_OPTION))
+        {
+            auto value = argument.substr(MAX_TRIANGLES_OPTION.size());
+            auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), options.maxTriangles);
+            if (error != std::errc{} || end != value.data() + value.size())
+            {
+                std::cerr << "Error: invalid value for " << MAX_TRIANGLES_OPTION << std::endl;
+                return false;
+            }
+        }
+        else if (argument.starts_with(CORPUS_DIR_OPTION))
+        {
+            options.corpusDirectory = std::filesystem::path{argument.substr(CORPUS_DIR_OPTION.size())};
+        }
+        else
+        {
+            std::cerr << "Error: unknown option " << argument << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    benchmark::Initialize(&argc, argv);
+
+    auto options = BenchOptions{};
+    if (!parseOptions(argc, argv, options))
+    {
+        std::cerr << "Usage: " << argv[0] << " [benchmark options] [" << MAX_TRIANGLES_OPTION << "N] ["
+                  << CORPUS_DIR_OPTION << "PATH]" << std::endl;
+        return 1;
+    }
+
+    registerBenchmarks(options);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -2,6 +2,9 @@
 out vec4 FragColor;
 
 in vec3 vertexColor;
+in float vertexScalar;
+in float vertexDeviation;
+in float vertexOcclusion;
 in vec3 Normal;
 in vec3 FragPos;
 
@@ -14,13 +17,64 @@ uniform float ambientStrength;
 uniform float specularStrength;
 uniform float shininess;
 
+// trueの場合は頂点法線の代わりに画面空間の微分から面法線を求める（溶接済みメッシュ用）
+uniform bool useFaceNormals;
+
+// trueの場合は頂点ごとのスカラー値を [scalarMin, scalarMax] の範囲でヒートマップの色に変換する
+uniform bool heatMapEnabled;
+uniform float scalarMin;
+uniform float scalarMax;
+
+// trueの場合は頂点ごとの偏差を許容差の段階で色分けする（偏差表示が肉厚のヒートマップより優先される）
+uniform bool deviationMapEnabled;
+uniform int deviationBands; // [-1, 1] の偏差に掛けると許容差の倍数になる段数
+
+// trueの場合は点スプライトとして描画する（円の外側を捨て、視点を向く半球として陰影を付ける）
+uniform bool pointSpritesEnabled;
+uniform mat4 view;
+
+// 点スプライト内の位置から半球の法線を求める（ビュー座標で求め、ビュー行列の回転を戻してワールド座標にする）
+vec3 pointSpriteNormal()
+{
+    vec2 offset = gl_PointCoord * 2.0 - 1.0;
+    float radiusSquared = dot(offset, offset);
+    if (radiusSquared > 1.0)
+    {
+        discard;
+    }
+    vec3 viewNormal = vec3(offset.x, -offset.y, sqrt(1.0 - radiusSquared)); // gl_PointCoord は下向きが正
+    return normalize(transpose(mat3(view)) * viewNormal);
+}
+
+// 0で赤、0.5で緑、1で青となる色相環上の色（彩度・明度は最大）
+vec3 heatMapColor(float t)
+{
+    float hue = clamp(t, 0.0, 1.0) * (2.0 / 3.0);
+    vec3 p = abs(fract(vec3(hue) + vec3(1.0, 2.0 / 3.0, 1.0 / 3.0)) * 6.0 - 3.0);
+    return clamp(p - 1.0, 0.0, 1.0);
+}
+
+// 許容差以内は緑、外側（正）は黄から赤、内側（負）は水色から青へ、許容差の倍数ごとに段階的に変える
+vec3 deviationColor(float deviation)
+{
+    float band = min(floor(abs(deviation) * float(deviationBands)), float(deviationBands));
+    if (band < 1.0)
+    {
+        return vec3(0.2, 0.8, 0.2);
+    }
+    float t = band / float(deviationBands);
+    return deviation > 0.0 ? mix(vec3(1.0, 0.9, 0.0), vec3(0.9, 0.0, 0.0), t)
+                           : mix(vec3(0.0, 0.9, 1.0), vec3(0.0, 0.1, 0.9), t);
+}
+
 void main()
 {
     // 環境光
     vec3 ambient = ambientStrength * lightColor;
     
     // 拡散光
-    vec3 norm = normalize(Normal);
+    vec3 norm = pointSpritesEnabled ? pointSpriteNormal()
+              : useFaceNormals ? normalize(cross(dFdx(FragPos), dFdy(FragPos))) : normalize(Normal);
     vec3 lightDir = normalize(lightPos - FragPos);
     float diff = max(dot(norm, lightDir), 0.0);
     vec3 diffuse = diff * lightColor;
@@ -31,6 +85,10 @@ void main()
     float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
     vec3 specular = specularStrength * spec * lightColor;
     
-    vec3 result = (ambient + diffuse + specular) * vertexColor;
+    vec3 baseColor = deviationMapEnabled ? deviationColor(vertexDeviation)
+                   : heatMapEnabled ? heatMapColor((vertexScalar - scalarMin) / max(scalarMax - scalarMin, 1e-6))
+                   : vertexColor;
+    // 焼き込んだ環境遮蔽で環境光・拡散光を弱め、凹部を暗くする（鏡面光はそのまま）
+    vec3 result = ((ambient + diffuse) * vertexOcclusion + specular) * baseColor;
     FragColor = vec4(result, 1.0);
 } 
\ No newline at end of file
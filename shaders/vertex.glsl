@@ -2,8 +2,20 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aColor;
 layout (location = 2) in vec3 aNormal;
+layout (location = 3) in float aScalar; // 頂点ごとのスカラー値（肉厚）
+layout (location = 4) in float aDeviation; // 頂点ごとの偏差（符号付き正規化整数から [-1, 1] に変換済み）
+layout (location = 5) in float aOcclusion; // 頂点ごとの遮られなかった光の割合（環境遮蔽、既定値は1）
+
+// ユーザー定義のクリップ平面（ワールド座標、dot(plane, vec4(pos, 1)) >= 0 の側を残す）
+// クリップ距離で切り捨てるため、切断された部分はラスタライズ前に除外される
+const int MAX_CLIP_PLANES = 3;
+uniform vec4 clipPlanes[MAX_CLIP_PLANES];
+out float gl_ClipDistance[MAX_CLIP_PLANES];
 
 out vec3 vertexColor;
+out float vertexScalar;
+out float vertexDeviation;
+out float vertexOcclusion;
 out vec3 Normal;
 out vec3 FragPos;
 
@@ -11,10 +23,23 @@ uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
 
+// 点スプライトの大きさ（ピクセル、GL_PROGRAM_POINT_SIZE が有効な点の描画時のみ使われる）
+uniform float pointSize;
+
 void main()
 {
     gl_Position = projection * view * model * vec4(aPos, 1.0);
     FragPos = vec3(model * vec4(aPos, 1.0));
     Normal = mat3(transpose(inverse(model))) * aNormal;
     vertexColor = aColor;
+    vertexScalar = aScalar;
+    vertexDeviation = aDeviation;
+    vertexOcclusion = aOcclusion;
+    gl_PointSize = pointSize;
+
+    // 有効化されていない平面（GL_CLIP_DISTANCEi 無効）の距離は無視される
+    for (int i = 0; i < MAX_CLIP_PLANES; ++i)
+    {
+        gl_ClipDistance[i] = dot(clipPlanes[i], vec4(FragPos, 1.0));
+    }
 } 
\ No newline at end of file
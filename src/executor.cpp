@@ -0,0 +1,102 @@
+#include "executor.h"
+#include "trace.h"
+
+ThreadPoolExecutor::ThreadPoolExecutor(std::size_t threadCount, const char *threadName)
+    : stopping{false}, threadName{threadName}
+{
+    auto count = threadCount == 0 ? std::size_t{1} : threadCount;
+    workers.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        workers.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+ThreadPoolExecutor::~ThreadPoolExecutor()
+{
+    shutdown();
+}
+
+void ThreadPoolExecutor::post(std::function<void()> job)
+{
+    {
+        auto lock = std::lock_guard<std::mutex>{mutex};
+        jobs.push_back(std::move(job));
+    }
+    condition.notify_one();
+}
+
+void ThreadPoolExecutor::shutdown()
+{
+    {
+        auto lock = std::lock_guard<std::mutex>{mutex};
+        stopping = true;
+    }
+    condition.notify_all();
+
+    for (auto &worker : workers)
+    {
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+}
+
+void ThreadPoolExecutor::workerLoop()
+{
+    trace::setThreadName(threadName);
+
+    while (true)
+    {
+        auto job = std::function<void()>{};
+        {
+            auto lock = std::unique_lock<std::mutex>{mutex};
+            condition.wait(lock, [this]() { return stopping || !jobs.empty(); });
+
+            // 終了要求があってもキューが空になるまでは処理を続ける
+            if (jobs.empty())
+            {
+                return;
+            }
+
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        job();
+    }
+}
+
+void RenderThreadExecutor::post(std::function<void()> job)
+{
+    {
+        auto lock = std::lock_guard<std::mutex>{mutex};
+        jobs.push_back(std::move(job));
+    }
+    condition.notify_one();
+}
+
+std::size_t RenderThreadExecutor::runPending()
+{
+    // ロック保持中にジョブを実行しないよう、ローカルに取り出してから実行する
+    auto pending = std::vector<std::function<void()>>{};
+    {
+        auto lock = std::lock_guard<std::mutex>{mutex};
+        pending.swap(jobs);
+    }
+
+    for (auto &job : pending)
+    {
+        job();
+    }
+    return pending.size();
+}
+
+std::size_t RenderThreadExecutor::waitAndRunPending()
+{
+    {
+        auto lock = std::unique_lock<std::mutex>{mutex};
+        condition.wait(lock, [this]() { return !jobs.empty(); });
+    }
+    return runPending();
+}
@@ -0,0 +1,149 @@
+/**
+ * @file executor.h
+ * @brief 非同期ロードパイプライン用のエグゼキューター定義
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief ジョブを実行するエグゼキューターの共通インターフェース
+ *
+ * コルーチンは scheduleOn() で取得した awaitable を co_await することで、
+ * 任意のエグゼキューター（I/O、CPUワーカー、描画スレッド）へ移動できる。
+ */
+class Executor {
+public:
+    virtual ~Executor() = default;
+
+    /**
+     * @brief ジョブを投入する
+     *
+     * @param job 実行するジョブ
+     * @note スレッドセーフ
+     */
+    virtual void post(std::function<void()> job) = 0;
+};
+
+/**
+ * @brief 固定数のワーカースレッドでジョブを実行するエグゼキューター
+ *
+ * I/O待ち用とCPU処理用にそれぞれインスタンスを作成して使用する。
+ * デストラクタは投入済みのジョブを全て処理してからスレッドを終了する。
+ */
+class ThreadPoolExecutor : public Executor {
+public:
+    /**
+     * @brief コンストラクタ
+     *
+     * @param threadCount ワーカースレッド数（0の場合は1として扱う）
+     * @param threadName ワーカースレッドのトレース上の名前（文字列リテラル等、プロセス終了まで有効な文字列）
+     */
+    ThreadPoolExecutor(std::size_t threadCount, const char *threadName);
+
+    /**
+     * @brief デストラクタ
+     *
+     * shutdown() を呼び出す（停止済みの場合は何もしない）。
+     */
+    ~ThreadPoolExecutor() override;
+
+    // スレッドを所有するためコピー・ムーブ禁止
+    ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+    ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete;
+
+    void post(std::function<void()> job) override;
+
+    /**
+     * @brief ワーカースレッドを停止して合流させる
+     *
+     * キュー内の残りのジョブを処理した後、全ワーカースレッドを合流させる。
+     * 停止後に投入されたジョブは実行されない。所有者がジョブの参照する状態を破棄する前に呼び出す。
+     *
+     * @pre ワーカースレッド以外の1つのスレッドから呼び出すこと
+     */
+    void shutdown();
+
+private:
+    std::vector<std::thread> workers;          ///< ワーカースレッド
+    std::deque<std::function<void()>> jobs;    ///< 実行待ちジョブ
+    std::mutex mutex;                          ///< jobs 保護用
+    std::condition_variable condition;         ///< ジョブ到着通知
+    bool stopping;                             ///< 終了要求フラグ
+    const char *threadName;                    ///< ワーカースレッドのトレース上の名前
+
+    /**
+     * @brief ワーカースレッドのメインループ
+     *
+     * 開始時に trace::setThreadName() でスレッド名を付け、トレースの記録用バッファを登録する。
+     */
+    void workerLoop();
+};
+
+/**
+ * @brief 描画スレッド（OpenGLコンテキストを持つスレッド）でジョブを実行するエグゼキューター
+ *
+ * 投入されたジョブはキューに溜められ、描画スレッドが runPending() を
+ * 呼び出したときにまとめて実行される。OpenGL呼び出しはこのエグゼキューター上でのみ行う。
+ */
+class RenderThreadExecutor : public Executor {
+public:
+    void post(std::function<void()> job) override;
+
+    /**
+     * @brief 溜まっているジョブを全て実行する
+     *
+     * @return 実行したジョブ数
+     * @pre 描画スレッドから呼び出すこと
+     */
+    std::size_t runPending();
+
+    /**
+     * @brief ジョブが到着するまで待機し、溜まっているジョブを全て実行する
+     *
+     * @return 実行したジョブ数
+     * @pre 描画スレッドから呼び出すこと
+     */
+    std::size_t waitAndRunPending();
+
+private:
+    std::vector<std::function<void()>> jobs;   ///< 実行待ちジョブ
+    std::mutex mutex;                          ///< jobs 保護用
+    std::condition_variable condition;         ///< ジョブ到着通知
+};
+
+/**
+ * @brief 指定したエグゼキューターへ実行を移す awaitable を返す
+ *
+ * @code
+ * co_await scheduleOn(cpuExecutor);   // 以降はCPUワーカー上で実行される
+ * @endcode
+ *
+ * @param executor 移動先のエグゼキューター
+ * @return co_await 可能なオブジェクト
+ */
+inline auto scheduleOn(Executor& executor)
+{
+    struct Awaiter {
+        Executor& executor;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) const
+        {
+            executor.post([handle]() { handle.resume(); });
+        }
+        void await_resume() const noexcept {}
+    };
+    return Awaiter{executor};
+}
@@ -5,11 +5,34 @@
  * @version 1.0
  */
 
+#include <algorithm>
 #include <boost/program_options.hpp>
+#include <chrono>
+#include <cmath>
 #include <cstdlib>
 #include <filesystem>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <sstream>
+#include <vector>
 
+#include "mesh_bvh.h"
+#include "mesh_distance.h"
+#include "mesh_features.h"
+#include "mesh_metrics.h"
+#include "mesh_occlusion.h"
+#include "mesh_orientation.h"
+#include "mesh_points.h"
+#include "mesh_sdf.h"
+#include "mesh_shells.h"
+#include "mesh_slicer.h"
+#include "mesh_topology.h"
+#include "mesh_voxelizer.h"
+#include "model_loader.h"
+#include "process_memory.h"
+#include "trace.h"
 #include "viewer.h"
 
 namespace po = boost::program_options;
@@ -19,6 +42,12 @@ namespace {
     constexpr int DEFAULT_WINDOW_WIDTH = 800;   ///< デフォルトウィンドウ幅
     constexpr int DEFAULT_WINDOW_HEIGHT = 600;  ///< デフォルトウィンドウ高
     constexpr const char* STL_EXTENSION = ".stl"; ///< STLファイル拡張子
+    constexpr float AUTO_WELD_EPSILON = -1.0f;    ///< 溶接許容誤差の自動設定を表す値
+    constexpr std::size_t DEFAULT_SLICE_LAYERS = 100; ///< スライス出力時の既定の層数
+    constexpr float DEFAULT_DEVIATION_TOLERANCE = 0.1f; ///< 偏差表示の既定の許容差
+    constexpr int DEFAULT_DEVIATION_BITS = 16;        ///< 偏差の頂点属性の既定の量子化ビット数
+    constexpr int DEFAULT_BENCHMARK_FRAMES = 300;     ///< 描画ベンチマークの既定のフレーム数（カメラが1周する）
+    constexpr double MILLISECONDS_PER_SECOND = 1000.0; ///< 秒からミリ秒への換算係数
 }
 
 /**
@@ -29,6 +58,47 @@ struct ViewerConfig
     std::string stlFilePath; ///< STLファイルのパス
     int windowWidth = DEFAULT_WINDOW_WIDTH;   ///< ウィンドウ幅（ピクセル）
     int windowHeight = DEFAULT_WINDOW_HEIGHT;  ///< ウィンドウ高（ピクセル）
+    bool weldEnabled = true;                   ///< 読み込み時に頂点溶接を行うか
+    float weldEpsilon = AUTO_WELD_EPSILON;     ///< 溶接許容誤差（負の場合は自動）
+    bool checkTopology = false;                ///< 水密性・多様体性をチェックするか
+    bool printMetrics = false;                 ///< ウィンドウを開かずに幾何特性を出力するか
+    std::size_t sliceLayers = 0;               ///< スライスの層数（0の場合はスライスしない）
+    std::string sliceOutputPath;               ///< スライス結果の出力先（空の場合は出力しない）
+    std::uint32_t voxelResolution = 0;         ///< ボクセル化の解像度（0の場合はボクセル化しない）
+    bool voxelSurfaceOnly = false;             ///< 内部を塗りつぶさず表面のみボクセル化するか
+    std::uint32_t sdfResolution = 0;           ///< 符号付き距離場の解像度（0の場合は計算しない）
+    bool wallThickness = false;                ///< 肉厚を解析してヒートマップ表示するか
+    bool checkInterference = false;            ///< シェル（部品）間の干渉をチェックするか
+    std::string distanceTargetPath;            ///< 距離を測る相手のモデル（空の場合は測らない）
+    std::string referencePath;                 ///< 偏差表示の参照モデル（空の場合は表示しない）
+    float deviationTolerance = DEFAULT_DEVIATION_TOLERANCE; ///< 偏差表示の許容差
+    int deviationBits = DEFAULT_DEVIATION_BITS; ///< 偏差の頂点属性の量子化ビット数（8または16）
+    bool ambientOcclusion = false;             ///< 頂点ごとの環境遮蔽を焼き込んで陰影に使うか
+    int occlusionRays = DEFAULT_OCCLUSION_RAYS; ///< 環境遮蔽の焼き込みで頂点ごとに飛ばす光線数
+    bool featureEdges = false;                 ///< 特徴辺（稜線）を抽出して線で表示するか
+    float featureAngle = DEFAULT_FEATURE_ANGLE_DEGREES; ///< 特徴辺とみなす二面角のしきい値（度）
+    float pointSize = DEFAULT_POINT_SIZE;      ///< 点スプライトの大きさ（ピクセル）
+    std::size_t pointTriangleBudget = DEFAULT_POINT_TRIANGLE_BUDGET; ///< 頂点を点として描画する三角形数の上限
+    bool benchmark = false;                    ///< ウィンドウを表示せずに描画時間を計測して終了するか
+    int benchmarkFrames = DEFAULT_BENCHMARK_FRAMES; ///< 描画ベンチマークのフレーム数
+    std::string benchmarkOutputPath;           ///< 描画ベンチマークの結果（JSON）の出力先（空の場合は標準出力）
+    std::string tracePath;                     ///< 処理段階のトレース（Chrome のトレース形式）の出力先（空の場合は記録しない）
+};
+
+/**
+ * @brief 描画ベンチマークのフレーム時間の分布（ミリ秒）
+ */
+struct FrameStatistics
+{
+    double first = 0.0;  ///< 最初のフレーム（シェーダーのコンパイル等を含むため分布からは除く）
+    double min = 0.0;    ///< 最小
+    double mean = 0.0;   ///< 平均
+    double median = 0.0; ///< 中央値
+    double p90 = 0.0;    ///< 90パーセンタイル
+    double p95 = 0.0;    ///< 95パーセンタイル
+    double p99 = 0.0;    ///< 99パーセンタイル
+    double max = 0.0;    ///< 最大
+    double stddev = 0.0; ///< 標準偏差
 };
 
 /**
@@ -98,7 +168,48 @@ bool validateSTLFile(const std::string &filePath)
 bool parseCommandLine(int argc, char *argv[], ViewerConfig &config)
 {
     auto desc = po::options_description{"STL Viewer Options"};
-    desc.add_options()("help,h", "Show this help message")("stl-file", po::value<std::string>(), "STL file path");
+    desc.add_options()("help,h", "Show this help message")("stl-file", po::value<std::string>(), "STL file path")(
+        "weld-epsilon", po::value<float>(&config.weldEpsilon),
+        "Vertex weld tolerance in model units (default: 1e-6 of the model size, 0: exact match only)")(
+        "no-weld", "Disable vertex welding and draw unindexed triangles (skips analyses that need shared vertices)")(
+        "check-topology", "Report boundary/non-manifold edges and draw them as an overlay")(
+        "metrics", "Print surface area, volume, centroid and inertia tensor without opening a window")(
+        "slice-layers", po::value<std::size_t>(&config.sliceLayers),
+        "Slice the model into this many Z layers and draw the contours as an overlay")(
+        "slice-output", po::value<std::string>(&config.sliceOutputPath),
+        "Write slice contours to a .svg or binary contour file without opening a window")(
+        "voxelize", po::value<std::uint32_t>(&config.voxelResolution),
+        "Voxelize the model at this resolution (voxels along the longest side) and print statistics")(
+        "voxel-surface", "Voxelize only the surface without filling the interior")(
+        "sdf", po::value<std::uint32_t>(&config.sdfResolution),
+        "Compute a signed distance field at this resolution (at most 512) and print statistics")(
+        "thickness", "Ray-cast the wall thickness of each triangle and show it as a heat map (toggle with H)")(
+        "check-interference", "Report intersecting triangles between shells (parts) and draw the intersection lines")(
+        "distance-to", po::value<std::string>(&config.distanceTargetPath),
+        "Print the minimum distance and per-vertex distances to another model without opening a window")(
+        "reference", po::value<std::string>(&config.referencePath),
+        "Color each vertex by its signed deviation from this reference model (toggle with D)")(
+        "tolerance", po::value<float>(&config.deviationTolerance),
+        "Deviation tolerance in model units; colors change at each multiple (default: 0.1)")(
+        "deviation-bits", po::value<int>(&config.deviationBits),
+        "Quantize the per-vertex deviation attribute to 8 or 16 bits (default: 16)")(
+        "ambient-occlusion", "Bake per-vertex ambient occlusion by ray casting and cache it on disk (toggle with O)")(
+        "ao-rays", po::value<int>(&config.occlusionRays),
+        "Number of hemisphere rays per vertex for --ambient-occlusion (default: 64)")(
+        "feature-edges", "Draw crease and boundary edges as lines, cached on disk (toggle with E)")(
+        "feature-angle", po::value<float>(&config.featureAngle),
+        "Dihedral angle in degrees above which an edge is a crease for --feature-edges (default: 30)")(
+        "point-size", po::value<float>(&config.pointSize),
+        "Screen-space size in pixels of point-cloud and vertex point sprites (default: 3)")(
+        "points-above", po::value<std::size_t>(&config.pointTriangleBudget),
+        "Draw the vertices as points for meshes with more triangles than this (toggle with P, default: 2000000)")(
+        "benchmark", "Render frames offscreen with an orbiting camera, print load/frame/memory statistics as JSON and exit")(
+        "benchmark-frames", po::value<int>(&config.benchmarkFrames),
+        "Number of frames rendered by --benchmark (default: 300)")(
+        "benchmark-output", po::value<std::string>(&config.benchmarkOutputPath),
+        "Write the --benchmark JSON to this file instead of standard output")(
+        "trace", po::value<std::string>(&config.tracePath),
+        "Record load/upload/shader phases and write them as Chrome trace JSON (chrome://tracing, Perfetto) on exit");
 
     auto p = po::positional_options_description{};
     p.add("stl-file", 1);
@@ -133,6 +244,323 @@ bool parseCommandLine(int argc, char *argv[], ViewerConfig &config)
     }
 
     config.stlFilePath = vm["stl-file"].as<std::string>();
+    config.weldEnabled = !vm.count("no-weld");
+    config.checkTopology = vm.count("check-topology") > 0;
+    config.printMetrics = vm.count("metrics") > 0;
+    config.voxelSurfaceOnly = vm.count("voxel-surface") > 0;
+    config.wallThickness = vm.count("thickness") > 0;
+    config.checkInterference = vm.count("check-interference") > 0;
+    config.ambientOcclusion = vm.count("ambient-occlusion") > 0;
+    config.featureEdges = vm.count("feature-edges") > 0;
+    config.benchmark = vm.count("benchmark") > 0;
+    if (!config.sliceOutputPath.empty() && config.sliceLayers == 0)
+    {
+        config.sliceLayers = DEFAULT_SLICE_LAYERS;
+    }
+    if (config.deviationBits != 8 && config.deviationBits != 16)
+    {
+        std::cerr << "Error: --deviation-bits must be 8 or 16." << std::endl;
+        return false;
+    }
+    if (!(config.deviationTolerance > 0.0f))
+    {
+        std::cerr << "Error: --tolerance must be positive." << std::endl;
+        return false;
+    }
+    if (config.occlusionRays <= 0)
+    {
+        std::cerr << "Error: --ao-rays must be positive." << std::endl;
+        return false;
+    }
+    if (!(config.featureAngle >= 0.0f && config.featureAngle <= 180.0f))
+    {
+        std::cerr << "Error: --feature-angle must be between 0 and 180." << std::endl;
+        return false;
+    }
+    if (!(config.pointSize > 0.0f))
+    {
+        std::cerr << "Error: --point-size must be positive." << std::endl;
+        return false;
+    }
+    if (config.sdfResolution > MAX_SIGNED_DISTANCE_RESOLUTION)
+    {
+        std::cerr << "Error: --sdf must be at most " << MAX_SIGNED_DISTANCE_RESOLUTION << "." << std::endl;
+        return false;
+    }
+    if (config.benchmarkFrames <= 0)
+    {
+        std::cerr << "Error: --benchmark-frames must be positive." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief ウィンドウを開かずにモデルを読み込み、溶接と向きの修正を行う
+ *
+ * ビューアーの読み込み処理と同じ weldAndOrientMesh() で
+ * インデックス付きメッシュを生成する。
+ *
+ * @param config ビューアーの設定（溶接の設定のみ使用する）
+ * @param filePath 読み込むファイルのパス
+ * @param mesh [out] 読み込んだメッシュ
+ * @param indexedMesh [out] 溶接・向き修正済みのメッシュ（溶接無効時は空）
+ * @param orientation [out] 向き修正の結果（溶接無効時は未設定）
+ * @return 読み込み成功時はtrue、失敗時はfalse
+ */
+bool loadMeshHeadless(const ViewerConfig &config, const std::string &filePath, ModelMesh &mesh,
+                      IndexedMesh &indexedMesh, OrientationReport &orientation)
+{
+    auto loader = ModelLoader{};
+    if (!loader.loadFile(filePath, mesh))
+    {
+        std::cerr << "Error: Failed to load STL file: " << loader.getErrorMessage() << std::endl;
+        return false;
+    }
+
+    if (config.weldEnabled)
+    {
+        auto shells = ShellDecomposition{};
+        auto edges = EdgeTable{};
+        orientation = weldAndOrientMesh(mesh, config.weldEpsilon, indexedMesh, shells, edges);
+    }
+    return true;
+}
+
+/**
+ * @brief ウィンドウを開かずに設定のモデルを読み込み、溶接と向きの修正を行う
+ *
+ * @see loadMeshHeadless(const ViewerConfig &, const std::string &, ModelMesh &, IndexedMesh &, OrientationReport &)
+ */
+bool loadMeshHeadless(const ViewerConfig &config, ModelMesh &mesh, IndexedMesh &indexedMesh,
+                      OrientationReport &orientation)
+{
+    return loadMeshHeadless(config, config.stlFilePath, mesh, indexedMesh, orientation);
+}
+
+/**
+ * @brief ウィンドウを開かずにモデルを読み込み、幾何特性を標準出力へ出力する
+ *
+ * 溶接が有効な場合は向き修正後のメッシュで計算するため、
+ * 巻き順が不揃いなSTLでも正しい体積が得られる。
+ * 面が閉じていない場合、体積・重心・慣性テンソルは参考値として警告を出す。
+ *
+ * @param config ビューアーの設定
+ * @return 読み込み成功時はtrue、失敗時はfalse
+ */
+bool printMeshMetrics(const ViewerConfig &config)
+{
+    auto mesh = ModelMesh{};
+    auto indexedMesh = IndexedMesh{};
+    auto orientation = OrientationReport{};
+    if (!loadMeshHeadless(config, mesh, indexedMesh, orientation))
+    {
+        return false;
+    }
+
+    auto closed = config.weldEnabled && orientation.canCullBackFaces();
+    auto metrics = config.weldEnabled ? computeMeshMetrics(indexedMesh) : computeMeshMetrics(mesh);
+
+    std::cout << std::setprecision(10);
+    std::cout << "Triangles:    " << mesh.triangles.size() << std::endl;
+    std::cout << "Surface area: " << metrics.surfaceArea << std::endl;
+    std::cout << "Volume:       " << metrics.volume << std::endl;
+    std::cout << "Centroid:     " << metrics.centroid.x << " " << metrics.centroid.y << " " << metrics.centroid.z
+              << std::endl;
+    std::cout << "Inertia tensor (about centroid, unit density):" << std::endl;
+    for (int row = 0; row < 3; ++row)
+    {
+        std::cout << "  " << metrics.inertia[0][row] << " " << metrics.inertia[1][row] << " "
+                  << metrics.inertia[2][row] << std::endl;
+    }
+
+    if (!closed)
+    {
+        std::cerr << "Warning: Mesh is not a closed, consistently oriented surface; "
+                  << "volume, centroid and inertia are approximate" << std::endl;
+    }
+    return true;
+}
+
+/**
+ * @brief ウィンドウを開かずにモデルをスライスし、輪郭をファイルへ書き出す
+ *
+ * @param config ビューアーの設定
+ * @return 書き込み成功時はtrue、失敗時はfalse
+ */
+bool writeSlices(const ViewerConfig &config)
+{
+    if (!config.weldEnabled)
+    {
+        std::cerr << "Error: Slicing requires vertex welding (remove --no-weld)" << std::endl;
+        return false;
+    }
+
+    auto mesh = ModelMesh{};
+    auto indexedMesh = IndexedMesh{};
+    auto orientation = OrientationReport{};
+    if (!loadMeshHeadless(config, mesh, indexedMesh, orientation))
+    {
+        return false;
+    }
+
+    auto layers = sliceMesh(indexedMesh, config.sliceLayers);
+    auto errorMessage = std::string{};
+    if (!writeSliceFile(config.sliceOutputPath, layers, errorMessage))
+    {
+        std::cerr << "Error: " << errorMessage << std::endl;
+        return false;
+    }
+
+    std::cout << "Wrote " << layers.size() << " layers to " << config.sliceOutputPath << std::endl;
+    return true;
+}
+
+/**
+ * @brief ウィンドウを開かずにモデルをボクセル化し、統計を標準出力へ出力する
+ *
+ * 疎なブリックマップで計算するため、高解像度でもグリッド全体のビット列は確保しない。
+ *
+ * @param config ビューアーの設定
+ * @return 読み込み成功時はtrue、失敗時はfalse
+ */
+bool printVoxelization(const ViewerConfig &config)
+{
+    auto mesh = ModelMesh{};
+    auto indexedMesh = IndexedMesh{};
+    auto orientation = OrientationReport{};
+    if (!loadMeshHeadless(config, mesh, indexedMesh, orientation))
+    {
+        return false;
+    }
+
+    auto settings = VoxelizeSettings{};
+    settings.resolution = config.voxelResolution;
+    settings.solid = !config.voxelSurfaceOnly;
+
+    auto start = std::chrono::steady_clock::now();
+    auto grid = voxelizeSparse(mesh, settings);
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const auto &dims = grid.layout.dimensions;
+    auto occupied = grid.count();
+    std::cout << std::setprecision(10);
+    std::cout << "Grid:          " << dims.x << " x " << dims.y << " x " << dims.z << std::endl;
+    std::cout << "Voxel size:    " << grid.layout.voxelSize << std::endl;
+    std::cout << "Occupied:      " << occupied << std::endl;
+    std::cout << "Bricks:        " << grid.bricks.size() << std::endl;
+    std::cout << "Voxel volume:  " << static_cast<double>(occupied) * grid.layout.voxelVolume() << std::endl;
+    std::cout << "Elapsed (s):   " << elapsed << std::endl;
+
+    if (settings.solid && !(config.weldEnabled && orientation.canCullBackFaces()))
+    {
+        std::cerr << "Warning: Mesh is not a closed surface; the interior fill may be incorrect" << std::endl;
+    }
+    return true;
+}
+
+/**
+ * @brief ウィンドウを開かずにモデルの符号付き距離場を計算し、統計を標準出力へ出力する
+ *
+ * 内部の最小値（最も深い格子点の距離）は内接球の半径、すなわち最大肉厚の半分の目安になる。
+ *
+ * @param config ビューアーの設定
+ * @return 読み込み成功時はtrue、失敗時はfalse
+ */
+bool printSignedDistanceField(const ViewerConfig &config)
+{
+    auto mesh = ModelMesh{};
+    auto indexedMesh = IndexedMesh{};
+    auto orientation = OrientationReport{};
+    if (!loadMeshHeadless(config, mesh, indexedMesh, orientation))
+    {
+        return false;
+    }
+
+    auto settings = SignedDistanceSettings{};
+    settings.resolution = config.sdfResolution;
+
+    auto start = std::chrono::steady_clock::now();
+    auto field = computeSignedDistanceField(mesh, settings);
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const auto &dims = field.layout.dimensions;
+    auto [minimum, maximum] = std::minmax_element(field.distances.begin(), field.distances.end());
+    std::cout << std::setprecision(10);
+    std::cout << "Grid:          " << dims.x << " x " << dims.y << " x " << dims.z << std::endl;
+    std::cout << "Spacing:       " << field.layout.voxelSize << std::endl;
+    std::cout << "Band points:   " << field.bandPoints << std::endl;
+    std::cout << "Min distance:  " << *minimum << std::endl;
+    std::cout << "Max distance:  " << *maximum << std::endl;
+    std::cout << "Elapsed (s):   " << elapsed << std::endl;
+
+    if (!(config.weldEnabled && orientation.canCullBackFaces()))
+    {
+        std::cerr << "Warning: Mesh is not a closed surface; the sign of the distance may be incorrect" << std::endl;
+    }
+    return true;
+}
+
+/**
+ * @brief ウィンドウを開かずに2つのモデル間の距離を計算し、標準出力へ出力する
+ *
+ * 面間の最小距離と最近点に加え、モデルの全頂点から相手の面までの最近点距離を並列に求め、
+ * その最大値（片側ハウスドルフ距離）と平均値を出力する。
+ *
+ * @param config ビューアーの設定
+ * @return 読み込み成功時はtrue、失敗時はfalse
+ */
+bool printSurfaceDistance(const ViewerConfig &config)
+{
+    auto mesh = ModelMesh{};
+    auto indexedMesh = IndexedMesh{};
+    auto orientation = OrientationReport{};
+    auto target = ModelMesh{};
+    auto targetIndexedMesh = IndexedMesh{};
+    auto targetOrientation = OrientationReport{};
+    if (!loadMeshHeadless(config, mesh, indexedMesh, orientation) ||
+        !loadMeshHeadless(config, config.distanceTargetPath, target, targetIndexedMesh, targetOrientation))
+    {
+        return false;
+    }
+
+    // 溶接時は共有頂点、それ以外は三角形の頂点を問い合わせ点にする
+    auto queries = indexedMesh.positions;
+    if (!config.weldEnabled)
+    {
+        for (const auto &triangle : mesh.triangles)
+        {
+            queries.insert(queries.end(), std::begin(triangle.vertices), std::end(triangle.vertices));
+        }
+    }
+
+    auto bvh = buildMeshBvh(mesh);
+    auto targetBvh = buildMeshBvh(target);
+    auto minimum = findMinimumDistance(bvh, targetBvh);
+
+    auto start = std::chrono::steady_clock::now();
+    auto closest = findClosestPoints(targetBvh, queries);
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    auto maximum = 0.0f;
+    auto sum = 0.0;
+    for (const auto &point : closest)
+    {
+        maximum = std::max(maximum, point.distance);
+        sum += point.distance;
+    }
+
+    std::cout << std::setprecision(10);
+    std::cout << "Min distance:    " << minimum.distance << std::endl;
+    std::cout << "  Model point:   " << minimum.firstPoint.x << " " << minimum.firstPoint.y << " "
+              << minimum.firstPoint.z << " (triangle " << minimum.firstTriangle << ")" << std::endl;
+    std::cout << "  Target point:  " << minimum.secondPoint.x << " " << minimum.secondPoint.y << " "
+              << minimum.secondPoint.z << " (triangle " << minimum.secondTriangle << ")" << std::endl;
+    std::cout << "Vertices:        " << queries.size() << std::endl;
+    std::cout << "Max distance:    " << maximum << std::endl;
+    std::cout << "Mean distance:   " << (queries.empty() ? 0.0 : sum / static_cast<double>(queries.size()))
+              << std::endl;
+    std::cout << "Elapsed (s):     " << elapsed << std::endl;
     return true;
 }
 
@@ -154,6 +582,16 @@ bool initializeViewer(const ViewerConfig &config, STLViewer &viewer)
         return false;
     }
 
+    viewer.setWeld(config.weldEnabled, config.weldEpsilon);
+    viewer.setTopologyCheck(config.checkTopology);
+    viewer.setSlicing(config.sliceLayers);
+    viewer.setWallThickness(config.wallThickness);
+    viewer.setInterferenceCheck(config.checkInterference);
+    viewer.setDeviationReference(config.referencePath, config.deviationTolerance, config.deviationBits);
+    viewer.setAmbientOcclusion(config.ambientOcclusion ? config.occlusionRays : 0);
+    viewer.setFeatureEdges(config.featureEdges, config.featureAngle);
+    viewer.setPointRendering(config.pointSize, config.pointTriangleBudget);
+
     if (!viewer.loadSTL(config.stlFilePath))
     {
         std::cerr << "Error: Failed to load STL file" << std::endl;
@@ -163,6 +601,212 @@ bool initializeViewer(const ViewerConfig &config, STLViewer &viewer)
     return true;
 }
 
+/**
+ * @brief フレームごとの所要時間から分布を求める
+ *
+ * 最初のフレームは別に記録し、2フレーム目以降の分布を求める（1フレームのみの場合はそのフレームを使う）。
+ * パーセンタイルは最近傍順位法で求める。
+ *
+ * @param frameSeconds フレームごとの所要時間（秒、空でないこと）
+ * @return フレーム時間の分布（ミリ秒）
+ */
+FrameStatistics summarizeFrameTimes(const std::vector<double> &frameSeconds)
+{
+    auto statistics = FrameStatistics{};
+    statistics.first = frameSeconds.front() * MILLISECONDS_PER_SECOND;
+
+    auto begin = frameSeconds.size() > 1 ? std::next(frameSeconds.begin()) : frameSeconds.begin();
+    auto sorted = std::vector<double>(begin, frameSeconds.end());
+    for (auto &value : sorted)
+    {
+        value *= MILLISECONDS_PER_SECOND;
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    auto count = sorted.size();
+    auto percentile = [&sorted, count](double fraction) {
+        auto rank = static_cast<std::size_t>(std::ceil(fraction * static_cast<double>(count)));
+        return sorted[std::clamp<std::size_t>(rank, 1, count) - 1];
+    };
+    auto sum = 0.0;
+    for (auto value : sorted)
+    {
+        sum += value;
+    }
+    statistics.mean = sum / static_cast<double>(count);
+    auto squares = 0.0;
+    for (auto value : sorted)
+    {
+        squares += (value - statistics.mean) * (value - statistics.mean);
+    }
+    statistics.min = sorted.front();
+    statistics.max = sorted.back();
+    statistics.median = count % 2 == 1 ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) * 0.5;
+    statistics.p90 = percentile(0.90);
+    statistics.p95 = percentile(0.95);
+    statistics.p99 = percentile(0.99);
+    statistics.stddev = std::sqrt(squares / static_cast<double>(count));
+    return statistics;
+}
+
+/**
+ * @brief JSON の文字列リテラルとして出力できるようにエスケープする
+ *
+ * @param value 元の文字列
+ * @return 引用符で囲んだエスケープ済みの文字列
+ */
+std::string jsonString(const std::string &value)
+{
+    auto oss = std::ostringstream{};
+    oss << '"';
+    for (auto c : value)
+    {
+        if (c == '"' || c == '\\')
+        {
+            oss << '\\' << c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            oss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+        }
+        else
+        {
+            oss << c;
+        }
+    }
+    oss << '"';
+    return oss.str();
+}
+
+/**
+ * @brief ウィンドウを表示せずにモデルを読み込み、カメラを周回させて描画時間を計測する
+ *
+ * 通常の表示と同じ初期化・読み込み・描画の経路を使い、読み込みの段階ごとの所要時間、
+ * 最初のフレームが描画されるまでの時間、フレーム時間の分布、メモリ使用量の最大値を JSON で出力する。
+ * 表示先の無い環境では Mesa のソフトウェアラスタライザー（llvmpipe）で実行できる。
+ *
+ * @param config ビューアーの設定
+ * @return 読み込み・描画・出力に成功した場合はtrue
+ */
+bool runRenderBenchmark(const ViewerConfig &config)
+{
+    auto start = std::chrono::steady_clock::now();
+    auto viewer = STLViewer{};
+    viewer.setHeadless(true);
+    if (!initializeViewer(config, viewer))
+    {
+        return false;
+    }
+    auto ready = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    auto peakAfterLoad = peakResidentBytes();
+
+    auto frameSeconds = viewer.renderBenchmarkFrames(config.benchmarkFrames);
+    if (frameSeconds.empty())
+    {
+        std::cerr << "Error: No frames were rendered" << std::endl;
+        return false;
+    }
+    auto frames = summarizeFrameTimes(frameSeconds);
+    const auto &load = viewer.getLoadTimings();
+
+    auto file = std::ofstream{};
+    if (!config.benchmarkOutputPath.empty())
+    {
+        file.open(config.benchmarkOutputPath);
+        if (!file.is_open())
+        {
+            std::cerr << "Error: Cannot open benchmark output file: " << config.benchmarkOutputPath << std::endl;
+            return false;
+        }
+    }
+    auto &out = config.benchmarkOutputPath.empty() ? std::cout : file;
+
+    // 初期化（GLFW・OpenGLコンテキスト・スレッドプール）は読み込み開始までの残りの時間とする
+    out << std::setprecision(9);
+    out << "{" << std::endl;
+    out << "  \"model\": " << jsonString(config.stlFilePath) << "," << std::endl;
+    out << "  \"renderer\": " << jsonString(viewer.getRendererName()) << "," << std::endl;
+    out << "  \"triangles\": " << viewer.getTriangleCount() << "," << std::endl;
+    out << "  \"frames\": " << frameSeconds.size() << "," << std::endl;
+    out << "  \"load_seconds\": {\"init\": " << ready - load.total << ", \"read\": " << load.read
+        << ", \"parse\": " << load.parse << ", \"analyze\": " << load.analyze << ", \"points\": " << load.points
+        << ", \"dispatch\": " << load.dispatch << ", \"upload\": " << load.upload << ", \"total\": " << load.total
+        << "}," << std::endl;
+    out << "  \"time_to_first_frame_seconds\": " << ready + frameSeconds.front() << "," << std::endl;
+    out << "  \"frame_ms\": {\"first\": " << frames.first << ", \"min\": " << frames.min << ", \"mean\": " << frames.mean
+        << ", \"median\": " << frames.median << ", \"p90\": " << frames.p90 << ", \"p95\": " << frames.p95
+        << ", \"p99\": " << frames.p99 << ", \"max\": " << frames.max << ", \"stddev\": " << frames.stddev << "},"
+        << std::endl;
+    out << "  \"fps\": " << (frames.mean > 0.0 ? MILLISECONDS_PER_SECOND / frames.mean : 0.0) << "," << std::endl;
+    out << "  \"memory_bytes\": {\"peak_after_load\": " << peakAfterLoad << ", \"peak\": " << peakResidentBytes()
+        << ", \"current\": " << currentResidentBytes() << "}" << std::endl;
+    out << "}" << std::endl;
+
+    if (!out)
+    {
+        std::cerr << "Error: Failed to write benchmark output" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 設定に応じた処理（ウィンドウを開かない出力・描画ベンチマーク・ビューアー）を実行する
+ *
+ * @param config ビューアーの設定
+ * @return プログラムの終了コード（EXIT_SUCCESS または EXIT_FAILURE）
+ */
+int runSelectedMode(const ViewerConfig &config)
+{
+    // 幾何特性の出力のみ（ウィンドウは開かない）
+    if (config.printMetrics)
+    {
+        return printMeshMetrics(config) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // スライス結果の出力のみ（ウィンドウは開かない）
+    if (!config.sliceOutputPath.empty())
+    {
+        return writeSlices(config) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // ボクセル化の統計の出力のみ（ウィンドウは開かない）
+    if (config.voxelResolution > 0)
+    {
+        return printVoxelization(config) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // 符号付き距離場の統計の出力のみ（ウィンドウは開かない）
+    if (config.sdfResolution > 0)
+    {
+        return printSignedDistanceField(config) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // モデル間の距離の出力のみ（ウィンドウは開かない）
+    if (!config.distanceTargetPath.empty())
+    {
+        return printSurfaceDistance(config) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // 描画ベンチマークのみ（ウィンドウは表示しない）
+    if (config.benchmark)
+    {
+        return runRenderBenchmark(config) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // ビューアーの初期化
+    auto viewer = STLViewer{};
+    if (!initializeViewer(config, viewer))
+    {
+        return EXIT_FAILURE;
+    }
+
+    // メインループを開始
+    viewer.run();
+
+    return EXIT_SUCCESS;
+}
+
 /**
  * @brief アプリケーションのメイン関数
  *
@@ -191,15 +835,20 @@ int main(int argc, char *argv[])
         return EXIT_FAILURE;
     }
 
-    // ビューアーの初期化
-    auto viewer = STLViewer{};
-    if (!initializeViewer(config, viewer))
+    // 処理段階のトレースを記録し、終了時に書き出す
+    if (!config.tracePath.empty())
     {
-        return EXIT_FAILURE;
+        trace::enable();
+        trace::setThreadName("main");
     }
 
-    // メインループを開始
-    viewer.run();
+    auto exitCode = runSelectedMode(config);
 
-    return EXIT_SUCCESS;
-}
\ No newline at end of file
+    auto traceError = std::string{};
+    if (!config.tracePath.empty() && !trace::writeChromeTrace(config.tracePath, traceError))
+    {
+        std::cerr << "Error: " << traceError << std::endl;
+        return EXIT_FAILURE;
+    }
+    return exitCode;
+}
@@ -0,0 +1,420 @@
+#include "mesh_bvh.h"
+#include "model_loader.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+// 内部定数定義
+namespace
+{
+constexpr int TRIANGLE_VERTICES{3};                 // 三角形の頂点数
+constexpr int SAH_BINS{16};                         // 分割位置の候補区間数
+constexpr std::size_t PARALLEL_SUBTREE_FACTOR{4};   // 並列に構築する部分木数（スレッド数に対する倍率）
+constexpr std::size_t MIN_PARALLEL_SUBTREE{4096};   // これより小さい部分木は並列化のために分割しない
+constexpr int BALANCED_SPLIT_DEPTH{64};             // これより深いノードは個数で二分する（深さを最大 64 + 32 に抑える）
+constexpr float DETERMINANT_EPSILON{1e-12f};        // 光線と平行とみなす行列式の大きさ
+
+/**
+ * @brief 構築中の三角形の参照
+ */
+struct BuildReference {
+    glm::vec3 minBounds;
+    glm::vec3 maxBounds;
+    glm::vec3 centroid;
+    std::uint32_t triangle;
+};
+
+/**
+ * @brief 軸平行バウンディングボックス
+ */
+struct Bounds {
+    glm::vec3 minBounds{std::numeric_limits<float>::max()};
+    glm::vec3 maxBounds{std::numeric_limits<float>::lowest()};
+
+    void grow(const glm::vec3 &low, const glm::vec3 &high)
+    {
+        minBounds = glm::min(minBounds, low);
+        maxBounds = glm::max(maxBounds, high);
+    }
+
+    float halfArea() const
+    {
+        auto extent = glm::max(maxBounds - minBounds, glm::vec3{0.0f});
+        return extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+    }
+};
+
+/**
+ * @brief 範囲 [begin, end) を分割し、分割位置を返す（葉にする場合は end）
+ *
+ * @param balanced true の場合は SAH を使わず個数で二分する（木の深さを抑える）
+ */
+std::size_t findSplit(std::vector<BuildReference> &references, std::size_t begin, std::size_t end, bool balanced)
+{
+    auto count = end - begin;
+    if (count <= BVH_MAX_LEAF_TRIANGLES)
+    {
+        return end;
+    }
+
+    auto centroidBounds = Bounds{};
+    for (auto i = begin; i < end; ++i)
+    {
+        centroidBounds.grow(references[i].centroid, references[i].centroid);
+    }
+
+    // 重心の広がりが最大の軸で分割する
+    auto extent = centroidBounds.maxBounds - centroidBounds.minBounds;
+    auto axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+    auto first = references.begin() + static_cast<std::ptrdiff_t>(begin);
+    auto last = references.begin() + static_cast<std::ptrdiff_t>(end);
+    if (balanced || !(extent[axis] > 0.0f))
+    {
+        auto middle = first + static_cast<std::ptrdiff_t>(count / 2);
+        std::nth_element(first, middle, last, [axis](const BuildReference &lhs, const BuildReference &rhs) {
+            return lhs.centroid[axis] < rhs.centroid[axis];
+        });
+        return begin + count / 2;
+    }
+
+    auto scale = SAH_BINS / extent[axis];
+    auto binOf = [&](const BuildReference &reference) {
+        auto bin = static_cast<int>((reference.centroid[axis] - centroidBounds.minBounds[axis]) * scale);
+        return std::clamp(bin, 0, SAH_BINS - 1);
+    };
+
+    auto binBounds = std::array<Bounds, SAH_BINS>{};
+    auto binCounts = std::array<std::size_t, SAH_BINS>{};
+    for (auto i = begin; i < end; ++i)
+    {
+        auto bin = binOf(references[i]);
+        binBounds[bin].grow(references[i].minBounds, references[i].maxBounds);
+        ++binCounts[bin];
+    }
+
+    // 右からの累積で各分割位置の右側のコストを求め、左からの累積と合わせて最小の位置を選ぶ
+    auto rightCosts = std::array<float, SAH_BINS>{};
+    auto accumulated = Bounds{};
+    auto accumulatedCount = std::size_t{0};
+    for (int bin = SAH_BINS - 1; bin > 0; --bin)
+    {
+        accumulated.grow(binBounds[bin].minBounds, binBounds[bin].maxBounds);
+        accumulatedCount += binCounts[bin];
+        rightCosts[bin] = accumulated.halfArea() * static_cast<float>(accumulatedCount);
+    }
+
+    // 重心の最小・最大は必ず両端の区間に入るため、両側が空でない分割位置が存在する
+    auto bestBin = 0;
+    auto bestCost = std::numeric_limits<float>::max();
+    accumulated = Bounds{};
+    accumulatedCount = 0;
+    for (int bin = 0; bin < SAH_BINS - 1; ++bin)
+    {
+        accumulated.grow(binBounds[bin].minBounds, binBounds[bin].maxBounds);
+        accumulatedCount += binCounts[bin];
+        auto cost = accumulated.halfArea() * static_cast<float>(accumulatedCount) + rightCosts[bin + 1];
+        if (accumulatedCount > 0 && accumulatedCount < count && cost < bestCost)
+        {
+            bestCost = cost;
+            bestBin = bin;
+        }
+    }
+
+    auto middle =
+        std::partition(first, last, [&](const BuildReference &reference) { return binOf(reference) <= bestBin; });
+    return static_cast<std::size_t>(middle - references.begin());
+}
+
+Bounds rangeBounds(const std::vector<BuildReference> &references, std::size_t begin, std::size_t end)
+{
+    auto bounds = Bounds{};
+    for (auto i = begin; i < end; ++i)
+    {
+        bounds.grow(references[i].minBounds, references[i].maxBounds);
+    }
+    return bounds;
+}
+
+/**
+ * @brief 範囲 [begin, end) の部分木を nodes[nodeIndex] を根として逐次に構築する
+ *
+ * @param depth nodeIndex の深さ（BALANCED_SPLIT_DEPTH 以降は個数で二分し、走査スタックに収める）
+ */
+void buildSubtree(std::vector<BuildReference> &references, std::size_t begin, std::size_t end,
+                  std::vector<BvhNode> &nodes, std::size_t nodeIndex, int depth)
+{
+    auto bounds = rangeBounds(references, begin, end);
+    nodes[nodeIndex].minBounds = bounds.minBounds;
+    nodes[nodeIndex].maxBounds = bounds.maxBounds;
+
+    auto middle = findSplit(references, begin, end, depth >= BALANCED_SPLIT_DEPTH);
+    if (middle == end)
+    {
+        nodes[nodeIndex].firstOrChild = static_cast<std::uint32_t>(begin);
+        nodes[nodeIndex].triangleCount = static_cast<std::uint32_t>(end - begin);
+        return;
+    }
+
+    auto left = nodes.size();
+    nodes[nodeIndex].firstOrChild = static_cast<std::uint32_t>(left);
+    nodes[nodeIndex].triangleCount = 0;
+    nodes.resize(left + 2);
+    buildSubtree(references, begin, middle, nodes, left, depth + 1);
+    buildSubtree(references, middle, end, nodes, left + 1, depth + 1);
+}
+
+/**
+ * @brief 並列に構築する部分木（範囲と、根を置くノード番号）
+ */
+struct SubtreeTask {
+    std::size_t begin;
+    std::size_t end;
+    std::size_t nodeIndex;
+    int depth;
+};
+
+/**
+ * @brief 三角形の頂点を返す関数から BVH を構築する
+ *
+ * @tparam TriangleVertices std::array<glm::vec3, 3>(std::size_t triangle) 形式の関数
+ */
+template <typename TriangleVertices>
+MeshBvh buildBvh(std::size_t triangleCount, TriangleVertices &&triangleVertices)
+{
+    auto bvh = MeshBvh{};
+    if (triangleCount == 0)
+    {
+        return bvh;
+    }
+
+    auto references = std::vector<BuildReference>(triangleCount);
+    parallel::forEach(triangleCount, [&](std::size_t t) {
+        auto vertices = triangleVertices(t);
+        auto &reference = references[t];
+        reference.minBounds = glm::min(glm::min(vertices[0], vertices[1]), vertices[2]);
+        reference.maxBounds = glm::max(glm::max(vertices[0], vertices[1]), vertices[2]);
+        reference.centroid = (reference.minBounds + reference.maxBounds) * 0.5f;
+        reference.triangle = static_cast<std::uint32_t>(t);
+    });
+
+    // 上位ノード: 最大の部分木を逐次に分割し、並列に構築できる部分木の数を確保する
+    auto &nodes = bvh.nodes;
+    nodes.resize(1);
+    auto tasks = std::vector<SubtreeTask>{{0, triangleCount, 0, 0}};
+    auto targetTasks = parallel::threadCount() * PARALLEL_SUBTREE_FACTOR;
+    while (tasks.size() < targetTasks)
+    {
+        auto largest = std::max_element(tasks.begin(), tasks.end(), [](const auto &lhs, const auto &rhs) {
+            return lhs.end - lhs.begin < rhs.end - rhs.begin;
+        });
+        if (largest->end - largest->begin < MIN_PARALLEL_SUBTREE)
+        {
+            break;
+        }
+
+        auto task = *largest;
+        auto bounds = rangeBounds(references, task.begin, task.end);
+        auto middle = findSplit(references, task.begin, task.end, false);
+        if (middle == task.end)
+        {
+            break;
+        }
+
+        auto left = nodes.size();
+        nodes[task.nodeIndex] = BvhNode{bounds.minBounds, static_cast<std::uint32_t>(left), bounds.maxBounds, 0};
+        nodes.resize(left + 2);
+        *largest = SubtreeTask{task.begin, middle, left, task.depth + 1};
+        tasks.push_back(SubtreeTask{middle, task.end, left + 1, task.depth + 1});
+    }
+
+    // 部分木: 範囲が重ならないため並列に構築し、局所的なノード番号で持つ
+    auto subtrees = std::vector<std::vector<BvhNode>>(tasks.size());
+    parallel::forEach(
+        tasks.size(),
+        [&](std::size_t i) {
+            subtrees[i].resize(1);
+            buildSubtree(references, tasks[i].begin, tasks[i].end, subtrees[i], 0, tasks[i].depth);
+        },
+        1);
+
+    // 部分木の根を上位ノードの位置に置き、残りを末尾に連結して子の番号を付け替える
+    for (std::size_t i = 0; i < tasks.size(); ++i)
+    {
+        const auto &subtree = subtrees[i];
+        auto base = nodes.size() - 1; // 局所番号 n (>= 1) → base + n
+        auto relocate = [base](BvhNode node) {
+            if (!node.isLeaf())
+            {
+                node.firstOrChild = static_cast<std::uint32_t>(base + node.firstOrChild);
+            }
+            return node;
+        };
+        nodes[tasks[i].nodeIndex] = relocate(subtree[0]);
+        for (std::size_t n = 1; n < subtree.size(); ++n)
+        {
+            nodes.push_back(relocate(subtree[n]));
+        }
+    }
+
+    // 三角形を葉の順に並べて複製する
+    bvh.triangles.resize(triangleCount);
+    bvh.triangleIds.resize(triangleCount);
+    parallel::forEach(triangleCount, [&](std::size_t i) {
+        auto triangle = references[i].triangle;
+        bvh.triangleIds[i] = triangle;
+        bvh.triangles[i] = triangleVertices(triangle);
+    });
+    return bvh;
+}
+
+/**
+ * @brief 光線とバウンディングボックスの交差区間の入口を求める（スラブ法）
+ *
+ * @return 入口の距離（交差しない場合は無限大）
+ */
+inline float intersectBox(const BvhNode &node, const glm::vec3 &origin, const glm::vec3 &inverseDirection,
+                          float maxDistance)
+{
+    auto t0 = (node.minBounds - origin) * inverseDirection;
+    auto t1 = (node.maxBounds - origin) * inverseDirection;
+    auto entry = std::max(std::max(std::min(t0.x, t1.x), std::min(t0.y, t1.y)), std::max(std::min(t0.z, t1.z), 0.0f));
+    auto exit = std::min(std::min(std::max(t0.x, t1.x), std::max(t0.y, t1.y)), std::min(std::max(t0.z, t1.z), maxDistance));
+    return entry <= exit ? entry : std::numeric_limits<float>::infinity();
+}
+
+/**
+ * @brief 光線と三角形の交点までの距離を求める（Möller–Trumbore 法）
+ *
+ * @return 交点までの距離（交差しない場合は負）
+ */
+inline float intersectTriangle(const std::array<glm::vec3, TRIANGLE_VERTICES> &triangle, const glm::vec3 &origin,
+                               const glm::vec3 &direction)
+{
+    auto edge1 = triangle[1] - triangle[0];
+    auto edge2 = triangle[2] - triangle[0];
+    auto p = glm::cross(direction, edge2);
+    auto determinant = glm::dot(edge1, p);
+    if (std::abs(determinant) < DETERMINANT_EPSILON)
+    {
+        return -1.0f;
+    }
+
+    auto inverse = 1.0f / determinant;
+    auto s = origin - triangle[0];
+    auto u = glm::dot(s, p) * inverse;
+    if (u < 0.0f || u > 1.0f)
+    {
+        return -1.0f;
+    }
+
+    auto q = glm::cross(s, edge1);
+    auto v = glm::dot(direction, q) * inverse;
+    if (v < 0.0f || u + v > 1.0f)
+    {
+        return -1.0f;
+    }
+    return glm::dot(edge2, q) * inverse;
+}
+} // namespace
+
+MeshBvh buildMeshBvh(const ModelMesh &mesh)
+{
+    return buildBvh(mesh.triangles.size(), [&mesh](std::size_t t) {
+        const auto &triangle = mesh.triangles[t];
+        return std::array<glm::vec3, TRIANGLE_VERTICES>{triangle.vertices[0], triangle.vertices[1],
+                                                        triangle.vertices[2]};
+    });
+}
+
+MeshBvh buildMeshBvh(const IndexedMesh &mesh)
+{
+    return buildMeshBvh(mesh, 0, mesh.triangleCount());
+}
+
+MeshBvh buildMeshBvh(const IndexedMesh &mesh, std::size_t firstTriangle, std::size_t triangleCount)
+{
+    const auto *indices = mesh.indices.data() + firstTriangle * TRIANGLE_VERTICES;
+    auto bvh = buildBvh(triangleCount, [&mesh, indices](std::size_t t) {
+        return std::array<glm::vec3, TRIANGLE_VERTICES>{mesh.positions[indices[t * TRIANGLE_VERTICES]],
+                                                        mesh.positions[indices[t * TRIANGLE_VERTICES + 1]],
+                                                        mesh.positions[indices[t * TRIANGLE_VERTICES + 2]]};
+    });
+
+    // 範囲内の番号をメッシュ全体の三角形番号に直す
+    if (firstTriangle > 0)
+    {
+        auto offset = static_cast<std::uint32_t>(firstTriangle);
+        parallel::forEach(bvh.triangleIds.size(), [&bvh, offset](std::size_t i) { bvh.triangleIds[i] += offset; });
+    }
+    return bvh;
+}
+
+RayHit intersectRay(const MeshBvh &bvh, const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance,
+                    std::uint32_t ignoredTriangle)
+{
+    auto result = RayHit{};
+    if (bvh.empty())
+    {
+        return result;
+    }
+
+    // 0除算は無限大となり、スラブ法はそのまま正しく動作する
+    auto inverseDirection = glm::vec3{1.0f} / direction;
+    auto closest = maxDistance;
+
+    // 積んだノードは入口の距離と組で持ち、取り出した時点で既知の交点より遠ければ枝刈りする
+    auto stack = std::array<std::pair<std::uint32_t, float>, BVH_TRAVERSAL_STACK_SIZE>{};
+    auto stackSize = std::size_t{0};
+    auto rootEntry = intersectBox(bvh.nodes[0], origin, inverseDirection, closest);
+    if (rootEntry == std::numeric_limits<float>::infinity())
+    {
+        return result;
+    }
+    stack[stackSize++] = {0, rootEntry};
+
+    while (stackSize > 0)
+    {
+        auto [nodeIndex, entry] = stack[--stackSize];
+        if (entry > closest)
+        {
+            continue;
+        }
+
+        const auto &node = bvh.nodes[nodeIndex];
+        if (node.isLeaf())
+        {
+            for (auto i = node.firstOrChild; i < node.firstOrChild + node.triangleCount; ++i)
+            {
+                auto distance = intersectTriangle(bvh.triangles[i], origin, direction);
+                if (distance >= 0.0f && distance < closest && bvh.triangleIds[i] != ignoredTriangle)
+                {
+                    closest = distance;
+                    result.distance = distance;
+                    result.triangle = bvh.triangleIds[i];
+                }
+            }
+            continue;
+        }
+
+        // 近い子を後に積んで先に走査する
+        auto left = node.firstOrChild;
+        auto right = left + 1;
+        auto leftEntry = intersectBox(bvh.nodes[left], origin, inverseDirection, closest);
+        auto rightEntry = intersectBox(bvh.nodes[right], origin, inverseDirection, closest);
+        if (leftEntry > rightEntry)
+        {
+            std::swap(left, right);
+            std::swap(leftEntry, rightEntry);
+        }
+        if (rightEntry != std::numeric_limits<float>::infinity())
+        {
+            stack[stackSize++] = {right, rightEntry};
+        }
+        if (leftEntry != std::numeric_limits<float>::infinity())
+        {
+            stack[stackSize++] = {left, leftEntry};
+        }
+    }
+    return result;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file mesh_bvh.h
+ * @brief 三角形メッシュの境界ボリューム階層（BVH）と光線との交差判定
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <glm/glm.hpp>
+
+struct ModelMesh;
+struct IndexedMesh;
+
+/// 葉ノードに格納する最大三角形数
+constexpr std::uint32_t BVH_MAX_LEAF_TRIANGLES{4};
+
+/// 走査スタックの大きさ（構築時に木の深さを 64 + 32 以下に抑えるため、これで足りる）
+constexpr std::size_t BVH_TRAVERSAL_STACK_SIZE{128};
+
+/// 交差しない場合の三角形番号
+constexpr std::uint32_t BVH_NO_TRIANGLE{std::numeric_limits<std::uint32_t>::max()};
+
+/**
+ * @brief BVH のノード（32バイト）
+ *
+ * 内部ノードの子は nodes[firstOrChild] と nodes[firstOrChild + 1] に隣接して置かれる。
+ */
+struct BvhNode {
+    glm::vec3 minBounds;          ///< バウンディングボックスの最小座標
+    std::uint32_t firstOrChild;   ///< 葉: 先頭の三角形の位置、内部ノード: 左の子の番号
+    glm::vec3 maxBounds;          ///< バウンディングボックスの最大座標
+    std::uint32_t triangleCount;  ///< 葉の三角形数（内部ノードでは0）
+
+    bool isLeaf() const noexcept { return triangleCount > 0; }
+};
+
+/**
+ * @brief 三角形メッシュの BVH
+ *
+ * 三角形の頂点は葉の順に並べ替えて複製して持つため、走査時に元のメッシュを参照しない。
+ */
+struct MeshBvh {
+    std::vector<BvhNode> nodes;                                 ///< ノード（nodes[0] が根）
+    std::vector<std::array<glm::vec3, 3>> triangles;            ///< 葉の順に並べた三角形の頂点
+    std::vector<std::uint32_t> triangleIds;                     ///< 葉の順の位置 → 元の三角形番号
+
+    bool empty() const noexcept { return nodes.empty(); }
+};
+
+/**
+ * @brief 光線と三角形の交差結果
+ */
+struct RayHit {
+    float distance = std::numeric_limits<float>::infinity();  ///< 光線の始点から交点までの距離（方向ベクトルの長さ単位）
+    std::uint32_t triangle = BVH_NO_TRIANGLE;                  ///< 交差した元の三角形番号
+
+    bool hit() const noexcept { return triangle != BVH_NO_TRIANGLE; }
+};
+
+/**
+ * @brief メッシュの BVH を構築する
+ *
+ * 三角形の重心を16区間に分けて表面積ヒューリスティック（SAH）で分割位置を選ぶ。
+ * 上位のノードを逐次に分割して部分木をスレッド数以上に分けた後、
+ * 部分木を並列に構築して連結する。
+ *
+ * @param mesh 対象のメッシュ
+ * @return BVH（三角形が無い場合は空）
+ */
+MeshBvh buildMeshBvh(const ModelMesh& mesh);
+
+/**
+ * @brief インデックス付きメッシュの BVH を構築する
+ *
+ * @param mesh 対象のメッシュ
+ * @return BVH（三角形が無い場合は空）
+ * @see buildMeshBvh(const ModelMesh&)
+ */
+MeshBvh buildMeshBvh(const IndexedMesh& mesh);
+
+/**
+ * @brief インデックス付きメッシュの連続した三角形範囲の BVH を構築する
+ *
+ * シェルごとの BVH など、メッシュの一部だけを対象にする場合に使う。
+ *
+ * @param mesh 対象のメッシュ
+ * @param firstTriangle 範囲の先頭の三角形番号
+ * @param triangleCount 範囲の三角形数
+ * @return BVH（triangleIds はメッシュ全体での三角形番号）
+ * @see buildMeshBvh(const ModelMesh&)
+ */
+MeshBvh buildMeshBvh(const IndexedMesh& mesh, std::size_t firstTriangle, std::size_t triangleCount);
+
+/**
+ * @brief 光線と最も近くで交差する三角形を求める
+ *
+ * 近い子ノードから順に走査し、既に見つかった交点より遠いノードは枝刈りする。
+ * 三角形との交差は Möller–Trumbore 法で判定する（表裏は区別しない）。
+ *
+ * @param bvh 対象の BVH
+ * @param origin 光線の始点
+ * @param direction 光線の方向（正規化不要）
+ * @param maxDistance 交点を探す最大距離
+ * @param ignoredTriangle 交差判定から除外する元の三角形番号（始点の三角形自身など）
+ * @return 最も近い交点（交差しない場合は hit() が false）
+ */
+RayHit intersectRay(const MeshBvh& bvh, const glm::vec3& origin, const glm::vec3& direction,
+                    float maxDistance = std::numeric_limits<float>::infinity(),
+                    std::uint32_t ignoredTriangle = BVH_NO_TRIANGLE);
@@ -0,0 +1,115 @@
+#include "mesh_cache.h"
+#include "mesh_hash.h"
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+// 内部定数定義
+namespace
+{
+constexpr std::uint32_t CACHE_MAGIC{0x43545353};   // "SSTC"（リトルエンディアン）
+constexpr std::uint32_t CACHE_FORMAT_VERSION{1};  // ヘッダー形式のバージョン
+constexpr const char *CACHE_DIRECTORY_NAME{"stl_viewer_cache"};
+
+/**
+ * @brief キャッシュエントリのヘッダー
+ */
+struct CacheHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t payloadSize;
+};
+} // namespace
+
+MeshCache::MeshCache(std::filesystem::path directory) : directory{std::move(directory)}
+{
+}
+
+std::filesystem::path MeshCache::defaultDirectory()
+{
+    auto error = std::error_code{};
+    auto base = std::filesystem::temp_directory_path(error);
+    return error ? std::filesystem::path{CACHE_DIRECTORY_NAME} : base / CACHE_DIRECTORY_NAME;
+}
+
+std::filesystem::path MeshCache::entryPath(std::uint64_t hash, const std::string &kind) const
+{
+    return directory / (formatMeshHash(hash) + "." + kind);
+}
+
+bool MeshCache::load(std::uint64_t hash, const std::string &kind, std::vector<char> &data) const
+{
+    errorMessage.clear();
+
+    // エントリが無いのはキャッシュミスであり、エラーではない
+    auto path = entryPath(hash, kind);
+    auto file = std::ifstream{path, std::ios::binary};
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    auto header = CacheHeader{};
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.magic != CACHE_MAGIC ||
+        header.version != CACHE_FORMAT_VERSION)
+    {
+        errorMessage = "Invalid cache entry header: " + path.string();
+        return false;
+    }
+
+    // 壊れたヘッダーの長さで巨大な領域を確保しないよう、ファイルの残りの長さと照合してから確保する
+    auto error = std::error_code{};
+    auto fileSize = std::filesystem::file_size(path, error);
+    if (error || header.payloadSize > fileSize - sizeof(header))
+    {
+        errorMessage = "Truncated cache entry: " + path.string();
+        return false;
+    }
+
+    data.resize(static_cast<std::size_t>(header.payloadSize));
+    if (!file.read(data.data(), static_cast<std::streamsize>(data.size())))
+    {
+        errorMessage = "Truncated cache entry: " + path.string();
+        data.clear();
+        return false;
+    }
+    return true;
+}
+
+bool MeshCache::store(std::uint64_t hash, const std::string &kind, std::span<const char> data)
+{
+    errorMessage.clear();
+
+    auto error = std::error_code{};
+    std::filesystem::create_directories(directory, error);
+    if (error)
+    {
+        errorMessage = "Failed to create cache directory: " + error.message();
+        return false;
+    }
+
+    // 一時ファイルに書き込んでから置き換える（中断時に壊れたエントリを残さない）
+    auto path = entryPath(hash, kind);
+    auto temporaryPath = path;
+    temporaryPath += ".tmp";
+    {
+        auto file = std::ofstream{temporaryPath, std::ios::binary | std::ios::trunc};
+        auto header = CacheHeader{CACHE_MAGIC, CACHE_FORMAT_VERSION, data.size()};
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        if (!file)
+        {
+            errorMessage = "Failed to write cache entry: " + temporaryPath.string();
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporaryPath, path, error);
+    if (error)
+    {
+        errorMessage = "Failed to commit cache entry: " + error.message();
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file mesh_cache.h
+ * @brief メッシュのコンテンツハッシュをキーとするディスクキャッシュ
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * @brief コンテンツハッシュをキーとしたディスクキャッシュ
+ *
+ * 形状から派生したデータ（溶接結果、解析結果、サムネイル等）を
+ * 「<ハッシュ16桁>.<種別>」というファイル名で保存する。キーはファイル名ではなく
+ * 形状のハッシュ（computeMeshHash()）であるため、別名・別形式で保存された
+ * 同一形状のファイルでもキャッシュが共有され、処理は一度だけ行われる。
+ *
+ * 各エントリにはマジック値・形式バージョン・ペイロード長のヘッダーを付加し、
+ * 読み込み時に検証する。書き込みは一時ファイル経由で行い、途中で中断しても
+ * 壊れたエントリが残らないようにする。
+ */
+class MeshCache {
+public:
+    /**
+     * @brief コンストラクタ
+     *
+     * @param directory キャッシュディレクトリ（存在しない場合は書き込み時に作成）
+     */
+    explicit MeshCache(std::filesystem::path directory = defaultDirectory());
+
+    /**
+     * @brief 既定のキャッシュディレクトリを取得する
+     *
+     * @return 一時ディレクトリ配下の "stl_viewer_cache"
+     */
+    static std::filesystem::path defaultDirectory();
+
+    /**
+     * @brief エントリのファイルパスを取得する
+     *
+     * @param hash 形状のコンテンツハッシュ
+     * @param kind データ種別（例: "weld", "thumbnail"）
+     * @return エントリのファイルパス
+     */
+    std::filesystem::path entryPath(std::uint64_t hash, const std::string& kind) const;
+
+    /**
+     * @brief エントリを読み込む
+     *
+     * @param hash 形状のコンテンツハッシュ
+     * @param kind データ種別
+     * @param data [out] 読み込んだペイロード
+     * @return エントリが存在し、ヘッダー検証に成功した場合はtrue
+     * @post エントリが存在しない場合はエラーメッセージが空、壊れていた場合はgetErrorMessage()でエラー詳細を取得可能
+     */
+    bool load(std::uint64_t hash, const std::string& kind, std::vector<char>& data) const;
+
+    /**
+     * @brief エントリを書き込む
+     *
+     * @param hash 形状のコンテンツハッシュ
+     * @param kind データ種別
+     * @param data 書き込むペイロード
+     * @return 書き込み成功時はtrue、失敗時はfalse
+     * @post 失敗時はgetErrorMessage()でエラー詳細を取得可能
+     */
+    bool store(std::uint64_t hash, const std::string& kind, std::span<const char> data);
+
+    /**
+     * @brief 最後に発生したエラーの詳細メッセージを取得する
+     *
+     * @return エラーメッセージ文字列（エラーがない場合は空文字列）
+     */
+    const std::string& getErrorMessage() const noexcept { return errorMessage; }
+
+private:
+    std::filesystem::path directory;   ///< キャッシュディレクトリ
+    mutable std::string errorMessage;  ///< 最後に発生したエラーメッセージ
+};
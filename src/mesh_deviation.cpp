@@ -0,0 +1,184 @@
+#include "mesh_deviation.h"
+#include "mesh_bvh.h"
+#include "mesh_distance.h"
+#include "mesh_orientation.h"
+#include "mesh_topology.h"
+#include "model_loader.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// 内部定数定義
+namespace
+{
+constexpr int TRIANGLE_VERTICES{3}; // 三角形の頂点数
+
+/**
+ * @brief 偏差の統計の部分和
+ */
+struct DeviationSums {
+    float minimum = std::numeric_limits<float>::max();
+    float maximum = std::numeric_limits<float>::lowest();
+    double sum = 0.0;
+    double squaredSum = 0.0;
+    std::size_t withinTolerance = 0;
+};
+
+/**
+ * @brief 辺・面の擬似法線
+ *
+ * 頂点の擬似法線は computeVertexNormals() で求める。
+ */
+struct FeatureNormals {
+    std::vector<glm::vec3> faceNormals;      ///< 三角形ごとの単位法線（面積0の三角形は零ベクトル）
+    std::vector<glm::vec3> edgeNormals;      ///< 無向辺ごとの擬似法線（辺を共有する面の単位法線の和）
+    std::vector<std::uint32_t> cornerEdges;  ///< 三角形の角 corner から始まる辺の無向辺番号（三角形数 × 3）
+};
+
+/**
+ * @brief 面と辺の擬似法線を求める
+ *
+ * 辺の擬似法線は、辺を共有する面の単位法線をそれぞれの角度重み π で加算したものに等しい。
+ * 無向辺ごとに辺テーブルの区間を順に加算するため、結果は実行ごとに変わらない。
+ */
+FeatureNormals computeFeatureNormals(const IndexedMesh &mesh)
+{
+    auto normals = FeatureNormals{};
+    auto triangleCount = mesh.triangleCount();
+    normals.faceNormals.resize(triangleCount);
+    parallel::forEach(triangleCount, [&](std::size_t t) {
+        const auto &a = mesh.positions[mesh.indices[t * TRIANGLE_VERTICES]];
+        const auto &b = mesh.positions[mesh.indices[t * TRIANGLE_VERTICES + 1]];
+        const auto &c = mesh.positions[mesh.indices[t * TRIANGLE_VERTICES + 2]];
+        auto normal = glm::cross(b - a, c - a);
+        auto length = glm::length(normal);
+        normals.faceNormals[t] = length > 0.0f ? normal / length : glm::vec3{0.0f};
+    });
+
+    auto edges = buildEdgeTable(mesh);
+    normals.edgeNormals.resize(edges.edgeCount());
+    normals.cornerEdges.resize(triangleCount * TRIANGLE_VERTICES);
+    parallel::forEach(edges.edgeCount(), [&](std::size_t e) {
+        auto normal = glm::vec3{0.0f};
+        for (auto h = edges.edgeOffsets[e]; h < edges.edgeOffsets[e + 1]; ++h)
+        {
+            const auto &halfEdge = edges.halfEdges[h];
+            normal += normals.faceNormals[halfEdge.triangle];
+            normals.cornerEdges[halfEdge.triangle * TRIANGLE_VERTICES + halfEdge.corner] = static_cast<std::uint32_t>(e);
+        }
+        normals.edgeNormals[e] = normal;
+    });
+    return normals;
+}
+
+/**
+ * @brief 最近点がある要素の擬似法線を取得する
+ */
+glm::vec3 pseudoNormal(const IndexedMesh &reference, const FeatureNormals &features,
+                       const std::vector<glm::vec3> &vertexNormals, const ClosestPoint &hit)
+{
+    auto t = static_cast<std::size_t>(hit.triangle);
+    switch (hit.feature)
+    {
+    case ClosestFeature::Vertex0:
+    case ClosestFeature::Vertex1:
+    case ClosestFeature::Vertex2: {
+        auto corner = static_cast<std::size_t>(hit.feature) - static_cast<std::size_t>(ClosestFeature::Vertex0);
+        return vertexNormals[reference.indices[t * TRIANGLE_VERTICES + corner]];
+    }
+    case ClosestFeature::Edge0:
+    case ClosestFeature::Edge1:
+    case ClosestFeature::Edge2: {
+        auto corner = static_cast<std::size_t>(hit.feature) - static_cast<std::size_t>(ClosestFeature::Edge0);
+        return features.edgeNormals[features.cornerEdges[t * TRIANGLE_VERTICES + corner]];
+    }
+    case ClosestFeature::Face:
+        break;
+    }
+    return features.faceNormals[t];
+}
+
+/**
+ * @brief 偏差を packingRange() で正規化し、符号付き整数へ量子化する
+ */
+template <typename T>
+std::vector<T> packDeviation(const MeshDeviation &deviation)
+{
+    const auto &values = deviation.vertexDeviation;
+    auto packed = std::vector<T>(values.size());
+    auto range = deviation.packingRange();
+    auto scale = range > 0.0f ? static_cast<float>(std::numeric_limits<T>::max()) / range : 0.0f;
+    auto limit = static_cast<float>(std::numeric_limits<T>::max());
+    parallel::forEach(values.size(), [&](std::size_t i) {
+        packed[i] = static_cast<T>(std::lround(std::clamp(values[i] * scale, -limit, limit)));
+    });
+    return packed;
+}
+} // namespace
+
+MeshDeviation computeDeviation(const IndexedMesh &mesh, const IndexedMesh &reference, float tolerance)
+{
+    auto result = MeshDeviation{};
+    result.tolerance = tolerance;
+    result.vertexDeviation.assign(mesh.positions.size(), 0.0f);
+    if (mesh.positions.empty() || reference.triangleCount() == 0)
+    {
+        return result;
+    }
+
+    auto bvh = buildMeshBvh(reference);
+    auto vertexNormals = computeVertexNormals(reference);
+    auto features = computeFeatureNormals(reference);
+    auto closest = findClosestPoints(bvh, mesh.positions);
+
+    // 最近点がある要素（面・辺・頂点）の擬似法線の向きで符号を決める
+    parallel::forEach(mesh.positions.size(), [&](std::size_t i) {
+        const auto &hit = closest[i];
+        auto normal = pseudoNormal(reference, features, vertexNormals, hit);
+        auto outside = glm::dot(mesh.positions[i] - hit.point, normal) >= 0.0f;
+        result.vertexDeviation[i] = outside ? hit.distance : -hit.distance;
+    });
+
+    auto sums = parallel::reduce(
+        mesh.positions.size(), DeviationSums{},
+        [&](std::size_t begin, std::size_t end) {
+            auto partial = DeviationSums{};
+            for (auto i = begin; i < end; ++i)
+            {
+                auto value = result.vertexDeviation[i];
+                partial.minimum = std::min(partial.minimum, value);
+                partial.maximum = std::max(partial.maximum, value);
+                partial.sum += value;
+                partial.squaredSum += static_cast<double>(value) * value;
+                partial.withinTolerance += std::abs(value) <= tolerance ? 1 : 0;
+            }
+            return partial;
+        },
+        [](DeviationSums lhs, const DeviationSums &rhs) {
+            lhs.minimum = std::min(lhs.minimum, rhs.minimum);
+            lhs.maximum = std::max(lhs.maximum, rhs.maximum);
+            lhs.sum += rhs.sum;
+            lhs.squaredSum += rhs.squaredSum;
+            lhs.withinTolerance += rhs.withinTolerance;
+            return lhs;
+        });
+
+    auto count = static_cast<double>(mesh.positions.size());
+    result.minimum = sums.minimum;
+    result.maximum = sums.maximum;
+    result.mean = static_cast<float>(sums.sum / count);
+    result.rms = static_cast<float>(std::sqrt(sums.squaredSum / count));
+    result.withinTolerance = sums.withinTolerance;
+    return result;
+}
+
+std::vector<std::int16_t> packDeviation16(const MeshDeviation &deviation)
+{
+    return packDeviation<std::int16_t>(deviation);
+}
+
+std::vector<std::int8_t> packDeviation8(const MeshDeviation &deviation)
+{
+    return packDeviation<std::int8_t>(deviation);
+}
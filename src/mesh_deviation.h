@@ -0,0 +1,74 @@
+/**
+ * @file mesh_deviation.h
+ * @brief 参照メッシュに対する頂点ごとの偏差（符号付き距離）の計算と頂点属性用の量子化
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct IndexedMesh;
+
+/// 偏差の色分けに使う許容差の段数（許容差の倍数ごとに色を変え、この段数以上は同じ色とする）
+constexpr int DEVIATION_BAND_COUNT{5};
+
+/**
+ * @brief 偏差解析の結果
+ */
+struct MeshDeviation {
+    std::vector<float> vertexDeviation;  ///< 頂点ごとの符号付き距離（参照面の外側が正、内側が負）
+    float tolerance = 0.0f;              ///< 許容差
+    float minimum = 0.0f;                ///< 偏差の最小値
+    float maximum = 0.0f;                ///< 偏差の最大値
+    float mean = 0.0f;                   ///< 偏差の平均値
+    float rms = 0.0f;                    ///< 偏差の二乗平均平方根
+    std::size_t withinTolerance = 0;     ///< 偏差の絶対値が許容差以内の頂点数
+
+    /**
+     * @brief 量子化する値の範囲（この絶対値を超える偏差は範囲の端に丸める）
+     */
+    float packingRange() const noexcept { return tolerance * DEVIATION_BAND_COUNT; }
+};
+
+/**
+ * @brief メッシュの各頂点から参照メッシュまでの符号付き距離を求める
+ *
+ * 参照メッシュの BVH を構築し、findClosestPoints() で全頂点の最近点を並列に求める。
+ * 符号は最近点がある要素の角度重み付き擬似法線との内積で決める（Bærentzen & Aanæs）。
+ * 最近点が面の内部にあれば面の法線、辺上にあれば辺を共有する面の法線の和、
+ * 頂点にあれば computeVertexNormals() の頂点法線を使う。
+ * 面の法線だけでは最近点が辺や頂点にある場合に符号を誤るため、隣接面の向きを反映した法線を使う。
+ *
+ * @param mesh 評価するメッシュ（スキャンデータなど）
+ * @param reference 参照メッシュ（CAD形状など、orientMesh() で外向きに揃えてあること）
+ * @param tolerance 許容差
+ * @return 偏差解析の結果
+ * @note 2つのメッシュは同じ座標系に位置合わせ済みであること
+ */
+MeshDeviation computeDeviation(const IndexedMesh& mesh, const IndexedMesh& reference, float tolerance);
+
+/**
+ * @brief 偏差を16ビットの符号付き正規化整数に量子化する
+ *
+ * [-packingRange(), packingRange()] を [-32767, 32767] に対応させる。
+ * GL_SHORT の正規化頂点属性として転送すると、シェーダーでは [-1, 1] の値として読める。
+ *
+ * @param deviation 偏差解析の結果
+ * @return 頂点ごとの量子化した偏差
+ */
+std::vector<std::int16_t> packDeviation16(const MeshDeviation& deviation);
+
+/**
+ * @brief 偏差を8ビットの符号付き正規化整数に量子化する
+ *
+ * [-packingRange(), packingRange()] を [-127, 127] に対応させる（許容差1段あたり約25段階）。
+ *
+ * @param deviation 偏差解析の結果
+ * @return 頂点ごとの量子化した偏差
+ * @see packDeviation16()
+ */
+std::vector<std::int8_t> packDeviation8(const MeshDeviation& deviation);
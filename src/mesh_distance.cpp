@@ -0,0 +1,534 @@
+#include "mesh_distance.h"
+#include "mesh_interference.h"
+#include "parallel.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <utility>
+
+// 内部定数定義
+namespace
+{
+constexpr int TRIANGLE_VERTICES{3};            // 三角形の頂点数
+constexpr std::size_t QUERY_MIN_CHUNK{1024};   // 1スレッドあたりの最小問い合わせ点数
+constexpr std::size_t PAIRS_PER_THREAD{16};    // 並列走査の前に展開するノード対の数（スレッド数に対する倍率）
+constexpr int MAX_EXPANSION_LEVELS{32};        // ノード対を幅優先に展開する最大段数
+constexpr std::uint32_t NO_LEAF_POSITION{BVH_NO_TRIANGLE};
+
+using Triangle = std::array<glm::vec3, TRIANGLE_VERTICES>;
+
+/**
+ * @brief 探索中の最近点の候補
+ */
+struct PointCandidate {
+    float distanceSquared;
+    std::uint32_t leafPosition;  ///< 最近点を含む三角形の葉の順の位置
+    glm::vec3 point;
+    ClosestFeature feature;
+};
+
+/**
+ * @brief 探索中の面間の最近点対の候補
+ */
+struct PairCandidate {
+    float distanceSquared = std::numeric_limits<float>::infinity();
+    std::uint32_t firstPosition = NO_LEAF_POSITION;
+    std::uint32_t secondPosition = NO_LEAF_POSITION;
+    glm::vec3 firstPoint{0.0f};
+    glm::vec3 secondPoint{0.0f};
+};
+
+/**
+ * @brief 走査中のノード対と距離の下界
+ */
+struct BoundedPair {
+    std::uint32_t first;
+    std::uint32_t second;
+    float bound;  ///< バウンディングボックス間の距離の2乗
+};
+
+inline float boxDistanceSquared(const BvhNode &node, const glm::vec3 &point)
+{
+    auto offset = glm::max(glm::max(node.minBounds - point, point - node.maxBounds), glm::vec3{0.0f});
+    return glm::dot(offset, offset);
+}
+
+inline float boxDistanceSquared(const BvhNode &lhs, const BvhNode &rhs)
+{
+    auto offset = glm::max(glm::max(lhs.minBounds - rhs.maxBounds, rhs.minBounds - lhs.maxBounds), glm::vec3{0.0f});
+    return glm::dot(offset, offset);
+}
+
+inline float halfArea(const BvhNode &node)
+{
+    auto extent = node.maxBounds - node.minBounds;
+    return extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+}
+
+/**
+ * @brief 点に最も近い三角形上の点を求める（最近点の領域判定による厳密解）
+ *
+ * @param feature [out] 最近点がある要素（頂点・辺・面の内部）
+ */
+glm::vec3 closestPointOnTriangle(const glm::vec3 &p, const Triangle &triangle, ClosestFeature &feature)
+{
+    const auto &a = triangle[0];
+    const auto &b = triangle[1];
+    const auto &c = triangle[2];
+    auto ab = b - a;
+    auto ac = c - a;
+    auto ap = p - a;
+    auto d1 = glm::dot(ab, ap);
+    auto d2 = glm::dot(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f)
+    {
+        feature = ClosestFeature::Vertex0;
+        return a; // 頂点 a
+    }
+
+    auto bp = p - b;
+    auto d3 = glm::dot(ab, bp);
+    auto d4 = glm::dot(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3)
+    {
+        feature = ClosestFeature::Vertex1;
+        return b; // 頂点 b
+    }
+
+    auto vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+    {
+        feature = ClosestFeature::Edge0;
+        return a + ab * (d1 / (d1 - d3)); // 辺 ab
+    }
+
+    auto cp = p - c;
+    auto d5 = glm::dot(ab, cp);
+    auto d6 = glm::dot(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6)
+    {
+        feature = ClosestFeature::Vertex2;
+        return c; // 頂点 c
+    }
+
+    auto vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+    {
+        feature = ClosestFeature::Edge2;
+        return a + ac * (d2 / (d2 - d6)); // 辺 ac
+    }
+
+    auto va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+    {
+        feature = ClosestFeature::Edge1;
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6))); // 辺 bc
+    }
+
+    auto denominator = va + vb + vc;
+    if (!(denominator > 0.0f))
+    {
+        feature = ClosestFeature::Vertex0;
+        return a; // 退化三角形（ここに来るのは面積0の場合のみ）
+    }
+    feature = ClosestFeature::Face;
+    return a + ab * (vb / denominator) + ac * (vc / denominator); // 面の内部
+}
+
+/**
+ * @brief 点に最も近い三角形上の点を求める（要素が不要な場合）
+ */
+glm::vec3 closestPointOnTriangle(const glm::vec3 &p, const Triangle &triangle)
+{
+    auto feature = ClosestFeature::Face;
+    return closestPointOnTriangle(p, triangle, feature);
+}
+
+/**
+ * @brief 2つの線分の最近点対を求める
+ */
+void closestSegmentPoints(const glm::vec3 &p1, const glm::vec3 &q1, const glm::vec3 &p2, const glm::vec3 &q2,
+                          glm::vec3 &closest1, glm::vec3 &closest2)
+{
+    auto d1 = q1 - p1;
+    auto d2 = q2 - p2;
+    auto r = p1 - p2;
+    auto a = glm::dot(d1, d1);
+    auto e = glm::dot(d2, d2);
+    auto f = glm::dot(d2, r);
+    auto s = 0.0f;
+    auto t = 0.0f;
+    if (a <= 0.0f && e <= 0.0f)
+    {
+        // 両方とも点
+    }
+    else if (a <= 0.0f)
+    {
+        t = std::clamp(f / e, 0.0f, 1.0f);
+    }
+    else
+    {
+        auto c = glm::dot(d1, r);
+        if (e <= 0.0f)
+        {
+            s = std::clamp(-c / a, 0.0f, 1.0f);
+        }
+        else
+        {
+            auto b = glm::dot(d1, d2);
+            auto denominator = a * e - b * b;
+            s = denominator > 0.0f ? std::clamp((b * f - c * e) / denominator, 0.0f, 1.0f) : 0.0f;
+            t = (b * s + f) / e;
+            if (t < 0.0f)
+            {
+                t = 0.0f;
+                s = std::clamp(-c / a, 0.0f, 1.0f);
+            }
+            else if (t > 1.0f)
+            {
+                t = 1.0f;
+                s = std::clamp((b - c) / a, 0.0f, 1.0f);
+            }
+        }
+    }
+    closest1 = p1 + d1 * s;
+    closest2 = p2 + d2 * t;
+}
+
+/**
+ * @brief 交差していない2つの三角形の最近点対を求める
+ *
+ * 交差しない三角形の最近点対は、一方の頂点と他方の面、または辺同士のいずれかに現れる。
+ *
+ * @return 最近点対の距離の2乗
+ */
+float closestTrianglePoints(const Triangle &first, const Triangle &second, glm::vec3 &firstPoint,
+                            glm::vec3 &secondPoint)
+{
+    auto best = std::numeric_limits<float>::infinity();
+    auto consider = [&best, &firstPoint, &secondPoint](const glm::vec3 &p, const glm::vec3 &q) {
+        auto offset = p - q;
+        auto squared = glm::dot(offset, offset);
+        if (squared < best)
+        {
+            best = squared;
+            firstPoint = p;
+            secondPoint = q;
+        }
+    };
+
+    for (int i = 0; i < TRIANGLE_VERTICES; ++i)
+    {
+        consider(first[i], closestPointOnTriangle(first[i], second));
+        consider(closestPointOnTriangle(second[i], first), second[i]);
+    }
+    for (int i = 0; i < TRIANGLE_VERTICES; ++i)
+    {
+        for (int j = 0; j < TRIANGLE_VERTICES; ++j)
+        {
+            auto p = glm::vec3{};
+            auto q = glm::vec3{};
+            closestSegmentPoints(first[i], first[(i + 1) % TRIANGLE_VERTICES], second[j],
+                                 second[(j + 1) % TRIANGLE_VERTICES], p, q);
+            consider(p, q);
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief BVH を分枝限定法で走査し、候補より近い最近点があれば更新する
+ *
+ * @param best [in,out] 現在の最近点の候補（distanceSquared が枝刈りの上界）
+ */
+void searchClosestPoint(const MeshBvh &bvh, const glm::vec3 &query, PointCandidate &best)
+{
+    auto stack = std::array<std::pair<std::uint32_t, float>, BVH_TRAVERSAL_STACK_SIZE>{};
+    auto stackSize = std::size_t{0};
+    stack[stackSize++] = {0, boxDistanceSquared(bvh.nodes[0], query)};
+
+    while (stackSize > 0)
+    {
+        auto [nodeIndex, bound] = stack[--stackSize];
+        if (bound >= best.distanceSquared)
+        {
+            continue;
+        }
+
+        const auto &node = bvh.nodes[nodeIndex];
+        if (node.isLeaf())
+        {
+            for (auto i = node.firstOrChild; i < node.firstOrChild + node.triangleCount; ++i)
+            {
+                auto feature = ClosestFeature::Face;
+                auto point = closestPointOnTriangle(query, bvh.triangles[i], feature);
+                auto offset = query - point;
+                auto squared = glm::dot(offset, offset);
+                if (squared < best.distanceSquared)
+                {
+                    best = PointCandidate{squared, i, point, feature};
+                }
+            }
+            continue;
+        }
+
+        // 近い子を後に積んで先に走査する
+        auto near = node.firstOrChild;
+        auto far = near + 1;
+        auto nearBound = boxDistanceSquared(bvh.nodes[near], query);
+        auto farBound = boxDistanceSquared(bvh.nodes[far], query);
+        if (nearBound > farBound)
+        {
+            std::swap(near, far);
+            std::swap(nearBound, farBound);
+        }
+        if (farBound < best.distanceSquared)
+        {
+            stack[stackSize++] = {far, farBound};
+        }
+        if (nearBound < best.distanceSquared)
+        {
+            stack[stackSize++] = {near, nearBound};
+        }
+    }
+}
+
+ClosestPoint toClosestPoint(const MeshBvh &bvh, const PointCandidate &candidate)
+{
+    if (candidate.leafPosition == NO_LEAF_POSITION)
+    {
+        return ClosestPoint{};
+    }
+    return ClosestPoint{candidate.point, std::sqrt(candidate.distanceSquared), bvh.triangleIds[candidate.leafPosition],
+                        candidate.feature};
+}
+
+/**
+ * @brief ノード対の子の組を、距離の下界とともに出力する
+ *
+ * 葉でない側のうち大きい方のノードを分割する（両方葉の場合は何もしない）。
+ *
+ * @return 子の組に展開した場合はtrue
+ */
+template <typename Output>
+bool expandPair(const MeshBvh &first, const MeshBvh &second, const BoundedPair &pair, Output &&output)
+{
+    const auto &firstNode = first.nodes[pair.first];
+    const auto &secondNode = second.nodes[pair.second];
+    if (firstNode.isLeaf() && secondNode.isLeaf())
+    {
+        return false;
+    }
+
+    auto splitFirst = !firstNode.isLeaf() && (secondNode.isLeaf() || halfArea(firstNode) >= halfArea(secondNode));
+    auto children = std::array<BoundedPair, 2>{};
+    for (std::uint32_t c = 0; c < 2; ++c)
+    {
+        auto childFirst = splitFirst ? firstNode.firstOrChild + c : pair.first;
+        auto childSecond = splitFirst ? pair.second : secondNode.firstOrChild + c;
+        children[c] = BoundedPair{childFirst, childSecond,
+                                  boxDistanceSquared(first.nodes[childFirst], second.nodes[childSecond])};
+    }
+
+    // 遠い組を先に出力する（スタックでは近い組が先に取り出される）
+    if (children[0].bound < children[1].bound)
+    {
+        std::swap(children[0], children[1]);
+    }
+    output(children[0]);
+    output(children[1]);
+    return true;
+}
+
+/**
+ * @brief 距離が等しい場合は三角形番号の小さい組を選び、結果をスレッド数に依存させない
+ */
+bool isCloser(const MeshBvh &first, const MeshBvh &second, const PairCandidate &lhs, const PairCandidate &rhs)
+{
+    if (lhs.distanceSquared != rhs.distanceSquared)
+    {
+        return lhs.distanceSquared < rhs.distanceSquared;
+    }
+    if (rhs.firstPosition == NO_LEAF_POSITION)
+    {
+        return lhs.firstPosition != NO_LEAF_POSITION;
+    }
+    if (lhs.firstPosition == NO_LEAF_POSITION)
+    {
+        return false;
+    }
+    return std::pair{first.triangleIds[lhs.firstPosition], second.triangleIds[lhs.secondPosition]} <
+           std::pair{first.triangleIds[rhs.firstPosition], second.triangleIds[rhs.secondPosition]};
+}
+
+/**
+ * @brief 値を小さい方へ更新する（複数スレッドで上界を共有するため原子的に行う）
+ */
+inline void atomicMin(std::atomic<float> &target, float value)
+{
+    auto current = target.load(std::memory_order_relaxed);
+    while (value < current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+}
+} // namespace
+
+ClosestPoint findClosestPoint(const MeshBvh &bvh, const glm::vec3 &query, float maxDistance)
+{
+    if (bvh.empty())
+    {
+        return ClosestPoint{};
+    }
+
+    auto best = PointCandidate{maxDistance * maxDistance, NO_LEAF_POSITION, glm::vec3{0.0f}, ClosestFeature::Face};
+    searchClosestPoint(bvh, query, best);
+    return toClosestPoint(bvh, best);
+}
+
+std::vector<ClosestPoint> findClosestPoints(const MeshBvh &bvh, std::span<const glm::vec3> queries,
+                                            float maxDistance)
+{
+    auto results = std::vector<ClosestPoint>(queries.size());
+    if (bvh.empty())
+    {
+        return results;
+    }
+
+    auto maxSquared = maxDistance * maxDistance;
+    parallel::forEachChunk(
+        queries.size(),
+        [&](std::size_t begin, std::size_t end, std::size_t) {
+            auto previous = NO_LEAF_POSITION;
+            for (auto i = begin; i < end; ++i)
+            {
+                // 直前の点の最近の三角形までの距離を初期の上界にする
+                auto best = PointCandidate{maxSquared, NO_LEAF_POSITION, glm::vec3{0.0f}, ClosestFeature::Face};
+                if (previous != NO_LEAF_POSITION)
+                {
+                    auto feature = ClosestFeature::Face;
+                    auto point = closestPointOnTriangle(queries[i], bvh.triangles[previous], feature);
+                    auto offset = queries[i] - point;
+                    auto squared = glm::dot(offset, offset);
+                    if (squared < maxSquared)
+                    {
+                        best = PointCandidate{squared, previous, point, feature};
+                    }
+                }
+
+                searchClosestPoint(bvh, queries[i], best);
+                results[i] = toClosestPoint(bvh, best);
+                previous = best.leafPosition;
+            }
+        },
+        QUERY_MIN_CHUNK);
+    return results;
+}
+
+SurfaceDistance findMinimumDistance(const MeshBvh &first, const MeshBvh &second)
+{
+    auto result = SurfaceDistance{};
+    if (first.empty() || second.empty())
+    {
+        return result;
+    }
+
+    // 交差している場合は距離0
+    if (auto contact = findFirstTriangleContact(first, second))
+    {
+        return SurfaceDistance{0.0f, contact->segmentStart, contact->segmentStart, contact->firstTriangle,
+                               contact->secondTriangle};
+    }
+
+    // 根の組から幅優先に展開し、並列に分配できるだけのノード対を用意する
+    auto frontier = std::vector<BoundedPair>{{0, 0, boxDistanceSquared(first.nodes[0], second.nodes[0])}};
+    auto targetPairs = parallel::threadCount() * PAIRS_PER_THREAD;
+    for (int level = 0; level < MAX_EXPANSION_LEVELS && frontier.size() < targetPairs; ++level)
+    {
+        auto next = std::vector<BoundedPair>{};
+        next.reserve(frontier.size() * 2);
+        auto expanded = false;
+        for (const auto &pair : frontier)
+        {
+            if (expandPair(first, second, pair, [&next](const BoundedPair &child) { next.push_back(child); }))
+            {
+                expanded = true;
+            }
+            else
+            {
+                next.push_back(pair);
+            }
+        }
+        frontier = std::move(next);
+        if (!expanded)
+        {
+            break;
+        }
+    }
+
+    // 下界の小さい順に並べ、各スレッドへ交互に割り当てて有望な組から走査する
+    std::sort(frontier.begin(), frontier.end(),
+              [](const BoundedPair &lhs, const BoundedPair &rhs) { return lhs.bound < rhs.bound; });
+    auto chunks = parallel::chunkCount(frontier.size(), 1);
+    auto chunkBest = std::vector<PairCandidate>(chunks);
+    auto sharedBound = std::atomic<float>{std::numeric_limits<float>::infinity()};
+    parallel::forEachChunk(
+        chunks,
+        [&](std::size_t, std::size_t, std::size_t chunk) {
+            auto &best = chunkBest[chunk];
+            auto stack = std::vector<BoundedPair>{};
+            for (auto i = chunk; i < frontier.size(); i += chunks)
+            {
+                stack.push_back(frontier[i]);
+                while (!stack.empty())
+                {
+                    auto pair = stack.back();
+                    stack.pop_back();
+                    if (pair.bound > sharedBound.load(std::memory_order_relaxed))
+                    {
+                        continue;
+                    }
+                    if (expandPair(first, second, pair, [&stack](const BoundedPair &child) { stack.push_back(child); }))
+                    {
+                        continue;
+                    }
+
+                    const auto &firstNode = first.nodes[pair.first];
+                    const auto &secondNode = second.nodes[pair.second];
+                    for (auto a = firstNode.firstOrChild; a < firstNode.firstOrChild + firstNode.triangleCount; ++a)
+                    {
+                        for (auto b = secondNode.firstOrChild; b < secondNode.firstOrChild + secondNode.triangleCount;
+                             ++b)
+                        {
+                            auto candidate = PairCandidate{};
+                            candidate.firstPosition = a;
+                            candidate.secondPosition = b;
+                            candidate.distanceSquared = closestTrianglePoints(
+                                first.triangles[a], second.triangles[b], candidate.firstPoint, candidate.secondPoint);
+                            if (isCloser(first, second, candidate, best))
+                            {
+                                best = candidate;
+                                atomicMin(sharedBound, best.distanceSquared);
+                            }
+                        }
+                    }
+                }
+            }
+        },
+        1);
+
+    auto best = PairCandidate{};
+    for (const auto &candidate : chunkBest)
+    {
+        if (isCloser(first, second, candidate, best))
+        {
+            best = candidate;
+        }
+    }
+    if (best.firstPosition != NO_LEAF_POSITION)
+    {
+        result = SurfaceDistance{std::sqrt(best.distanceSquared), best.firstPoint, best.secondPoint,
+                                 first.triangleIds[best.firstPosition], second.triangleIds[best.secondPosition]};
+    }
+    return result;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file mesh_distance.h
+ * @brief BVH の分枝限定法による最近点・面間の最小距離の計算
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+#include <glm/glm.hpp>
+#include "mesh_bvh.h"
+
+/**
+ * @brief 最近点が三角形のどの要素（頂点・辺・面の内部）にあるか
+ *
+ * 角の番号は三角形のインデックスの順（0〜2）で、EdgeN は角 N から角 (N + 1) % 3 への辺を表す。
+ */
+enum class ClosestFeature : std::uint8_t {
+    Vertex0,
+    Vertex1,
+    Vertex2,
+    Edge0,
+    Edge1,
+    Edge2,
+    Face,
+};
+
+/**
+ * @brief メッシュ上の最近点
+ */
+struct ClosestPoint {
+    glm::vec3 point{0.0f};                                     ///< メッシュ上の最近点
+    float distance = std::numeric_limits<float>::infinity();   ///< 問い合わせ点から最近点までの距離
+    std::uint32_t triangle = BVH_NO_TRIANGLE;                  ///< 最近点を含む元の三角形番号
+    ClosestFeature feature = ClosestFeature::Face;             ///< 最近点がある三角形の要素
+
+    bool found() const noexcept { return triangle != BVH_NO_TRIANGLE; }
+};
+
+/**
+ * @brief 2つの面の間の最小距離
+ */
+struct SurfaceDistance {
+    float distance = std::numeric_limits<float>::infinity();  ///< 最小距離（交差している場合は0）
+    glm::vec3 firstPoint{0.0f};                                ///< 1つ目の面上の最近点
+    glm::vec3 secondPoint{0.0f};                               ///< 2つ目の面上の最近点
+    std::uint32_t firstTriangle = BVH_NO_TRIANGLE;             ///< firstPoint を含む元の三角形番号
+    std::uint32_t secondTriangle = BVH_NO_TRIANGLE;            ///< secondPoint を含む元の三角形番号
+
+    bool found() const noexcept { return firstTriangle != BVH_NO_TRIANGLE; }
+};
+
+/**
+ * @brief 点に最も近いメッシュ上の点を求める
+ *
+ * 点とバウンディングボックスの距離を下界として近い子ノードから走査し、
+ * 既に見つかった最近点より遠いノードは枝刈りする（分枝限定法）。
+ *
+ * @param bvh 対象の BVH
+ * @param query 問い合わせ点
+ * @param maxDistance 探索する最大距離（これより遠い場合は見つからない）
+ * @return 最近点（maxDistance 以内に面が無い場合は found() が false）
+ */
+ClosestPoint findClosestPoint(const MeshBvh& bvh, const glm::vec3& query,
+                              float maxDistance = std::numeric_limits<float>::infinity());
+
+/**
+ * @brief 多数の点の最近点をまとめて並列に求める
+ *
+ * 連続した点をチャンクに分けて並列に処理する。チャンク内では直前の点の最近の三角形までの距離を
+ * 初期の上界とするため、走査順に近い点が並ぶ入力（スキャンの頂点列など）ほど枝刈りが効く。
+ *
+ * @param bvh 対象の BVH
+ * @param queries 問い合わせ点
+ * @param maxDistance 探索する最大距離
+ * @return 問い合わせ点ごとの最近点（queries と同じ順序）
+ */
+std::vector<ClosestPoint> findClosestPoints(const MeshBvh& bvh, std::span<const glm::vec3> queries,
+                                            float maxDistance = std::numeric_limits<float>::infinity());
+
+/**
+ * @brief 2つの面の間の最小距離を求める
+ *
+ * 交差している場合は findFirstTriangleContact() で見つけた交差を距離0として返す（全ての交差は求めない）。
+ * 交差していない場合は、バウンディングボックス間の距離を下界として BVH 同士を分枝限定法で走査する。
+ * ノード対を幅優先に展開した後、下界の小さい順に並列に走査し、
+ * 各スレッドが見つけた最小距離を共有して枝刈りに使う。
+ *
+ * @param first 1つ目の面の BVH
+ * @param second 2つ目の面の BVH
+ * @return 最小距離と両面上の最近点（どちらかが空の場合は found() が false）
+ */
+SurfaceDistance findMinimumDistance(const MeshBvh& first, const MeshBvh& second);
@@ -0,0 +1,145 @@
+#include "mesh_features.h"
+#include "mesh_topology.h"
+#include "model_loader.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// 内部定数定義
+namespace
+{
+constexpr int TRIANGLE_VERTICES{3}; // 三角形の頂点数
+constexpr int EDGE_VERTICES{2};     // 辺の頂点数
+
+/**
+ * @brief 辺の分類の集計（並列リダクション用）
+ */
+struct FeatureCounts {
+    std::size_t crease;
+    std::size_t outline;
+};
+
+/**
+ * @brief キャッシュのペイロードのヘッダー
+ */
+struct FeatureHeader {
+    float angleDegrees;
+    std::uint32_t reserved;
+    std::uint64_t creaseEdges;
+    std::uint64_t outlineEdges;
+};
+
+/**
+ * @brief 三角形の単位法線を求める（面積0の場合は零ベクトル）
+ */
+glm::vec3 triangleNormal(const IndexedMesh &mesh, std::size_t triangle)
+{
+    const auto &a = mesh.positions[mesh.indices[triangle * TRIANGLE_VERTICES]];
+    const auto &b = mesh.positions[mesh.indices[triangle * TRIANGLE_VERTICES + 1]];
+    const auto &c = mesh.positions[mesh.indices[triangle * TRIANGLE_VERTICES + 2]];
+    auto normal = glm::cross(b - a, c - a);
+    auto length = glm::length(normal);
+    return length > 0.0f ? normal / length : glm::vec3{0.0f};
+}
+} // namespace
+
+FeatureEdges extractFeatureEdges(const IndexedMesh &mesh, const EdgeTable &edges, float angleDegrees)
+{
+    auto result = FeatureEdges{};
+    result.angleDegrees = angleDegrees;
+    auto edgeCount = edges.edgeCount();
+    auto cosineThreshold = std::cos(glm::radians(angleDegrees));
+
+    // 辺ごとに特徴辺かどうかを判定し、両端の頂点とフラグを書き込む（後で特徴辺のみに詰める）
+    auto vertices = std::vector<std::uint32_t>(edgeCount * EDGE_VERTICES);
+    auto keep = std::vector<std::uint8_t>(edgeCount * EDGE_VERTICES, 0);
+    auto counts = parallel::reduce(
+        edgeCount, FeatureCounts{},
+        [&](std::size_t begin, std::size_t end) {
+            auto partial = FeatureCounts{};
+            for (auto e = begin; e < end; ++e)
+            {
+                const auto &first = edges.halfEdges[edges.edgeOffsets[e]];
+                vertices[e * EDGE_VERTICES] = first.lowVertex();
+                vertices[e * EDGE_VERTICES + 1] = first.highVertex();
+
+                auto feature = false;
+                if (edges.edgeValence(e) != 2)
+                {
+                    feature = true;
+                    ++partial.outline;
+                }
+                else
+                {
+                    // 整合した向きでは2つの三角形は共有辺を逆向きにたどるため、法線をそのまま比較できる
+                    const auto &second = edges.halfEdges[edges.edgeOffsets[e] + 1];
+                    auto firstNormal = triangleNormal(mesh, first.triangle);
+                    auto secondNormal = triangleNormal(mesh, second.triangle);
+                    if (halfEdgeOrigin(mesh.indices, first) == halfEdgeOrigin(mesh.indices, second))
+                    {
+                        secondNormal = -secondNormal;
+                    }
+                    if (glm::dot(firstNormal, secondNormal) < cosineThreshold)
+                    {
+                        feature = true;
+                        ++partial.crease;
+                    }
+                }
+                keep[e * EDGE_VERTICES] = keep[e * EDGE_VERTICES + 1] = feature ? 1 : 0;
+            }
+            return partial;
+        },
+        [](FeatureCounts lhs, const FeatureCounts &rhs) {
+            lhs.crease += rhs.crease;
+            lhs.outline += rhs.outline;
+            return lhs;
+        });
+
+    parallel::compact(vertices, keep);
+    result.edgeVertices = std::move(vertices);
+    result.creaseEdges = counts.crease;
+    result.outlineEdges = counts.outline;
+    return result;
+}
+
+std::vector<char> serializeFeatureEdges(const FeatureEdges &features)
+{
+    auto header = FeatureHeader{features.angleDegrees, 0, features.creaseEdges, features.outlineEdges};
+    auto indexBytes = features.edgeVertices.size() * sizeof(std::uint32_t);
+    auto data = std::vector<char>(sizeof(header) + indexBytes);
+    std::memcpy(data.data(), &header, sizeof(header));
+    std::memcpy(data.data() + sizeof(header), features.edgeVertices.data(), indexBytes);
+    return data;
+}
+
+bool deserializeFeatureEdges(std::span<const char> data, std::size_t vertexCount, FeatureEdges &features)
+{
+    auto header = FeatureHeader{};
+    if (data.size() < sizeof(header))
+    {
+        return false;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    auto edgeCount = header.creaseEdges + header.outlineEdges;
+    if (data.size() != sizeof(header) + edgeCount * EDGE_VERTICES * sizeof(std::uint32_t))
+    {
+        return false;
+    }
+
+    auto edgeVertices = std::vector<std::uint32_t>(edgeCount * EDGE_VERTICES);
+    std::memcpy(edgeVertices.data(), data.data() + sizeof(header), edgeVertices.size() * sizeof(std::uint32_t));
+    if (std::any_of(edgeVertices.begin(), edgeVertices.end(),
+                    [vertexCount](std::uint32_t index) { return index >= vertexCount; }))
+    {
+        return false;
+    }
+
+    features.edgeVertices = std::move(edgeVertices);
+    features.angleDegrees = header.angleDegrees;
+    features.creaseEdges = header.creaseEdges;
+    features.outlineEdges = header.outlineEdges;
+    features.cached = true;
+    return true;
+}
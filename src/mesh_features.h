@@ -0,0 +1,69 @@
+/**
+ * @file mesh_features.h
+ * @brief 二面角による特徴辺（稜線）の抽出
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+struct IndexedMesh;
+struct EdgeTable;
+
+/// 特徴辺とみなす既定の二面角のしきい値（度、隣接面の法線がこれより大きく折れる辺を抽出する）
+constexpr float DEFAULT_FEATURE_ANGLE_DEGREES{30.0f};
+
+/**
+ * @brief 特徴辺の抽出結果
+ */
+struct FeatureEdges {
+    std::vector<std::uint32_t> edgeVertices;  ///< 特徴辺の頂点インデックス（2つで1辺、辺テーブルの順）
+    float angleDegrees = 0.0f;                ///< 抽出に使った二面角のしきい値（度）
+    std::size_t creaseEdges = 0;              ///< 二面角がしきい値を超えた辺の数
+    std::size_t outlineEdges = 0;             ///< 境界辺・非多様体辺の数（二面角を定義できないため常に含める）
+    bool cached = false;                      ///< キャッシュから読み込んだ場合はtrue
+
+    /**
+     * @brief 特徴辺の数を取得する
+     */
+    std::size_t edgeCount() const noexcept { return edgeVertices.size() / 2; }
+};
+
+/**
+ * @brief 二面角がしきい値を超える辺を特徴辺として抽出する
+ *
+ * 2つの三角形に共有される辺について両側の面の法線のなす角を求め、しきい値を超える辺を抽出する。
+ * 共有辺を同じ向きにたどる（向きが不整合な）組は一方の法線を反転して比較する。
+ * 境界辺・非多様体辺は輪郭として常に含める。辺ごとの判定は並列に行い、
+ * 抽出した辺はストリームコンパクションで辺テーブルの順に詰める。
+ *
+ * @param mesh 溶接済みのインデックス付きメッシュ
+ * @param edges mesh から構築した辺テーブル
+ * @param angleDegrees 二面角のしきい値（度）
+ * @return 抽出結果
+ */
+FeatureEdges extractFeatureEdges(const IndexedMesh& mesh, const EdgeTable& edges, float angleDegrees);
+
+/**
+ * @brief 抽出結果をキャッシュのペイロードに変換する
+ *
+ * @param features 抽出結果
+ * @return しきい値・辺の数のヘッダーと頂点インデックスを連結したバイト列
+ * @see MeshCache::store()
+ */
+std::vector<char> serializeFeatureEdges(const FeatureEdges& features);
+
+/**
+ * @brief キャッシュのペイロードから抽出結果を復元する
+ *
+ * @param data serializeFeatureEdges() で作成したバイト列
+ * @param vertexCount 対象のメッシュの頂点数（範囲外のインデックスを含む場合は失敗とする）
+ * @param features [out] 復元した抽出結果（cached が true になる）
+ * @return ペイロードの長さと頂点インデックスが正しい場合はtrue
+ */
+bool deserializeFeatureEdges(std::span<const char> data, std::size_t vertexCount, FeatureEdges& features);
@@ -0,0 +1,147 @@
+#include "mesh_hash.h"
+#include "model_loader.h"
+#include "parallel.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+
+// 内部定数定義
+namespace
+{
+constexpr int TRIANGLE_VERTICES{3};                          // 三角形の頂点数
+constexpr std::uint64_t HASH_MULTIPLIER{0x9E3779B97F4A7C15ull}; // 黄金比由来の乗数
+constexpr std::uint64_t TRIANGLE_SEED{0x27D4EB2F165667C5ull};   // 三角形ハッシュの初期値
+constexpr std::uint64_t INDEX_SEED{0x165667B19E3779F9ull};      // インデックス列ハッシュの初期値
+constexpr std::uint64_t POINT_SEED{0x85EBCA77C2B2AE63ull};      // 点ハッシュの初期値
+
+using QuantizedVertex = std::array<std::int64_t, 3>;
+
+/**
+ * @brief 頂点座標を量子化する（-0.0 と 0.0 も同一値になる）
+ */
+inline QuantizedVertex quantize(const glm::vec3 &vertex, float inverseStep)
+{
+    return {std::llround(vertex.x * inverseStep), std::llround(vertex.y * inverseStep),
+            std::llround(vertex.z * inverseStep)};
+}
+
+/**
+ * @brief 1つの三角形のハッシュを計算する
+ *
+ * 辞書順で最小の頂点が先頭になるよう巡回シフトしてからハッシュ化するため、
+ * 開始頂点の違いには依存しないが、面の向き（巡回順）の違いは区別される。
+ */
+std::uint64_t hashTriangle(const ModelTriangle &triangle, float inverseStep)
+{
+    auto vertices = std::array<QuantizedVertex, TRIANGLE_VERTICES>{};
+    for (int i = 0; i < TRIANGLE_VERTICES; ++i)
+    {
+        vertices[i] = quantize(triangle.vertices[i], inverseStep);
+    }
+
+    auto first = static_cast<int>(std::min_element(vertices.begin(), vertices.end()) - vertices.begin());
+
+    auto hash = TRIANGLE_SEED;
+    for (int i = 0; i < TRIANGLE_VERTICES; ++i)
+    {
+        for (auto coordinate : vertices[(first + i) % TRIANGLE_VERTICES])
+        {
+            hash = (hash ^ mixHash64(static_cast<std::uint64_t>(coordinate))) * HASH_MULTIPLIER;
+        }
+    }
+    return mixHash64(hash);
+}
+} // namespace
+
+std::uint64_t computeMeshHash(const ModelMesh &mesh, float quantizationStep)
+{
+    auto inverseStep = 1.0f / quantizationStep;
+    const auto &triangles = mesh.triangles;
+
+    // 三角形ハッシュの総和（順序非依存）をチャンクごとに並列計算
+    auto sum = parallel::reduce(
+        triangles.size(), std::uint64_t{0},
+        [&triangles, inverseStep](std::size_t begin, std::size_t end) {
+            auto partial = std::uint64_t{0};
+            for (auto i = begin; i < end; ++i)
+            {
+                partial += hashTriangle(triangles[i], inverseStep);
+            }
+            return partial;
+        },
+        [](std::uint64_t lhs, std::uint64_t rhs) { return lhs + rhs; });
+
+    // 三角形数も混ぜて、同じ三角形の重複数が異なるケースを区別する
+    auto hash = mixHash64(sum ^ mixHash64(static_cast<std::uint64_t>(triangles.size()) * HASH_MULTIPLIER));
+    if (mesh.points.empty())
+    {
+        return hash; // 三角形のみのメッシュは点プリミティブ対応前と同じ値を保つ
+    }
+
+    // 点も座標のハッシュの総和（順序非依存）と点数を混ぜる
+    const auto &points = mesh.points;
+    auto pointSum = parallel::reduce(
+        points.size(), std::uint64_t{0},
+        [&points, inverseStep](std::size_t begin, std::size_t end) {
+            auto partial = std::uint64_t{0};
+            for (auto i = begin; i < end; ++i)
+            {
+                auto pointHash = std::uint64_t{POINT_SEED};
+                for (auto coordinate : quantize(points[i], inverseStep))
+                {
+                    pointHash = (pointHash ^ mixHash64(static_cast<std::uint64_t>(coordinate))) * HASH_MULTIPLIER;
+                }
+                partial += mixHash64(pointHash);
+            }
+            return partial;
+        },
+        [](std::uint64_t lhs, std::uint64_t rhs) { return lhs + rhs; });
+    return mixHash64(hash ^ pointSum ^ mixHash64(static_cast<std::uint64_t>(points.size()) * POINT_SEED));
+}
+
+std::uint64_t computeIndexedMeshHash(const IndexedMesh &mesh, float quantizationStep)
+{
+    auto inverseStep = 1.0f / quantizationStep;
+    auto add = [](std::uint64_t lhs, std::uint64_t rhs) { return lhs + rhs; };
+
+    // 頂点番号と量子化した座標を混ぜたハッシュの総和（番号を含むため並び順の違いも区別される）
+    auto vertexSum = parallel::reduce(
+        mesh.positions.size(), std::uint64_t{0},
+        [&mesh, inverseStep](std::size_t begin, std::size_t end) {
+            auto partial = std::uint64_t{0};
+            for (auto i = begin; i < end; ++i)
+            {
+                auto hash = mixHash64(static_cast<std::uint64_t>(i) * HASH_MULTIPLIER);
+                for (auto coordinate : quantize(mesh.positions[i], inverseStep))
+                {
+                    hash = (hash ^ mixHash64(static_cast<std::uint64_t>(coordinate))) * HASH_MULTIPLIER;
+                }
+                partial += mixHash64(hash);
+            }
+            return partial;
+        },
+        add);
+
+    // インデックスも位置と値を混ぜて加算する
+    auto indexSum = parallel::reduce(
+        mesh.indices.size(), std::uint64_t{0},
+        [&mesh](std::size_t begin, std::size_t end) {
+            auto partial = std::uint64_t{0};
+            for (auto i = begin; i < end; ++i)
+            {
+                partial += mixHash64((static_cast<std::uint64_t>(i) * HASH_MULTIPLIER) ^ (mesh.indices[i] + INDEX_SEED));
+            }
+            return partial;
+        },
+        add);
+
+    return mixHash64(vertexSum ^ mixHash64(indexSum ^ mixHash64(mesh.positions.size() * HASH_MULTIPLIER)));
+}
+
+std::string formatMeshHash(std::uint64_t hash)
+{
+    auto buffer = std::array<char, 17>{};
+    std::snprintf(buffer.data(), buffer.size(), "%016llx", static_cast<unsigned long long>(hash));
+    return std::string{buffer.data()};
+}
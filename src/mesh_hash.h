@@ -0,0 +1,73 @@
+/**
+ * @file mesh_hash.h
+ * @brief メッシュ形状のコンテンツハッシュ計算
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+struct ModelMesh;
+struct IndexedMesh;
+
+/**
+ * @brief 64bit値の全ビットを撹拌する（splitmix64 の最終化関数）
+ *
+ * ハッシュテーブルやソート用のキー生成に使用する。
+ *
+ * @param value 入力値
+ * @return 撹拌後の値
+ */
+inline std::uint64_t mixHash64(std::uint64_t value)
+{
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ull;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBull;
+    value ^= value >> 31;
+    return value;
+}
+
+/// 位置座標の量子化幅（これより小さい差はハッシュ上同一とみなす）
+constexpr float MESH_HASH_QUANTIZATION_STEP{1.0f / 65536.0f};
+
+/**
+ * @brief メッシュ形状の64bitコンテンツハッシュを計算する
+ *
+ * 頂点座標を量子化し、各三角形の頂点を巡回順（向き）を保ったまま正規化してから
+ * ハッシュ化する。三角形ごとのハッシュは加算で結合するため三角形の並び順に依存せず、
+ * ファイル名や形式、面の出力順が異なっても同じ形状であれば同じ値になる。
+ * 点プリミティブを含む場合は点の座標のハッシュも同様に加算で結合する。
+ * 法線は形状から再計算可能なためハッシュに含めない。
+ * 三角形単位の処理はスレッド間で並列に実行される。
+ *
+ * @param mesh ハッシュ対象のメッシュ
+ * @param quantizationStep 座標の量子化幅
+ * @return コンテンツハッシュ値
+ */
+std::uint64_t computeMeshHash(const ModelMesh& mesh, float quantizationStep = MESH_HASH_QUANTIZATION_STEP);
+
+/**
+ * @brief インデックス付きメッシュの64bitハッシュを計算する
+ *
+ * computeMeshHash() と異なり、頂点・インデックスの並び順にも依存する。
+ * 頂点番号に対応づけた派生データ（頂点ごとの解析結果など）をキャッシュする際のキーに使い、
+ * 同じ形状でも溶接結果の頂点番号が異なれば別のエントリとなる。
+ * 頂点・インデックスは番号と値を混ぜてから加算で結合し、並列に計算する。
+ *
+ * @param mesh ハッシュ対象のメッシュ
+ * @param quantizationStep 座標の量子化幅
+ * @return ハッシュ値
+ */
+std::uint64_t computeIndexedMeshHash(const IndexedMesh& mesh, float quantizationStep = MESH_HASH_QUANTIZATION_STEP);
+
+/**
+ * @brief ハッシュ値をキャッシュキー用の16桁16進文字列に変換する
+ *
+ * @param hash コンテンツハッシュ値
+ * @return 16桁の16進文字列（例: "00ff12ab34cd56ef"）
+ */
+std::string formatMeshHash(std::uint64_t hash);
@@ -0,0 +1,605 @@
+#include "mesh_interference.h"
+#include "mesh_bvh.h"
+#include "mesh_shells.h"
+#include "model_loader.h"
+#include "parallel.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <optional>
+#include <utility>
+
+// 内部定数定義
+namespace
+{
+constexpr int TRIANGLE_VERTICES{3};          // 三角形の頂点数
+constexpr std::size_t PAIRS_PER_THREAD{16};  // 並列走査の前に展開するノード対の数（スレッド数に対する倍率）
+constexpr int MAX_EXPANSION_LEVELS{32};      // ノード対を幅優先に展開する最大段数
+
+using Triangle = std::array<glm::vec3, TRIANGLE_VERTICES>;
+
+/**
+ * @brief 走査中のノード対
+ */
+struct NodePair {
+    std::uint32_t partPair;  ///< 部品の組の番号
+    std::uint32_t first;     ///< 1つ目の部品のノード番号
+    std::uint32_t second;    ///< 2つ目の部品のノード番号
+};
+
+/**
+ * @brief 部品の組の番号に紐づけた三角形の交差
+ */
+struct PairedContact {
+    std::uint32_t partPair;
+    TriangleContact contact;
+};
+
+inline bool boxesOverlap(const BvhNode &lhs, const BvhNode &rhs)
+{
+    return lhs.minBounds.x <= rhs.maxBounds.x && rhs.minBounds.x <= lhs.maxBounds.x &&
+           lhs.minBounds.y <= rhs.maxBounds.y && rhs.minBounds.y <= lhs.maxBounds.y &&
+           lhs.minBounds.z <= rhs.maxBounds.z && rhs.minBounds.z <= lhs.maxBounds.z;
+}
+
+inline float halfArea(const BvhNode &node)
+{
+    auto extent = node.maxBounds - node.minBounds;
+    return extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+}
+
+/**
+ * @brief 三角形と平面の交わりを求める
+ *
+ * @param distances 各頂点の平面からの符号付き距離
+ * @param points [out] 交わりの端点（辺が平面を横切る点と平面上の頂点）
+ * @return 端点の数（0〜3、3になるのは三角形が平面上にある場合のみ）
+ */
+int intersectPlane(const Triangle &triangle, const std::array<float, TRIANGLE_VERTICES> &distances,
+                   std::array<glm::vec3, TRIANGLE_VERTICES> &points)
+{
+    auto count = 0;
+    for (int i = 0; i < TRIANGLE_VERTICES; ++i)
+    {
+        auto j = (i + 1) % TRIANGLE_VERTICES;
+        if (distances[i] == 0.0f)
+        {
+            points[count++] = triangle[i];
+        }
+        else if ((distances[i] < 0.0f) != (distances[j] < 0.0f) && distances[j] != 0.0f)
+        {
+            auto t = distances[i] / (distances[i] - distances[j]);
+            points[count++] = triangle[i] + (triangle[j] - triangle[i]) * t;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief 平面に対する3頂点の符号付き距離を求め、すべて同じ側にあるかを判定する
+ *
+ * @return 三角形が平面の片側に完全にある場合はtrue（平面上にある場合は false）
+ */
+bool separatedByPlane(const Triangle &plane, const glm::vec3 &normal, const Triangle &triangle,
+                      std::array<float, TRIANGLE_VERTICES> &distances)
+{
+    auto offset = glm::dot(normal, plane[0]);
+    for (int i = 0; i < TRIANGLE_VERTICES; ++i)
+    {
+        distances[i] = glm::dot(normal, triangle[i]) - offset;
+    }
+    auto allPositive = distances[0] > 0.0f && distances[1] > 0.0f && distances[2] > 0.0f;
+    auto allNegative = distances[0] < 0.0f && distances[1] < 0.0f && distances[2] < 0.0f;
+    return allPositive || allNegative;
+}
+
+inline bool allZero(const std::array<float, TRIANGLE_VERTICES> &distances)
+{
+    return distances[0] == 0.0f && distances[1] == 0.0f && distances[2] == 0.0f;
+}
+
+/**
+ * @brief 2次元の3点の向き（正: 反時計回り、負: 時計回り、0: 同一直線上）
+ */
+inline float orientation2d(const glm::vec2 &a, const glm::vec2 &b, const glm::vec2 &c)
+{
+    return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+/**
+ * @brief 2次元の点が三角形に含まれるか（辺上を含む）
+ */
+bool containsPoint2d(const std::array<glm::vec2, TRIANGLE_VERTICES> &triangle, const glm::vec2 &point)
+{
+    auto d0 = orientation2d(triangle[0], triangle[1], point);
+    auto d1 = orientation2d(triangle[1], triangle[2], point);
+    auto d2 = orientation2d(triangle[2], triangle[0], point);
+    auto hasNegative = d0 < 0.0f || d1 < 0.0f || d2 < 0.0f;
+    auto hasPositive = d0 > 0.0f || d1 > 0.0f || d2 > 0.0f;
+    return !(hasNegative && hasPositive);
+}
+
+/**
+ * @brief 2次元の2つの線分の交点を求める（端点での接触を含む、重なる場合は端点の1つ）
+ *
+ * @param t [out] 交点の p0 → p1 方向のパラメータ
+ * @return 交わる場合はtrue
+ */
+bool intersectSegments2d(const glm::vec2 &p0, const glm::vec2 &p1, const glm::vec2 &q0, const glm::vec2 &q1, float &t)
+{
+    auto d0 = orientation2d(q0, q1, p0);
+    auto d1 = orientation2d(q0, q1, p1);
+    auto e0 = orientation2d(p0, p1, q0);
+    auto e1 = orientation2d(p0, p1, q1);
+    if ((d0 > 0.0f && d1 > 0.0f) || (d0 < 0.0f && d1 < 0.0f) || (e0 > 0.0f && e1 > 0.0f) || (e0 < 0.0f && e1 < 0.0f))
+    {
+        return false;
+    }
+    if (d0 != d1)
+    {
+        t = d0 / (d0 - d1);
+        return true;
+    }
+
+    // 同一直線上: 端点が相手の線分に含まれれば交わる
+    auto direction = p1 - p0;
+    auto length = glm::dot(direction, direction);
+    if (!(length > 0.0f))
+    {
+        t = 0.0f;
+        return glm::dot(q0 - p0, q1 - p0) <= 0.0f;
+    }
+    auto s0 = glm::dot(q0 - p0, direction) / length;
+    auto s1 = glm::dot(q1 - p0, direction) / length;
+    if (std::max(s0, s1) < 0.0f || std::min(s0, s1) > 1.0f)
+    {
+        return false;
+    }
+    t = std::clamp(std::min(s0, s1), 0.0f, 1.0f);
+    return true;
+}
+
+/**
+ * @brief 同一平面上の2つの三角形の重なりを求める
+ *
+ * 法線の絶対値が最大の軸を落として2次元に投影し、相手に含まれる頂点と辺同士の交点を集める。
+ * これらの点は凸な重なり領域に含まれるため、最初の点と最も遠い点を結ぶ線分を交線とする。
+ *
+ * @param normal 平面の法線（零ベクトルでないこと）
+ * @param start [out] 重なり領域を横切る線分の始点
+ * @param end [out] 重なり領域を横切る線分の終点
+ * @return 重なる場合（辺や頂点で接する場合を含む）はtrue
+ */
+bool intersectCoplanarTriangles(const Triangle &first, const Triangle &second, const glm::vec3 &normal,
+                                glm::vec3 &start, glm::vec3 &end)
+{
+    auto magnitude = glm::abs(normal);
+    auto drop = magnitude.x >= magnitude.y && magnitude.x >= magnitude.z ? 0 : (magnitude.y >= magnitude.z ? 1 : 2);
+    auto u = (drop + 1) % 3;
+    auto v = (drop + 2) % 3;
+    auto project = [u, v](const Triangle &triangle) {
+        return std::array<glm::vec2, TRIANGLE_VERTICES>{glm::vec2{triangle[0][u], triangle[0][v]},
+                                                        glm::vec2{triangle[1][u], triangle[1][v]},
+                                                        glm::vec2{triangle[2][u], triangle[2][v]}};
+    };
+    auto first2d = project(first);
+    auto second2d = project(second);
+
+    auto points = std::array<glm::vec3, TRIANGLE_VERTICES * TRIANGLE_VERTICES + 2 * TRIANGLE_VERTICES>{};
+    auto count = 0;
+    for (int i = 0; i < TRIANGLE_VERTICES; ++i)
+    {
+        if (containsPoint2d(second2d, first2d[i]))
+        {
+            points[count++] = first[i];
+        }
+        if (containsPoint2d(first2d, second2d[i]))
+        {
+            points[count++] = second[i];
+        }
+    }
+    for (int i = 0; i < TRIANGLE_VERTICES; ++i)
+    {
+        auto i1 = (i + 1) % TRIANGLE_VERTICES;
+        for (int j = 0; j < TRIANGLE_VERTICES; ++j)
+        {
+            auto j1 = (j + 1) % TRIANGLE_VERTICES;
+            auto t = 0.0f;
+            if (intersectSegments2d(first2d[i], first2d[i1], second2d[j], second2d[j1], t))
+            {
+                points[count++] = first[i] + (first[i1] - first[i]) * t;
+            }
+        }
+    }
+    if (count == 0)
+    {
+        return false;
+    }
+
+    start = points[0];
+    end = points[0];
+    auto farthest = 0.0f;
+    for (int i = 1; i < count; ++i)
+    {
+        auto offset = points[i] - start;
+        auto squared = glm::dot(offset, offset);
+        if (squared > farthest)
+        {
+            farthest = squared;
+            end = points[i];
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 2つの三角形の交線を求める（Möller の区間重なり判定）
+ *
+ * 各三角形が相手の平面と交わる線分は、どちらも2平面の交線上にある。
+ * 両方の線分が交線方向で重なる区間が三角形同士の交わりとなる。
+ *
+ * @param start [out] 交線の始点
+ * @param end [out] 交線の終点
+ * @return 交差する場合はtrue
+ */
+bool intersectTriangles(const Triangle &first, const Triangle &second, glm::vec3 &start, glm::vec3 &end)
+{
+    // 相手の平面の片側に収まる組を先に棄却する（大部分の組はここで終わる）
+    auto secondNormal = glm::cross(second[1] - second[0], second[2] - second[0]);
+    auto firstDistances = std::array<float, TRIANGLE_VERTICES>{};
+    if (separatedByPlane(second, secondNormal, first, firstDistances))
+    {
+        return false;
+    }
+    if (allZero(firstDistances))
+    {
+        // 同一平面上（面積0の三角形の平面は定まらないため交差しないものとする）
+        return secondNormal != glm::vec3{0.0f} && intersectCoplanarTriangles(first, second, secondNormal, start, end);
+    }
+
+    auto firstNormal = glm::cross(first[1] - first[0], first[2] - first[0]);
+    auto secondDistances = std::array<float, TRIANGLE_VERTICES>{};
+    if (separatedByPlane(first, firstNormal, second, secondDistances) || allZero(secondDistances))
+    {
+        return false; // 全て0になるのは first が面積0の場合のみ
+    }
+
+    auto direction = glm::cross(firstNormal, secondNormal);
+    auto firstPoints = std::array<glm::vec3, TRIANGLE_VERTICES>{};
+    auto secondPoints = std::array<glm::vec3, TRIANGLE_VERTICES>{};
+    auto firstCount = intersectPlane(first, firstDistances, firstPoints);
+    auto secondCount = intersectPlane(second, secondDistances, secondPoints);
+    if (firstCount == 0 || secondCount == 0)
+    {
+        return false;
+    }
+
+    // 交線方向の座標で各線分を [low, high] に揃え、重なる区間を求める
+    auto project = [&direction](const std::array<glm::vec3, TRIANGLE_VERTICES> &points, int count) {
+        auto low = 0;
+        auto high = 0;
+        for (int i = 1; i < count; ++i)
+        {
+            auto t = glm::dot(direction, points[i]);
+            low = t < glm::dot(direction, points[low]) ? i : low;
+            high = t > glm::dot(direction, points[high]) ? i : high;
+        }
+        return std::pair{low, high};
+    };
+    auto [firstLow, firstHigh] = project(firstPoints, firstCount);
+    auto [secondLow, secondHigh] = project(secondPoints, secondCount);
+
+    auto firstLowT = glm::dot(direction, firstPoints[firstLow]);
+    auto firstHighT = glm::dot(direction, firstPoints[firstHigh]);
+    auto secondLowT = glm::dot(direction, secondPoints[secondLow]);
+    auto secondHighT = glm::dot(direction, secondPoints[secondHigh]);
+    if (firstHighT < secondLowT || secondHighT < firstLowT)
+    {
+        return false;
+    }
+
+    start = firstLowT >= secondLowT ? firstPoints[firstLow] : secondPoints[secondLow];
+    end = firstHighT <= secondHighT ? firstPoints[firstHigh] : secondPoints[secondHigh];
+    return true;
+}
+
+/**
+ * @brief ノード対の子のうち、バウンディングボックスが重なる組を出力する
+ *
+ * 葉でない側のうち大きい方のノードを分割する（両方葉の場合は何もしない）。
+ *
+ * @return 子の組に展開した場合はtrue
+ */
+template <typename Output>
+bool expandPair(const MeshBvh &first, const MeshBvh &second, const NodePair &pair, Output &&output)
+{
+    const auto &firstNode = first.nodes[pair.first];
+    const auto &secondNode = second.nodes[pair.second];
+    if (firstNode.isLeaf() && secondNode.isLeaf())
+    {
+        return false;
+    }
+
+    auto splitFirst = !firstNode.isLeaf() && (secondNode.isLeaf() || halfArea(firstNode) >= halfArea(secondNode));
+    for (std::uint32_t c = 0; c < 2; ++c)
+    {
+        auto child = NodePair{pair.partPair, splitFirst ? firstNode.firstOrChild + c : pair.first,
+                              splitFirst ? pair.second : secondNode.firstOrChild + c};
+        if (boxesOverlap(first.nodes[child.first], second.nodes[child.second]))
+        {
+            output(child);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 両方が葉のノード対について、三角形の全組の交差を調べる
+ */
+void intersectLeaves(const MeshBvh &first, const MeshBvh &second, const NodePair &pair,
+                     std::vector<PairedContact> &contacts)
+{
+    const auto &firstNode = first.nodes[pair.first];
+    const auto &secondNode = second.nodes[pair.second];
+    for (auto i = firstNode.firstOrChild; i < firstNode.firstOrChild + firstNode.triangleCount; ++i)
+    {
+        for (auto j = secondNode.firstOrChild; j < secondNode.firstOrChild + secondNode.triangleCount; ++j)
+        {
+            auto contact = TriangleContact{first.triangleIds[i], second.triangleIds[j], glm::vec3{0.0f}, glm::vec3{0.0f}};
+            if (intersectTriangles(first.triangles[i], second.triangles[j], contact.segmentStart, contact.segmentEnd))
+            {
+                contacts.push_back(PairedContact{pair.partPair, contact});
+            }
+        }
+    }
+}
+
+/**
+ * @brief 両方が葉のノード対について、最初に見つかった三角形の交差を求める
+ *
+ * @param contact [out] 交差する三角形の組
+ * @return 交差が見つかった場合はtrue
+ */
+bool firstLeafContact(const MeshBvh &first, const MeshBvh &second, const NodePair &pair, TriangleContact &contact)
+{
+    const auto &firstNode = first.nodes[pair.first];
+    const auto &secondNode = second.nodes[pair.second];
+    for (auto i = firstNode.firstOrChild; i < firstNode.firstOrChild + firstNode.triangleCount; ++i)
+    {
+        for (auto j = secondNode.firstOrChild; j < secondNode.firstOrChild + secondNode.triangleCount; ++j)
+        {
+            contact = TriangleContact{first.triangleIds[i], second.triangleIds[j], glm::vec3{0.0f}, glm::vec3{0.0f}};
+            if (intersectTriangles(first.triangles[i], second.triangles[j], contact.segmentStart, contact.segmentEnd))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 部品の組の根から幅優先に展開し、並列に分配できるだけのノード対を用意する
+ *
+ * @param pairCount 部品の組の数
+ * @param bvhPair ノード対から部品の組の BVH を取得する関数
+ * @return 走査を始めるノード対（展開の順序は決定的）
+ */
+template <typename BvhPair>
+std::vector<NodePair> expandFrontier(std::size_t pairCount, BvhPair &&bvhPair)
+{
+    auto frontier = std::vector<NodePair>{};
+    for (std::uint32_t p = 0; p < pairCount; ++p)
+    {
+        auto pair = NodePair{p, 0, 0};
+        auto [first, second] = bvhPair(pair);
+        if (boxesOverlap(first.nodes[0], second.nodes[0]))
+        {
+            frontier.push_back(pair);
+        }
+    }
+
+    auto targetPairs = parallel::threadCount() * PAIRS_PER_THREAD;
+    for (int level = 0; level < MAX_EXPANSION_LEVELS && frontier.size() < targetPairs; ++level)
+    {
+        auto next = std::vector<NodePair>{};
+        next.reserve(frontier.size() * 2);
+        auto expanded = false;
+        for (const auto &pair : frontier)
+        {
+            auto [first, second] = bvhPair(pair);
+            if (expandPair(first, second, pair, [&next](const NodePair &child) { next.push_back(child); }))
+            {
+                expanded = true;
+            }
+            else
+            {
+                next.push_back(pair);
+            }
+        }
+        frontier = std::move(next);
+        if (!expanded)
+        {
+            break;
+        }
+    }
+    return frontier;
+}
+
+/**
+ * @brief 部品の組ごとに BVH 同士を走査し、交差する三角形の組を求める
+ *
+ * @param partPairs 調べる部品の組
+ * @return 組ごとの交差（三角形番号の昇順）
+ */
+std::vector<std::vector<TriangleContact>> intersectPartPairs(
+    const std::vector<const MeshBvh *> &parts, const std::vector<std::pair<std::uint32_t, std::uint32_t>> &partPairs)
+{
+    auto bvhPair = [&parts, &partPairs](const NodePair &pair) -> std::pair<const MeshBvh &, const MeshBvh &> {
+        return {*parts[partPairs[pair.partPair].first], *parts[partPairs[pair.partPair].second]};
+    };
+    auto frontier = expandFrontier(partPairs.size(), bvhPair);
+
+    // ノード対ごとに並列に深さ優先で走査する（結果はチャンクごとに集める）
+    auto chunkContacts = std::vector<std::vector<PairedContact>>(parallel::chunkCount(frontier.size(), 1));
+    parallel::forEachChunk(
+        frontier.size(),
+        [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+            auto &contacts = chunkContacts[chunk];
+            auto stack = std::vector<NodePair>{};
+            for (auto i = begin; i < end; ++i)
+            {
+                auto [first, second] = bvhPair(frontier[i]);
+                stack.push_back(frontier[i]);
+                while (!stack.empty())
+                {
+                    auto pair = stack.back();
+                    stack.pop_back();
+                    if (!expandPair(first, second, pair, [&stack](const NodePair &child) { stack.push_back(child); }))
+                    {
+                        intersectLeaves(first, second, pair, contacts);
+                    }
+                }
+            }
+        },
+        1);
+
+    auto result = std::vector<std::vector<TriangleContact>>(partPairs.size());
+    for (const auto &contacts : chunkContacts)
+    {
+        for (const auto &paired : contacts)
+        {
+            result[paired.partPair].push_back(paired.contact);
+        }
+    }
+
+    // 走査順はスレッド数で変わるため、三角形番号順に並べて結果を一意にする
+    parallel::forEach(
+        result.size(),
+        [&result](std::size_t p) {
+            std::sort(result[p].begin(), result[p].end(), [](const TriangleContact &lhs, const TriangleContact &rhs) {
+                return std::pair{lhs.firstTriangle, lhs.secondTriangle} <
+                       std::pair{rhs.firstTriangle, rhs.secondTriangle};
+            });
+        },
+        1);
+    return result;
+}
+} // namespace
+
+std::vector<TriangleContact> findTriangleContacts(const MeshBvh &first, const MeshBvh &second)
+{
+    if (first.empty() || second.empty())
+    {
+        return {};
+    }
+
+    auto pairContacts = intersectPartPairs({&first, &second}, {{0, 1}});
+    return std::move(pairContacts.front());
+}
+
+std::optional<TriangleContact> findFirstTriangleContact(const MeshBvh &first, const MeshBvh &second)
+{
+    if (first.empty() || second.empty())
+    {
+        return std::nullopt;
+    }
+
+    auto bvhPair = [&first, &second](const NodePair &) -> std::pair<const MeshBvh &, const MeshBvh &> {
+        return {first, second};
+    };
+    auto frontier = expandFrontier(1, bvhPair);
+
+    // 交差が見つかったノード対の最小の番号より後ろのノード対は走査しない
+    // （それより前のノード対は必ず最後まで走査するため、結果は最小の番号のノード対の最初の交差になる）
+    auto found = std::atomic<std::size_t>{frontier.size()};
+    auto hits = std::vector<TriangleContact>(frontier.size());
+    parallel::forEachChunk(
+        frontier.size(),
+        [&](std::size_t begin, std::size_t end, std::size_t) {
+            auto stack = std::vector<NodePair>{};
+            for (auto i = begin; i < end && i < found.load(std::memory_order_relaxed); ++i)
+            {
+                stack.assign(1, frontier[i]);
+                while (!stack.empty() && i < found.load(std::memory_order_relaxed))
+                {
+                    auto pair = stack.back();
+                    stack.pop_back();
+                    if (expandPair(first, second, pair, [&stack](const NodePair &child) { stack.push_back(child); }) ||
+                        !firstLeafContact(first, second, pair, hits[i]))
+                    {
+                        continue;
+                    }
+
+                    auto current = found.load(std::memory_order_relaxed);
+                    while (i < current && !found.compare_exchange_weak(current, i, std::memory_order_relaxed))
+                    {
+                    }
+                    break;
+                }
+            }
+        },
+        1);
+
+    auto index = found.load();
+    return index < frontier.size() ? std::optional{hits[index]} : std::nullopt;
+}
+
+InterferenceReport checkInterference(const std::vector<MeshBvh> &parts)
+{
+    auto report = InterferenceReport{};
+    report.partCount = parts.size();
+
+    // 粗い判定: 根のバウンディングボックスをX方向の最小座標順に掃引し、重なる組を求める
+    auto order = std::vector<std::uint32_t>{};
+    for (std::uint32_t i = 0; i < parts.size(); ++i)
+    {
+        if (!parts[i].empty())
+        {
+            order.push_back(i);
+        }
+    }
+    std::sort(order.begin(), order.end(), [&parts](std::uint32_t lhs, std::uint32_t rhs) {
+        return parts[lhs].nodes[0].minBounds.x < parts[rhs].nodes[0].minBounds.x;
+    });
+
+    auto partPairs = std::vector<std::pair<std::uint32_t, std::uint32_t>>{};
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        const auto &root = parts[order[i]].nodes[0];
+        for (auto j = i + 1; j < order.size() && parts[order[j]].nodes[0].minBounds.x <= root.maxBounds.x; ++j)
+        {
+            if (boxesOverlap(root, parts[order[j]].nodes[0]))
+            {
+                partPairs.emplace_back(std::min(order[i], order[j]), std::max(order[i], order[j]));
+            }
+        }
+    }
+    std::sort(partPairs.begin(), partPairs.end());
+    report.candidatePairs = partPairs.size();
+
+    // 詳細判定: 全組のノード対をまとめて並列に走査する
+    auto partPointers = std::vector<const MeshBvh *>(parts.size());
+    std::transform(parts.begin(), parts.end(), partPointers.begin(), [](const MeshBvh &part) { return &part; });
+    auto pairContacts = intersectPartPairs(partPointers, partPairs);
+    for (std::size_t p = 0; p < partPairs.size(); ++p)
+    {
+        if (!pairContacts[p].empty())
+        {
+            report.contacts.push_back(PartContact{partPairs[p].first, partPairs[p].second, std::move(pairContacts[p])});
+        }
+    }
+    return report;
+}
+
+InterferenceReport checkShellInterference(const IndexedMesh &mesh, const ShellDecomposition &decomposition)
+{
+    // 小さいシェルの構築は並列化されないため、シェルごとに順に構築する（大きいシェルは内部で並列化される）
+    auto parts = std::vector<MeshBvh>{};
+    parts.reserve(decomposition.shells.size());
+    for (const auto &shell : decomposition.shells)
+    {
+        parts.push_back(buildMeshBvh(mesh, shell.firstTriangle, shell.triangleCount));
+    }
+    return checkInterference(parts);
+}
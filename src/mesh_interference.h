@@ -0,0 +1,108 @@
+/**
+ * @file mesh_interference.h
+ * @brief BVH 同士の走査による部品間の干渉（交差する三角形の組）の検出
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include <glm/glm.hpp>
+
+struct IndexedMesh;
+struct MeshBvh;
+struct ShellDecomposition;
+
+/**
+ * @brief 交差する三角形の組と交線
+ */
+struct TriangleContact {
+    std::uint32_t firstTriangle;   ///< 1つ目の部品の三角形番号（BVH の triangleIds の値）
+    std::uint32_t secondTriangle;  ///< 2つ目の部品の三角形番号
+    glm::vec3 segmentStart;        ///< 交線の始点
+    glm::vec3 segmentEnd;          ///< 交線の終点（点で接する場合は始点と同じ）
+};
+
+/**
+ * @brief 干渉している部品の組
+ */
+struct PartContact {
+    std::uint32_t firstPart;                ///< 1つ目の部品番号
+    std::uint32_t secondPart;               ///< 2つ目の部品番号（firstPart より大きい）
+    std::vector<TriangleContact> contacts;  ///< 交差する三角形の組（三角形番号の昇順）
+};
+
+/**
+ * @brief 干渉チェックの結果
+ */
+struct InterferenceReport {
+    std::size_t partCount = 0;          ///< 部品数
+    std::size_t candidatePairs = 0;     ///< バウンディングボックスが重なり、詳細に調べた部品の組の数
+    std::vector<PartContact> contacts;  ///< 干渉している部品の組（部品番号の昇順）
+
+    /**
+     * @brief 交差する三角形の組の総数を取得する
+     */
+    std::size_t triangleContactCount() const noexcept
+    {
+        auto count = std::size_t{0};
+        for (const auto& contact : contacts)
+        {
+            count += contact.contacts.size();
+        }
+        return count;
+    }
+};
+
+/**
+ * @brief 2つの BVH の間で交差する三角形の組を求める
+ *
+ * @param first 1つ目の部品の BVH
+ * @param second 2つ目の部品の BVH
+ * @return 交差する三角形の組（三角形番号の昇順）
+ * @see checkInterference()
+ */
+std::vector<TriangleContact> findTriangleContacts(const MeshBvh& first, const MeshBvh& second);
+
+/**
+ * @brief 2つの BVH の間で交差する三角形の組を1つ求める（見つかった時点で走査を打ち切る）
+ *
+ * findTriangleContacts() と同じくノード対に分けて並列に走査するが、交差が見つかったノード対より
+ * 後ろのノード対は走査しない。交差の有無だけが必要な場合（面間の最小距離など）に使う。
+ * 返す組は走査の順で最初のノード対の最初の交差で、スレッドの実行順によらない。
+ *
+ * @param first 1つ目の部品の BVH
+ * @param second 2つ目の部品の BVH
+ * @return 交差する三角形の組（交差しない場合は std::nullopt）
+ */
+std::optional<TriangleContact> findFirstTriangleContact(const MeshBvh& first, const MeshBvh& second);
+
+/**
+ * @brief 部品のすべての組について干渉をチェックする
+ *
+ * 1. 粗い判定: 根のバウンディングボックスをX方向に並べて掃引し、重なる部品の組を求める
+ * 2. 詳細判定: 全組のノード対を幅優先に展開してスレッド数より十分多いノード対に分け、
+ *    ノード対ごとに並列に BVH 同士を深さ優先で走査する。
+ *    葉の組では三角形同士の交差を、互いの平面による符号判定で棄却してから交線まで求める。
+ *
+ * @param parts 部品ごとの BVH
+ * @return 干渉チェックの結果
+ * @note 同一平面上で重なる三角形（面同士の接触）も交差として数え、重なり領域を横切る線分を交線とする
+ */
+InterferenceReport checkInterference(const std::vector<MeshBvh>& parts);
+
+/**
+ * @brief メッシュのシェル同士の干渉をチェックする
+ *
+ * ビルドプレート上の複数部品を1つのファイルにまとめた場合など、
+ * 各シェルを1つの部品とみなしてシェルごとの BVH を構築し、checkInterference() で調べる。
+ *
+ * @param mesh decomposeShells() でシェル順に並べ替えたメッシュ
+ * @param decomposition シェル分解の結果
+ * @return 干渉チェックの結果（部品番号はシェル番号、三角形番号はメッシュ全体での番号）
+ */
+InterferenceReport checkShellInterference(const IndexedMesh& mesh, const ShellDecomposition& decomposition);
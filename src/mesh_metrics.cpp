@@ -0,0 +1,198 @@
+#include "mesh_metrics.h"
+#include "model_loader.h"
+#include "parallel.h"
+#include <array>
+#include <cmath>
+#include <utility>
+
+// 内部定数定義
+namespace
+{
+constexpr int TRIANGLE_VERTICES{3};      // 三角形の頂点数
+constexpr double VOLUME_FACTOR{1.0 / 6.0};          // 四面体の体積 = 行列式 / 6
+constexpr double FIRST_MOMENT_FACTOR{1.0 / 24.0};   // 1次モーメント = 行列式 / 24 * (a + b + c)
+constexpr double SECOND_MOMENT_FACTOR{1.0 / 120.0}; // 2次モーメント = 行列式 / 120 * (...)
+
+/**
+ * @brief 補償加算（Neumaier法）による総和
+ */
+struct CompensatedSum {
+    double sum;
+    double compensation;
+
+    void add(double value)
+    {
+        auto total = sum + value;
+        if (std::abs(sum) >= std::abs(value))
+        {
+            compensation += (sum - total) + value;
+        }
+        else
+        {
+            compensation += (value - total) + sum;
+        }
+        sum = total;
+    }
+
+    void add(const CompensatedSum &other)
+    {
+        add(other.sum);
+        add(other.compensation);
+    }
+
+    double value() const { return sum + compensation; }
+};
+
+/**
+ * @brief 積分値の添字
+ */
+enum Moment
+{
+    AREA,
+    VOLUME,
+    FIRST_X,
+    FIRST_Y,
+    FIRST_Z,
+    SECOND_XX,
+    SECOND_YY,
+    SECOND_ZZ,
+    SECOND_XY,
+    SECOND_YZ,
+    SECOND_ZX,
+    MOMENT_COUNT
+};
+
+using MomentSums = std::array<CompensatedSum, MOMENT_COUNT>;
+
+/**
+ * @brief 1つの三角形の寄与を加算する（表面積と原点を頂点とする四面体の積分）
+ */
+void accumulateTriangle(MomentSums &sums, const glm::dvec3 &a, const glm::dvec3 &b, const glm::dvec3 &c)
+{
+    auto determinant = glm::dot(a, glm::cross(b, c));
+    auto s = a + b + c;
+
+    sums[AREA].add(0.5 * glm::length(glm::cross(b - a, c - a)));
+    sums[VOLUME].add(determinant * VOLUME_FACTOR);
+
+    auto first = determinant * FIRST_MOMENT_FACTOR;
+    sums[FIRST_X].add(first * s.x);
+    sums[FIRST_Y].add(first * s.y);
+    sums[FIRST_Z].add(first * s.z);
+
+    // ∫ x_i x_j dV = det / 120 * (Σ_k v_k,i v_k,j + s_i s_j)
+    auto second = determinant * SECOND_MOMENT_FACTOR;
+    auto product = [&](int i, int j) { return a[i] * a[j] + b[i] * b[j] + c[i] * c[j] + s[i] * s[j]; };
+    sums[SECOND_XX].add(second * product(0, 0));
+    sums[SECOND_YY].add(second * product(1, 1));
+    sums[SECOND_ZZ].add(second * product(2, 2));
+    sums[SECOND_XY].add(second * product(0, 1));
+    sums[SECOND_YZ].add(second * product(1, 2));
+    sums[SECOND_ZX].add(second * product(2, 0));
+}
+
+/**
+ * @brief 全三角形の積分値を並列に求め、幾何特性に変換する
+ *
+ * @tparam TriangleVertices std::array<glm::vec3, 3>(std::size_t triangle) 形式の関数
+ * @param triangleCount 三角形数
+ * @param origin 積分の基準点
+ * @param triangleVertices 三角形の3頂点を返す関数
+ */
+template <typename TriangleVertices>
+MeshMetrics computeMetrics(std::size_t triangleCount, const glm::dvec3 &origin, TriangleVertices &&triangleVertices)
+{
+    auto sums = parallel::reduce(
+        triangleCount, MomentSums{},
+        [&](std::size_t begin, std::size_t end) {
+            auto partial = MomentSums{};
+            for (auto t = begin; t < end; ++t)
+            {
+                auto vertices = triangleVertices(t);
+                accumulateTriangle(partial, glm::dvec3{vertices[0]} - origin, glm::dvec3{vertices[1]} - origin,
+                                   glm::dvec3{vertices[2]} - origin);
+            }
+            return partial;
+        },
+        [](MomentSums lhs, const MomentSums &rhs) {
+            for (int i = 0; i < MOMENT_COUNT; ++i)
+            {
+                lhs[i].add(rhs[i]);
+            }
+            return lhs;
+        });
+
+    auto metrics = MeshMetrics{};
+    metrics.surfaceArea = sums[AREA].value();
+    metrics.volume = sums[VOLUME].value();
+    metrics.centroid = origin;
+    metrics.inertia = glm::dmat3{0.0};
+    if (metrics.volume == 0.0)
+    {
+        return metrics;
+    }
+
+    // 基準点から見た重心
+    auto offset = glm::dvec3{sums[FIRST_X].value(), sums[FIRST_Y].value(), sums[FIRST_Z].value()} / metrics.volume;
+    metrics.centroid = origin + offset;
+
+    // 2次モーメントを重心まわりに平行移動: C_c = C - V * m m^T
+    auto covariance = [&](Moment moment, int i, int j) {
+        return sums[moment].value() - metrics.volume * offset[i] * offset[j];
+    };
+    auto xx = covariance(SECOND_XX, 0, 0);
+    auto yy = covariance(SECOND_YY, 1, 1);
+    auto zz = covariance(SECOND_ZZ, 2, 2);
+    auto xy = covariance(SECOND_XY, 0, 1);
+    auto yz = covariance(SECOND_YZ, 1, 2);
+    auto zx = covariance(SECOND_ZX, 2, 0);
+
+    // 慣性テンソル I = tr(C) E - C
+    metrics.inertia[0] = glm::dvec3{yy + zz, -xy, -zx};
+    metrics.inertia[1] = glm::dvec3{-xy, xx + zz, -yz};
+    metrics.inertia[2] = glm::dvec3{-zx, -yz, xx + yy};
+    return metrics;
+}
+} // namespace
+
+MeshMetrics computeMeshMetrics(const ModelMesh &mesh)
+{
+    auto origin = (glm::dvec3{mesh.min_bounds} + glm::dvec3{mesh.max_bounds}) * 0.5;
+    return computeMetrics(mesh.triangles.size(), origin, [&mesh](std::size_t t) {
+        const auto &triangle = mesh.triangles[t];
+        return std::array<glm::vec3, TRIANGLE_VERTICES>{triangle.vertices[0], triangle.vertices[1],
+                                                        triangle.vertices[2]};
+    });
+}
+
+MeshMetrics computeMeshMetrics(const IndexedMesh &mesh)
+{
+    // インデックス付きメッシュはバウンディングボックスを持たないため、頂点の範囲を並列に求める
+    using Bounds = std::pair<glm::vec3, glm::vec3>;
+    const auto &positions = mesh.positions;
+    auto origin = glm::dvec3{0.0};
+    if (!positions.empty())
+    {
+        auto bounds = parallel::reduce(
+            positions.size(), Bounds{positions.front(), positions.front()},
+            [&positions](std::size_t begin, std::size_t end) {
+                auto partial = Bounds{positions[begin], positions[begin]};
+                for (auto i = begin; i < end; ++i)
+                {
+                    partial.first = glm::min(partial.first, positions[i]);
+                    partial.second = glm::max(partial.second, positions[i]);
+                }
+                return partial;
+            },
+            [](Bounds lhs, const Bounds &rhs) {
+                return Bounds{glm::min(lhs.first, rhs.first), glm::max(lhs.second, rhs.second)};
+            });
+        origin = (glm::dvec3{bounds.first} + glm::dvec3{bounds.second}) * 0.5;
+    }
+
+    return computeMetrics(mesh.triangleCount(), origin, [&mesh](std::size_t t) {
+        return std::array<glm::vec3, TRIANGLE_VERTICES>{mesh.positions[mesh.indices[t * TRIANGLE_VERTICES]],
+                                                        mesh.positions[mesh.indices[t * TRIANGLE_VERTICES + 1]],
+                                                        mesh.positions[mesh.indices[t * TRIANGLE_VERTICES + 2]]};
+    });
+}
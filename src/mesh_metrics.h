@@ -0,0 +1,48 @@
+/**
+ * @file mesh_metrics.h
+ * @brief 表面積・体積・重心・慣性テンソルの計算
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+struct ModelMesh;
+struct IndexedMesh;
+
+/**
+ * @brief メッシュの幾何特性
+ *
+ * 体積・重心・慣性テンソルは面が閉じていて外向きに揃っている場合にのみ意味を持つ
+ * （向きの修正は orientMesh() で行う）。
+ */
+struct MeshMetrics {
+    double surfaceArea;   ///< 表面積（モデル座標単位の2乗）
+    double volume;        ///< 囲まれた体積（外向きの閉じた面で正、モデル座標単位の3乗）
+    glm::dvec3 centroid;  ///< 体積重心（体積が0の場合はバウンディングボックスの中心）
+    glm::dmat3 inertia;   ///< 重心まわりの慣性テンソル（密度1）
+};
+
+/**
+ * @brief 三角形メッシュの幾何特性を計算する
+ *
+ * 各三角形と原点がなす符号付き四面体の積分を足し合わせ、表面積・体積・1次/2次モーメントを
+ * 1回の並列パスでまとめて求める。総和はチャンクごとに補償加算（Neumaier法）で行い、
+ * チャンク順に結合するため、三角形数が多くても丸め誤差が蓄積せず結果は決定的になる。
+ * 桁落ちを避けるため、積分はバウンディングボックスの中心を基準に行う。
+ *
+ * @param mesh 対象のメッシュ
+ * @return 幾何特性
+ */
+MeshMetrics computeMeshMetrics(const ModelMesh& mesh);
+
+/**
+ * @brief インデックス付きメッシュの幾何特性を計算する
+ *
+ * @param mesh 対象のメッシュ（orientMesh() で向きを修正済みであること）
+ * @return 幾何特性
+ * @see computeMeshMetrics(const ModelMesh&)
+ */
+MeshMetrics computeMeshMetrics(const IndexedMesh& mesh);
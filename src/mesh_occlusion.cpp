@@ -0,0 +1,177 @@
+#include "mesh_occlusion.h"
+#include "mesh_bvh.h"
+#include "mesh_hash.h"
+#include "mesh_orientation.h"
+#include "model_loader.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+#include <utility>
+
+// 内部定数定義
+namespace
+{
+constexpr float OCCLUSION_RADIUS_RATIO{0.1f};  // 遮蔽とみなす距離（バウンディングボックスの対角線長に対する割合）
+constexpr float RAY_OFFSET_RATIO{1e-4f};       // 光線の始点を法線方向へずらす量（遮蔽距離に対する割合）
+constexpr std::size_t VERTEX_MIN_CHUNK{64};    // 1スレッドあたりの最小頂点数
+constexpr float ACCESSIBILITY_SCALE{255.0f};   // 正規化整数の最大値
+constexpr float GOLDEN_ANGLE{2.39996323f};     // 黄金角（フィボナッチ螺旋の方位角の増分）
+constexpr int ROTATION_HASH_SHIFT{40};         // 回転角に使うハッシュの上位24ビットを取り出すシフト量
+constexpr float ROTATION_HASH_SCALE{2.0f * std::numbers::pi_v<float> / 16777216.0f}; // 24ビット値 → [0, 2π)
+
+/**
+ * @brief キャッシュのペイロードのヘッダー
+ */
+struct OcclusionHeader {
+    std::int32_t rayCount;
+    float radius;
+    float meanAccessibility;
+    std::uint32_t reserved;
+    std::uint64_t vertexCount;
+};
+
+/**
+ * @brief 法線を Z 軸とする正規直交基底を求める（Duff et al. の分岐なしの方法）
+ */
+inline void orthonormalBasis(const glm::vec3 &normal, glm::vec3 &tangent, glm::vec3 &bitangent)
+{
+    auto sign = std::copysign(1.0f, normal.z);
+    auto a = -1.0f / (sign + normal.z);
+    auto b = normal.x * normal.y * a;
+    tangent = glm::vec3{1.0f + sign * normal.x * normal.x * a, sign * b, -sign * normal.x};
+    bitangent = glm::vec3{b, sign + normal.y * normal.y * a, -normal.y};
+}
+} // namespace
+
+float automaticOcclusionRadius(const IndexedMesh &mesh)
+{
+    const auto &positions = mesh.positions;
+    if (positions.empty())
+    {
+        return 0.0f;
+    }
+    auto bounds = parallel::reduce(
+        positions.size(), std::pair{positions.front(), positions.front()},
+        [&](std::size_t begin, std::size_t end) {
+            auto partial = std::pair{positions[begin], positions[begin]};
+            for (auto i = begin; i < end; ++i)
+            {
+                partial.first = glm::min(partial.first, positions[i]);
+                partial.second = glm::max(partial.second, positions[i]);
+            }
+            return partial;
+        },
+        [](std::pair<glm::vec3, glm::vec3> lhs, const std::pair<glm::vec3, glm::vec3> &rhs) {
+            return std::pair{glm::min(lhs.first, rhs.first), glm::max(lhs.second, rhs.second)};
+        });
+    return glm::length(bounds.second - bounds.first) * OCCLUSION_RADIUS_RATIO;
+}
+
+AmbientOcclusion bakeAmbientOcclusion(const IndexedMesh &mesh, const MeshBvh &bvh, int rayCount, float radius)
+{
+    auto result = AmbientOcclusion{};
+    result.rayCount = rayCount;
+    result.radius = radius;
+    result.vertexAccessibility.assign(mesh.positions.size(), static_cast<std::uint8_t>(ACCESSIBILITY_SCALE));
+    if (mesh.positions.empty() || bvh.empty() || rayCount <= 0 || !(radius > 0.0f))
+    {
+        result.meanAccessibility = 1.0f;
+        return result;
+    }
+
+    // 余弦重み付きの半球上の方向（法線を Z 軸とする局所座標、頂点ごとに Z 軸周りに回転させて使う）
+    auto directions = std::vector<glm::vec3>(static_cast<std::size_t>(rayCount));
+    for (int i = 0; i < rayCount; ++i)
+    {
+        auto u = (static_cast<float>(i) + 0.5f) / static_cast<float>(rayCount);
+        auto r = std::sqrt(u);
+        auto phi = GOLDEN_ANGLE * static_cast<float>(i);
+        directions[static_cast<std::size_t>(i)] = glm::vec3{r * std::cos(phi), r * std::sin(phi), std::sqrt(1.0f - u)};
+    }
+
+    auto normals = computeVertexNormals(mesh);
+    auto offset = radius * RAY_OFFSET_RATIO;
+    parallel::forEach(
+        mesh.positions.size(),
+        [&](std::size_t v) {
+            auto length = glm::length(normals[v]);
+            if (!(length > 0.0f))
+            {
+                return; // 面積0の三角形のみに接する頂点は遮蔽なしとする
+            }
+            auto normal = normals[v] / length;
+            auto tangent = glm::vec3{};
+            auto bitangent = glm::vec3{};
+            orthonormalBasis(normal, tangent, bitangent);
+
+            // 頂点番号から決まる角度だけ螺旋を回転させる
+            auto rotation = static_cast<float>(mixHash64(v) >> ROTATION_HASH_SHIFT) * ROTATION_HASH_SCALE;
+            auto cosine = std::cos(rotation);
+            auto sine = std::sin(rotation);
+
+            // 始点を法線方向へわずかにずらし、頂点に接する面との交差を避ける
+            auto origin = mesh.positions[v] + normal * offset;
+            auto unoccluded = 0;
+            for (const auto &local : directions)
+            {
+                auto x = local.x * cosine - local.y * sine;
+                auto y = local.x * sine + local.y * cosine;
+                auto direction = tangent * x + bitangent * y + normal * local.z;
+                unoccluded += intersectRay(bvh, origin, direction, radius).hit() ? 0 : 1;
+            }
+            auto accessibility = static_cast<float>(unoccluded) / static_cast<float>(rayCount);
+            result.vertexAccessibility[v] = static_cast<std::uint8_t>(std::lround(accessibility * ACCESSIBILITY_SCALE));
+        },
+        VERTEX_MIN_CHUNK);
+
+    auto sum = parallel::reduce(
+        result.vertexAccessibility.size(), std::uint64_t{0},
+        [&result](std::size_t begin, std::size_t end) {
+            auto partial = std::uint64_t{0};
+            for (auto i = begin; i < end; ++i)
+            {
+                partial += result.vertexAccessibility[i];
+            }
+            return partial;
+        },
+        [](std::uint64_t lhs, std::uint64_t rhs) { return lhs + rhs; });
+    result.meanAccessibility = static_cast<float>(static_cast<double>(sum) /
+                                                  (static_cast<double>(mesh.positions.size()) * ACCESSIBILITY_SCALE));
+    return result;
+}
+
+std::vector<char> serializeAmbientOcclusion(const AmbientOcclusion &occlusion)
+{
+    auto header = OcclusionHeader{occlusion.rayCount, occlusion.radius, occlusion.meanAccessibility, 0,
+                                  occlusion.vertexAccessibility.size()};
+    auto data = std::vector<char>(sizeof(header) + occlusion.vertexAccessibility.size());
+    std::memcpy(data.data(), &header, sizeof(header));
+    std::memcpy(data.data() + sizeof(header), occlusion.vertexAccessibility.data(),
+                occlusion.vertexAccessibility.size());
+    return data;
+}
+
+bool deserializeAmbientOcclusion(std::span<const char> data, std::size_t vertexCount, int rayCount, float radius,
+                                 AmbientOcclusion &occlusion)
+{
+    auto header = OcclusionHeader{};
+    if (data.size() != sizeof(header) + vertexCount)
+    {
+        return false;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.vertexCount != vertexCount || header.rayCount != rayCount || header.radius != radius)
+    {
+        return false;
+    }
+
+    occlusion.rayCount = header.rayCount;
+    occlusion.radius = header.radius;
+    occlusion.meanAccessibility = header.meanAccessibility;
+    occlusion.vertexAccessibility.resize(vertexCount);
+    std::memcpy(occlusion.vertexAccessibility.data(), data.data() + sizeof(header), vertexCount);
+    occlusion.cached = true;
+    return true;
+}
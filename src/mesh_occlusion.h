@@ -0,0 +1,82 @@
+/**
+ * @file mesh_occlusion.h
+ * @brief BVH の光線追跡による頂点ごとの環境遮蔽（アンビエントオクルージョン）の焼き込み
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+struct IndexedMesh;
+struct MeshBvh;
+
+/// 環境遮蔽の焼き込みで頂点ごとに飛ばす既定の光線数
+constexpr int DEFAULT_OCCLUSION_RAYS{64};
+
+/**
+ * @brief 環境遮蔽の焼き込み結果
+ */
+struct AmbientOcclusion {
+    std::vector<std::uint8_t> vertexAccessibility;  ///< 頂点ごとの遮られなかった光の割合（0〜255の正規化整数）
+    int rayCount = 0;                               ///< 頂点ごとに飛ばした光線数
+    float radius = 0.0f;                            ///< 遮蔽とみなす交点までの最大距離
+    float meanAccessibility = 0.0f;                 ///< 遮られなかった光の割合の平均（0〜1）
+    bool cached = false;                            ///< キャッシュから読み込んだ場合はtrue
+};
+
+/**
+ * @brief メッシュの大きさから遮蔽とみなす距離を決める
+ *
+ * 頂点のバウンディングボックスの対角線長の一定割合とする。遠くの面まで遮蔽とみなすと
+ * 開口部の奥行きに関係なく全体が暗くなるため、近くの凹部だけが暗くなる距離に抑える。
+ * BVH を使わないため、BVH を構築する前にキャッシュの照合に使える。
+ *
+ * @param mesh 対象のメッシュ
+ * @return 遮蔽とみなす距離（頂点が無い場合は0）
+ */
+float automaticOcclusionRadius(const IndexedMesh& mesh);
+
+/**
+ * @brief 頂点ごとの環境遮蔽を光線追跡で焼き込む
+ *
+ * 各頂点の角度重み付き法線の半球へ余弦重み付きの光線を飛ばし、radius 以内で面に当たらなかった
+ * 光線の割合を遮られなかった光の割合とする。方向はフィボナッチ螺旋で半球に均等に配置し、
+ * 頂点ごとに螺旋を回転させて隣接頂点間で同じ方向の縞が出ないようにする（乱数は使わず結果は決定的）。
+ * 頂点ごとの光線は BVH を共有して並列に追跡する。
+ *
+ * @param mesh 対象のメッシュ（orientMesh() で外向きに揃えてあること）
+ * @param bvh mesh から buildMeshBvh() で構築した BVH
+ * @param rayCount 頂点ごとの光線数
+ * @param radius 遮蔽とみなす交点までの最大距離
+ * @return 焼き込み結果
+ */
+AmbientOcclusion bakeAmbientOcclusion(const IndexedMesh& mesh, const MeshBvh& bvh, int rayCount, float radius);
+
+/**
+ * @brief 焼き込み結果をキャッシュのペイロードに変換する
+ *
+ * @param occlusion 焼き込み結果
+ * @return 光線数・距離・頂点数のヘッダーと頂点ごとの値を連結したバイト列
+ * @see MeshCache::store()
+ */
+std::vector<char> serializeAmbientOcclusion(const AmbientOcclusion& occlusion);
+
+/**
+ * @brief キャッシュのペイロードから焼き込み結果を復元する
+ *
+ * 光線数と遮蔽距離がこれから焼き込む条件と異なる結果は、同じメッシュでも使わない。
+ *
+ * @param data serializeAmbientOcclusion() で作成したバイト列
+ * @param vertexCount 対象のメッシュの頂点数
+ * @param rayCount 焼き込みに使う光線数
+ * @param radius 焼き込みに使う遮蔽距離
+ * @param occlusion [out] 復元した焼き込み結果（cached が true になる）
+ * @return ペイロードの長さ・頂点数・光線数・遮蔽距離が全て一致した場合はtrue
+ */
+bool deserializeAmbientOcclusion(std::span<const char> data, std::size_t vertexCount, int rayCount, float radius,
+                                 AmbientOcclusion& occlusion);
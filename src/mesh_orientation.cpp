@@ -0,0 +1,420 @@
+#include "mesh_orientation.h"
+#include "mesh_shells.h"
+#include "mesh_topology.h"
+#include "mesh_weld.h"
+#include "model_loader.h"
+#include "parallel.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <utility>
+
+// 内部定数定義
+namespace
+{
+constexpr int TRIANGLE_VERTICES{3}; // 三角形の頂点数
+constexpr std::uint32_t NO_NEIGHBOR{std::numeric_limits<std::uint32_t>::max()};
+constexpr double INSIDE_WINDING{0.5};   // 閉じたシェルの内側とみなす一般化巻き数の絶対値の閾値
+
+/**
+ * @brief 三角形の辺を介した隣接関係
+ *
+ * 三角形 t の角 c から始まる辺の向こう側の三角形を neighbors[t * 3 + c] に持つ。
+ * 辺が2つの三角形に共有されていない場合は NO_NEIGHBOR。
+ */
+struct TriangleAdjacency {
+    std::vector<std::uint32_t> neighbors;
+    std::vector<std::uint8_t> sameDirection; ///< 隣接三角形が共有辺を同じ向きにたどるか
+};
+
+/**
+ * @brief 向き修正の集計（並列リダクション用）
+ */
+struct OrientationCounts {
+    std::size_t patches;
+    std::size_t inverted;
+};
+
+/**
+ * @brief 修正後の辺の状態の集計（並列リダクション用）
+ */
+struct EdgeStateCounts {
+    std::size_t open;
+    std::size_t conflicting;
+};
+
+/**
+ * @brief 2つの三角形に共有される辺から隣接関係を構築する
+ */
+TriangleAdjacency buildAdjacency(const IndexedMesh &mesh, const EdgeTable &edges)
+{
+    auto adjacency = TriangleAdjacency{};
+    adjacency.neighbors.assign(mesh.indices.size(), NO_NEIGHBOR);
+    adjacency.sameDirection.assign(mesh.indices.size(), 0);
+
+    // 各ハーフエッジは1つの辺にのみ属するため、書き込み先は辺間で重ならない
+    parallel::forEach(edges.edgeCount(), [&](std::size_t e) {
+        if (edges.edgeValence(e) != 2)
+        {
+            return;
+        }
+
+        const auto &first = edges.halfEdges[edges.edgeOffsets[e]];
+        const auto &second = edges.halfEdges[edges.edgeOffsets[e] + 1];
+        auto same = halfEdgeOrigin(mesh.indices, first) == halfEdgeOrigin(mesh.indices, second);
+        auto firstSlot = static_cast<std::size_t>(first.triangle) * TRIANGLE_VERTICES + first.corner;
+        auto secondSlot = static_cast<std::size_t>(second.triangle) * TRIANGLE_VERTICES + second.corner;
+        adjacency.neighbors[firstSlot] = second.triangle;
+        adjacency.neighbors[secondSlot] = first.triangle;
+        adjacency.sameDirection[firstSlot] = adjacency.sameDirection[secondSlot] = same;
+    });
+
+    return adjacency;
+}
+
+/**
+ * @brief 三角形の符号付き体積（の6倍）を計算する
+ *
+ * 原点を基準とした四面体の体積で、閉じた面の総和は原点の位置に依存しない。
+ */
+double signedVolume(const IndexedMesh &mesh, std::size_t triangle, const glm::dvec3 &origin)
+{
+    auto a = glm::dvec3{mesh.positions[mesh.indices[triangle * TRIANGLE_VERTICES]]} - origin;
+    auto b = glm::dvec3{mesh.positions[mesh.indices[triangle * TRIANGLE_VERTICES + 1]]} - origin;
+    auto c = glm::dvec3{mesh.positions[mesh.indices[triangle * TRIANGLE_VERTICES + 2]]} - origin;
+    return glm::dot(a, glm::cross(b, c));
+}
+
+/**
+ * @brief 1つのシェル内の巻き順を伝播させ、パッチごとに外向きにする
+ *
+ * @param flipped [in,out] 三角形ごとの反転フラグ（シェルの範囲のみ書き込む）
+ * @param visited [in,out] 三角形ごとの探索済みフラグ（シェルの範囲のみ書き込む）
+ * @param queue 探索キュー（呼び出し間で再利用する作業領域）
+ */
+OrientationCounts orientShell(const IndexedMesh &mesh, const TriangleAdjacency &adjacency, const MeshShell &shell,
+                              std::vector<std::uint8_t> &flipped, std::vector<std::uint8_t> &visited,
+                              std::vector<std::uint32_t> &queue)
+{
+    auto counts = OrientationCounts{};
+    auto origin = (glm::dvec3{shell.minBounds} + glm::dvec3{shell.maxBounds}) * 0.5;
+
+    for (auto seed = shell.firstTriangle; seed < shell.firstTriangle + shell.triangleCount; ++seed)
+    {
+        if (visited[seed])
+        {
+            continue;
+        }
+
+        // 幅優先探索で巻き順を伝播（キューには探索したパッチの全三角形が残る）
+        queue.clear();
+        queue.push_back(seed);
+        visited[seed] = 1;
+        for (std::size_t head = 0; head < queue.size(); ++head)
+        {
+            auto triangle = queue[head];
+            for (int corner = 0; corner < TRIANGLE_VERTICES; ++corner)
+            {
+                auto slot = static_cast<std::size_t>(triangle) * TRIANGLE_VERTICES + corner;
+                auto neighbor = adjacency.neighbors[slot];
+                if (neighbor == NO_NEIGHBOR || visited[neighbor])
+                {
+                    continue;
+                }
+
+                // 共有辺を同じ向きにたどる隣接三角形は、自身と逆の反転状態にする
+                flipped[neighbor] = flipped[triangle] ^ adjacency.sameDirection[slot];
+                visited[neighbor] = 1;
+                queue.push_back(neighbor);
+            }
+        }
+
+        // パッチの符号付き体積が負なら内向きなので全体を反転
+        auto volume = 0.0;
+        for (auto triangle : queue)
+        {
+            auto sign = flipped[triangle] ? -1.0 : 1.0;
+            volume += sign * signedVolume(mesh, triangle, origin);
+        }
+        if (volume < 0.0)
+        {
+            for (auto triangle : queue)
+            {
+                flipped[triangle] ^= 1;
+            }
+            ++counts.inverted;
+        }
+
+        ++counts.patches;
+    }
+
+    return counts;
+}
+
+/**
+ * @brief シェルが点の周りを回る回数（一般化巻き数）を計算する
+ *
+ * 各三角形が点に張る立体角の総和を 4π で割った値で、閉じたシェルの内側では ±1、外側では 0 となる
+ * （Van Oosterom & Strackee の立体角の式、Jacobson et al. の一般化巻き数）。
+ */
+double windingNumber(const IndexedMesh &mesh, const MeshShell &shell, const std::vector<std::uint8_t> &flipped,
+                     const glm::dvec3 &point)
+{
+    auto total = 0.0;
+    for (auto triangle = shell.firstTriangle; triangle < shell.firstTriangle + shell.triangleCount; ++triangle)
+    {
+        auto a = glm::dvec3{mesh.positions[mesh.indices[triangle * TRIANGLE_VERTICES]]} - point;
+        auto b = glm::dvec3{mesh.positions[mesh.indices[triangle * TRIANGLE_VERTICES + 1]]} - point;
+        auto c = glm::dvec3{mesh.positions[mesh.indices[triangle * TRIANGLE_VERTICES + 2]]} - point;
+        if (flipped[triangle])
+        {
+            std::swap(b, c);
+        }
+
+        auto la = glm::length(a);
+        auto lb = glm::length(b);
+        auto lc = glm::length(c);
+        auto numerator = glm::dot(a, glm::cross(b, c));
+        auto denominator = la * lb * lc + glm::dot(a, b) * lc + glm::dot(b, c) * la + glm::dot(c, a) * lb;
+        total += 2.0 * std::atan2(numerator, denominator);
+    }
+    return total / (4.0 * std::numbers::pi);
+}
+
+/**
+ * @brief 点がバウンディングボックスに含まれるか
+ */
+bool boundsContain(const MeshShell &shell, const glm::dvec3 &point)
+{
+    return point.x >= shell.minBounds.x && point.x <= shell.maxBounds.x && point.y >= shell.minBounds.y &&
+           point.y <= shell.maxBounds.y && point.z >= shell.minBounds.z && point.z <= shell.maxBounds.z;
+}
+
+/**
+ * @brief シェルごとに、他のシェルの内側にある空洞（入れ子の深さが奇数）かどうかを判定する
+ *
+ * シェルの先頭三角形の重心を代表点とし、それを囲む他のシェルの数を入れ子の深さとする。
+ * 代表点をバウンディングボックスに含むシェルのみを一般化巻き数で判定し、
+ * 候補はX方向の区間インデックスで絞り込む。
+ *
+ * @param flipped 三角形ごとの反転フラグ（シェル内のパッチは外向きに揃えてあること）
+ * @return シェルごとの空洞フラグ
+ */
+std::vector<std::uint8_t> findCavityShells(const IndexedMesh &mesh, const ShellDecomposition &shells,
+                                           const std::vector<std::uint8_t> &flipped)
+{
+    const auto &list = shells.shells;
+    auto cavities = std::vector<std::uint8_t>(list.size(), 0);
+    if (list.size() < 2)
+    {
+        return cavities;
+    }
+
+    auto minX = static_cast<double>(list.front().minBounds.x);
+    auto maxX = static_cast<double>(list.front().maxBounds.x);
+    for (const auto &shell : list)
+    {
+        minX = std::min(minX, static_cast<double>(shell.minBounds.x));
+        maxX = std::max(maxX, static_cast<double>(shell.maxBounds.x));
+    }
+    auto bucketCount = list.size();
+    auto scale = maxX > minX ? static_cast<double>(bucketCount) / (maxX - minX) : 0.0;
+    auto bucketOf = [&](double x) {
+        auto bucket = static_cast<std::int64_t>((x - minX) * scale);
+        return std::clamp<std::int64_t>(bucket, 0, static_cast<std::int64_t>(bucketCount) - 1);
+    };
+    auto buckets = parallel::bucketRanges(
+        list.size(), bucketCount,
+        [&](std::size_t s) {
+            return std::pair<std::int64_t, std::int64_t>{bucketOf(list[s].minBounds.x), bucketOf(list[s].maxBounds.x)};
+        },
+        1);
+
+    parallel::forEach(
+        list.size(),
+        [&](std::size_t s) {
+            auto first = list[s].firstTriangle * TRIANGLE_VERTICES;
+            auto point = (glm::dvec3{mesh.positions[mesh.indices[first]]} +
+                          glm::dvec3{mesh.positions[mesh.indices[first + 1]]} +
+                          glm::dvec3{mesh.positions[mesh.indices[first + 2]]}) /
+                         3.0;
+            auto bucket = static_cast<std::size_t>(bucketOf(point.x));
+            auto depth = 0;
+            for (auto i = buckets.offsets[bucket]; i < buckets.offsets[bucket + 1]; ++i)
+            {
+                auto other = buckets.items[i];
+                if (other != s && boundsContain(list[other], point) &&
+                    std::abs(windingNumber(mesh, list[other], flipped, point)) > INSIDE_WINDING)
+                {
+                    ++depth;
+                }
+            }
+            cavities[s] = depth % 2;
+        },
+        1);
+    return cavities;
+}
+} // namespace
+
+OrientationReport orientMesh(IndexedMesh &mesh, EdgeTable &edges, const ShellDecomposition &shells)
+{
+    auto report = OrientationReport{};
+    auto triangleCount = mesh.triangleCount();
+    auto adjacency = buildAdjacency(mesh, edges);
+
+    // 1. シェルごとに並列に巻き順を伝播・外向き化
+    auto flipped = std::vector<std::uint8_t>(triangleCount, 0);
+    auto visited = std::vector<std::uint8_t>(triangleCount, 0);
+    auto counts = parallel::reduce(
+        shells.shells.size(), OrientationCounts{},
+        [&](std::size_t begin, std::size_t end) {
+            auto partial = OrientationCounts{};
+            auto queue = std::vector<std::uint32_t>{};
+            for (auto s = begin; s < end; ++s)
+            {
+                auto shellCounts = orientShell(mesh, adjacency, shells.shells[s], flipped, visited, queue);
+                partial.patches += shellCounts.patches;
+                partial.inverted += shellCounts.inverted;
+            }
+            return partial;
+        },
+        [](OrientationCounts lhs, const OrientationCounts &rhs) {
+            lhs.patches += rhs.patches;
+            lhs.inverted += rhs.inverted;
+            return lhs;
+        },
+        1);
+
+    report.patches = counts.patches;
+    report.invertedPatches = counts.inverted;
+
+    // 2. 他のシェルの内側にある空洞のシェルは内向きにする（入れ子の深さの偶奇で外向き・内向きが交互になる）
+    auto cavities = findCavityShells(mesh, shells, flipped);
+    parallel::forEach(
+        shells.shells.size(),
+        [&](std::size_t s) {
+            if (!cavities[s])
+            {
+                return;
+            }
+            const auto &shell = shells.shells[s];
+            for (auto triangle = shell.firstTriangle; triangle < shell.firstTriangle + shell.triangleCount; ++triangle)
+            {
+                flipped[triangle] ^= 1;
+            }
+        },
+        1);
+    report.cavityShells = static_cast<std::size_t>(std::count(cavities.begin(), cavities.end(), std::uint8_t{1}));
+    report.flippedTriangles = parallel::reduce(
+        triangleCount, std::size_t{0},
+        [&flipped](std::size_t begin, std::size_t end) {
+            return static_cast<std::size_t>(std::count(flipped.begin() + begin, flipped.begin() + end, std::uint8_t{1}));
+        },
+        [](std::size_t lhs, std::size_t rhs) { return lhs + rhs; });
+
+    // 3. 反転する三角形の2番目と3番目の頂点を入れ替える
+    //    （角 c から始まる辺は反転後に角 2 - c から始まるため、辺テーブルの角番号も更新する）
+    if (report.flippedTriangles > 0)
+    {
+        parallel::forEach(triangleCount, [&](std::size_t t) {
+            if (flipped[t])
+            {
+                std::swap(mesh.indices[t * TRIANGLE_VERTICES + 1], mesh.indices[t * TRIANGLE_VERTICES + 2]);
+            }
+        });
+        parallel::forEach(edges.halfEdges.size(), [&](std::size_t h) {
+            auto &halfEdge = edges.halfEdges[h];
+            if (flipped[halfEdge.triangle])
+            {
+                halfEdge.corner = TRIANGLE_VERTICES - 1 - halfEdge.corner;
+            }
+        });
+    }
+
+    // 4. 修正後の向きの整合性と閉じているかを検査（並列）
+    auto edgeCounts = parallel::reduce(
+        edges.edgeCount(), EdgeStateCounts{},
+        [&](std::size_t begin, std::size_t end) {
+            auto partial = EdgeStateCounts{};
+            for (auto e = begin; e < end; ++e)
+            {
+                if (edges.edgeValence(e) != 2)
+                {
+                    ++partial.open;
+                    continue;
+                }
+
+                const auto &first = edges.halfEdges[edges.edgeOffsets[e]];
+                const auto &second = edges.halfEdges[edges.edgeOffsets[e] + 1];
+                if (halfEdgeOrigin(mesh.indices, first) == halfEdgeOrigin(mesh.indices, second))
+                {
+                    ++partial.conflicting;
+                }
+            }
+            return partial;
+        },
+        [](EdgeStateCounts lhs, const EdgeStateCounts &rhs) {
+            lhs.open += rhs.open;
+            lhs.conflicting += rhs.conflicting;
+            return lhs;
+        });
+
+    report.openEdges = edgeCounts.open;
+    report.conflictingEdges = edgeCounts.conflicting;
+    return report;
+}
+
+OrientationReport weldAndOrientMesh(const ModelMesh &mesh, float weldEpsilon, IndexedMesh &indexed,
+                                    ShellDecomposition &shells, EdgeTable &edges)
+{
+    auto epsilon = weldEpsilon < 0.0f ? automaticWeldEpsilon(mesh) : weldEpsilon;
+    weldVertices(mesh, epsilon, indexed);
+    shells = decomposeShells(indexed);
+    edges = buildEdgeTable(indexed);
+    return orientMesh(indexed, edges, shells);
+}
+
+std::vector<glm::vec3> computeVertexNormals(const IndexedMesh &mesh)
+{
+    // 角ごとに重み付き法線を求める（三角形単位で並列）
+    auto cornerNormals = std::vector<glm::vec3>(mesh.indices.size(), glm::vec3{0.0f});
+    parallel::forEach(mesh.triangleCount(), [&](std::size_t t) {
+        auto corners = std::array<std::uint32_t, TRIANGLE_VERTICES>{mesh.indices[t * TRIANGLE_VERTICES],
+                                                                    mesh.indices[t * TRIANGLE_VERTICES + 1],
+                                                                    mesh.indices[t * TRIANGLE_VERTICES + 2]};
+        const auto &a = mesh.positions[corners[0]];
+        const auto &b = mesh.positions[corners[1]];
+        const auto &c = mesh.positions[corners[2]];
+        auto normal = glm::cross(b - a, c - a);
+        auto length = glm::length(normal);
+        if (!(length > 0.0f))
+        {
+            return;
+        }
+        normal /= length;
+
+        for (int corner = 0; corner < TRIANGLE_VERTICES; ++corner)
+        {
+            const auto &p = mesh.positions[corners[corner]];
+            auto u = mesh.positions[corners[(corner + 1) % TRIANGLE_VERTICES]] - p;
+            auto v = mesh.positions[corners[(corner + 2) % TRIANGLE_VERTICES]] - p;
+            auto cosine = glm::dot(u, v) / std::max(glm::length(u) * glm::length(v), std::numeric_limits<float>::min());
+            cornerNormals[t * TRIANGLE_VERTICES + corner] = normal * std::acos(std::clamp(cosine, -1.0f, 1.0f));
+        }
+    });
+
+    // 頂点ごとに角の順で加算する（頂点単位で並列、加算順が固定のため結果は決定的）
+    auto vertexCorners = buildVertexCorners(mesh);
+    auto normals = std::vector<glm::vec3>(mesh.positions.size(), glm::vec3{0.0f});
+    parallel::forEach(mesh.positions.size(), [&](std::size_t v) {
+        auto sum = glm::vec3{0.0f};
+        for (auto i = vertexCorners.cornerOffsets[v]; i < vertexCorners.cornerOffsets[v + 1]; ++i)
+        {
+            sum += cornerNormals[vertexCorners.corners[i]];
+        }
+        normals[v] = sum;
+    });
+    return normals;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file mesh_orientation.h
+ * @brief 面の向き（巻き順）の統一と外向き化
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+
+struct ModelMesh;
+struct IndexedMesh;
+struct EdgeTable;
+struct ShellDecomposition;
+
+/**
+ * @brief 向き修正の結果統計
+ */
+struct OrientationReport {
+    std::size_t flippedTriangles;   ///< 巻き順を反転した三角形の数
+    std::size_t patches;            ///< 多様体辺でつながった面の塊（パッチ）の数
+    std::size_t invertedPatches;    ///< 符号付き体積が負のため全体を反転したパッチの数
+    std::size_t cavityShells;       ///< 他のシェルの内側にあるため内向きにしたシェル（空洞）の数
+    std::size_t conflictingEdges;   ///< 修正後も向きが揃わない辺の数（メビウスの帯など向き付け不可能な面）
+    std::size_t openEdges;          ///< 2つの三角形に共有されていない辺（境界辺・非多様体辺）の数
+
+    /**
+     * @brief 背面カリングを安全に有効にできるか
+     *
+     * 閉じた多様体で全ての面の向きが揃って外向きであれば、
+     * 裏面はカメラから見えないため描画を省略できる。
+     */
+    bool canCullBackFaces() const noexcept { return conflictingEdges == 0 && openEdges == 0; }
+};
+
+/**
+ * @brief 面の巻き順を統一し、外向きになるよう修正する
+ *
+ * 1. 2つの三角形に共有される辺を介して隣接する三角形をたどり（幅優先探索）、
+ *    共有辺を逆向きにたどるよう巻き順を伝播させる。
+ * 2. つながった面の塊（パッチ）ごとに符号付き体積を計算し、負であれば
+ *    パッチ全体を反転して外向きにする。
+ * 3. シェルを囲む他のシェルの数（入れ子の深さ）を一般化巻き数で求め、奇数であれば
+ *    空洞としてシェル全体を内向きにする。中空の部品でも符号付き体積の総和が実体積と一致する。
+ *
+ * シェル同士は辺を共有しないため、シェル単位で並列に処理する。
+ * 反転した三角形は2番目と3番目の頂点を入れ替え、辺テーブルの角番号も合わせて更新する。
+ *
+ * @param mesh 溶接済みのインデックス付きメッシュ（indices が修正される）
+ * @param edges mesh から構築した辺テーブル（角番号が修正後の mesh に合わせて更新される）
+ * @param shells mesh のシェル分解の結果
+ * @return 修正結果の統計
+ * @pre mesh は decomposeShells() によりシェル順に並べ替え済みである
+ */
+OrientationReport orientMesh(IndexedMesh& mesh, EdgeTable& edges, const ShellDecomposition& shells);
+
+/**
+ * @brief 三角形メッシュを溶接し、シェル分解と面の向きの修正までを行う
+ *
+ * 読み込んだモデル、偏差解析の参照メッシュ、ヘッドレス処理で共通の前処理。
+ * weldVertices() → decomposeShells() → buildEdgeTable() → orientMesh() の順に実行する。
+ *
+ * @param mesh 入力メッシュ（バウンディングボックス計算済み）
+ * @param weldEpsilon 溶接許容誤差（負の場合は automaticWeldEpsilon() の値を使う）
+ * @param indexed [out] 溶接・向き修正済みのメッシュ（三角形はシェル順に並ぶ）
+ * @param shells [out] シェル分解の結果
+ * @param edges [out] 向き修正後のメッシュの辺テーブル
+ * @return 向き修正の結果統計
+ */
+OrientationReport weldAndOrientMesh(const ModelMesh& mesh, float weldEpsilon, IndexedMesh& indexed,
+                                    ShellDecomposition& shells, EdgeTable& edges);
+
+/**
+ * @brief 頂点ごとの角度重み付き法線（擬似法線）を求める
+ *
+ * 各三角形の単位法線を、その頂点における内角で重み付けして加算する。
+ * 内角で重み付けすると三角形の分割の仕方に依存しない法線となり、
+ * 最近点が頂点にある点の内外判定に使える（Bærentzen & Aanæs）。
+ * 角ごとの重み付き法線を三角形単位で並列に求めてから、buildVertexCorners() の角の順に頂点ごとに加算する。
+ * 加算の順序が固定されるため、スレッド数や実行ごとに結果が変わらない。
+ *
+ * @param mesh 対象のメッシュ（orientMesh() で外向きに揃えてあること）
+ * @return 頂点ごとの法線（正規化していない。面積0の三角形のみに接する頂点は零ベクトル）
+ */
+std::vector<glm::vec3> computeVertexNormals(const IndexedMesh& mesh);
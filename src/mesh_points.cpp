@@ -0,0 +1,150 @@
+#include "mesh_points.h"
+#include "mesh_hash.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+
+// 内部定数定義
+namespace
+{
+constexpr int MORTON_LEVELS{10};                                 // 1軸あたりの細分ビット数（8分木の深さ）
+constexpr int MORTON_AXES{3};                                    // モートン符号でインターリーブする軸の数
+constexpr float MORTON_MAX_CELL{(1 << MORTON_LEVELS) - 1};       // 1軸あたりの最大セル番号
+constexpr std::uint8_t UNRANKED_LEVEL{MORTON_LEVELS + 1};        // どの階層の代表点にもならなかった点の階層
+constexpr float POINT_OVERDRAW{4.0f};    // 表側に見える点は約半分 × 隙間を埋めるための重なり2倍
+constexpr std::size_t MIN_VISIBLE_POINTS{1024}; // 遠くから見た場合も形が分かるよう最低限描画する点数
+
+/**
+ * @brief 点のバウンディングボックス（並列リダクション用）
+ */
+struct PointBounds {
+    glm::vec3 minimum;
+    glm::vec3 maximum;
+};
+
+/**
+ * @brief 並べ替え用の点のキー
+ */
+struct PointKey {
+    std::uint64_t hash;   // 点番号のハッシュ（セルの代表点の選択と同じ階層内の並び順に使う）
+    std::uint32_t morton; // モートン符号（ソート後は同じセルの点が連続する）
+    std::uint32_t index;  // 元の点番号
+};
+
+/**
+ * @brief 10ビットの値のビット間に2ビットずつ0を挿入する
+ */
+inline std::uint32_t spreadBits(std::uint32_t value)
+{
+    value &= 0x3FF;
+    value = (value | (value << 16)) & 0x030000FF;
+    value = (value | (value << 8)) & 0x0300F00F;
+    value = (value | (value << 4)) & 0x030C30C3;
+    value = (value | (value << 2)) & 0x09249249;
+    return value;
+}
+} // namespace
+
+std::vector<glm::vec3> orderPointsForSubsampling(std::span<const glm::vec3> points)
+{
+    auto count = points.size();
+    if (count == 0)
+    {
+        return {};
+    }
+
+    auto bounds = parallel::reduce(
+        count, PointBounds{points[0], points[0]},
+        [&points](std::size_t begin, std::size_t end) {
+            auto partial = PointBounds{points[begin], points[begin]};
+            for (auto i = begin; i < end; ++i)
+            {
+                partial.minimum = glm::min(partial.minimum, points[i]);
+                partial.maximum = glm::max(partial.maximum, points[i]);
+            }
+            return partial;
+        },
+        [](PointBounds lhs, const PointBounds &rhs) {
+            lhs.minimum = glm::min(lhs.minimum, rhs.minimum);
+            lhs.maximum = glm::max(lhs.maximum, rhs.maximum);
+            return lhs;
+        });
+
+    // 最長辺に合わせた立方体を各軸 2^10 のセルに分け、モートン符号順に並べる
+    auto size = bounds.maximum - bounds.minimum;
+    auto extent = std::max({size.x, size.y, size.z});
+    auto scale = extent > 0.0f ? MORTON_MAX_CELL / extent : 0.0f;
+    auto keys = std::vector<PointKey>(count);
+    parallel::forEach(count, [&](std::size_t i) {
+        auto cell = glm::clamp((points[i] - bounds.minimum) * scale, glm::vec3{0.0f}, glm::vec3{MORTON_MAX_CELL});
+        auto morton = spreadBits(static_cast<std::uint32_t>(cell.x)) |
+                      (spreadBits(static_cast<std::uint32_t>(cell.y)) << 1) |
+                      (spreadBits(static_cast<std::uint32_t>(cell.z)) << 2);
+        keys[i] = PointKey{mixHash64(i), morton, static_cast<std::uint32_t>(i)};
+    });
+    parallel::sort(keys.begin(), keys.end(), [](const PointKey &lhs, const PointKey &rhs) {
+        return lhs.morton != rhs.morton ? lhs.morton < rhs.morton : lhs.index < rhs.index;
+    });
+
+    // 粗い階層から順に、各セルでハッシュ最小の点を代表点とし、その点が最初に代表点となった階層を記録する
+    // （ハッシュ最小の点は子セルでも最小なので、親セルの代表点は必ずいずれかの子セルの代表点になる）
+    auto levels = std::vector<std::uint8_t>(count, UNRANKED_LEVEL);
+    for (int level = 0; level <= MORTON_LEVELS; ++level)
+    {
+        auto shift = MORTON_AXES * (MORTON_LEVELS - level);
+        auto cellOf = [&keys, shift](std::size_t i) { return keys[i].morton >> shift; };
+        parallel::forEachChunk(count, [&](std::size_t begin, std::size_t end, std::size_t) {
+            // チャンク内で始まるセルのみを担当する（セルがチャンク末尾をまたぐ場合は最後まで読む）
+            auto i = begin;
+            while (i < end && i > 0 && cellOf(i) == cellOf(i - 1))
+            {
+                ++i;
+            }
+            while (i < end)
+            {
+                auto cell = cellOf(i);
+                auto best = i;
+                auto j = i + 1;
+                for (; j < count && cellOf(j) == cell; ++j)
+                {
+                    if (keys[j].hash < keys[best].hash)
+                    {
+                        best = j;
+                    }
+                }
+                auto &bestLevel = levels[keys[best].index];
+                bestLevel = std::min(bestLevel, static_cast<std::uint8_t>(level));
+                i = j;
+            }
+        });
+    }
+
+    // 階層の浅い順、同じ階層内はハッシュ順（空間的に偏りのない順）に並べる
+    parallel::sort(keys.begin(), keys.end(), [&levels](const PointKey &lhs, const PointKey &rhs) {
+        auto lhsLevel = levels[lhs.index];
+        auto rhsLevel = levels[rhs.index];
+        return lhsLevel != rhsLevel ? lhsLevel < rhsLevel : lhs.hash < rhs.hash;
+    });
+
+    auto ordered = std::vector<glm::vec3>(count);
+    parallel::forEach(count, [&](std::size_t i) { ordered[i] = points[keys[i].index]; });
+    return ordered;
+}
+
+std::size_t visiblePointCount(std::size_t pointCount, float projectedRadius, float pointSize)
+{
+    if (!(pointSize > 0.0f) || !(projectedRadius > 0.0f))
+    {
+        return pointCount;
+    }
+
+    auto area = std::numbers::pi * static_cast<double>(projectedRadius) * projectedRadius;
+    auto needed = area * POINT_OVERDRAW / (static_cast<double>(pointSize) * pointSize);
+    if (needed >= static_cast<double>(pointCount))
+    {
+        return pointCount;
+    }
+    return std::min(pointCount, std::max(MIN_VISIBLE_POINTS, static_cast<std::size_t>(std::ceil(needed))));
+}
@@ -0,0 +1,46 @@
+/**
+ * @file mesh_points.h
+ * @brief 点群描画のための空間的に均等な間引き順の生成と描画点数の見積もり
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+#include <glm/glm.hpp>
+
+/// 点スプライトの既定の大きさ（ピクセル）
+constexpr float DEFAULT_POINT_SIZE{3.0f};
+
+/// 三角形数がこれを超えるメッシュは既定で頂点を点として描画する（ソフトウェアGLでも対話的な速度を保つ上限）
+constexpr std::size_t DEFAULT_POINT_TRIANGLE_BUDGET{2000000};
+
+/**
+ * @brief 任意の先頭部分が空間的に均等な間引きとなる順に点を並べ替える
+ *
+ * バウンディングボックスを 8 分木状に細分し、各階層のセルから1点ずつを代表点として選ぶ。
+ * 粗い階層の代表点ほど前に並べるため、先頭から N 点を取り出すだけで密度に偏りの少ない
+ * 間引き結果が得られる（描画時は点数を変えるだけで再転送が不要）。
+ * セルの代表点は点番号のハッシュが最小の点とし、親セルの代表点は子セルでも代表点となる。
+ * モートン符号の計算・ソート・セルごとの代表点の選択は並列に行う。結果は決定的。
+ *
+ * @param points 入力点（非有限値を含まないこと）
+ * @return 並べ替えた点（入力と同じ点の集合）
+ */
+std::vector<glm::vec3> orderPointsForSubsampling(std::span<const glm::vec3> points);
+
+/**
+ * @brief 画面上の大きさから隙間なく表示するのに必要な描画点数を見積もる
+ *
+ * モデルの投影円の面積を点スプライトの面積で割り、表裏の面と重なりの分を掛けた点数とする。
+ * orderPointsForSubsampling() で並べた点の先頭からこの数だけ描画する。
+ *
+ * @param pointCount 点の総数
+ * @param projectedRadius モデルの外接球の画面上の半径（ピクセル）
+ * @param pointSize 点スプライトの大きさ（ピクセル）
+ * @return 描画する点数（pointCount 以下）
+ */
+std::size_t visiblePointCount(std::size_t pointCount, float projectedRadius, float pointSize);
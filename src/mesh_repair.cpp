@@ -0,0 +1,230 @@
+#include "mesh_repair.h"
+#include "mesh_hash.h"
+#include "model_loader.h"
+#include "parallel.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// 内部定数定義
+namespace
+{
+constexpr int TRIANGLE_VERTICES{3};                             // 三角形の頂点数
+constexpr float NORMAL_LENGTH_TOLERANCE{1e-3f};                 // 単位長とみなす法線長の許容誤差
+constexpr std::uint64_t HASH_MULTIPLIER{0x9E3779B97F4A7C15ull}; // 頂点ハッシュ用乗数
+
+/**
+ * @brief 三角形の分類結果
+ */
+enum class TriangleClass : std::uint8_t
+{
+    Valid,
+    NonFinite,
+    Degenerate,
+    Duplicate,
+};
+
+using VertexBits = std::array<std::uint32_t, 3>;
+using CanonicalTriangle = std::array<VertexBits, TRIANGLE_VERTICES>;
+
+/**
+ * @brief 順序・向きによらない三角形の正規形（頂点のビット列を辞書順に並べたもの）
+ *
+ * -0.0 は 0.0 に揃えてから比較する。
+ */
+CanonicalTriangle canonicalize(const ModelTriangle &triangle)
+{
+    auto canonical = CanonicalTriangle{};
+    for (int i = 0; i < TRIANGLE_VERTICES; ++i)
+    {
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            auto value = triangle.vertices[i][axis] + 0.0f;
+            std::memcpy(&canonical[i][axis], &value, sizeof(float));
+        }
+    }
+    std::sort(canonical.begin(), canonical.end());
+    return canonical;
+}
+
+std::uint64_t hashCanonical(const CanonicalTriangle &canonical)
+{
+    auto hash = std::uint64_t{0};
+    for (const auto &vertex : canonical)
+    {
+        for (auto bits : vertex)
+        {
+            hash = (hash ^ mixHash64(bits)) * HASH_MULTIPLIER;
+        }
+    }
+    return mixHash64(hash);
+}
+
+bool isFinite(const glm::vec3 &v)
+{
+    return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
+}
+
+/**
+ * @brief 三角形の座標から退化・非有限値を判定する
+ */
+TriangleClass classifyGeometry(const ModelTriangle &triangle)
+{
+    const auto &v = triangle.vertices;
+    if (!isFinite(v[0]) || !isFinite(v[1]) || !isFinite(v[2]))
+    {
+        return TriangleClass::NonFinite;
+    }
+
+    auto e0 = v[1] - v[0];
+    auto e1 = v[2] - v[1];
+    auto e2 = v[0] - v[2];
+    auto maxEdgeSquared = std::max({glm::dot(e0, e0), glm::dot(e1, e1), glm::dot(e2, e2)});
+    auto crossLength = glm::length(glm::cross(e0, -e2));
+
+    // 辺長0の場合も 0 <= 0 で退化と判定される
+    return crossLength <= DEGENERATE_RELATIVE_AREA * maxEdgeSquared ? TriangleClass::Degenerate
+                                                                     : TriangleClass::Valid;
+}
+
+/**
+ * @brief 重複検出用のソートキー
+ */
+struct DuplicateKey {
+    std::uint64_t hash;
+    std::uint32_t index;
+};
+
+/**
+ * @brief 有効な三角形の中から重複面を検出し、2つ目以降を Duplicate に分類する
+ */
+void markDuplicates(const ModelMesh &mesh, std::pmr::vector<TriangleClass> &classes, std::pmr::memory_resource *scratch)
+{
+    const auto &triangles = mesh.triangles;
+
+    auto keys = std::pmr::vector<DuplicateKey>(triangles.size(), scratch);
+    parallel::forEach(triangles.size(), [&](std::size_t i) {
+        auto hash = classes[i] == TriangleClass::Valid ? hashCanonical(canonicalize(triangles[i])) : 0;
+        keys[i] = DuplicateKey{hash, static_cast<std::uint32_t>(i)};
+    });
+
+    // 無効な三角形はキーから外し、ハッシュ・インデックス順に並列ソート
+    keys.erase(std::remove_if(keys.begin(), keys.end(),
+                              [&classes](const DuplicateKey &key) { return classes[key.index] != TriangleClass::Valid; }),
+               keys.end());
+    parallel::sort(keys.begin(), keys.end(), [](const DuplicateKey &lhs, const DuplicateKey &rhs) {
+        return lhs.hash != rhs.hash ? lhs.hash < rhs.hash : lhs.index < rhs.index;
+    });
+
+    // 同一ハッシュのグループごとに正規形を比較する。
+    // 各チャンクは自分の範囲内で始まるグループを最後まで（範囲外にはみ出しても）処理する。
+    parallel::forEachChunk(keys.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+        auto groupBegin = begin;
+        while (groupBegin > 0 && groupBegin < keys.size() && keys[groupBegin - 1].hash == keys[groupBegin].hash)
+        {
+            ++groupBegin;
+        }
+
+        while (groupBegin < end)
+        {
+            auto groupEnd = groupBegin + 1;
+            while (groupEnd < keys.size() && keys[groupEnd].hash == keys[groupBegin].hash)
+            {
+                ++groupEnd;
+            }
+
+            // グループ内はインデックス昇順なので、先に現れた面と一致すれば重複
+            for (auto i = groupBegin + 1; i < groupEnd; ++i)
+            {
+                auto canonical = canonicalize(triangles[keys[i].index]);
+                for (auto j = groupBegin; j < i; ++j)
+                {
+                    if (classes[keys[j].index] == TriangleClass::Valid &&
+                        canonicalize(triangles[keys[j].index]) == canonical)
+                    {
+                        classes[keys[i].index] = TriangleClass::Duplicate;
+                        break;
+                    }
+                }
+            }
+            groupBegin = groupEnd;
+        }
+    });
+}
+
+/**
+ * @brief 法線が不正な場合に面法線で置き換える
+ *
+ * @return 再計算した場合はtrue
+ */
+bool repairNormal(ModelTriangle &triangle)
+{
+    auto length = glm::length(triangle.normal);
+    if (std::isfinite(length) && std::abs(length - 1.0f) <= NORMAL_LENGTH_TOLERANCE)
+    {
+        return false;
+    }
+
+    // 退化三角形は除去済みのため外積は0にならない
+    const auto &v = triangle.vertices;
+    triangle.normal = glm::normalize(glm::cross(v[1] - v[0], v[2] - v[0]));
+    return true;
+}
+} // namespace
+
+RepairStats repairMesh(ModelMesh &mesh, std::pmr::memory_resource *scratch)
+{
+    auto &triangles = mesh.triangles;
+
+    // 1. 座標による分類（並列）
+    auto classes = std::pmr::vector<TriangleClass>(triangles.size(), scratch);
+    parallel::forEach(triangles.size(), [&](std::size_t i) { classes[i] = classifyGeometry(triangles[i]); });
+
+    // 2. 重複面の検出（並列ソート + グループ比較）
+    markDuplicates(mesh, classes, scratch);
+
+    // 3. 分類ごとの集計と法線の修復（並列リダクション）
+    auto stats = parallel::reduce(
+        triangles.size(), RepairStats{},
+        [&](std::size_t begin, std::size_t end) {
+            auto partial = RepairStats{};
+            for (auto i = begin; i < end; ++i)
+            {
+                switch (classes[i])
+                {
+                case TriangleClass::Valid:
+                    partial.recomputedNormals += repairNormal(triangles[i]) ? 1 : 0;
+                    break;
+                case TriangleClass::NonFinite:
+                    ++partial.nonFiniteTriangles;
+                    break;
+                case TriangleClass::Degenerate:
+                    ++partial.degenerateTriangles;
+                    break;
+                case TriangleClass::Duplicate:
+                    ++partial.duplicateTriangles;
+                    break;
+                }
+            }
+            return partial;
+        },
+        [](RepairStats lhs, const RepairStats &rhs) {
+            lhs.nonFiniteTriangles += rhs.nonFiniteTriangles;
+            lhs.degenerateTriangles += rhs.degenerateTriangles;
+            lhs.duplicateTriangles += rhs.duplicateTriangles;
+            lhs.recomputedNormals += rhs.recomputedNormals;
+            return lhs;
+        });
+
+    // 4. 有効な三角形のみをその場で詰める（並列ストリームコンパクション）
+    if (stats.removedTriangles() > 0)
+    {
+        auto keep = std::pmr::vector<std::uint8_t>(triangles.size(), scratch);
+        parallel::forEach(triangles.size(), [&](std::size_t i) { keep[i] = classes[i] == TriangleClass::Valid; });
+        parallel::compact(triangles, keep);
+    }
+
+    return stats;
+}
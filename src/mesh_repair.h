@@ -0,0 +1,57 @@
+/**
+ * @file mesh_repair.h
+ * @brief 不正な三角形（退化・重複・非有限値）の除去と法線の修復
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+struct ModelMesh;
+
+/// 退化判定の閾値（外積の長さ ÷ 最長辺の2乗。三角形の高さ/底辺比に相当）
+constexpr float DEGENERATE_RELATIVE_AREA{1e-6f};
+
+/**
+ * @brief 修復処理の結果統計
+ */
+struct RepairStats {
+    std::size_t nonFiniteTriangles;   ///< 座標に NaN/Inf を含むため除去した三角形数
+    std::size_t degenerateTriangles;  ///< 面積がほぼ0のため除去した三角形数
+    std::size_t duplicateTriangles;   ///< 同じ3頂点を持つ重複面として除去した三角形数
+    std::size_t recomputedNormals;    ///< 法線が不正（NaN・非単位長）のため再計算した三角形数
+
+    /**
+     * @brief 除去した三角形の総数を取得する
+     *
+     * @return 除去した三角形数
+     */
+    std::size_t removedTriangles() const noexcept
+    {
+        return nonFiniteTriangles + degenerateTriangles + duplicateTriangles;
+    }
+};
+
+/**
+ * @brief メッシュから不正な三角形を除去し、壊れた法線を再計算する
+ *
+ * 面積0の面に対する glm::normalize が生成する NaN 法線や、エクスポーターが
+ * 出力する重複面は、GPUの無駄な処理やライティングの破綻を招く。本関数は次を行う:
+ * - 座標に NaN/Inf を含む三角形の除去
+ * - 退化三角形（外積の長さ ≤ DEGENERATE_RELATIVE_AREA × 最長辺²）の除去
+ * - 重複面（頂点の順序・向きによらず同じ3頂点を持つ面）の除去（最初の1つを残す）
+ * - 残った三角形のうち法線が非有限または単位長でないものを面法線で再計算
+ *
+ * 三角形の分類は分岐の少ないループで並列に行い、重複検出は頂点ハッシュの並列ソート、
+ * 除去は並列ストリームコンパクションでその場で行う。残った三角形の順序は保たれる。
+ * 分類結果・ソートキー等の作業用配列は scratch から確保する。
+ *
+ * @param mesh 修復対象のメッシュ
+ * @param scratch 作業用配列の確保に使用するメモリリソース
+ * @return 修復処理の結果統計
+ * @post バウンディングボックス等は更新されないため、必要に応じて再計算すること
+ */
+RepairStats repairMesh(ModelMesh& mesh, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
@@ -0,0 +1,404 @@
+#include "mesh_sdf.h"
+#include "model_loader.h"
+#include "parallel.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+// 内部定数定義
+namespace
+{
+constexpr int TRIANGLE_VERTICES{3};          // 三角形の頂点数
+constexpr int SLAB_DEPTH{VOXEL_BRICK_SIZE};  // 狭帯域計算のスラブの厚さ（Z層数）
+constexpr int SWEEP_BLOCK_SIZE{16};          // 掃引の並列化の単位となるブロック1辺の格子点数
+constexpr int WORD_BITS{64};                 // 帯のビット列の1語のビット数
+constexpr float UNKNOWN_DISTANCE{std::numeric_limits<float>::max()};
+
+/**
+ * @brief 点から三角形までの距離の2乗を求める（最近点の領域判定による厳密解）
+ */
+double pointTriangleDistanceSquared(const glm::dvec3 &p, const glm::dvec3 &a, const glm::dvec3 &b,
+                                    const glm::dvec3 &c)
+{
+    auto ab = b - a;
+    auto ac = c - a;
+    auto ap = p - a;
+    auto d1 = glm::dot(ab, ap);
+    auto d2 = glm::dot(ac, ap);
+    if (d1 <= 0.0 && d2 <= 0.0)
+    {
+        return glm::dot(ap, ap); // 頂点 a
+    }
+
+    auto bp = p - b;
+    auto d3 = glm::dot(ab, bp);
+    auto d4 = glm::dot(ac, bp);
+    if (d3 >= 0.0 && d4 <= d3)
+    {
+        return glm::dot(bp, bp); // 頂点 b
+    }
+
+    auto closest = glm::dvec3{};
+    auto vc = d1 * d4 - d3 * d2;
+    auto cp = p - c;
+    auto d5 = glm::dot(ab, cp);
+    auto d6 = glm::dot(ac, cp);
+    auto vb = d5 * d2 - d1 * d6;
+    auto va = d3 * d6 - d5 * d4;
+    if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+    {
+        closest = a + ab * (d1 / (d1 - d3)); // 辺 ab
+    }
+    else if (d6 >= 0.0 && d5 <= d6)
+    {
+        closest = c; // 頂点 c
+    }
+    else if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+    {
+        closest = a + ac * (d2 / (d2 - d6)); // 辺 ac
+    }
+    else if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+    {
+        closest = b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6))); // 辺 bc
+    }
+    else
+    {
+        auto denominator = va + vb + vc;
+        if (denominator == 0.0)
+        {
+            return std::min({glm::dot(ap, ap), glm::dot(bp, bp), glm::dot(cp, cp)}); // 退化三角形
+        }
+        closest = a + ab * (vb / denominator) + ac * (vc / denominator); // 面の内部
+    }
+
+    auto offset = p - closest;
+    return glm::dot(offset, offset);
+}
+
+/**
+ * @brief 三角形の近傍（帯幅以内）にある格子点の範囲を求める
+ *
+ * @param low ボクセル単位の三角形の最小座標
+ * @param high ボクセル単位の三角形の最大座標
+ * @return 軸ごとの格子点番号の閉区間 [first, last]（first > last の場合は空）
+ */
+std::pair<glm::ivec3, glm::ivec3> bandRange(const glm::dvec3 &low, const glm::dvec3 &high, double bandWidth,
+                                            const glm::ivec3 &dimensions)
+{
+    auto first = glm::ivec3{};
+    auto last = glm::ivec3{};
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        // 格子点 i の座標は i + 0.5
+        auto from = std::ceil(low[axis] - bandWidth - 0.5);
+        auto to = std::floor(high[axis] + bandWidth - 0.5);
+        first[axis] = static_cast<int>(std::max(from, 0.0));
+        last[axis] = static_cast<int>(std::min(to, static_cast<double>(dimensions[axis] - 1)));
+    }
+    return {first, last};
+}
+
+/**
+ * @brief ボクセル単位に変換した三角形
+ */
+struct GridTriangle {
+    std::array<glm::dvec3, TRIANGLE_VERTICES> vertices;
+    glm::ivec3 first;  ///< 帯に含まれる格子点の最小番号
+    glm::ivec3 last;   ///< 帯に含まれる格子点の最大番号
+};
+
+GridTriangle toGridTriangle(const ModelTriangle &triangle, const VoxelGridLayout &layout, double bandWidth)
+{
+    auto gridTriangle = GridTriangle{};
+    auto origin = glm::dvec3{layout.origin};
+    auto inverseSize = 1.0 / static_cast<double>(layout.voxelSize);
+    for (int i = 0; i < TRIANGLE_VERTICES; ++i)
+    {
+        gridTriangle.vertices[i] = (glm::dvec3{triangle.vertices[i]} - origin) * inverseSize;
+    }
+
+    const auto &v = gridTriangle.vertices;
+    auto low = glm::min(glm::min(v[0], v[1]), v[2]);
+    auto high = glm::max(glm::max(v[0], v[1]), v[2]);
+    auto [first, last] = bandRange(low, high, bandWidth, layout.dimensions);
+    gridTriangle.first = first;
+    gridTriangle.last = last;
+    return gridTriangle;
+}
+
+/**
+ * @brief 行 (y, z) 上で三角形の平面から帯幅以内にある格子点の X 範囲を求める
+ *
+ * 平面から帯幅より遠い格子点は三角形からも帯幅より遠いため、距離計算を省略できる。
+ *
+ * @param normal 三角形の単位法線（退化三角形では零ベクトル）
+ * @return 格子点番号の閉区間 [first, last]（範囲を絞れない場合は int の全範囲）
+ */
+std::pair<int, int> planeBandRange(const glm::dvec3 &normal, const glm::dvec3 &vertex, double y, double z,
+                                   double bandWidth)
+{
+    constexpr auto unbounded = std::pair<int, int>{std::numeric_limits<int>::min(), std::numeric_limits<int>::max()};
+    auto offset = normal.y * (y - vertex.y) + normal.z * (z - vertex.z) - normal.x * vertex.x;
+    if (std::abs(normal.x) < 1e-9)
+    {
+        return std::abs(offset) <= bandWidth || normal == glm::dvec3{0.0} ? unbounded : std::pair<int, int>{1, 0};
+    }
+
+    // |normal.x * (x + 0.5) + offset| <= bandWidth を満たす x
+    auto from = (-bandWidth - offset) / normal.x - 0.5;
+    auto to = (bandWidth - offset) / normal.x - 0.5;
+    if (from > to)
+    {
+        std::swap(from, to);
+    }
+    auto limit = static_cast<double>(std::numeric_limits<int>::max() / 2);
+    return {static_cast<int>(std::ceil(std::clamp(from, -limit, limit))),
+            static_cast<int>(std::floor(std::clamp(to, -limit, limit)))};
+}
+
+/**
+ * @brief 狭帯域内の格子点について最近傍の三角形までの厳密距離を求める（ボクセル単位）
+ *
+ * @param distances [in,out] 格子点ごとの距離（未計算は UNKNOWN_DISTANCE）
+ * @param band [out] 距離が厳密な格子点のビット（layout と words を確保済みであること）
+ */
+void computeNarrowBand(const ModelMesh &mesh, const VoxelGridLayout &layout, double bandWidth,
+                       std::vector<float> &distances, DenseVoxelGrid &band)
+{
+    const auto &dims = layout.dimensions;
+    auto slabCount = static_cast<std::size_t>((dims.z + SLAB_DEPTH - 1) / SLAB_DEPTH);
+    auto slabs = parallel::bucketRanges(mesh.triangles.size(), slabCount, [&](std::size_t t) {
+        auto gridTriangle = toGridTriangle(mesh.triangles[t], layout, bandWidth);
+        return std::pair<std::int64_t, std::int64_t>{gridTriangle.first.z / SLAB_DEPTH,
+                                                     gridTriangle.last.z / SLAB_DEPTH};
+    });
+
+    // スラブはZ層が重ならないため、各スラブが格子点へ直接書き込む
+    auto pointsPerLayer = static_cast<std::size_t>(dims.x) * dims.y;
+    parallel::forEach(
+        slabCount,
+        [&](std::size_t slab) {
+            auto zBegin = static_cast<int>(slab) * SLAB_DEPTH;
+            auto zEnd = std::min(zBegin + SLAB_DEPTH, dims.z);
+            for (auto i = slabs.offsets[slab]; i < slabs.offsets[slab + 1]; ++i)
+            {
+                auto triangle = toGridTriangle(mesh.triangles[slabs.items[i]], layout, bandWidth);
+                const auto &v = triangle.vertices;
+                auto normal = glm::cross(v[1] - v[0], v[2] - v[0]);
+                auto normalLength = glm::length(normal);
+                normal = normalLength > 0.0 ? normal / normalLength : glm::dvec3{0.0};
+                auto z0 = std::max(triangle.first.z, zBegin);
+                auto z1 = std::min(triangle.last.z, zEnd - 1);
+                for (auto z = z0; z <= z1; ++z)
+                {
+                    for (auto y = triangle.first.y; y <= triangle.last.y; ++y)
+                    {
+                        auto [x0, x1] = planeBandRange(normal, v[0], y + 0.5, z + 0.5, bandWidth);
+                        x0 = std::max(x0, triangle.first.x);
+                        x1 = std::min(x1, triangle.last.x);
+                        auto row = distances.data() + z * pointsPerLayer + static_cast<std::size_t>(y) * dims.x;
+                        for (auto x = x0; x <= x1; ++x)
+                        {
+                            auto point = glm::dvec3{x + 0.5, y + 0.5, z + 0.5};
+                            auto squared = pointTriangleDistanceSquared(point, v[0], v[1], v[2]);
+                            auto current = static_cast<double>(row[x]);
+                            if (current == UNKNOWN_DISTANCE || squared < current * current)
+                            {
+                                row[x] = static_cast<float>(std::sqrt(squared));
+                            }
+                        }
+                    }
+                }
+            }
+
+            // 帯幅以内の値は最近傍の三角形から得たものなので厳密（以降の掃引で更新しない）
+            // 行はスラブ内で完結するため、ビット列の語も他のスラブと共有しない
+            for (auto row = static_cast<std::size_t>(zBegin) * dims.y; row < static_cast<std::size_t>(zEnd) * dims.y; ++row)
+            {
+                const auto *values = distances.data() + row * dims.x;
+                auto *words = band.words.data() + row * band.wordsPerRow;
+                for (int x = 0; x < dims.x; ++x)
+                {
+                    if (values[x] <= bandWidth)
+                    {
+                        words[x / WORD_BITS] |= std::uint64_t{1} << (x % WORD_BITS);
+                    }
+                }
+            }
+        },
+        1);
+}
+
+/**
+ * @brief 隣接格子点の値から Eikonal 方程式 |∇d| = 1 の Godunov 離散化の解を求める（格子間隔1）
+ *
+ * @param a, b, c 各軸の隣接格子点の最小値
+ */
+inline float solveEikonal(float a, float b, float c)
+{
+    // a <= b <= c に並べ替え
+    if (a > b)
+    {
+        std::swap(a, b);
+    }
+    if (b > c)
+    {
+        std::swap(b, c);
+    }
+    if (a > b)
+    {
+        std::swap(a, b);
+    }
+    if (a == UNKNOWN_DISTANCE)
+    {
+        return UNKNOWN_DISTANCE;
+    }
+
+    auto result = static_cast<double>(a) + 1.0;
+    if (result > b)
+    {
+        auto difference = static_cast<double>(a) - b;
+        result = (static_cast<double>(a) + b + std::sqrt(2.0 - difference * difference)) * 0.5;
+        if (result > c)
+        {
+            auto sum = static_cast<double>(a) + b + c;
+            auto squares = static_cast<double>(a) * a + static_cast<double>(b) * b + static_cast<double>(c) * c;
+            result = (sum + std::sqrt(std::max(0.0, sum * sum - 3.0 * (squares - 1.0)))) / 3.0;
+        }
+    }
+    return static_cast<float>(result);
+}
+
+/**
+ * @brief 帯の外側の格子点の距離を高速掃引法で求める
+ *
+ * 格子を SWEEP_BLOCK_SIZE 立方のブロックに分け、掃引方向ごとにブロック番号の和
+ * bi' + bj' + bk' = level が等しいブロックの平面を順に処理する（bi', bj', bk' は掃引方向に沿った番号）。
+ * 同じ平面上のブロックは面で接しないため、隣接格子点の参照が他のスレッドの書き込みと重ならず、
+ * ブロック単位で並列に更新できる。ブロック内は掃引方向の順に Gauss-Seidel 型で更新する。
+ * 格子点の斜めの平面ごとに並列化するより並列区間の数がブロック1辺分だけ少なく、1区間の仕事量が大きい。
+ * 距離関数は 2^3 = 8 方向の掃引1巡で収束する。
+ */
+void sweepDistances(const glm::ivec3 &dims, std::vector<float> &distances, const DenseVoxelGrid &band)
+{
+    auto strideY = static_cast<std::size_t>(dims.x);
+    auto strideZ = strideY * dims.y;
+    auto neighborMin = [&](std::size_t index, int coordinate, int dimension, std::size_t stride) {
+        auto lower = coordinate > 0 ? distances[index - stride] : UNKNOWN_DISTANCE;
+        auto upper = coordinate + 1 < dimension ? distances[index + stride] : UNKNOWN_DISTANCE;
+        return std::min(lower, upper);
+    };
+    auto blocks = (dims + (SWEEP_BLOCK_SIZE - 1)) / SWEEP_BLOCK_SIZE;
+    auto plane = std::vector<glm::ivec3>{};
+
+    for (int direction = 0; direction < 8; ++direction)
+    {
+        auto flip = glm::ivec3{direction & 1, (direction >> 1) & 1, (direction >> 2) & 1};
+        auto step = 1 - 2 * flip;
+        auto levels = blocks.x + blocks.y + blocks.z - 2;
+        for (int level = 0; level < levels; ++level)
+        {
+            // この平面上のブロック（掃引方向に沿った番号）
+            plane.clear();
+            auto kFirst = std::max(0, level - (blocks.x - 1) - (blocks.y - 1));
+            auto kLast = std::min(blocks.z - 1, level);
+            for (auto k = kFirst; k <= kLast; ++k)
+            {
+                auto jFirst = std::max(0, level - k - (blocks.x - 1));
+                auto jLast = std::min(blocks.y - 1, level - k);
+                for (auto j = jFirst; j <= jLast; ++j)
+                {
+                    plane.push_back(glm::ivec3{level - k - j, j, k});
+                }
+            }
+
+            parallel::forEach(
+                plane.size(),
+                [&](std::size_t b) {
+                    // ブロックの格子点範囲を掃引方向の始点と終点（終点は含まない）で表す
+                    auto first = glm::ivec3{};
+                    auto last = glm::ivec3{};
+                    for (int axis = 0; axis < 3; ++axis)
+                    {
+                        auto block = flip[axis] ? blocks[axis] - 1 - plane[b][axis] : plane[b][axis];
+                        auto low = block * SWEEP_BLOCK_SIZE;
+                        auto high = std::min(low + SWEEP_BLOCK_SIZE, dims[axis]);
+                        first[axis] = flip[axis] ? high - 1 : low;
+                        last[axis] = flip[axis] ? low - 1 : high;
+                    }
+
+                    for (auto z = first.z; z != last.z; z += step.z)
+                    {
+                        for (auto y = first.y; y != last.y; y += step.y)
+                        {
+                            auto row = static_cast<std::size_t>(z) * dims.y + y;
+                            const auto *words = band.words.data() + row * band.wordsPerRow;
+                            for (auto x = first.x; x != last.x; x += step.x)
+                            {
+                                if ((words[x / WORD_BITS] >> (x % WORD_BITS)) & 1u)
+                                {
+                                    continue;
+                                }
+
+                                auto index = row * strideY + x;
+                                auto candidate = solveEikonal(neighborMin(index, x, dims.x, 1),
+                                                              neighborMin(index, y, dims.y, strideY),
+                                                              neighborMin(index, z, dims.z, strideZ));
+                                distances[index] = std::min(distances[index], candidate);
+                            }
+                        }
+                    }
+                },
+                1);
+        }
+    }
+}
+} // namespace
+
+SignedDistanceField computeSignedDistanceField(const ModelMesh &mesh, const SignedDistanceSettings &settings)
+{
+    // 符号判定用の内部（中心がメッシュ内にあるボクセル）と格子の配置
+    auto voxelSettings = VoxelizeSettings{};
+    voxelSettings.resolution = std::min(settings.resolution, MAX_SIGNED_DISTANCE_RESOLUTION);
+    voxelSettings.padding = settings.padding;
+    voxelSettings.surface = false;
+    voxelSettings.solid = true;
+    auto inside = voxelizeDense(mesh, voxelSettings);
+
+    auto field = SignedDistanceField{};
+    field.layout = inside.layout;
+    const auto &dims = field.layout.dimensions;
+    auto pointCount = static_cast<std::size_t>(dims.x) * dims.y * dims.z;
+    field.distances.assign(pointCount, UNKNOWN_DISTANCE);
+
+    // 帯の格子点は内部と同じ形式のビット列で持つ（格子点1つあたり1ビット）
+    auto band = DenseVoxelGrid{};
+    band.layout = field.layout;
+    band.wordsPerRow = inside.wordsPerRow;
+    band.words.assign(inside.words.size(), 0);
+
+    auto bandWidth = static_cast<double>(std::max(settings.bandWidth, 1.0f));
+    computeNarrowBand(mesh, field.layout, bandWidth, field.distances, band);
+    sweepDistances(dims, field.distances, band);
+    field.bandPoints = band.count();
+
+    // ボクセル単位の距離をモデル座標系に戻し、内部の格子点を負にする
+    auto voxelSize = field.layout.voxelSize;
+    parallel::forEach(
+        static_cast<std::size_t>(dims.z) * dims.y,
+        [&](std::size_t row) {
+            auto y = static_cast<int>(row % dims.y);
+            auto z = static_cast<int>(row / dims.y);
+            auto values = field.distances.data() + row * dims.x;
+            for (int x = 0; x < dims.x; ++x)
+            {
+                auto distance = values[x] == UNKNOWN_DISTANCE ? values[x] : values[x] * voxelSize;
+                values[x] = inside.test(x, y, z) ? -distance : distance;
+            }
+        },
+        1);
+
+    return field;
+}
@@ -0,0 +1,156 @@
+#include "mesh_shells.h"
+#include "model_loader.h"
+#include "parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+
+// 内部定数定義
+namespace
+{
+constexpr int TRIANGLE_VERTICES{3}; // 三角形の頂点数
+constexpr std::uint32_t NO_SHELL{std::numeric_limits<std::uint32_t>::max()};
+
+/**
+ * @brief ロックフリーの並列 Union-Find
+ *
+ * 根同士を結合する際は常に大きいインデックスの根を小さいインデックスの根へ
+ * CAS でリンクするため、最終的な各成分の根は成分内の最小インデックスになる。
+ */
+class ConcurrentUnionFind {
+public:
+    explicit ConcurrentUnionFind(std::size_t size) : parents{std::make_unique<std::atomic<std::uint32_t>[]>(size)}
+    {
+        parallel::forEach(size, [this](std::size_t i) {
+            parents[i].store(static_cast<std::uint32_t>(i), std::memory_order_relaxed);
+        });
+    }
+
+    /**
+     * @brief 根を探す（経路半減により木を平坦化しながらたどる）
+     */
+    std::uint32_t find(std::uint32_t x)
+    {
+        while (true)
+        {
+            auto parent = parents[x].load(std::memory_order_relaxed);
+            if (parent == x)
+            {
+                return x;
+            }
+
+            auto grandparent = parents[parent].load(std::memory_order_relaxed);
+            if (parent != grandparent)
+            {
+                // 失敗しても他スレッドがより根に近い親を設定しただけなので無視してよい
+                parents[x].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+            }
+            x = grandparent;
+        }
+    }
+
+    void unite(std::uint32_t a, std::uint32_t b)
+    {
+        while (true)
+        {
+            a = find(a);
+            b = find(b);
+            if (a == b)
+            {
+                return;
+            }
+            if (a > b)
+            {
+                std::swap(a, b);
+            }
+
+            // b がまだ根であればリンクする（他スレッドに先を越されたらやり直す）
+            auto expected = b;
+            if (parents[b].compare_exchange_strong(expected, a, std::memory_order_acq_rel))
+            {
+                return;
+            }
+        }
+    }
+
+private:
+    std::unique_ptr<std::atomic<std::uint32_t>[]> parents;
+};
+} // namespace
+
+ShellDecomposition decomposeShells(IndexedMesh &mesh)
+{
+    auto result = ShellDecomposition{};
+    auto &indices = mesh.indices;
+    auto triangleCount = mesh.triangleCount();
+
+    // 1. 三角形の頂点同士を並列に結合
+    auto unionFind = ConcurrentUnionFind{mesh.positions.size()};
+    parallel::forEach(triangleCount, [&](std::size_t t) {
+        unionFind.unite(indices[t * TRIANGLE_VERTICES], indices[t * TRIANGLE_VERTICES + 1]);
+        unionFind.unite(indices[t * TRIANGLE_VERTICES], indices[t * TRIANGLE_VERTICES + 2]);
+    });
+
+    // 2. 三角形ごとの根を求め、根に連番のシェル番号を振る（根の昇順 = 決定的）
+    auto triangleRoots = std::vector<std::uint32_t>(triangleCount);
+    parallel::forEach(triangleCount, [&](std::size_t t) { triangleRoots[t] = unionFind.find(indices[t * TRIANGLE_VERTICES]); });
+
+    auto rootShells = std::vector<std::uint32_t>(mesh.positions.size(), NO_SHELL);
+    for (auto root : triangleRoots)
+    {
+        rootShells[root] = 0; // 使用中の根に印を付ける
+    }
+    auto shellCount = std::uint32_t{0};
+    for (auto &shell : rootShells)
+    {
+        if (shell != NO_SHELL)
+        {
+            shell = shellCount++;
+        }
+    }
+
+    // 3. シェル番号で安定な計数ソート
+    auto offsets = std::vector<std::uint32_t>(shellCount + 1, 0);
+    for (auto root : triangleRoots)
+    {
+        ++offsets[rootShells[root] + 1];
+    }
+    for (std::uint32_t s = 0; s < shellCount; ++s)
+    {
+        offsets[s + 1] += offsets[s];
+    }
+
+    auto sortedIndices = std::vector<std::uint32_t>(indices.size());
+    auto cursor = std::vector<std::uint32_t>(offsets.begin(), offsets.end() - 1);
+    result.triangleShells.resize(triangleCount);
+    for (std::size_t t = 0; t < triangleCount; ++t)
+    {
+        auto shell = rootShells[triangleRoots[t]];
+        auto destination = cursor[shell]++;
+        std::copy_n(indices.begin() + t * TRIANGLE_VERTICES, TRIANGLE_VERTICES,
+                    sortedIndices.begin() + static_cast<std::size_t>(destination) * TRIANGLE_VERTICES);
+        result.triangleShells[destination] = shell;
+    }
+    indices.swap(sortedIndices);
+
+    // 4. シェルごとの三角形数とバウンディングボックス（並列）
+    result.shells.resize(shellCount);
+    parallel::forEach(
+        shellCount,
+        [&](std::size_t s) {
+            auto &shell = result.shells[s];
+            shell.firstTriangle = offsets[s];
+            shell.triangleCount = offsets[s + 1] - offsets[s];
+            shell.minBounds = shell.maxBounds = mesh.positions[indices[static_cast<std::size_t>(offsets[s]) * TRIANGLE_VERTICES]];
+            for (auto i = static_cast<std::size_t>(offsets[s]) * TRIANGLE_VERTICES;
+                 i < static_cast<std::size_t>(offsets[s + 1]) * TRIANGLE_VERTICES; ++i)
+            {
+                shell.minBounds = glm::min(shell.minBounds, mesh.positions[indices[i]]);
+                shell.maxBounds = glm::max(shell.maxBounds, mesh.positions[indices[i]]);
+            }
+        },
+        1);
+
+    return result;
+}
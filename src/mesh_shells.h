@@ -0,0 +1,51 @@
+/**
+ * @file mesh_shells.h
+ * @brief 連結成分（シェル）の検出と三角形の並べ替え
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+struct IndexedMesh;
+
+/**
+ * @brief 1つのシェル（頂点を共有する三角形の連結成分）
+ *
+ * decomposeShells() による並べ替え後、シェルの三角形はインデックスバッファ上で
+ * [firstTriangle, firstTriangle + triangleCount) の連続区間に並ぶため、
+ * 1回の描画呼び出しで描画できる。
+ */
+struct MeshShell {
+    std::uint32_t firstTriangle;  ///< 先頭三角形のインデックス
+    std::uint32_t triangleCount;  ///< 三角形数
+    glm::vec3 minBounds;          ///< バウンディングボックスの最小座標
+    glm::vec3 maxBounds;          ///< バウンディングボックスの最大座標
+};
+
+/**
+ * @brief シェル分解の結果
+ */
+struct ShellDecomposition {
+    std::vector<MeshShell> shells;               ///< シェル一覧（最小頂点インデックスの昇順）
+    std::vector<std::uint32_t> triangleShells;   ///< 並べ替え後の三角形ごとのシェル番号
+};
+
+/**
+ * @brief メッシュを互いに頂点を共有しないシェルに分解し、三角形をシェル順に並べ替える
+ *
+ * 共有頂点に対するロックフリーの並列 Union-Find（CAS によるリンクと経路半減）で
+ * 連結成分を求める。各成分の代表は最小の頂点インデックスとなるため、
+ * 結果はスレッド数や実行順序に依存しない。
+ * その後、三角形をシェル番号で安定な計数ソートにより並べ替え、
+ * シェルごとの三角形数とバウンディングボックスを並列に計算する。
+ *
+ * @param mesh 溶接済みのインデックス付きメッシュ（indices がシェル順に並べ替えられる）
+ * @return シェル分解の結果
+ * @post 同じシェルに属する三角形の相対順序は保たれる
+ */
+ShellDecomposition decomposeShells(IndexedMesh& mesh);
@@ -0,0 +1,347 @@
+#include "mesh_slicer.h"
+#include "model_loader.h"
+#include "parallel.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <unordered_map>
+
+// 内部定数定義
+namespace
+{
+constexpr int TRIANGLE_VERTICES{3}; // 三角形の頂点数
+constexpr std::uint32_t NO_SEGMENT{std::numeric_limits<std::uint32_t>::max()};
+constexpr std::uint32_t SLICE_FILE_VERSION{1};
+constexpr std::array<char, 4> SLICE_FILE_MAGIC{'S', 'L', 'C', 'B'};
+constexpr const char *SVG_EXTENSION{".svg"};
+constexpr float SVG_MARGIN{1.0f};        // SVGの余白（モデル座標単位）
+constexpr float SVG_STROKE_WIDTH{0.1f};  // SVGの線幅（モデル座標単位）
+
+/**
+ * @brief 2頂点から無向辺キーを作る
+ */
+inline std::uint64_t edgeKey(std::uint32_t a, std::uint32_t b)
+{
+    auto low = std::min(a, b);
+    auto high = std::max(a, b);
+    return (static_cast<std::uint64_t>(low) << 32) | high;
+}
+
+/**
+ * @brief 三角形と平面の交線（辺キーで表した始点・終点と座標）
+ */
+struct Segment {
+    std::uint64_t startEdge;
+    std::uint64_t endEdge;
+    glm::vec2 start;
+};
+
+/**
+ * @brief 高さ z 以下で最も高い平面の層番号を求める（概算、範囲外の番号も返す）
+ */
+inline std::int64_t layerOf(float z, float bottom, float inverseHeight)
+{
+    return static_cast<std::int64_t>(std::floor((z - bottom) * inverseHeight - 0.5f));
+}
+
+/**
+ * @brief 三角形ごとに交差する層の範囲を求め、層ごとの三角形リスト（区間インデックス）を構築する
+ *
+ * 層 i と交差する三角形は items[offsets[i], offsets[i + 1]) に三角形番号順に並ぶ。
+ */
+parallel::Buckets buildLayerIndex(const IndexedMesh &mesh, std::size_t layerCount, float bottom, float layerHeight)
+{
+    auto inverseHeight = 1.0f / layerHeight;
+    auto lastLayer = static_cast<std::int64_t>(layerCount) - 1;
+    auto planeHeight = [bottom, layerHeight](std::int64_t layer) {
+        return bottom + (static_cast<float>(layer) + 0.5f) * layerHeight;
+    };
+
+    // 三角形 t が交差する層は [first, last]（空の場合は first > last）
+    auto layerRange = [&](std::size_t t) {
+        auto low = std::numeric_limits<float>::max();
+        auto high = std::numeric_limits<float>::lowest();
+        for (int corner = 0; corner < TRIANGLE_VERTICES; ++corner)
+        {
+            auto z = mesh.positions[mesh.indices[t * TRIANGLE_VERTICES + corner]].z;
+            low = std::min(low, z);
+            high = std::max(high, z);
+        }
+        // 平面上の頂点は上側とみなすため、平面の高さ h が low < h <= high の層のみ交差する
+        // （丸め誤差で層番号がずれないよう、スライス時と同じ式の高さで境界を補正する）
+        auto first = std::clamp<std::int64_t>(layerOf(low, bottom, inverseHeight) + 1, 0, lastLayer + 1);
+        while (first <= lastLayer && planeHeight(first) <= low)
+        {
+            ++first;
+        }
+        while (first > 0 && planeHeight(first - 1) > low)
+        {
+            --first;
+        }
+        auto last = std::clamp<std::int64_t>(layerOf(high, bottom, inverseHeight), -1, lastLayer);
+        while (last >= 0 && planeHeight(last) > high)
+        {
+            --last;
+        }
+        while (last < lastLayer && planeHeight(last + 1) <= high)
+        {
+            ++last;
+        }
+        return std::pair<std::int64_t, std::int64_t>{first, last};
+    };
+
+    return parallel::bucketRanges(mesh.triangleCount(), layerCount, layerRange);
+}
+
+/**
+ * @brief 辺と平面の交点を求める（辺の頂点順に依存しない）
+ */
+glm::vec2 intersectEdge(const IndexedMesh &mesh, std::uint32_t a, std::uint32_t b, float z)
+{
+    if (a > b)
+    {
+        std::swap(a, b);
+    }
+    const auto &p = mesh.positions[a];
+    const auto &q = mesh.positions[b];
+    auto t = (z - p.z) / (q.z - p.z);
+    return glm::vec2{p.x + (q.x - p.x) * t, p.y + (q.y - p.y) * t};
+}
+
+/**
+ * @brief 1つの層の線分を求めて輪郭につなげる
+ */
+SliceLayer sliceLayer(const IndexedMesh &mesh, const parallel::Buckets &index, std::size_t layer, float z)
+{
+    auto result = SliceLayer{z, {}};
+    auto begin = index.offsets[layer];
+    auto end = index.offsets[layer + 1];
+
+    // 線分の生成: 外向きの面では、平面を上から下へ横切る辺の交点から
+    // 下から上へ横切る辺の交点へ向かうと、+Z から見て外周が反時計回りになる
+    auto segments = std::vector<Segment>{};
+    segments.reserve(end - begin);
+    for (auto i = begin; i < end; ++i)
+    {
+        auto t = static_cast<std::size_t>(index.items[i]);
+        auto downEdge = std::uint64_t{0};
+        auto upEdge = std::uint64_t{0};
+        auto downPoint = glm::vec2{0.0f};
+        auto found = 0;
+        for (int corner = 0; corner < TRIANGLE_VERTICES; ++corner)
+        {
+            auto from = mesh.indices[t * TRIANGLE_VERTICES + corner];
+            auto to = mesh.indices[t * TRIANGLE_VERTICES + (corner + 1) % TRIANGLE_VERTICES];
+            auto fromAbove = mesh.positions[from].z >= z;
+            auto toAbove = mesh.positions[to].z >= z;
+            if (fromAbove == toAbove)
+            {
+                continue;
+            }
+
+            ++found;
+            if (fromAbove)
+            {
+                downEdge = edgeKey(from, to);
+                downPoint = intersectEdge(mesh, from, to, z);
+            }
+            else
+            {
+                upEdge = edgeKey(from, to);
+            }
+        }
+        if (found == 2)
+        {
+            segments.push_back(Segment{downEdge, upEdge, downPoint});
+        }
+    }
+
+    // 始点の辺キーから線分を引くハッシュ表
+    auto startOf = std::unordered_map<std::uint64_t, std::uint32_t>{};
+    startOf.reserve(segments.size());
+    for (std::uint32_t s = 0; s < segments.size(); ++s)
+    {
+        startOf.emplace(segments[s].startEdge, s);
+    }
+    auto next = std::vector<std::uint32_t>(segments.size(), NO_SEGMENT);
+    auto hasPrevious = std::vector<std::uint8_t>(segments.size(), 0);
+    for (std::uint32_t s = 0; s < segments.size(); ++s)
+    {
+        auto found = startOf.find(segments[s].endEdge);
+        if (found != startOf.end() && !hasPrevious[found->second])
+        {
+            next[s] = found->second;
+            hasPrevious[found->second] = 1;
+        }
+    }
+
+    // 輪郭をたどる: 開いた折れ線を先頭から処理してから、残りの閉じた輪郭を処理する
+    auto visited = std::vector<std::uint8_t>(segments.size(), 0);
+    auto trace = [&](std::uint32_t first) {
+        auto contour = SliceContour{{}, false};
+        auto s = first;
+        while (s != NO_SEGMENT && !visited[s])
+        {
+            visited[s] = 1;
+            contour.points.push_back(segments[s].start);
+            if (next[s] == NO_SEGMENT)
+            {
+                // 開いた折れ線の終点（最後の線分の終点）を補う
+                auto endEdge = segments[s].endEdge;
+                contour.points.push_back(intersectEdge(mesh, static_cast<std::uint32_t>(endEdge >> 32),
+                                                       static_cast<std::uint32_t>(endEdge), z));
+            }
+            s = next[s];
+        }
+        contour.closed = s == first;
+        result.contours.push_back(std::move(contour));
+    };
+    for (std::uint32_t s = 0; s < segments.size(); ++s)
+    {
+        if (!hasPrevious[s])
+        {
+            trace(s);
+        }
+    }
+    for (std::uint32_t s = 0; s < segments.size(); ++s)
+    {
+        if (!visited[s])
+        {
+            trace(s);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief 数値をバイナリとしてストリームへ書き出す
+ */
+template <typename T>
+void writeValue(std::ofstream &file, const T &value)
+{
+    file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+void writeBinary(std::ofstream &file, const std::vector<SliceLayer> &layers)
+{
+    file.write(SLICE_FILE_MAGIC.data(), SLICE_FILE_MAGIC.size());
+    writeValue(file, SLICE_FILE_VERSION);
+    writeValue(file, static_cast<std::uint32_t>(layers.size()));
+    for (const auto &layer : layers)
+    {
+        writeValue(file, layer.z);
+        writeValue(file, static_cast<std::uint32_t>(layer.contours.size()));
+        for (const auto &contour : layer.contours)
+        {
+            writeValue(file, static_cast<std::uint32_t>(contour.points.size()));
+            writeValue(file, static_cast<std::uint32_t>(contour.closed ? 1 : 0));
+            file.write(reinterpret_cast<const char *>(contour.points.data()),
+                       static_cast<std::streamsize>(contour.points.size() * sizeof(glm::vec2)));
+        }
+    }
+}
+
+void writeSvg(std::ofstream &file, const std::vector<SliceLayer> &layers)
+{
+    // 全層の輪郭を囲む範囲を viewBox にする（SVGはY軸が下向きのため反転する）
+    auto low = glm::vec2{std::numeric_limits<float>::max()};
+    auto high = glm::vec2{std::numeric_limits<float>::lowest()};
+    for (const auto &layer : layers)
+    {
+        for (const auto &contour : layer.contours)
+        {
+            for (const auto &point : contour.points)
+            {
+                low = glm::min(low, point);
+                high = glm::max(high, point);
+            }
+        }
+    }
+    if (low.x > high.x)
+    {
+        low = high = glm::vec2{0.0f};
+    }
+
+    file << "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"" << low.x - SVG_MARGIN << " "
+         << -high.y - SVG_MARGIN << " " << high.x - low.x + 2 * SVG_MARGIN << " " << high.y - low.y + 2 * SVG_MARGIN
+         << "\">\n";
+    for (std::size_t i = 0; i < layers.size(); ++i)
+    {
+        file << "  <g id=\"layer-" << i << "\" data-z=\"" << layers[i].z << "\" fill=\"none\" stroke=\"black\" "
+             << "stroke-width=\"" << SVG_STROKE_WIDTH << "\">\n";
+        for (const auto &contour : layers[i].contours)
+        {
+            file << "    <path d=\"";
+            for (std::size_t p = 0; p < contour.points.size(); ++p)
+            {
+                file << (p == 0 ? "M" : " L") << contour.points[p].x << " " << -contour.points[p].y;
+            }
+            file << (contour.closed ? " Z" : "") << "\"/>\n";
+        }
+        file << "  </g>\n";
+    }
+    file << "</svg>\n";
+}
+} // namespace
+
+std::vector<SliceLayer> sliceMesh(const IndexedMesh &mesh, std::size_t layerCount)
+{
+    auto layers = std::vector<SliceLayer>(layerCount);
+    if (layerCount == 0 || mesh.positions.empty())
+    {
+        return layers;
+    }
+
+    auto [lowest, highest] = std::minmax_element(
+        mesh.positions.begin(), mesh.positions.end(),
+        [](const glm::vec3 &lhs, const glm::vec3 &rhs) { return lhs.z < rhs.z; });
+    auto bottom = lowest->z;
+    auto layerHeight = std::max((highest->z - bottom) / static_cast<float>(layerCount),
+                                std::numeric_limits<float>::min());
+
+    auto index = buildLayerIndex(mesh, layerCount, bottom, layerHeight);
+
+    // 層ごとに独立なので並列に処理する
+    parallel::forEach(
+        layerCount,
+        [&](std::size_t layer) {
+            auto z = bottom + (static_cast<float>(layer) + 0.5f) * layerHeight;
+            layers[layer] = sliceLayer(mesh, index, layer, z);
+        },
+        1);
+
+    return layers;
+}
+
+bool writeSliceFile(const std::filesystem::path &path, const std::vector<SliceLayer> &layers,
+                    std::string &errorMessage)
+{
+    auto isSvg = path.extension() == SVG_EXTENSION;
+    auto file = std::ofstream{path, isSvg ? std::ios::out | std::ios::trunc
+                                          : std::ios::out | std::ios::binary | std::ios::trunc};
+    if (!file.is_open())
+    {
+        errorMessage = "Cannot open slice output file: " + path.string();
+        return false;
+    }
+
+    if (isSvg)
+    {
+        writeSvg(file, layers);
+    }
+    else
+    {
+        writeBinary(file, layers);
+    }
+
+    if (!file)
+    {
+        errorMessage = "Failed to write slice output file: " + path.string();
+        return false;
+    }
+    return true;
+}
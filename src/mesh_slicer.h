@@ -0,0 +1,70 @@
+/**
+ * @file mesh_slicer.h
+ * @brief Z方向の平面によるスライスと層ごとの輪郭生成
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+struct IndexedMesh;
+
+/**
+ * @brief 1つの輪郭（多角形または折れ線）
+ *
+ * 外向きに向きの揃った閉じたメッシュでは、+Z 側から見て外周は反時計回り、
+ * 穴は時計回りになる。
+ */
+struct SliceContour {
+    std::vector<glm::vec2> points;  ///< 頂点のXY座標（閉じている場合も始点は繰り返さない）
+    bool closed;                    ///< 始点に戻って閉じているか（開いたメッシュでは false になり得る）
+};
+
+/**
+ * @brief 1つの層の輪郭
+ */
+struct SliceLayer {
+    float z;                              ///< スライス平面の高さ
+    std::vector<SliceContour> contours;   ///< 層の輪郭
+};
+
+/**
+ * @brief メッシュをZ方向に等間隔の平面でスライスする
+ *
+ * 1. 三角形ごとに交差する層の範囲を求め、層ごとの三角形リスト（区間インデックス）を構築する。
+ * 2. 層ごとに並列に三角形と平面の交線（線分）を求める。交点は辺の2頂点から常に同じ順序で
+ *    補間するため、辺を共有する三角形は完全に同じ交点を得る。
+ * 3. 線分の終点を辺キーのハッシュで次の線分の始点と結合し、輪郭につなげる。
+ *
+ * 平面上にちょうど乗る頂点は平面より上にあるとみなすため、交点が頂点に重なる
+ * 特殊ケースの処理は不要である。
+ *
+ * @param mesh 溶接済みのインデックス付きメッシュ（orientMesh() で向きを修正済みであること）
+ * @param layerCount 層数（層 i の高さは Zの範囲を layerCount 等分した区間の中央）
+ * @return 下から順に並んだ層
+ */
+std::vector<SliceLayer> sliceMesh(const IndexedMesh& mesh, std::size_t layerCount);
+
+/**
+ * @brief スライス結果をファイルに書き出す
+ *
+ * 拡張子が ".svg" の場合は層ごとの &lt;g&gt; 要素を持つSVG、それ以外は
+ * 以下のリトルエンディアンのバイナリ輪郭ファイルとして書き出す。
+ *
+ * - ヘッダー: マジック "SLCB"、形式バージョン（uint32）、層数（uint32）
+ * - 層ごと: 高さ（float）、輪郭数（uint32）
+ * - 輪郭ごと: 頂点数（uint32）、閉じているか（uint32、0/1）、頂点XY（float × 2 × 頂点数）
+ *
+ * @param path 出力ファイルのパス
+ * @param layers スライス結果
+ * @param errorMessage [out] 失敗時のエラーメッセージ
+ * @return 書き込み成功時はtrue、失敗時はfalse
+ */
+bool writeSliceFile(const std::filesystem::path& path, const std::vector<SliceLayer>& layers,
+                    std::string& errorMessage);
@@ -0,0 +1,602 @@
+#include "mesh_synthetic.h"
+#include "mesh_hash.h"
+#include "model_loader.h"
+#include "parallel.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+// 内部定数定義
+namespace
+{
+constexpr int TRIANGLE_VERTICES{3};                  // 三角形の頂点数
+constexpr std::uint64_t SHARING_STEPS{1024};         // 頂点を共有する割合の分解能
+constexpr std::uint64_t SHELL_GAP{2};                // 隣り合うシェルの間隔（格子のセル数）
+constexpr float WAVE_AMPLITUDE{0.05f};               // 格子の高さ方向の波の振幅（格子幅1に対する値）
+constexpr float WAVE_FREQUENCY{0.3f};                // 格子の波の周波数（セルあたりのラジアン）
+constexpr float SURFACE_JITTER{0.02f};               // シードで決まる頂点の高さの揺らぎの幅
+constexpr std::uint64_t JITTER_STREAM{0x6A09E667F3BCC909ull};    // 頂点の揺らぎの乱数系列
+constexpr std::uint64_t PATHOLOGY_STREAM{0xBB67AE8584CAA73Bull}; // 病的な三角形の選択の乱数系列
+constexpr double UNIT_SCALE{1.0 / 9007199254740992.0};           // 53ビットの整数を [0, 1) に写す係数
+constexpr std::size_t STL_HEADER_SIZE{80};           // バイナリSTLのヘッダーのバイト数
+constexpr std::size_t WRITE_BUFFER_SIZE{1 << 20};    // ファイル書き出し時のバッファのバイト数
+constexpr std::uint32_t GLB_MAGIC{0x46546C67};       // GLB のマジックナンバー（"glTF"）
+constexpr std::uint32_t GLB_VERSION{2};              // GLB のバージョン
+constexpr std::uint32_t GLB_JSON_CHUNK{0x4E4F534A};  // JSON チャンクの種類（"JSON"）
+constexpr std::uint32_t GLB_BIN_CHUNK{0x004E4942};   // バイナリチャンクの種類（"BIN\0"）
+constexpr std::uint64_t GLB_HEADER_SIZE{12};         // GLB のファイルヘッダーのバイト数
+constexpr std::uint64_t GLB_CHUNK_HEADER_SIZE{8};    // GLB のチャンクヘッダーのバイト数
+constexpr std::uint64_t GLB_ALIGNMENT{4};            // GLB のチャンクの境界
+constexpr std::uint64_t MAX_PLY_VERTICES{std::numeric_limits<std::int32_t>::max()}; // PLY の頂点番号（int）の上限
+constexpr std::uint64_t MAX_UINT32{std::numeric_limits<std::uint32_t>::max()};      // 32ビットの上限
+
+/**
+ * @brief シードと系列から番号ごとの一様乱数 [0, 1) を求める
+ */
+double unitRandom(std::uint64_t seed, std::uint64_t stream, std::uint64_t index)
+{
+    return static_cast<double>(mixHash64(mixHash64(seed ^ stream) + index) >> 11) * UNIT_SCALE;
+}
+
+/**
+ * @brief 三角形の単位法線を求める（面積0・非有限値の場合は零ベクトル）
+ */
+glm::vec3 faceNormal(const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c)
+{
+    auto normal = glm::cross(b - a, c - a);
+    auto length = glm::length(normal);
+    return length > 0.0f && std::isfinite(length) ? normal / length : glm::vec3{0.0f};
+}
+
+/**
+ * @brief 有限な頂点のバウンディングボックス（並列リダクション用）
+ */
+struct VertexBounds {
+    glm::vec3 minimum;
+    glm::vec3 maximum;
+};
+
+/**
+ * @brief バッファリングしてファイルへ書き出す
+ */
+class BufferedWriter {
+public:
+    explicit BufferedWriter(const std::filesystem::path &path) : file{path, std::ios::binary | std::ios::trunc}
+    {
+        buffer.reserve(WRITE_BUFFER_SIZE);
+    }
+
+    bool isOpen() const { return file.is_open(); }
+
+    void write(const void *data, std::size_t size)
+    {
+        if (buffer.size() + size > WRITE_BUFFER_SIZE)
+        {
+            flush();
+        }
+        buffer.insert(buffer.end(), static_cast<const char *>(data), static_cast<const char *>(data) + size);
+    }
+
+    template <typename T>
+    void value(const T &data)
+    {
+        write(&data, sizeof(data));
+    }
+
+    void text(std::string_view value) { write(value.data(), value.size()); }
+
+    template <typename T>
+    void number(T value)
+    {
+        auto digits = std::array<char, 32>{};
+        auto result = std::to_chars(digits.data(), digits.data() + digits.size(), value);
+        write(digits.data(), static_cast<std::size_t>(result.ptr - digits.data()));
+    }
+
+    void vector(const glm::vec3 &value)
+    {
+        number(value.x);
+        text(" ");
+        number(value.y);
+        text(" ");
+        number(value.z);
+    }
+
+    bool flush()
+    {
+        file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+        return file.good();
+    }
+
+private:
+    std::ofstream file;
+    std::vector<char> buffer;
+};
+
+void writeBinaryStl(const SyntheticMesh &mesh, BufferedWriter &writer)
+{
+    // "solid" で始まるヘッダーは ASCII STL と誤判定する読み込み処理の検証用
+    auto header = std::array<char, STL_HEADER_SIZE>{};
+    auto title = std::string_view{mesh.getSettings().solidHeader ? "solid synthetic (binary)" : "synthetic binary stl"};
+    std::memcpy(header.data(), title.data(), title.size());
+    writer.write(header.data(), header.size());
+    writer.value(static_cast<std::uint32_t>(mesh.triangleCount()));
+    for (std::uint64_t t = 0; t < mesh.triangleCount(); ++t)
+    {
+        auto corners = mesh.triangle(t);
+        auto a = mesh.vertex(corners[0]);
+        auto b = mesh.vertex(corners[1]);
+        auto c = mesh.vertex(corners[2]);
+        writer.value(faceNormal(a, b, c));
+        writer.value(a);
+        writer.value(b);
+        writer.value(c);
+        writer.value(std::uint16_t{0});
+    }
+}
+
+void writeAsciiStl(const SyntheticMesh &mesh, BufferedWriter &writer)
+{
+    writer.text("solid synthetic\n");
+    for (std::uint64_t t = 0; t < mesh.triangleCount(); ++t)
+    {
+        auto corners = mesh.triangle(t);
+        auto a = mesh.vertex(corners[0]);
+        auto b = mesh.vertex(corners[1]);
+        auto c = mesh.vertex(corners[2]);
+        writer.text("facet normal ");
+        writer.vector(faceNormal(a, b, c));
+        writer.text("\nouter loop\n");
+        for (const auto &vertex : {a, b, c})
+        {
+            writer.text("vertex ");
+            writer.vector(vertex);
+            writer.text("\n");
+        }
+        writer.text("endloop\nendfacet\n");
+    }
+    writer.text("endsolid synthetic\n");
+}
+
+void writeObj(const SyntheticMesh &mesh, BufferedWriter &writer)
+{
+    for (std::uint64_t v = 0; v < mesh.vertexCount(); ++v)
+    {
+        writer.text("v ");
+        writer.vector(mesh.vertex(v));
+        writer.text("\n");
+    }
+    for (std::uint64_t t = 0; t < mesh.triangleCount(); ++t)
+    {
+        writer.text("f");
+        for (auto index : mesh.triangle(t))
+        {
+            writer.text(" ");
+            writer.number(index + 1); // OBJ は1始まり
+        }
+        writer.text("\n");
+    }
+}
+
+void writeBinaryPly(const SyntheticMesh &mesh, BufferedWriter &writer)
+{
+    writer.text("ply\nformat binary_little_endian 1.0\nelement vertex ");
+    writer.number(mesh.vertexCount());
+    writer.text("\nproperty float x\nproperty float y\nproperty float z\nelement face ");
+    writer.number(mesh.triangleCount());
+    writer.text("\nproperty list uchar int vertex_indices\nend_header\n");
+    for (std::uint64_t v = 0; v < mesh.vertexCount(); ++v)
+    {
+        writer.value(mesh.vertex(v));
+    }
+    for (std::uint64_t t = 0; t < mesh.triangleCount(); ++t)
+    {
+        writer.value(static_cast<std::uint8_t>(TRIANGLE_VERTICES));
+        for (auto index : mesh.triangle(t))
+        {
+            writer.value(static_cast<std::int32_t>(index));
+        }
+    }
+}
+
+/**
+ * @brief glTF の min/max に使う有限な頂点のバウンディングボックスを求める
+ */
+VertexBounds finiteBounds(const SyntheticMesh &mesh)
+{
+    auto empty = VertexBounds{glm::vec3{std::numeric_limits<float>::max()}, glm::vec3{std::numeric_limits<float>::lowest()}};
+    auto bounds = parallel::reduce(
+        static_cast<std::size_t>(mesh.vertexCount()), empty,
+        [&](std::size_t begin, std::size_t end) {
+            auto partial = empty;
+            for (auto v = begin; v < end; ++v)
+            {
+                auto position = mesh.vertex(v);
+                if (std::isfinite(position.x) && std::isfinite(position.y) && std::isfinite(position.z))
+                {
+                    partial.minimum = glm::min(partial.minimum, position);
+                    partial.maximum = glm::max(partial.maximum, position);
+                }
+            }
+            return partial;
+        },
+        [](VertexBounds lhs, const VertexBounds &rhs) {
+            lhs.minimum = glm::min(lhs.minimum, rhs.minimum);
+            lhs.maximum = glm::max(lhs.maximum, rhs.maximum);
+            return lhs;
+        });
+    return bounds.minimum.x <= bounds.maximum.x ? bounds : VertexBounds{glm::vec3{0.0f}, glm::vec3{0.0f}};
+}
+
+/**
+ * @brief 数値を JSON の配列要素として追加する
+ */
+void appendJsonVector(std::string &json, const glm::vec3 &value)
+{
+    json += "[";
+    for (int i = 0; i < 3; ++i)
+    {
+        auto digits = std::array<char, 32>{};
+        auto result = std::to_chars(digits.data(), digits.data() + digits.size(), value[i]);
+        json.append(digits.data(), result.ptr);
+        json += i + 1 < 3 ? "," : "]";
+    }
+}
+
+/**
+ * @brief GLB（glTF 2.0 バイナリ）の JSON チャンクを作成する（4バイト境界まで空白で埋める）
+ */
+std::string makeGlbJson(const SyntheticMesh &mesh, std::uint64_t positionBytes, std::uint64_t indexBytes)
+{
+    auto bounds = finiteBounds(mesh);
+    auto json = std::string{R"({"asset":{"version":"2.0","generator":"stl_corpus"},"scene":0,"scenes":[{"nodes":[0]}],)"};
+    json += R"("nodes":[{"mesh":0}],"meshes":[{"primitives":[{"attributes":{"POSITION":0},"indices":1}]}],)";
+    json += R"("buffers":[{"byteLength":)" + std::to_string(positionBytes + indexBytes) + "}],";
+    json += R"("bufferViews":[{"buffer":0,"byteOffset":0,"byteLength":)" + std::to_string(positionBytes) +
+            R"(,"target":34962},{"buffer":0,"byteOffset":)" + std::to_string(positionBytes) +
+            R"(,"byteLength":)" + std::to_string(indexBytes) + R"(,"target":34963}],)";
+    json += R"("accessors":[{"bufferView":0,"componentType":5126,"count":)" + std::to_string(mesh.vertexCount()) +
+            R"(,"type":"VEC3","min":)";
+    appendJsonVector(json, bounds.minimum);
+    json += R"(,"max":)";
+    appendJsonVector(json, bounds.maximum);
+    json += R"(},{"bufferView":1,"componentType":5125,"count":)" +
+            std::to_string(mesh.triangleCount() * TRIANGLE_VERTICES) + R"(,"type":"SCALAR"}]})";
+    json.resize((json.size() + GLB_ALIGNMENT - 1) / GLB_ALIGNMENT * GLB_ALIGNMENT, ' ');
+    return json;
+}
+
+void writeGlb(const SyntheticMesh &mesh, const std::string &json, BufferedWriter &writer)
+{
+    auto positionBytes = mesh.vertexCount() * sizeof(glm::vec3);
+    auto indexBytes = mesh.triangleCount() * TRIANGLE_VERTICES * sizeof(std::uint32_t);
+    writer.value(GLB_MAGIC);
+    writer.value(GLB_VERSION);
+    writer.value(static_cast<std::uint32_t>(GLB_HEADER_SIZE + 2 * GLB_CHUNK_HEADER_SIZE + json.size() + positionBytes +
+                                            indexBytes));
+    writer.value(static_cast<std::uint32_t>(json.size()));
+    writer.value(GLB_JSON_CHUNK);
+    writer.text(json);
+
+    // 頂点座標・頂点番号ともに4バイト単位のため、バイナリチャンクの埋め草は不要
+    writer.value(static_cast<std::uint32_t>(positionBytes + indexBytes));
+    writer.value(GLB_BIN_CHUNK);
+    for (std::uint64_t v = 0; v < mesh.vertexCount(); ++v)
+    {
+        writer.value(mesh.vertex(v));
+    }
+    for (std::uint64_t t = 0; t < mesh.triangleCount(); ++t)
+    {
+        for (auto index : mesh.triangle(t))
+        {
+            writer.value(static_cast<std::uint32_t>(index));
+        }
+    }
+}
+} // namespace
+
+SyntheticMesh::SyntheticMesh(const SyntheticSettings &settings) : settings{settings}
+{
+    auto &adjusted = this->settings;
+    adjusted.vertexSharing = std::clamp(adjusted.vertexSharing, 0.0f, 1.0f);
+    adjusted.degenerateRatio = std::clamp(adjusted.degenerateRatio, 0.0f, 1.0f);
+    adjusted.nonFiniteRatio = std::clamp(adjusted.nonFiniteRatio, 0.0f, 1.0f);
+    adjusted.shellCount = std::clamp<std::uint64_t>(adjusted.shellCount, 1, std::max<std::uint64_t>(1, adjusted.triangleCount));
+
+    // 三角形をシェルに均等に割り振る（先頭のシェルから余りを1つずつ多く持つ）
+    auto shells = adjusted.shellCount;
+    largeShellCount = adjusted.triangleCount % shells;
+    smallShell = makeLayout(adjusted.triangleCount / shells);
+    largeShell = makeLayout(adjusted.triangleCount / shells + 1);
+    while (shellsPerRow * shellsPerRow < shells)
+    {
+        ++shellsPerRow;
+    }
+    gridVertices = largeShellCount * largeShell.vertices + (shells - largeShellCount) * smallShell.vertices;
+
+    // 頂点を共有しない三角形は一定の比率で均等に散らす（番号から専用の頂点の位置を O(1) で求めるため）
+    privatePerStep = static_cast<std::uint64_t>(
+        std::llround((1.0 - static_cast<double>(adjusted.vertexSharing)) * static_cast<double>(SHARING_STEPS)));
+    privateVertices = privateTrianglesBefore(adjusted.triangleCount) * TRIANGLE_VERTICES;
+    hasNonFiniteVertex = adjusted.nonFiniteRatio > 0.0f && adjusted.triangleCount > 0;
+}
+
+SyntheticMesh::ShellLayout SyntheticMesh::makeLayout(std::uint64_t triangles)
+{
+    if (triangles == 0)
+    {
+        return {};
+    }
+    auto quads = (triangles + 1) / 2;
+    auto columns = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(std::sqrt(static_cast<double>(quads)))));
+    auto rows = (quads + columns - 1) / columns;
+    return ShellLayout{triangles, columns, (columns + 1) * (rows + 1)};
+}
+
+SyntheticMesh::ShellLocation SyntheticMesh::locateTriangle(std::uint64_t index) const
+{
+    auto boundary = largeShellCount * largeShell.triangles;
+    auto location = ShellLocation{};
+    if (index < boundary)
+    {
+        location.shell = index / largeShell.triangles;
+        location.local = index % largeShell.triangles;
+        location.layout = &largeShell;
+    }
+    else
+    {
+        location.shell = largeShellCount + (index - boundary) / smallShell.triangles;
+        location.local = (index - boundary) % smallShell.triangles;
+        location.layout = &smallShell;
+    }
+    location.firstVertex = shellFirstVertex(location.shell);
+    return location;
+}
+
+SyntheticMesh::ShellLocation SyntheticMesh::locateVertex(std::uint64_t index) const
+{
+    auto boundary = largeShellCount * largeShell.vertices;
+    auto location = ShellLocation{};
+    if (index < boundary)
+    {
+        location.shell = index / largeShell.vertices;
+        location.local = index % largeShell.vertices;
+        location.layout = &largeShell;
+    }
+    else
+    {
+        location.shell = largeShellCount + (index - boundary) / smallShell.vertices;
+        location.local = (index - boundary) % smallShell.vertices;
+        location.layout = &smallShell;
+    }
+    location.firstVertex = index - location.local;
+    return location;
+}
+
+std::uint64_t SyntheticMesh::shellFirstVertex(std::uint64_t shell) const
+{
+    if (shell < largeShellCount)
+    {
+        return shell * largeShell.vertices;
+    }
+    return largeShellCount * largeShell.vertices + (shell - largeShellCount) * smallShell.vertices;
+}
+
+std::array<std::uint64_t, 3> SyntheticMesh::gridTriangle(std::uint64_t index) const
+{
+    auto location = locateTriangle(index);
+    auto columns = location.layout->columns;
+    auto quad = location.local / 2;
+    auto row = quad / columns;
+    auto column = quad % columns;
+    auto vertex = [&](std::uint64_t r, std::uint64_t c) { return location.firstVertex + r * (columns + 1) + c; };
+    if (location.local % 2 == 0)
+    {
+        return {vertex(row, column), vertex(row, column + 1), vertex(row + 1, column + 1)};
+    }
+    return {vertex(row, column), vertex(row + 1, column + 1), vertex(row + 1, column)};
+}
+
+glm::vec3 SyntheticMesh::gridVertex(std::uint64_t index) const
+{
+    // シェルは三角形が多い方の格子の大きさに間隔を加えた升目に正方形状に並べる
+    auto location = locateVertex(index);
+    auto stride = location.layout->columns + 1;
+    auto spacing = largeShell.columns + SHELL_GAP;
+    auto x = static_cast<float>(location.shell % shellsPerRow * spacing + location.local % stride);
+    auto y = static_cast<float>(location.shell / shellsPerRow * spacing + location.local / stride);
+    auto jitter = static_cast<float>(unitRandom(settings.seed, JITTER_STREAM, index) - 0.5) * SURFACE_JITTER;
+    auto z = WAVE_AMPLITUDE * std::sin(x * WAVE_FREQUENCY) * std::cos(y * WAVE_FREQUENCY) + jitter;
+    return {x, y, z};
+}
+
+std::uint64_t SyntheticMesh::privateTrianglesBefore(std::uint64_t index) const
+{
+    return index * privatePerStep / SHARING_STEPS;
+}
+
+glm::vec3 SyntheticMesh::vertex(std::uint64_t index) const
+{
+    if (index < gridVertices)
+    {
+        return gridVertex(index);
+    }
+    if (index < gridVertices + privateVertices)
+    {
+        // 専用の頂点は対応する格子の頂点と同じ座標にする
+        auto offset = index - gridVertices;
+        auto ordinal = offset / TRIANGLE_VERTICES;
+        auto triangleIndex = ((ordinal + 1) * SHARING_STEPS + privatePerStep - 1) / privatePerStep - 1;
+        return gridVertex(gridTriangle(triangleIndex)[offset % TRIANGLE_VERTICES]);
+    }
+    return {std::numeric_limits<float>::quiet_NaN(), 0.0f, 0.0f};
+}
+
+std::array<std::uint64_t, 3> SyntheticMesh::triangle(std::uint64_t index) const
+{
+    auto corners = gridTriangle(index);
+    if (privateTrianglesBefore(index + 1) > privateTrianglesBefore(index))
+    {
+        auto first = gridVertices + privateTrianglesBefore(index) * TRIANGLE_VERTICES;
+        corners = {first, first + 1, first + 2};
+    }
+
+    // 病的な三角形は共有の有無とは独立に選ぶ（NaN の頂点は全ての該当三角形で共有する）
+    auto random = unitRandom(settings.seed, PATHOLOGY_STREAM, index);
+    if (random < settings.nonFiniteRatio)
+    {
+        corners[0] = gridVertices + privateVertices;
+    }
+    else if (random < static_cast<double>(settings.nonFiniteRatio) + settings.degenerateRatio)
+    {
+        corners[1] = corners[0];
+    }
+    return corners;
+}
+
+std::optional<SyntheticFormat> parseSyntheticFormat(std::string_view name)
+{
+    if (name == "stl")
+    {
+        return SyntheticFormat::BinaryStl;
+    }
+    if (name == "stl-ascii")
+    {
+        return SyntheticFormat::AsciiStl;
+    }
+    if (name == "obj")
+    {
+        return SyntheticFormat::Obj;
+    }
+    if (name == "ply")
+    {
+        return SyntheticFormat::BinaryPly;
+    }
+    if (name == "glb")
+    {
+        return SyntheticFormat::Glb;
+    }
+    return std::nullopt;
+}
+
+std::string_view syntheticFormatExtension(SyntheticFormat format)
+{
+    switch (format)
+    {
+    case SyntheticFormat::BinaryStl:
+    case SyntheticFormat::AsciiStl:
+        return ".stl";
+    case SyntheticFormat::Obj:
+        return ".obj";
+    case SyntheticFormat::BinaryPly:
+        return ".ply";
+    case SyntheticFormat::Glb:
+        return ".glb";
+    }
+    return {};
+}
+
+std::string syntheticSettingsTag(const SyntheticSettings &settings)
+{
+    // 割合は最短の往復可能な表記にする（"0.5", "1e-05" など、ファイル名に使えない文字を含まない）
+    auto ratio = [](float value) {
+        auto digits = std::array<char, 32>{};
+        auto result = std::to_chars(digits.data(), digits.data() + digits.size(), value);
+        return std::string(digits.data(), result.ptr);
+    };
+    auto tag = "v" + std::to_string(SYNTHETIC_GENERATOR_VERSION) + "_seed" + std::to_string(settings.seed) + "_t" +
+               std::to_string(settings.triangleCount) + "_shells" + std::to_string(settings.shellCount) + "_sharing" +
+               ratio(settings.vertexSharing) + "_degenerate" + ratio(settings.degenerateRatio) + "_nan" +
+               ratio(settings.nonFiniteRatio);
+    if (settings.solidHeader)
+    {
+        tag += "_solid";
+    }
+    return tag;
+}
+
+bool writeSyntheticMesh(const SyntheticMesh &mesh, SyntheticFormat format, const std::filesystem::path &path,
+                        std::string &errorMessage)
+{
+    // 形式ごとの上限を書き出し前に確認する
+    auto json = std::string{};
+    if (format == SyntheticFormat::BinaryStl && mesh.triangleCount() > MAX_UINT32)
+    {
+        errorMessage = "Binary STL cannot store more than 2^32-1 triangles";
+        return false;
+    }
+    if (format == SyntheticFormat::BinaryPly && mesh.vertexCount() > MAX_PLY_VERTICES)
+    {
+        errorMessage = "PLY output is limited to 2^31-1 vertices (int vertex indices)";
+        return false;
+    }
+    if (format == SyntheticFormat::Glb)
+    {
+        auto positionBytes = mesh.vertexCount() * sizeof(glm::vec3);
+        auto indexBytes = mesh.triangleCount() * TRIANGLE_VERTICES * sizeof(std::uint32_t);
+        if (mesh.triangleCount() == 0 || mesh.vertexCount() > MAX_UINT32)
+        {
+            errorMessage = "GLB output requires 1 to 2^32 vertices and at least one triangle";
+            return false;
+        }
+        json = makeGlbJson(mesh, positionBytes, indexBytes);
+        if (GLB_HEADER_SIZE + 2 * GLB_CHUNK_HEADER_SIZE + json.size() + positionBytes + indexBytes > MAX_UINT32)
+        {
+            errorMessage = "GLB output cannot exceed 4 GiB";
+            return false;
+        }
+    }
+
+    auto writer = BufferedWriter{path};
+    if (!writer.isOpen())
+    {
+        errorMessage = "Cannot open output file: " + path.string();
+        return false;
+    }
+
+    switch (format)
+    {
+    case SyntheticFormat::BinaryStl:
+        writeBinaryStl(mesh, writer);
+        break;
+    case SyntheticFormat::AsciiStl:
+        writeAsciiStl(mesh, writer);
+        break;
+    case SyntheticFormat::Obj:
+        writeObj(mesh, writer);
+        break;
+    case SyntheticFormat::BinaryPly:
+        writeBinaryPly(mesh, writer);
+        break;
+    case SyntheticFormat::Glb:
+        writeGlb(mesh, json, writer);
+        break;
+    }
+
+    if (!writer.flush())
+    {
+        errorMessage = "Failed to write output file: " + path.string();
+        return false;
+    }
+    return true;
+}
+
+void expandSyntheticMesh(const SyntheticMesh &mesh, ModelMesh &model)
+{
+    model.triangles.resize(static_cast<std::size_t>(mesh.triangleCount()));
+    parallel::forEach(model.triangles.size(), [&](std::size_t t) {
+        auto &triangle = model.triangles[t];
+        auto corners = mesh.triangle(t);
+        for (int i = 0; i < TRIANGLE_VERTICES; ++i)
+        {
+            triangle.vertices[i] = mesh.vertex(corners[i]);
+        }
+        triangle.normal = faceNormal(triangle.vertices[0], triangle.vertices[1], triangle.vertices[2]);
+    });
+}
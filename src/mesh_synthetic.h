@@ -0,0 +1,194 @@
+/**
+ * @file mesh_synthetic.h
+ * @brief シードから決定的に生成する合成メッシュと各形式への書き出し（読み込み・ベンチマークの検証用）
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <glm/glm.hpp>
+
+struct ModelMesh;
+
+/// 合成メッシュの既定のシード
+constexpr std::uint64_t DEFAULT_SYNTHETIC_SEED{1};
+
+/// 生成手順の版（同じ設定から生成される内容が変わる変更をしたら上げる）
+constexpr int SYNTHETIC_GENERATOR_VERSION{1};
+
+/**
+ * @brief 合成メッシュの生成設定
+ */
+struct SyntheticSettings {
+    std::uint64_t seed = DEFAULT_SYNTHETIC_SEED; ///< 乱数のシード（頂点の揺らぎ・病的な三角形の選択が決まる）
+    std::uint64_t triangleCount = 0;             ///< 三角形数（病的な三角形を含めた正確な数）
+    std::uint64_t shellCount = 1;                ///< 互いに離れたシェル（格子の面）の数
+    float vertexSharing = 1.0f;                  ///< 頂点を隣接三角形と共有する三角形の割合（0でトライアングルスープ）
+    float degenerateRatio = 0.0f;                ///< 面積0（2頂点が同一）にする三角形の割合
+    float nonFiniteRatio = 0.0f;                 ///< 頂点座標に NaN を含める三角形の割合
+    bool solidHeader = false;                    ///< バイナリSTLのヘッダーを "solid" で始める（ASCIIと誤判定されやすい）
+};
+
+/**
+ * @brief 合成メッシュの書き出し形式
+ */
+enum class SyntheticFormat {
+    BinaryStl,
+    AsciiStl,
+    Obj,
+    BinaryPly,
+    Glb
+};
+
+/**
+ * @brief 手続き的に定義した合成メッシュ
+ *
+ * 各シェルは波打つ正方形に近い格子で、セルを2つの三角形に分割する。
+ * 頂点・三角形は番号から O(1) で求まるため、全体をメモリに置かずに1億三角形以上を書き出せる。
+ * 頂点を共有しない三角形は格子の頂点と同じ座標の専用の頂点を持つ（溶接で元の格子に戻る）。
+ * 同じ設定からは常に同じメッシュが得られる。
+ *
+ * 頂点の並びは [格子の頂点][共有しない三角形の専用の頂点][NaN の頂点（nonFiniteRatio > 0 の場合のみ）]。
+ * 格子の頂点は全ての三角形が共有しない場合も出力するため、共有の割合が低いほど未参照の頂点が増える。
+ */
+class SyntheticMesh {
+public:
+    /**
+     * @brief 設定からメッシュの形状を決める
+     *
+     * shellCount は 1 以上かつ三角形数以下に、各割合は [0, 1] に丸める。
+     *
+     * @param settings 生成設定
+     */
+    explicit SyntheticMesh(const SyntheticSettings& settings);
+
+    /**
+     * @brief 頂点数を取得する
+     */
+    std::uint64_t vertexCount() const noexcept { return gridVertices + privateVertices + (hasNonFiniteVertex ? 1 : 0); }
+
+    /**
+     * @brief 三角形数を取得する
+     */
+    std::uint64_t triangleCount() const noexcept { return settings.triangleCount; }
+
+    /**
+     * @brief 生成設定を取得する
+     */
+    const SyntheticSettings& getSettings() const noexcept { return settings; }
+
+    /**
+     * @brief 頂点座標を求める
+     *
+     * @param index 頂点番号（vertexCount() 未満）
+     * @return 頂点座標
+     */
+    glm::vec3 vertex(std::uint64_t index) const;
+
+    /**
+     * @brief 三角形の頂点番号を求める
+     *
+     * @param index 三角形番号（triangleCount() 未満）
+     * @return 3つの頂点番号（反時計回り）
+     */
+    std::array<std::uint64_t, 3> triangle(std::uint64_t index) const;
+
+private:
+    /**
+     * @brief 同じ三角形数のシェルに共通する格子の寸法
+     */
+    struct ShellLayout {
+        std::uint64_t triangles = 0; ///< シェルの三角形数
+        std::uint64_t columns = 0;   ///< 格子のセルの列数
+        std::uint64_t vertices = 0;  ///< 格子の頂点数
+    };
+
+    /**
+     * @brief 通し番号に対応するシェルとシェル内の番号
+     */
+    struct ShellLocation {
+        std::uint64_t shell = 0;             ///< シェル番号
+        std::uint64_t local = 0;             ///< シェル内の番号
+        std::uint64_t firstVertex = 0;       ///< シェルの最初の格子の頂点番号
+        const ShellLayout* layout = nullptr; ///< シェルの格子の寸法
+    };
+
+    static ShellLayout makeLayout(std::uint64_t triangles);
+    ShellLocation locateTriangle(std::uint64_t index) const;
+    ShellLocation locateVertex(std::uint64_t index) const;
+    std::uint64_t shellFirstVertex(std::uint64_t shell) const;
+    std::array<std::uint64_t, 3> gridTriangle(std::uint64_t index) const;
+    glm::vec3 gridVertex(std::uint64_t index) const;
+    std::uint64_t privateTrianglesBefore(std::uint64_t index) const;
+
+    SyntheticSettings settings;
+    ShellLayout largeShell;            ///< 三角形が1つ多いシェル（先頭の largeShellCount 個）
+    ShellLayout smallShell;            ///< 残りのシェル
+    std::uint64_t largeShellCount = 0; ///< 三角形が1つ多いシェルの数
+    std::uint64_t shellsPerRow = 1;    ///< シェルを並べる正方形の1辺のシェル数
+    std::uint64_t privatePerStep = 0;  ///< 頂点を共有しない三角形の比率（SHARING_STEPS 分の1単位）
+    std::uint64_t gridVertices = 0;    ///< 全シェルの格子の頂点数
+    std::uint64_t privateVertices = 0; ///< 共有しない三角形の専用の頂点数
+    bool hasNonFiniteVertex = false;   ///< NaN の頂点を持つか
+};
+
+/**
+ * @brief 形式名（"stl", "stl-ascii", "obj", "ply", "glb"）から書き出し形式を求める
+ *
+ * @param name 形式名
+ * @return 書き出し形式（不明な名前の場合は std::nullopt）
+ */
+std::optional<SyntheticFormat> parseSyntheticFormat(std::string_view name);
+
+/**
+ * @brief 書き出し形式の標準の拡張子を取得する
+ *
+ * @param format 書き出し形式
+ * @return ドットを含む拡張子
+ */
+std::string_view syntheticFormatExtension(SyntheticFormat format);
+
+/**
+ * @brief 生成設定の全ての値と生成手順の版を並べたファイル名用の文字列を作る
+ *
+ * 書き出したファイルを再利用する際、ファイル名が一致すれば内容も一致するよう
+ * 生成結果に影響する値を全て含める（例: "v1_seed1_t1000_shells1_sharing1_degenerate0_nan0"）。
+ *
+ * @param settings 生成設定
+ * @return ファイル名に使える文字列
+ */
+std::string syntheticSettingsTag(const SyntheticSettings& settings);
+
+/**
+ * @brief 合成メッシュをファイルに書き出す
+ *
+ * 頂点・三角形を番号順に求めながらバッファリングして書き出すため、メッシュの大きさによらず
+ * 使用メモリは一定。STL の法線は面から計算し、面積0・NaN の三角形は零ベクトルとする。
+ * 各形式の上限（PLY・GLB は頂点番号が32ビット、GLB はファイル全体が4GiB）を超える場合は失敗する。
+ *
+ * @param mesh 合成メッシュ
+ * @param format 書き出し形式
+ * @param path 出力先
+ * @param errorMessage [out] 失敗時のエラーメッセージ
+ * @return 書き出しに成功した場合はtrue
+ */
+bool writeSyntheticMesh(const SyntheticMesh& mesh, SyntheticFormat format, const std::filesystem::path& path,
+                        std::string& errorMessage);
+
+/**
+ * @brief 合成メッシュを読み込み結果と同じ三角形配列に展開する
+ *
+ * ファイルを介さずに読み込み後の段階を計測・検証するために使う。展開は並列に行い、
+ * 法線は writeSyntheticMesh() と同じく面から計算する。中心・スケール等は設定しない。
+ *
+ * @param mesh 合成メッシュ
+ * @param model [out] 展開先（triangles のみを置き換える）
+ */
+void expandSyntheticMesh(const SyntheticMesh& mesh, ModelMesh& model);
@@ -0,0 +1,80 @@
+#include "mesh_thickness.h"
+#include "mesh_bvh.h"
+#include "mesh_topology.h"
+#include "model_loader.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+
+// 内部定数定義
+namespace
+{
+constexpr int TRIANGLE_VERTICES{3}; // 三角形の頂点数
+constexpr std::size_t RAY_MIN_CHUNK{1024}; // 1スレッドあたりの最小光線数
+constexpr float UNMEASURED{std::numeric_limits<float>::infinity()};
+} // namespace
+
+WallThickness computeWallThickness(const IndexedMesh &mesh, const MeshBvh &bvh)
+{
+    auto result = WallThickness{};
+    auto triangleCount = mesh.triangleCount();
+    result.triangleThickness.assign(triangleCount, UNMEASURED);
+    result.vertexThickness.assign(mesh.positions.size(), UNMEASURED);
+
+    // 三角形ごとに重心から内側へ光線を飛ばす（自分自身との交差は除外する）
+    // BVH の葉の順に処理し、隣り合う光線が同じノードをたどるようにしてキャッシュの局所性を高める
+    parallel::forEach(
+        triangleCount,
+        [&](std::size_t leafPosition) {
+            auto t = static_cast<std::size_t>(bvh.triangleIds[leafPosition]);
+            const auto &a = mesh.positions[mesh.indices[t * TRIANGLE_VERTICES]];
+            const auto &b = mesh.positions[mesh.indices[t * TRIANGLE_VERTICES + 1]];
+            const auto &c = mesh.positions[mesh.indices[t * TRIANGLE_VERTICES + 2]];
+            auto normal = glm::cross(b - a, c - a);
+            auto length = glm::length(normal);
+            if (!(length > 0.0f))
+            {
+                return;
+            }
+
+            auto centroid = (a + b + c) / 3.0f;
+            auto hit = intersectRay(bvh, centroid, -normal / length, UNMEASURED, static_cast<std::uint32_t>(t));
+            if (!hit.hit())
+            {
+                return;
+            }
+
+            result.triangleThickness[t] = hit.distance;
+        },
+        RAY_MIN_CHUNK);
+
+    // 頂点の肉厚は接する三角形の最小値（頂点単位で並列）
+    auto vertexCorners = buildVertexCorners(mesh);
+    parallel::forEach(mesh.positions.size(), [&](std::size_t v) {
+        auto thickness = UNMEASURED;
+        for (auto i = vertexCorners.cornerOffsets[v]; i < vertexCorners.cornerOffsets[v + 1]; ++i)
+        {
+            thickness = std::min(thickness, result.triangleThickness[vertexCorners.corners[i] / TRIANGLE_VERTICES]);
+        }
+        result.vertexThickness[v] = thickness;
+    });
+
+    // 測定できた値の統計
+    auto measured = std::vector<float>{};
+    measured.reserve(triangleCount);
+    std::copy_if(result.triangleThickness.begin(), result.triangleThickness.end(), std::back_inserter(measured),
+                 [](float thickness) { return thickness != UNMEASURED; });
+    result.unmeasuredTriangles = triangleCount - measured.size();
+    if (!measured.empty())
+    {
+        auto middle = measured.begin() + static_cast<std::ptrdiff_t>(measured.size() / 2);
+        std::nth_element(measured.begin(), middle, measured.end());
+        result.median = *middle;
+        auto [minimum, maximum] = std::minmax_element(measured.begin(), measured.end());
+        result.minimum = *minimum;
+        result.maximum = *maximum;
+    }
+    return result;
+}
@@ -0,0 +1,42 @@
+/**
+ * @file mesh_thickness.h
+ * @brief BVH の光線追跡による肉厚解析
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+struct IndexedMesh;
+struct MeshBvh;
+
+/**
+ * @brief 肉厚解析の結果
+ *
+ * 反対側の面が見つからない三角形・頂点の値は無限大となる。
+ */
+struct WallThickness {
+    std::vector<float> triangleThickness;  ///< 三角形ごとの肉厚
+    std::vector<float> vertexThickness;    ///< 頂点ごとの肉厚（接する三角形の最小値）
+    float minimum = 0.0f;                  ///< 測定できた肉厚の最小値
+    float median = 0.0f;                   ///< 測定できた肉厚の中央値
+    float maximum = 0.0f;                  ///< 測定できた肉厚の最大値
+    std::size_t unmeasuredTriangles = 0;   ///< 反対側の面が見つからなかった三角形数
+};
+
+/**
+ * @brief 三角形ごとの肉厚を光線追跡で求める
+ *
+ * 各三角形の重心から法線の逆方向（内側）へ光線を飛ばし、最初に交差する面までの距離を
+ * その三角形の肉厚とする。三角形ごとの光線は BVH を共有して並列に追跡する。
+ * 頂点の値は接する三角形の最小値（薄い箇所を見逃さない側）とする。
+ *
+ * @param mesh 対象のメッシュ（orientMesh() で外向きに揃えてあること）
+ * @param bvh mesh から buildMeshBvh() で構築した BVH
+ * @return 肉厚解析の結果
+ * @note 開いたメッシュや内向きの面では、反対側の面が見つからないか、値が意味を持たない
+ */
+WallThickness computeWallThickness(const IndexedMesh& mesh, const MeshBvh& bvh);
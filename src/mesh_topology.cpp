@@ -0,0 +1,326 @@
+#include "mesh_topology.h"
+#include "model_loader.h"
+#include "parallel.h"
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <span>
+#include <utility>
+
+// 内部定数定義
+namespace
+{
+constexpr int TRIANGLE_VERTICES{3};             // 三角形の頂点数
+constexpr std::size_t SMALL_FAN_TRIANGLES{16};  // 扇の数え上げで総当たりの比較を使う頂点の三角形数の上限
+
+/**
+ * @brief 2頂点から無向辺キーを作る
+ */
+inline std::uint64_t edgeKey(std::uint32_t a, std::uint32_t b)
+{
+    auto low = std::min(a, b);
+    auto high = std::max(a, b);
+    return (static_cast<std::uint64_t>(low) << 32) | high;
+}
+
+/**
+ * @brief 辺の分類ごとの集計（並列リダクション用）
+ */
+struct EdgeCounts {
+    std::size_t boundary;
+    std::size_t nonManifold;
+    std::size_t inconsistent;
+};
+
+/**
+ * @brief 頂点ごとに、その頂点を使う三角形の残り2頂点（次の頂点・前の頂点）をまとめた表
+ *
+ * 扇の数え上げで三角形を引き直さずに済むよう、buildVertexCorners() の角の番号の代わりに
+ * 相手の頂点を直接振り分ける。
+ */
+struct VertexLinks {
+    std::vector<std::uint32_t> offsets;                           ///< 頂点 v の区間 [offsets[v], offsets[v+1])
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> others;  ///< 角ごとの {次の頂点, 前の頂点}
+};
+
+/**
+ * @brief 頂点ごとの相手の頂点の表を構築する（計数ソート）
+ */
+VertexLinks buildVertexLinks(const IndexedMesh &mesh)
+{
+    auto links = VertexLinks{};
+    const auto &indices = mesh.indices;
+    links.offsets.assign(mesh.positions.size() + 1, 0);
+    for (auto vertex : indices)
+    {
+        ++links.offsets[vertex + 1];
+    }
+    for (std::size_t v = 0; v < mesh.positions.size(); ++v)
+    {
+        links.offsets[v + 1] += links.offsets[v];
+    }
+
+    links.others.resize(indices.size());
+    auto next = std::vector<std::uint32_t>(links.offsets.begin(), links.offsets.end() - 1);
+    for (std::size_t t = 0; t < mesh.triangleCount(); ++t)
+    {
+        auto a = indices[t * TRIANGLE_VERTICES];
+        auto b = indices[t * TRIANGLE_VERTICES + 1];
+        auto c = indices[t * TRIANGLE_VERTICES + 2];
+        links.others[next[a]++] = {b, c};
+        links.others[next[b]++] = {c, a};
+        links.others[next[c]++] = {a, b};
+    }
+    return links;
+}
+
+/**
+ * @brief 素集合の代表を求める（経路を半分に縮約する）
+ */
+inline std::uint32_t findRoot(std::uint32_t *parents, std::uint32_t node)
+{
+    while (parents[node] != node)
+    {
+        node = parents[node] = parents[parents[node]];
+    }
+    return node;
+}
+
+/**
+ * @brief 頂点の周りの三角形が、その頂点を含む辺でつながってできる扇の数を数える
+ *
+ * 同じ相手の頂点を持つ（頂点を含む同じ辺を共有する）三角形同士を素集合で併合する。
+ * 閉じた面の大半の頂点は辺を順にたどるだけで1つの扇と分かるため、先にそれを試す。
+ * 通常の頂点は三角形数が少ないため総当たりで比較し、SMALL_FAN_TRIANGLES を超える頂点のみ
+ * 相手の頂点でソートしてから比較する。
+ *
+ * @param others 頂点の角ごとの {次の頂点, 前の頂点}
+ * @param sorted 作業領域（相手の頂点と区間内の三角形の番号）
+ * @param parents 作業領域（素集合の親）
+ * @return 扇の数
+ */
+std::size_t countVertexFans(std::span<const std::pair<std::uint32_t, std::uint32_t>> others,
+                            std::vector<std::pair<std::uint32_t, std::uint32_t>> &sorted,
+                            std::vector<std::uint32_t> &parents)
+{
+    auto fans = others.size();
+    if (others.size() <= SMALL_FAN_TRIANGLES)
+    {
+        // 向きの揃った内部の頂点では、次の頂点が前の頂点に一致する三角形を順にたどると全ての三角形を1周する
+        auto current = std::size_t{0};
+        auto steps = std::size_t{0};
+        do
+        {
+            auto following = std::find_if(others.begin(), others.end(), [&](const auto &other) {
+                return other.second == others[current].first;
+            });
+            if (following == others.end())
+            {
+                break;
+            }
+            current = static_cast<std::size_t>(following - others.begin());
+            ++steps;
+        } while (current != 0 && steps < others.size());
+        if (current == 0 && steps == others.size())
+        {
+            return 1;
+        }
+
+        auto roots = std::array<std::uint32_t, SMALL_FAN_TRIANGLES>{};
+        for (std::uint32_t i = 0; i < others.size(); ++i)
+        {
+            roots[i] = i;
+            for (std::uint32_t j = 0; j < i; ++j)
+            {
+                const auto &[next, previous] = others[i];
+                if (next != others[j].first && next != others[j].second && previous != others[j].first &&
+                    previous != others[j].second)
+                {
+                    continue;
+                }
+                auto a = findRoot(roots.data(), i);
+                auto b = findRoot(roots.data(), j);
+                if (a != b)
+                {
+                    roots[std::max(a, b)] = std::min(a, b);
+                    --fans;
+                }
+            }
+        }
+        return fans;
+    }
+
+    sorted.clear();
+    for (std::uint32_t local = 0; local < others.size(); ++local)
+    {
+        sorted.emplace_back(others[local].first, local);
+        sorted.emplace_back(others[local].second, local);
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    parents.resize(others.size());
+    std::iota(parents.begin(), parents.end(), 0u);
+    for (std::size_t i = 1; i < sorted.size(); ++i)
+    {
+        if (sorted[i].first != sorted[i - 1].first)
+        {
+            continue;
+        }
+        auto a = findRoot(parents.data(), sorted[i - 1].second);
+        auto b = findRoot(parents.data(), sorted[i].second);
+        if (a != b)
+        {
+            parents[std::max(a, b)] = std::min(a, b);
+            --fans;
+        }
+    }
+    return fans;
+}
+} // namespace
+
+EdgeTable buildEdgeTable(const IndexedMesh &mesh)
+{
+    auto table = EdgeTable{};
+    const auto &indices = mesh.indices;
+    auto triangleCount = mesh.triangleCount();
+
+    // 1. ハーフエッジを生成（並列）
+    table.halfEdges.resize(triangleCount * TRIANGLE_VERTICES);
+    parallel::forEach(triangleCount, [&](std::size_t t) {
+        for (std::uint32_t corner = 0; corner < TRIANGLE_VERTICES; ++corner)
+        {
+            auto from = indices[t * TRIANGLE_VERTICES + corner];
+            auto to = indices[t * TRIANGLE_VERTICES + (corner + 1) % TRIANGLE_VERTICES];
+            table.halfEdges[t * TRIANGLE_VERTICES + corner] =
+                HalfEdge{edgeKey(from, to), static_cast<std::uint32_t>(t), corner};
+        }
+    });
+
+    // 2. 無向辺キーで並列ソート（同キー内は三角形順で決定的にする）
+    parallel::sort(table.halfEdges.begin(), table.halfEdges.end(), [](const HalfEdge &lhs, const HalfEdge &rhs) {
+        return lhs.key != rhs.key ? lhs.key < rhs.key : lhs.triangle < rhs.triangle;
+    });
+
+    // 3. キーが変わる位置を辺の開始位置として記録
+    const auto &halfEdges = table.halfEdges;
+    for (std::uint32_t i = 0; i < halfEdges.size(); ++i)
+    {
+        if (i == 0 || halfEdges[i].key != halfEdges[i - 1].key)
+        {
+            table.edgeOffsets.push_back(i);
+        }
+    }
+    table.edgeOffsets.push_back(static_cast<std::uint32_t>(halfEdges.size()));
+
+    return table;
+}
+
+VertexCorners buildVertexCorners(const IndexedMesh &mesh)
+{
+    auto table = VertexCorners{};
+    const auto &indices = mesh.indices;
+    table.cornerOffsets.assign(mesh.positions.size() + 1, 0);
+    for (auto vertex : indices)
+    {
+        ++table.cornerOffsets[vertex + 1];
+    }
+    for (std::size_t v = 0; v < mesh.positions.size(); ++v)
+    {
+        table.cornerOffsets[v + 1] += table.cornerOffsets[v];
+    }
+
+    // 角の順に振り分けるため、頂点ごとの区間内は昇順になる
+    table.corners.resize(indices.size());
+    auto next = std::vector<std::uint32_t>(table.cornerOffsets.begin(), table.cornerOffsets.end() - 1);
+    for (std::uint32_t corner = 0; corner < indices.size(); ++corner)
+    {
+        table.corners[next[indices[corner]]++] = corner;
+    }
+    return table;
+}
+
+TopologyReport analyzeTopology(const IndexedMesh &mesh, const EdgeTable &edges)
+{
+    auto report = TopologyReport{};
+    report.edgeCount = edges.edgeCount();
+
+    // 辺ごとに分類して集計（並列）
+    auto counts = parallel::reduce(
+        edges.edgeCount(), EdgeCounts{},
+        [&](std::size_t begin, std::size_t end) {
+            auto partial = EdgeCounts{};
+            for (auto e = begin; e < end; ++e)
+            {
+                auto valence = edges.edgeValence(e);
+                if (valence == 1)
+                {
+                    ++partial.boundary;
+                }
+                else if (valence > 2)
+                {
+                    ++partial.nonManifold;
+                }
+                else
+                {
+                    // 整合した向きでは、2つの三角形は共有辺を逆向きにたどる
+                    const auto &first = edges.halfEdges[edges.edgeOffsets[e]];
+                    const auto &second = edges.halfEdges[edges.edgeOffsets[e] + 1];
+                    if (halfEdgeOrigin(mesh.indices, first) == halfEdgeOrigin(mesh.indices, second))
+                    {
+                        ++partial.inconsistent;
+                    }
+                }
+            }
+            return partial;
+        },
+        [](EdgeCounts lhs, const EdgeCounts &rhs) {
+            lhs.boundary += rhs.boundary;
+            lhs.nonManifold += rhs.nonManifold;
+            lhs.inconsistent += rhs.inconsistent;
+            return lhs;
+        });
+
+    report.boundaryEdges = counts.boundary;
+    report.nonManifoldEdges = counts.nonManifold;
+    report.inconsistentEdges = counts.inconsistent;
+
+    // 頂点ごとに扇の数を数える（並列、2つ以上に分かれる頂点は非多様体）
+    auto links = buildVertexLinks(mesh);
+    report.nonManifoldVertices = parallel::reduce(
+        mesh.positions.size(), std::size_t{0},
+        [&](std::size_t begin, std::size_t end) {
+            auto partial = std::size_t{0};
+            auto sorted = std::vector<std::pair<std::uint32_t, std::uint32_t>>{};
+            auto parents = std::vector<std::uint32_t>{};
+            for (auto v = begin; v < end; ++v)
+            {
+                auto first = links.others.data() + links.offsets[v];
+                auto count = links.offsets[v + 1] - links.offsets[v];
+                if (count > 1 && countVertexFans({first, count}, sorted, parents) > 1)
+                {
+                    ++partial;
+                }
+            }
+            return partial;
+        },
+        [](std::size_t lhs, std::size_t rhs) { return lhs + rhs; });
+
+    // 問題のある辺の頂点を収集（オーバーレイ描画用、件数は通常少ない）
+    report.boundaryEdgeVertices.reserve(counts.boundary * 2);
+    report.nonManifoldEdgeVertices.reserve(counts.nonManifold * 2);
+    for (std::size_t e = 0; e < edges.edgeCount(); ++e)
+    {
+        auto valence = edges.edgeValence(e);
+        if (valence == 2)
+        {
+            continue;
+        }
+
+        const auto &halfEdge = edges.halfEdges[edges.edgeOffsets[e]];
+        auto &output = valence == 1 ? report.boundaryEdgeVertices : report.nonManifoldEdgeVertices;
+        output.push_back(halfEdge.lowVertex());
+        output.push_back(halfEdge.highVertex());
+    }
+
+    return report;
+}
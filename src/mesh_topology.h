@@ -0,0 +1,140 @@
+/**
+ * @file mesh_topology.h
+ * @brief 辺テーブルの構築と水密性・多様体性の解析
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct IndexedMesh;
+
+/**
+ * @brief 三角形の1辺（ハーフエッジ）
+ *
+ * 三角形 triangle の角 corner から角 (corner + 1) % 3 へ向かう辺を表す。
+ */
+struct HalfEdge {
+    std::uint64_t key;       ///< 無向辺のキー（小さい頂点インデックス << 32 | 大きい頂点インデックス）
+    std::uint32_t triangle;  ///< 所属する三角形のインデックス
+    std::uint32_t corner;    ///< 辺の始点となる角（0〜2）
+
+    /**
+     * @brief 無向辺の小さい方の頂点インデックスを取得する
+     */
+    std::uint32_t lowVertex() const noexcept { return static_cast<std::uint32_t>(key >> 32); }
+
+    /**
+     * @brief 無向辺の大きい方の頂点インデックスを取得する
+     */
+    std::uint32_t highVertex() const noexcept { return static_cast<std::uint32_t>(key); }
+};
+
+/**
+ * @brief 無向辺ごとにハーフエッジをまとめた辺テーブル
+ *
+ * ハーフエッジは (key, triangle) 順にソートされており、同じ無向辺を共有する
+ * ハーフエッジは edgeOffsets で示される連続区間に並ぶ。
+ * std::map を使わず、並列ソートのみで構築する。
+ */
+struct EdgeTable {
+    std::vector<HalfEdge> halfEdges;          ///< ソート済みハーフエッジ（三角形数 × 3）
+    std::vector<std::uint32_t> edgeOffsets;   ///< 無向辺 e のハーフエッジ区間 [edgeOffsets[e], edgeOffsets[e+1])
+
+    /**
+     * @brief 無向辺の数を取得する
+     */
+    std::size_t edgeCount() const noexcept { return edgeOffsets.empty() ? 0 : edgeOffsets.size() - 1; }
+
+    /**
+     * @brief 無向辺を共有する三角形の数を取得する
+     */
+    std::uint32_t edgeValence(std::size_t edge) const noexcept { return edgeOffsets[edge + 1] - edgeOffsets[edge]; }
+};
+
+/**
+ * @brief 頂点ごとに、その頂点を使う三角形の角をまとめた表
+ *
+ * 角の番号は三角形のインデックス × 3 + 角（indices の位置）で、頂点ごとに昇順に並ぶ。
+ * 頂点への加算を角の順に行えば、並列に処理しても結果が実行ごとに変わらない。
+ */
+struct VertexCorners {
+    std::vector<std::uint32_t> cornerOffsets;  ///< 頂点 v の角の区間 [cornerOffsets[v], cornerOffsets[v+1])
+    std::vector<std::uint32_t> corners;        ///< 角の番号（頂点ごとに昇順）
+};
+
+/**
+ * @brief 水密性・多様体性の解析結果
+ */
+struct TopologyReport {
+    std::size_t edgeCount;            ///< 無向辺の数
+    std::size_t boundaryEdges;        ///< 1つの三角形にのみ属する辺（穴の縁）の数
+    std::size_t nonManifoldEdges;     ///< 3つ以上の三角形に共有される辺の数
+    std::size_t inconsistentEdges;    ///< 2つの三角形が同じ向きにたどる（向きが不整合な）辺の数
+    std::size_t nonManifoldVertices;  ///< 周りの三角形が複数の扇に分かれる頂点（蝶ネクタイ状の頂点）の数
+
+    std::vector<std::uint32_t> boundaryEdgeVertices;     ///< 境界辺の頂点インデックス（2つで1辺）
+    std::vector<std::uint32_t> nonManifoldEdgeVertices;  ///< 非多様体辺の頂点インデックス（2つで1辺）
+
+    /**
+     * @brief 3つ以上の三角形に共有される辺が無く、各頂点の周りの三角形が1つの扇につながっているか（多様体か）
+     *
+     * 境界辺は許容する（境界を持つ多様体も多様体とみなす）。
+     */
+    bool isManifold() const noexcept { return nonManifoldEdges == 0 && nonManifoldVertices == 0; }
+
+    /**
+     * @brief 境界辺・非多様体辺が無いか（水密か）
+     *
+     * 頂点のみで接する閉じた部品も水密とみなす。
+     */
+    bool isClosed() const noexcept { return boundaryEdges == 0 && nonManifoldEdges == 0; }
+};
+
+/**
+ * @brief インデックス付きメッシュから辺テーブルを構築する
+ *
+ * 全三角形のハーフエッジを生成し、無向辺キーで並列ソートしてから
+ * 同一キーの区間を求める。
+ *
+ * @param mesh 溶接済みのインデックス付きメッシュ
+ * @return 辺テーブル
+ */
+EdgeTable buildEdgeTable(const IndexedMesh& mesh);
+
+/**
+ * @brief 頂点ごとの角の表を構築する
+ *
+ * 頂点ごとの角の数を数えてから角の順に振り分ける（計数ソート）。
+ *
+ * @param mesh インデックス付きメッシュ
+ * @return 頂点ごとの角の表
+ */
+VertexCorners buildVertexCorners(const IndexedMesh& mesh);
+
+/**
+ * @brief 辺テーブルから辺を分類し、水密性・多様体性を解析する
+ *
+ * 辺の分類に加えて、頂点ごとに周りの三角形を頂点を含む辺でつなぎ、扇の数を数える。
+ *
+ * @param mesh 溶接済みのインデックス付きメッシュ
+ * @param edges mesh から構築した辺テーブル
+ * @return 解析結果
+ */
+TopologyReport analyzeTopology(const IndexedMesh& mesh, const EdgeTable& edges);
+
+/**
+ * @brief ハーフエッジの始点の頂点インデックスを取得する
+ *
+ * @param indices インデックス付きメッシュのインデックス配列
+ * @param halfEdge 対象のハーフエッジ
+ * @return 始点の頂点インデックス
+ */
+inline std::uint32_t halfEdgeOrigin(const std::vector<std::uint32_t>& indices, const HalfEdge& halfEdge)
+{
+    return indices[static_cast<std::size_t>(halfEdge.triangle) * 3 + halfEdge.corner];
+}
@@ -0,0 +1,39 @@
+#include "mesh_vertices.h"
+#include "model_loader.h"
+#include <array>
+#include <boost/range/adaptor/transformed.hpp>
+#include <boost/range/algorithm/copy.hpp>
+
+// 内部定数定義
+namespace
+{
+constexpr int TRIANGLE_VERTICES{3}; // 三角形の頂点数
+} // namespace
+
+std::pmr::vector<float> createInterleavedVertices(const ModelMesh &mesh, const glm::vec3 &color,
+                                                  std::pmr::memory_resource *resource)
+{
+    // 3Dモデルデータを頂点配列に変換（位置3つ + 色3つ + 法線3つ = 9つの値）
+    // 最終サイズで一度だけ確保し、insertによる容量チェックを避けて直接書き込む
+    auto vertices = std::pmr::vector<float>{resource};
+    vertices.resize(mesh.triangles.size() * TRIANGLE_VERTICES * INTERLEAVED_VERTEX_COMPONENTS);
+    auto output = vertices.begin();
+
+    // 各三角形の頂点データをOpenGL用の配列形式に変換
+    for (const auto& triangle : mesh.triangles) {
+        auto vertexData = triangle.vertices 
+            | boost::adaptors::transformed([&triangle, &color](const auto& vertex) {
+                return std::array<float, INTERLEAVED_VERTEX_COMPONENTS>{
+                    vertex.x, vertex.y, vertex.z,                    // 位置
+                    color.x, color.y, color.z,                       // 色  
+                    triangle.normal.x, triangle.normal.y, triangle.normal.z  // 法線
+                };
+            });
+        
+        for (const auto& vertexArray : vertexData) {
+            output = boost::copy(vertexArray, output);
+        }
+    }
+
+    return vertices;
+}
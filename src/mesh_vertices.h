@@ -0,0 +1,32 @@
+/**
+ * @file mesh_vertices.h
+ * @brief 三角形メッシュから描画用のインターリーブ頂点配列への変換
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <memory_resource>
+#include <vector>
+#include <glm/glm.hpp>
+
+struct ModelMesh;
+
+/// インターリーブ頂点配列の1頂点あたりの要素数（位置3 + 色3 + 法線3）
+constexpr int INTERLEAVED_VERTEX_COMPONENTS{9};
+
+/**
+ * @brief 三角形メッシュを描画用のインターリーブ頂点配列に変換する
+ *
+ * 溶接しないメッシュをそのまま頂点バッファへ転送するために使う。各三角形の3頂点について
+ * 位置・色・面法線を並べる。最終サイズで一度だけ確保し、容量チェックなしで直接書き込む。
+ * ウィンドウやOpenGLコンテキストに依存しないため、ベンチマークからも直接呼び出せる。
+ *
+ * @param mesh 変換対象のメッシュ
+ * @param color 全頂点に設定する色
+ * @param resource 頂点配列の確保に使用するメモリリソース
+ * @return 三角形数 × 3 × INTERLEAVED_VERTEX_COMPONENTS 個の値
+ */
+std::pmr::vector<float> createInterleavedVertices(const ModelMesh& mesh, const glm::vec3& color,
+                                                  std::pmr::memory_resource* resource);
@@ -0,0 +1,427 @@
+#include "mesh_voxelizer.h"
+#include "model_loader.h"
+#include "parallel.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <span>
+#include <utility>
+
+// 内部定数定義
+namespace
+{
+constexpr int TRIANGLE_VERTICES{3}; // 三角形の頂点数
+constexpr int WORD_BITS{64};        // 1語あたりのボクセル数
+constexpr int SLAB_DEPTH{VOXEL_BRICK_SIZE}; // スラブの厚さ（ブリック1層分のZ層数）
+constexpr std::uint64_t BRICK_ROW_MASK{(1ull << VOXEL_BRICK_SIZE) - 1};
+
+/**
+ * @brief ボクセル単位に変換した三角形と、重なり判定用の前計算値
+ *
+ * ボクセル (x, y, z) は [x, x+1] × [y, y+1] × [z, z+1] の立方体となる。
+ * 判定は平面との重なりと、XY・YZ・ZX平面への投影での辺関数で行い、
+ * 分離軸判定（13軸）と同じ結果を乗算と加算のみで得る。
+ */
+struct TriangleSetup {
+    std::array<glm::dvec3, TRIANGLE_VERTICES> vertices;
+    glm::dvec3 normal;
+    double planeLow;   // 平面までの符号付き距離の下限側オフセット
+    double planeHigh;  // 平面までの符号付き距離の上限側オフセット
+    std::array<glm::dvec2, TRIANGLE_VERTICES> edgeNormalsXY;
+    std::array<glm::dvec2, TRIANGLE_VERTICES> edgeNormalsYZ;
+    std::array<glm::dvec2, TRIANGLE_VERTICES> edgeNormalsZX;
+    std::array<double, TRIANGLE_VERTICES> edgeOffsetsXY;
+    std::array<double, TRIANGLE_VERTICES> edgeOffsetsYZ;
+    std::array<double, TRIANGLE_VERTICES> edgeOffsetsZX;
+    glm::ivec3 minVoxel;
+    glm::ivec3 maxVoxel;
+};
+
+/**
+ * @brief 投影した辺関数の法線とオフセットを求める（ボクセルの最も内側の角で評価する）
+ */
+inline void setupProjectedEdge(const glm::dvec2 &edge, const glm::dvec2 &vertex, double sign, glm::dvec2 &normal,
+                               double &offset)
+{
+    normal = glm::dvec2{-edge.y, edge.x} * sign;
+    offset = -glm::dot(normal, vertex) + std::max(0.0, normal.x) + std::max(0.0, normal.y);
+}
+
+TriangleSetup setupTriangle(const ModelTriangle &triangle, const VoxelGridLayout &layout)
+{
+    auto setup = TriangleSetup{};
+    auto origin = glm::dvec3{layout.origin};
+    auto inverseSize = 1.0 / static_cast<double>(layout.voxelSize);
+    for (int i = 0; i < TRIANGLE_VERTICES; ++i)
+    {
+        setup.vertices[i] = (glm::dvec3{triangle.vertices[i]} - origin) * inverseSize;
+    }
+
+    const auto &v = setup.vertices;
+    auto edges = std::array<glm::dvec3, TRIANGLE_VERTICES>{v[1] - v[0], v[2] - v[1], v[0] - v[2]};
+    setup.normal = glm::cross(edges[0], edges[1]);
+
+    // 平面: ボクセルの対角の2頂点が平面の両側（または平面上）にあれば重なる
+    const auto &n = setup.normal;
+    auto critical = glm::dvec3{n.x > 0.0 ? 1.0 : 0.0, n.y > 0.0 ? 1.0 : 0.0, n.z > 0.0 ? 1.0 : 0.0};
+    setup.planeLow = glm::dot(n, critical - v[0]);
+    setup.planeHigh = glm::dot(n, glm::dvec3{1.0} - critical - v[0]);
+
+    auto signXY = n.z >= 0.0 ? 1.0 : -1.0;
+    auto signYZ = n.x >= 0.0 ? 1.0 : -1.0;
+    auto signZX = n.y >= 0.0 ? 1.0 : -1.0;
+    for (int i = 0; i < TRIANGLE_VERTICES; ++i)
+    {
+        setupProjectedEdge(glm::dvec2{edges[i].x, edges[i].y}, glm::dvec2{v[i].x, v[i].y}, signXY,
+                           setup.edgeNormalsXY[i], setup.edgeOffsetsXY[i]);
+        setupProjectedEdge(glm::dvec2{edges[i].y, edges[i].z}, glm::dvec2{v[i].y, v[i].z}, signYZ,
+                           setup.edgeNormalsYZ[i], setup.edgeOffsetsYZ[i]);
+        setupProjectedEdge(glm::dvec2{edges[i].z, edges[i].x}, glm::dvec2{v[i].z, v[i].x}, signZX,
+                           setup.edgeNormalsZX[i], setup.edgeOffsetsZX[i]);
+    }
+
+    auto low = glm::min(glm::min(v[0], v[1]), v[2]);
+    auto high = glm::max(glm::max(v[0], v[1]), v[2]);
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        auto last = layout.dimensions[axis] - 1;
+        setup.minVoxel[axis] = std::clamp(static_cast<int>(std::floor(low[axis])), 0, last);
+        setup.maxVoxel[axis] = std::clamp(static_cast<int>(std::floor(high[axis])), 0, last);
+    }
+    return setup;
+}
+
+/**
+ * @brief ボクセル単位の三角形の Z 範囲から、三角形が属するスラブの範囲を求める
+ */
+std::pair<std::int64_t, std::int64_t> slabRange(const ModelTriangle &triangle, const VoxelGridLayout &layout)
+{
+    auto low = std::min({triangle.vertices[0].z, triangle.vertices[1].z, triangle.vertices[2].z});
+    auto high = std::max({triangle.vertices[0].z, triangle.vertices[1].z, triangle.vertices[2].z});
+    auto toVoxel = [&layout](float z) {
+        auto voxel = std::floor((static_cast<double>(z) - layout.origin.z) / layout.voxelSize);
+        return std::clamp(static_cast<std::int64_t>(voxel), std::int64_t{0},
+                          static_cast<std::int64_t>(layout.dimensions.z) - 1);
+    };
+    return {toVoxel(low) / SLAB_DEPTH, toVoxel(high) / SLAB_DEPTH};
+}
+
+/**
+ * @brief 投影した辺関数を評価する
+ */
+inline bool insideEdges(const std::array<glm::dvec2, TRIANGLE_VERTICES> &normals,
+                        const std::array<double, TRIANGLE_VERTICES> &offsets, const glm::dvec2 &point)
+{
+    return glm::dot(normals[0], point) + offsets[0] >= 0.0 && glm::dot(normals[1], point) + offsets[1] >= 0.0 &&
+           glm::dot(normals[2], point) + offsets[2] >= 0.0;
+}
+
+/**
+ * @brief 三角形に触れるボクセルのビットを立てる（保守的な表面ボクセル化）
+ *
+ * @param rows スラブの先頭Z層からの行（Z層 × Y行 × wordsPerRow 語）
+ */
+void rasterizeSurface(const TriangleSetup &setup, int zBegin, int zEnd, int dimensionY, std::size_t wordsPerRow,
+                      std::span<std::uint64_t> rows)
+{
+    auto z0 = std::max(setup.minVoxel.z, zBegin);
+    auto z1 = std::min(setup.maxVoxel.z, zEnd - 1);
+    for (auto z = z0; z <= z1; ++z)
+    {
+        auto cornerZ = static_cast<double>(z);
+        for (auto y = setup.minVoxel.y; y <= setup.maxVoxel.y; ++y)
+        {
+            auto cornerY = static_cast<double>(y);
+
+            // YZ投影はX方向の行内で一定なので行ごとに1回だけ判定する
+            if (!insideEdges(setup.edgeNormalsYZ, setup.edgeOffsetsYZ, glm::dvec2{cornerY, cornerZ}))
+            {
+                continue;
+            }
+
+            auto row = rows.data() + (static_cast<std::size_t>(z - zBegin) * dimensionY + y) * wordsPerRow;
+            for (auto x = setup.minVoxel.x; x <= setup.maxVoxel.x; ++x)
+            {
+                auto cornerX = static_cast<double>(x);
+                auto distance = glm::dot(setup.normal, glm::dvec3{cornerX, cornerY, cornerZ});
+                auto crossesPlane = (distance + setup.planeLow) * (distance + setup.planeHigh) <= 0.0;
+                if (crossesPlane && insideEdges(setup.edgeNormalsXY, setup.edgeOffsetsXY, glm::dvec2{cornerX, cornerY}) &&
+                    insideEdges(setup.edgeNormalsZX, setup.edgeOffsetsZX, glm::dvec2{cornerZ, cornerX}))
+                {
+                    row[x / WORD_BITS] |= 1ull << (x % WORD_BITS);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief YZ投影した辺関数を評価する（共有辺上の点はちょうど一方の三角形にのみ含まれる）
+ *
+ * 辺の端点を常に同じ順序で使って計算するため、辺を共有する2つの三角形は
+ * 符号だけが異なる同一の値を得る。値が0の場合は内向き法線の向きで一方に決める。
+ */
+inline bool insideProjectedEdge(const glm::dvec2 &from, const glm::dvec2 &to, double orientation,
+                                const glm::dvec2 &point)
+{
+    auto swapped = std::make_pair(to.x, to.y) < std::make_pair(from.x, from.y);
+    const auto &a = swapped ? to : from;
+    const auto &b = swapped ? from : to;
+    auto value = ((b.x - a.x) * (point.y - a.y) - (b.y - a.y) * (point.x - a.x)) * (swapped ? -1.0 : 1.0);
+    value *= orientation;
+    if (value != 0.0)
+    {
+        return value > 0.0;
+    }
+
+    auto inward = glm::dvec2{-(to.y - from.y), to.x - from.x} * orientation;
+    return inward.x > 0.0 || (inward.x == 0.0 && inward.y > 0.0);
+}
+
+/**
+ * @brief 行内のボクセル first 以降のビットを反転する
+ */
+inline void flipFrom(std::uint64_t *row, int first, std::size_t wordsPerRow)
+{
+    auto word = static_cast<std::size_t>(first / WORD_BITS);
+    if (word >= wordsPerRow)
+    {
+        return;
+    }
+    row[word] ^= ~0ull << (first % WORD_BITS);
+    for (auto w = word + 1; w < wordsPerRow; ++w)
+    {
+        row[w] = ~row[w];
+    }
+}
+
+/**
+ * @brief X方向の光線と三角形の交点より先のボクセルを反転する（偶奇による内部塗りつぶし）
+ */
+void rasterizeParity(const TriangleSetup &setup, int zBegin, int zEnd, int dimensionX, int dimensionY,
+                     std::size_t wordsPerRow, std::span<std::uint64_t> rows)
+{
+    const auto &n = setup.normal;
+    if (n.x == 0.0)
+    {
+        return; // X方向の光線と平行
+    }
+
+    const auto &v = setup.vertices;
+    auto orientation = n.x > 0.0 ? 1.0 : -1.0;
+    auto projected = std::array<glm::dvec2, TRIANGLE_VERTICES>{glm::dvec2{v[0].y, v[0].z}, glm::dvec2{v[1].y, v[1].z},
+                                                              glm::dvec2{v[2].y, v[2].z}};
+    auto z0 = std::max(setup.minVoxel.z, zBegin);
+    auto z1 = std::min(setup.maxVoxel.z, zEnd - 1);
+    for (auto z = z0; z <= z1; ++z)
+    {
+        for (auto y = setup.minVoxel.y; y <= setup.maxVoxel.y; ++y)
+        {
+            auto center = glm::dvec2{y + 0.5, z + 0.5};
+            if (!insideProjectedEdge(projected[0], projected[1], orientation, center) ||
+                !insideProjectedEdge(projected[1], projected[2], orientation, center) ||
+                !insideProjectedEdge(projected[2], projected[0], orientation, center))
+            {
+                continue;
+            }
+
+            // 交点のX座標から、中心が交点より先にある最初のボクセルを求める
+            auto x = v[0].x - (n.y * (center.x - v[0].y) + n.z * (center.y - v[0].z)) / n.x;
+            auto first = std::clamp(static_cast<int>(std::floor(x - 0.5)) + 1, 0, dimensionX);
+            auto row = rows.data() + (static_cast<std::size_t>(z - zBegin) * dimensionY + y) * wordsPerRow;
+            flipFrom(row, first, wordsPerRow);
+        }
+    }
+}
+
+/**
+ * @brief グリッドの配置を決める
+ */
+VoxelGridLayout createLayout(const ModelMesh &mesh, const VoxelizeSettings &settings)
+{
+    auto layout = VoxelGridLayout{};
+    auto extent = mesh.max_bounds - mesh.min_bounds;
+    auto maxExtent = std::max({extent.x, extent.y, extent.z});
+    auto cells = std::max<std::uint32_t>(settings.resolution, 1);
+    auto padding = static_cast<int>(settings.padding);
+    layout.voxelSize = maxExtent > 0.0f ? maxExtent / static_cast<float>(cells) : 1.0f;
+    layout.origin = mesh.min_bounds - static_cast<float>(padding) * layout.voxelSize;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        auto count = static_cast<int>(std::ceil(extent[axis] / layout.voxelSize));
+        layout.dimensions[axis] = std::clamp(count, 1, static_cast<int>(cells)) + 2 * padding;
+    }
+    return layout;
+}
+
+/**
+ * @brief メッシュをスラブ単位で並列にボクセル化する
+ *
+ * @tparam SlabRows std::span<std::uint64_t>(std::size_t slab) 形式の関数（スラブの行の書き込み先）
+ * @tparam SlabDone void(std::size_t slab, std::span<const std::uint64_t> rows) 形式の関数
+ */
+template <typename SlabRows, typename SlabDone>
+void voxelizeSlabs(const ModelMesh &mesh, const VoxelGridLayout &layout, std::size_t wordsPerRow,
+                   const VoxelizeSettings &settings, SlabRows &&slabRows, SlabDone &&slabDone)
+{
+    auto solid = settings.solid;
+    const auto &dims = layout.dimensions;
+    auto slabCount = static_cast<std::size_t>((dims.z + SLAB_DEPTH - 1) / SLAB_DEPTH);
+    auto slabs = parallel::bucketRanges(mesh.triangles.size(), slabCount,
+                                        [&](std::size_t t) { return slabRange(mesh.triangles[t], layout); });
+
+    auto paddingMask = dims.x % WORD_BITS == 0 ? ~0ull : (1ull << (dims.x % WORD_BITS)) - 1;
+    parallel::forEach(
+        slabCount,
+        [&](std::size_t slab) {
+            auto zBegin = static_cast<int>(slab) * SLAB_DEPTH;
+            auto zEnd = std::min(zBegin + SLAB_DEPTH, dims.z);
+            auto rows = slabRows(slab);
+            auto interior = std::vector<std::uint64_t>(solid ? rows.size() : 0, 0);
+
+            for (auto i = slabs.offsets[slab]; i < slabs.offsets[slab + 1]; ++i)
+            {
+                auto setup = setupTriangle(mesh.triangles[slabs.items[i]], layout);
+                if (settings.surface)
+                {
+                    rasterizeSurface(setup, zBegin, zEnd, dims.y, wordsPerRow, rows);
+                }
+                if (solid)
+                {
+                    rasterizeParity(setup, zBegin, zEnd, dims.x, dims.y, wordsPerRow, interior);
+                }
+            }
+
+            // 内部と表面を合成し、行末の余りビットを消す
+            auto rowCount = rows.size() / wordsPerRow;
+            for (std::size_t r = 0; r < rowCount; ++r)
+            {
+                for (std::size_t w = 0; w < wordsPerRow; ++w)
+                {
+                    if (solid)
+                    {
+                        rows[r * wordsPerRow + w] |= interior[r * wordsPerRow + w];
+                    }
+                }
+                rows[r * wordsPerRow + wordsPerRow - 1] &= paddingMask;
+            }
+
+            slabDone(slab, rows);
+        },
+        1);
+}
+} // namespace
+
+std::size_t DenseVoxelGrid::count() const
+{
+    return parallel::reduce(
+        words.size(), std::size_t{0},
+        [this](std::size_t begin, std::size_t end) {
+            auto partial = std::size_t{0};
+            for (auto i = begin; i < end; ++i)
+            {
+                partial += static_cast<std::size_t>(std::popcount(words[i]));
+            }
+            return partial;
+        },
+        [](std::size_t lhs, std::size_t rhs) { return lhs + rhs; });
+}
+
+std::size_t SparseVoxelGrid::count() const
+{
+    auto total = std::size_t{0};
+    for (const auto &brick : bricks)
+    {
+        for (auto layer : brick.layers)
+        {
+            total += static_cast<std::size_t>(std::popcount(layer));
+        }
+    }
+    return total;
+}
+
+DenseVoxelGrid voxelizeDense(const ModelMesh &mesh, const VoxelizeSettings &settings)
+{
+    auto grid = DenseVoxelGrid{};
+    grid.layout = createLayout(mesh, settings);
+    const auto &dims = grid.layout.dimensions;
+    grid.wordsPerRow = static_cast<std::size_t>((dims.x + WORD_BITS - 1) / WORD_BITS);
+    auto wordsPerLayer = static_cast<std::size_t>(dims.y) * grid.wordsPerRow;
+    grid.words.assign(wordsPerLayer * dims.z, 0);
+
+    // スラブの行はグリッド内で重ならないため、直接書き込む
+    voxelizeSlabs(
+        mesh, grid.layout, grid.wordsPerRow, settings,
+        [&](std::size_t slab) {
+            auto zBegin = slab * SLAB_DEPTH;
+            auto zEnd = std::min<std::size_t>(zBegin + SLAB_DEPTH, dims.z);
+            return std::span<std::uint64_t>{grid.words.data() + zBegin * wordsPerLayer, (zEnd - zBegin) * wordsPerLayer};
+        },
+        [](std::size_t, std::span<const std::uint64_t>) {});
+
+    return grid;
+}
+
+SparseVoxelGrid voxelizeSparse(const ModelMesh &mesh, const VoxelizeSettings &settings)
+{
+    auto grid = SparseVoxelGrid{};
+    grid.layout = createLayout(mesh, settings);
+    const auto &dims = grid.layout.dimensions;
+    auto wordsPerRow = static_cast<std::size_t>((dims.x + WORD_BITS - 1) / WORD_BITS);
+    auto wordsPerLayer = static_cast<std::size_t>(dims.y) * wordsPerRow;
+    auto slabCount = static_cast<std::size_t>((dims.z + SLAB_DEPTH - 1) / SLAB_DEPTH);
+    auto bricksX = (dims.x + VOXEL_BRICK_SIZE - 1) / VOXEL_BRICK_SIZE;
+    auto bricksY = (dims.y + VOXEL_BRICK_SIZE - 1) / VOXEL_BRICK_SIZE;
+
+    // スラブごとの作業領域とブリック（スラブ順に連結して決定的な順序にする）
+    auto slabBuffers = std::vector<std::vector<std::uint64_t>>(slabCount);
+    auto slabBricks = std::vector<std::vector<std::pair<glm::ivec3, VoxelBrick>>>(slabCount);
+    voxelizeSlabs(
+        mesh, grid.layout, wordsPerRow, settings,
+        [&](std::size_t slab) {
+            auto zBegin = static_cast<int>(slab) * SLAB_DEPTH;
+            auto zEnd = std::min(zBegin + SLAB_DEPTH, dims.z);
+            slabBuffers[slab].assign(static_cast<std::size_t>(zEnd - zBegin) * wordsPerLayer, 0);
+            return std::span<std::uint64_t>{slabBuffers[slab]};
+        },
+        [&](std::size_t slab, std::span<const std::uint64_t> rows) {
+            auto layers = static_cast<int>(rows.size() / wordsPerLayer);
+            for (int by = 0; by < bricksY; ++by)
+            {
+                for (int bx = 0; bx < bricksX; ++bx)
+                {
+                    // ブリック幅は語のビット数を割り切るため、各行の8ビットは1語に収まる
+                    auto brick = VoxelBrick{};
+                    auto occupied = std::uint64_t{0};
+                    auto bitX = bx * VOXEL_BRICK_SIZE;
+                    for (int lz = 0; lz < layers; ++lz)
+                    {
+                        for (int ly = 0; ly < VOXEL_BRICK_SIZE && by * VOXEL_BRICK_SIZE + ly < dims.y; ++ly)
+                        {
+                            auto row = (static_cast<std::size_t>(lz) * dims.y + by * VOXEL_BRICK_SIZE + ly) * wordsPerRow;
+                            auto bits = (rows[row + bitX / WORD_BITS] >> (bitX % WORD_BITS)) & BRICK_ROW_MASK;
+                            brick.layers[lz] |= bits << (ly * VOXEL_BRICK_SIZE);
+                        }
+                        occupied |= brick.layers[lz];
+                    }
+                    if (occupied != 0)
+                    {
+                        slabBricks[slab].emplace_back(glm::ivec3{bx, by, static_cast<int>(slab)}, brick);
+                    }
+                }
+            }
+            slabBuffers[slab] = std::vector<std::uint64_t>{}; // 作業領域を解放
+        });
+
+    for (const auto &bricks : slabBricks)
+    {
+        for (const auto &[coordinates, brick] : bricks)
+        {
+            grid.brickIndex.emplace(SparseVoxelGrid::brickKey(coordinates.x, coordinates.y, coordinates.z),
+                                    static_cast<std::uint32_t>(grid.bricks.size()));
+            grid.brickCoordinates.push_back(coordinates);
+            grid.bricks.push_back(brick);
+        }
+    }
+    return grid;
+}
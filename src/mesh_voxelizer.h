@@ -0,0 +1,151 @@
+/**
+ * @file mesh_voxelizer.h
+ * @brief メッシュのボクセル化（表面・内部塗りつぶし、密なビット集合・疎なブリックマップ）
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+struct ModelMesh;
+
+/// ブリック（疎なボクセルグリッドの割り当て単位）1辺のボクセル数
+constexpr int VOXEL_BRICK_SIZE{8};
+
+/**
+ * @brief ボクセル化の設定
+ */
+struct VoxelizeSettings {
+    std::uint32_t resolution = 256;  ///< バウンディングボックスの最長辺方向のボクセル数
+    std::uint32_t padding = 0;       ///< バウンディングボックスの各面の外側に追加するボクセル数
+    bool surface = true;             ///< 三角形に触れるボクセルを含めるか
+    bool solid = true;               ///< 内部（中心がメッシュ内にあるボクセル）を含めるか（閉じたメッシュでのみ正しく塗りつぶされる）
+};
+
+/**
+ * @brief ボクセルグリッドの配置（ボクセル (x, y, z) は origin + (x, y, z) * voxelSize から1辺 voxelSize の立方体）
+ */
+struct VoxelGridLayout {
+    glm::ivec3 dimensions;  ///< 各軸のボクセル数
+    glm::vec3 origin;       ///< グリッドの最小座標
+    float voxelSize;        ///< ボクセル1辺の長さ
+
+    /**
+     * @brief ボクセルの中心座標を取得する
+     */
+    glm::vec3 voxelCenter(int x, int y, int z) const noexcept
+    {
+        return origin + (glm::vec3{static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)} + 0.5f) * voxelSize;
+    }
+
+    /**
+     * @brief ボクセル1つの体積を取得する
+     */
+    double voxelVolume() const noexcept { return static_cast<double>(voxelSize) * voxelSize * voxelSize; }
+};
+
+/**
+ * @brief 密なボクセルグリッド（1ボクセル1ビット）
+ *
+ * X方向の1行を64ビット語の列として持ち、行は (z, y) の順に並ぶ。
+ */
+struct DenseVoxelGrid {
+    VoxelGridLayout layout;
+    std::size_t wordsPerRow;            ///< 1行（X方向）あたりの64ビット語数
+    std::vector<std::uint64_t> words;   ///< ボクセルのビット列
+
+    /**
+     * @brief ボクセルが占有されているか判定する
+     */
+    bool test(int x, int y, int z) const noexcept
+    {
+        auto row = (static_cast<std::size_t>(z) * layout.dimensions.y + y) * wordsPerRow;
+        return (words[row + x / 64] >> (x % 64)) & 1u;
+    }
+
+    /**
+     * @brief 占有されているボクセル数を数える
+     */
+    std::size_t count() const;
+};
+
+/**
+ * @brief 1つのブリック（8×8×8 ボクセル、Z層ごとに64ビット語1つ、ビット位置は y * 8 + x）
+ */
+struct VoxelBrick {
+    std::array<std::uint64_t, VOXEL_BRICK_SIZE> layers;
+};
+
+/**
+ * @brief 疎なボクセルグリッド（占有ボクセルを含むブリックのみを保持）
+ *
+ * ブリックはブリック座標の (z, y, x) 順に並ぶ。
+ */
+struct SparseVoxelGrid {
+    VoxelGridLayout layout;
+    std::vector<glm::ivec3> brickCoordinates;                  ///< ブリックごとのブリック座標
+    std::vector<VoxelBrick> bricks;                            ///< ブリックのビット列
+    std::unordered_map<std::uint64_t, std::uint32_t> brickIndex; ///< ブリックキー → ブリック番号
+
+    /**
+     * @brief ブリック座標からブリックキーを作る
+     */
+    static std::uint64_t brickKey(int bx, int by, int bz) noexcept
+    {
+        return (static_cast<std::uint64_t>(bz) << 42) | (static_cast<std::uint64_t>(by) << 21) |
+               static_cast<std::uint64_t>(bx);
+    }
+
+    /**
+     * @brief ボクセルが占有されているか判定する
+     */
+    bool test(int x, int y, int z) const
+    {
+        auto found = brickIndex.find(brickKey(x / VOXEL_BRICK_SIZE, y / VOXEL_BRICK_SIZE, z / VOXEL_BRICK_SIZE));
+        if (found == brickIndex.end())
+        {
+            return false;
+        }
+        auto bit = (y % VOXEL_BRICK_SIZE) * VOXEL_BRICK_SIZE + x % VOXEL_BRICK_SIZE;
+        return (bricks[found->second].layers[z % VOXEL_BRICK_SIZE] >> bit) & 1u;
+    }
+
+    /**
+     * @brief 占有されているボクセル数を数える
+     */
+    std::size_t count() const;
+};
+
+/**
+ * @brief メッシュを密なボクセルグリッドに変換する
+ *
+ * 1. 三角形をZ方向のスラブ（ブリック1層分）ごとに振り分け、スラブ単位で並列に処理する。
+ * 2. 表面: 三角形のバウンディングボックス内のボクセルについて、三角形ごとに前計算した
+ *    平面と3方向の投影の辺関数で重なりを判定する（保守的: 三角形に触れるボクセルを全て含む）。
+ * 3. 内部: X方向のボクセル列の中心を通る光線と三角形の交点を求め、交点より先の
+ *    ボクセルのビットを反転する（偶奇判定）。共有辺上の交点は一方の三角形のみが数える。
+ *
+ * @param mesh 対象のメッシュ
+ * @param settings ボクセル化の設定
+ * @return 密なボクセルグリッド（解像度1024でおよそ128MB）
+ */
+DenseVoxelGrid voxelizeDense(const ModelMesh& mesh, const VoxelizeSettings& settings);
+
+/**
+ * @brief メッシュを疎なボクセルグリッド（ブリックマップ）に変換する
+ *
+ * voxelizeDense() と同じ処理をスラブ単位の作業領域で行い、占有ボクセルを含むブリックのみを
+ * 出力するため、グリッド全体の密なビット列は確保しない。
+ *
+ * @param mesh 対象のメッシュ
+ * @param settings ボクセル化の設定
+ * @return 疎なボクセルグリッド
+ */
+SparseVoxelGrid voxelizeSparse(const ModelMesh& mesh, const VoxelizeSettings& settings);
@@ -0,0 +1,323 @@
+#include "mesh_weld.h"
+#include "mesh_hash.h"
+#include "model_loader.h"
+#include "parallel.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+// 内部定数定義
+namespace
+{
+constexpr int TRIANGLE_VERTICES{3};                                 // 三角形の頂点数
+constexpr float CELL_SIZE_FACTOR{32.0f};                            // セル幅 = epsilon × この値
+constexpr std::uint64_t HASH_MULTIPLIER{0x9E3779B97F4A7C15ull};     // セル座標ハッシュ用乗数
+constexpr std::uint32_t NO_LINK{std::numeric_limits<std::uint32_t>::max()};
+constexpr float MAX_CELLS_PER_AXIS{1e12f};                          // これを超えるとセル座標が桁あふれする
+
+/**
+ * @brief 頂点とそのセルキーの組（ソート用）
+ */
+struct CellEntry {
+    std::uint64_t key;    ///< セル座標のハッシュ値
+    std::uint32_t index;  ///< 頂点インデックス
+};
+
+/**
+ * @brief 同一キーの頂点が並ぶソート済み区間
+ */
+struct CellRange {
+    std::uint64_t key;
+    std::uint32_t begin;
+    std::uint32_t end;
+};
+
+using CellCoord = std::array<std::int64_t, 3>;
+
+/**
+ * @brief セル座標をハッシュ値に変換する（衝突しても距離判定で正しく処理される）
+ */
+inline std::uint64_t cellKey(const CellCoord &cell)
+{
+    auto hash = std::uint64_t{0};
+    for (auto coordinate : cell)
+    {
+        hash = (hash ^ mixHash64(static_cast<std::uint64_t>(coordinate))) * HASH_MULTIPLIER;
+    }
+    return mixHash64(hash);
+}
+
+/**
+ * @brief 頂点座標のビット列からキーを作る（完全一致溶接用）
+ *
+ * -0.0 と 0.0 は == で等しいため、同じキーになるよう 0.0 に揃えてからビット列を取る。
+ */
+inline std::uint64_t exactKey(const glm::vec3 &position)
+{
+    auto normalized = position + glm::vec3{0.0f};
+    auto bits = std::array<std::uint32_t, 3>{};
+    std::memcpy(bits.data(), &normalized.x, sizeof(float));
+    std::memcpy(bits.data() + 1, &normalized.y, sizeof(float));
+    std::memcpy(bits.data() + 2, &normalized.z, sizeof(float));
+    return cellKey({bits[0], bits[1], bits[2]});
+}
+
+/**
+ * @brief 溶接処理の内部状態
+ */
+class VertexWelder {
+public:
+    VertexWelder(const ModelMesh &mesh, float epsilon)
+        : mesh{mesh}, epsilon{epsilon}, epsilonSquared{epsilon * epsilon},
+          cellSize{epsilon * CELL_SIZE_FACTOR}, origin{mesh.min_bounds}
+    {
+    }
+
+    WeldStats run(IndexedMesh &indexed)
+    {
+        gatherPositions();
+        sortByCell();
+        buildCellRanges();
+        linkNearestVertices();
+        resolveRoots();
+        return emit(indexed);
+    }
+
+private:
+    const ModelMesh &mesh;
+    float epsilon;
+    float epsilonSquared;
+    float cellSize;
+    glm::vec3 origin;
+
+    std::vector<glm::vec3> positions;     ///< 三角形の角ごとの座標
+    std::vector<CellEntry> entries;       ///< セルキーでソートされた頂点
+    std::vector<CellRange> cells;         ///< キーでソートされたセル区間
+    std::vector<std::uint32_t> links;     ///< 統合先の頂点インデックス（自分自身なら代表）
+
+    bool exact() const noexcept { return epsilon <= 0.0f; }
+
+    static bool isFinite(const glm::vec3 &position)
+    {
+        return std::isfinite(position.x) && std::isfinite(position.y) && std::isfinite(position.z);
+    }
+
+    CellCoord cellOf(const glm::vec3 &position) const
+    {
+        auto relative = (position - origin) / cellSize;
+        return {static_cast<std::int64_t>(std::floor(relative.x)), static_cast<std::int64_t>(std::floor(relative.y)),
+                static_cast<std::int64_t>(std::floor(relative.z))};
+    }
+
+    void gatherPositions()
+    {
+        const auto &triangles = mesh.triangles;
+        positions.resize(triangles.size() * TRIANGLE_VERTICES);
+        parallel::forEach(triangles.size(), [this, &triangles](std::size_t t) {
+            for (int k = 0; k < TRIANGLE_VERTICES; ++k)
+            {
+                positions[t * TRIANGLE_VERTICES + k] = triangles[t].vertices[k];
+            }
+        });
+    }
+
+    void sortByCell()
+    {
+        entries.resize(positions.size());
+        parallel::forEach(positions.size(), [this](std::size_t i) {
+            // 非有限値の頂点はセルに割り当てられないため完全一致のみで扱う
+            auto key = (exact() || !isFinite(positions[i])) ? exactKey(positions[i]) : cellKey(cellOf(positions[i]));
+            entries[i] = CellEntry{key, static_cast<std::uint32_t>(i)};
+        });
+
+        parallel::sort(entries.begin(), entries.end(), [](const CellEntry &lhs, const CellEntry &rhs) {
+            return lhs.key != rhs.key ? lhs.key < rhs.key : lhs.index < rhs.index;
+        });
+    }
+
+    void buildCellRanges()
+    {
+        for (std::uint32_t i = 0; i < entries.size();)
+        {
+            auto end = i + 1;
+            while (end < entries.size() && entries[end].key == entries[i].key)
+            {
+                ++end;
+            }
+            cells.push_back(CellRange{entries[i].key, i, static_cast<std::uint32_t>(end)});
+            i = static_cast<std::uint32_t>(end);
+        }
+    }
+
+    const CellRange *findCell(std::uint64_t key) const
+    {
+        auto it = std::lower_bound(cells.begin(), cells.end(), key,
+                                   [](const CellRange &cell, std::uint64_t value) { return cell.key < value; });
+        return (it != cells.end() && it->key == key) ? &*it : nullptr;
+    }
+
+    /**
+     * @brief セル内で指定頂点から epsilon 以内にある最小インデックスを探す
+     */
+    std::uint32_t nearestInCell(const CellRange &cell, std::uint32_t vertex, std::uint32_t best) const
+    {
+        const auto &position = positions[vertex];
+        for (auto e = cell.begin; e < cell.end; ++e)
+        {
+            auto candidate = entries[e].index;
+            if (candidate >= best)
+            {
+                break; // セル内はインデックス昇順なので以降は不要
+            }
+
+            auto delta = positions[candidate] - position;
+            auto matches = exact() ? positions[candidate] == position : glm::dot(delta, delta) <= epsilonSquared;
+            if (matches)
+            {
+                return candidate;
+            }
+        }
+        return best;
+    }
+
+    void linkNearestVertices()
+    {
+        links.assign(positions.size(), NO_LINK);
+
+        parallel::forEachChunk(cells.size(), [this](std::size_t begin, std::size_t end, std::size_t) {
+            for (auto c = begin; c < end; ++c)
+            {
+                const auto &cell = cells[c];
+                for (auto e = cell.begin; e < cell.end; ++e)
+                {
+                    auto vertex = entries[e].index;
+                    auto best = nearestInCell(cell, vertex, vertex);
+                    if (!exact() && isFinite(positions[vertex]))
+                    {
+                        best = nearestInNeighborCells(vertex, best);
+                    }
+                    links[vertex] = best;
+                }
+            }
+        }, 1024);
+    }
+
+    /**
+     * @brief セル境界から epsilon 以内にある頂点について、隣接セルを調べる
+     */
+    std::uint32_t nearestInNeighborCells(std::uint32_t vertex, std::uint32_t best) const
+    {
+        const auto &position = positions[vertex];
+        auto home = cellOf(position);
+
+        // 軸ごとに調べるべきオフセット（0 は常に、±1 は境界に近い場合のみ）
+        auto offsets = std::array<std::array<int, 3>, 3>{};
+        auto offsetCounts = std::array<int, 3>{};
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            auto local = (position[axis] - origin[axis]) - static_cast<float>(home[axis]) * cellSize;
+            offsets[axis][offsetCounts[axis]++] = 0;
+            if (local < epsilon)
+            {
+                offsets[axis][offsetCounts[axis]++] = -1;
+            }
+            if (cellSize - local < epsilon)
+            {
+                offsets[axis][offsetCounts[axis]++] = 1;
+            }
+        }
+
+        for (int ix = 0; ix < offsetCounts[0]; ++ix)
+        {
+            for (int iy = 0; iy < offsetCounts[1]; ++iy)
+            {
+                for (int iz = 0; iz < offsetCounts[2]; ++iz)
+                {
+                    if (ix == 0 && iy == 0 && iz == 0)
+                    {
+                        continue; // 自セルは調査済み
+                    }
+
+                    auto neighbor = CellCoord{home[0] + offsets[0][ix], home[1] + offsets[1][iy],
+                                              home[2] + offsets[2][iz]};
+                    if (const auto *cell = findCell(cellKey(neighbor)))
+                    {
+                        best = nearestInCell(*cell, vertex, best);
+                    }
+                }
+            }
+        }
+        return best;
+    }
+
+    void resolveRoots()
+    {
+        // リンクは常に小さいインデックスを指すため、たどれば必ず代表頂点に到達する
+        // （他のスレッドがたどる途中のリンクを書き換えないよう、結果は別の配列へ書き込んでから置き換える）
+        auto roots = std::vector<std::uint32_t>(links.size());
+        parallel::forEach(links.size(), [this, &roots](std::size_t i) {
+            auto root = links[i];
+            while (links[root] != root)
+            {
+                root = links[root];
+            }
+            roots[i] = root;
+        });
+        links.swap(roots);
+    }
+
+    WeldStats emit(IndexedMesh &indexed)
+    {
+        // 代表頂点に新しい連番を振る
+        auto remap = std::vector<std::uint32_t>(positions.size(), NO_LINK);
+        indexed.positions.clear();
+        for (std::uint32_t i = 0; i < positions.size(); ++i)
+        {
+            if (links[i] == i)
+            {
+                remap[i] = static_cast<std::uint32_t>(indexed.positions.size());
+                indexed.positions.push_back(positions[i]);
+            }
+        }
+
+        // 退化しなかった三角形のみインデックスを出力
+        auto triangleCount = mesh.triangles.size();
+        indexed.indices.clear();
+        indexed.indices.reserve(positions.size());
+        for (std::size_t t = 0; t < triangleCount; ++t)
+        {
+            auto a = remap[links[t * TRIANGLE_VERTICES]];
+            auto b = remap[links[t * TRIANGLE_VERTICES + 1]];
+            auto c = remap[links[t * TRIANGLE_VERTICES + 2]];
+            if (a != b && b != c && c != a)
+            {
+                indexed.indices.insert(indexed.indices.end(), {a, b, c});
+            }
+        }
+
+        return WeldStats{positions.size(), indexed.positions.size(), triangleCount - indexed.triangleCount()};
+    }
+};
+} // namespace
+
+float automaticWeldEpsilon(const ModelMesh &mesh)
+{
+    auto size = mesh.max_bounds - mesh.min_bounds;
+    return std::max({size.x, size.y, size.z}) * DEFAULT_WELD_RELATIVE_EPSILON;
+}
+
+WeldStats weldVertices(const ModelMesh &mesh, float epsilon, IndexedMesh &indexed)
+{
+    // 許容誤差が形状に対して小さすぎる場合は完全一致溶接に切り替える
+    auto size = mesh.max_bounds - mesh.min_bounds;
+    if (epsilon > 0.0f && std::max({size.x, size.y, size.z}) / (epsilon * CELL_SIZE_FACTOR) > MAX_CELLS_PER_AXIS)
+    {
+        epsilon = 0.0f;
+    }
+
+    auto welder = VertexWelder{mesh, epsilon};
+    return welder.run(indexed);
+}
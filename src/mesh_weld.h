@@ -0,0 +1,56 @@
+/**
+ * @file mesh_weld.h
+ * @brief 許容誤差付き頂点溶接（インデックス付きメッシュの生成）
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstddef>
+
+struct ModelMesh;
+struct IndexedMesh;
+
+/// 自動設定時の溶接許容誤差（バウンディングボックス最大辺に対する比率）
+constexpr float DEFAULT_WELD_RELATIVE_EPSILON{1e-6f};
+
+/**
+ * @brief 溶接処理の結果統計
+ */
+struct WeldStats {
+    std::size_t inputVertices;       ///< 溶接前の頂点数（三角形数 × 3）
+    std::size_t outputVertices;      ///< 溶接後の共有頂点数
+    std::size_t collapsedTriangles;  ///< 溶接により退化して除去された三角形数
+};
+
+/**
+ * @brief 溶接許容誤差の自動設定値を計算する
+ *
+ * @param mesh バウンディングボックス計算済みのメッシュ
+ * @return バウンディングボックス最大辺 × DEFAULT_WELD_RELATIVE_EPSILON
+ */
+float automaticWeldEpsilon(const ModelMesh& mesh);
+
+/**
+ * @brief 距離が許容誤差以下の頂点を統合し、インデックス付きメッシュを生成する
+ *
+ * STL出力で末尾ビットだけ異なる頂点など、ビット単位の重複排除や
+ * aiProcess_JoinIdenticalVertices では統合されない近接頂点を統合する。
+ *
+ * 処理は全て並列に行う:
+ * 1. 各頂点を一辺 epsilon × 32 のグリッドセルに割り当て、セルキーで並列ソートする
+ * 2. 各頂点について、自セルと（セル境界から epsilon 以内の場合のみ）隣接セルの頂点を調べ、
+ *    距離 epsilon 以内で最小インデックスの頂点へリンクする
+ * 3. リンクを根までたどって代表頂点を決定し、代表頂点のみを詰めて出力する
+ *
+ * 結果は入力順のみに依存し、スレッド数によらず決定的である。
+ * 溶接で2頂点以上が同一になった三角形は出力から除去する。
+ *
+ * @param mesh 入力メッシュ
+ * @param epsilon 溶接許容誤差（0の場合は座標が完全一致する頂点のみ統合）
+ * @param indexed [out] 溶接結果
+ * @return 溶接処理の結果統計
+ * @note 1セルに極端に多くの頂点が集中する場合（epsilon が大きすぎる場合）は遅くなる
+ */
+WeldStats weldVertices(const ModelMesh& mesh, float epsilon, IndexedMesh& indexed);
@@ -1,23 +1,66 @@
 #include "model_loader.h"
+#include "mesh_hash.h"
+#include "trace.h"
 #include <algorithm>
+#include <array>
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/irange.hpp>
 #include <boost/range/numeric.hpp>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 
 // 内部定数定義
 namespace
 {
 constexpr int TRIANGLE_VERTICES{3};              // 三角形の頂点数
+constexpr int POINT_COMPONENTS{3};               // 点群テキストの1行から読む座標の数
 constexpr float CENTER_CALCULATION_FACTOR{0.5f}; // 中心計算用係数
 constexpr float DEFAULT_SCALE{1.0f};             // デフォルトスケール
 constexpr float EPSILON{1e-6f};                  // 浮動小数点ゼロ判定用イプシロン
+
+// Assimp読み込みフラグ（自動で最適化処理を適用）
+constexpr unsigned int IMPORT_FLAGS{aiProcess_Triangulate |           // 全てのポリゴンを三角形に変換
+                                    aiProcess_GenNormals |            // 法線ベクトルを自動生成
+                                    aiProcess_ValidateDataStructure | // データ構造の妥当性を検証
+                                    aiProcess_JoinIdenticalVertices | // 重複頂点を統合
+                                    aiProcess_SortByPType |           // プリミティブタイプでソート
+                                    aiProcess_OptimizeMeshes};        // メッシュを最適化
+
+// 外部ファイルを参照しない（メモリから読み込み可能な）形式の拡張子
+const std::array<std::string, 4> SELF_CONTAINED_EXTENSIONS{".stl", ".ply", ".glb", ".off"};
+
+// Assimpが対応していない点群テキストの拡張子
+constexpr const char *POINT_CLOUD_TEXT_EXTENSION{".xyz"};
+
+/**
+ * @brief 拡張子を小文字で取得する
+ */
+std::string lowerExtension(const std::string &filePath)
+{
+    auto extension = std::filesystem::path{filePath}.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extension;
+}
+
+/**
+ * @brief 座標が全て有限値か
+ */
+inline bool isFinitePoint(const glm::vec3 &point)
+{
+    return std::isfinite(point.x) && std::isfinite(point.y) && std::isfinite(point.z);
+}
 } // namespace
 
-ModelLoader::ModelLoader()
+ModelLoader::ModelLoader() : repairStats{}
 {
 }
 
@@ -26,7 +69,7 @@ ModelLoader::~ModelLoader()
 }
 
 // Copy semantics
-ModelLoader::ModelLoader(const ModelLoader &other) : errorMessage(other.errorMessage)
+ModelLoader::ModelLoader(const ModelLoader &other) : errorMessage(other.errorMessage), repairStats(other.repairStats)
 {
 }
 
@@ -35,12 +78,14 @@ ModelLoader &ModelLoader::operator=(const ModelLoader &other)
     if (this != &other)
     {
         errorMessage = other.errorMessage;
+        repairStats = other.repairStats;
     }
     return *this;
 }
 
 // Move semantics
-ModelLoader::ModelLoader(ModelLoader &&other) noexcept : errorMessage(std::move(other.errorMessage))
+ModelLoader::ModelLoader(ModelLoader &&other) noexcept
+    : errorMessage(std::move(other.errorMessage)), repairStats(other.repairStats)
 {
 }
 
@@ -49,17 +94,69 @@ ModelLoader &ModelLoader::operator=(ModelLoader &&other) noexcept
     if (this != &other)
     {
         errorMessage = std::move(other.errorMessage);
+        repairStats = other.repairStats;
     }
     return *this;
 }
 
-bool ModelLoader::loadFile(const std::string &filePath, ModelMesh &mesh)
+bool ModelLoader::loadFile(const std::string &filePath, ModelMesh &mesh, std::pmr::memory_resource *scratch)
 {
+    TRACE_SCOPE("ModelLoader::loadFile");
+
     errorMessage.clear();
+    repairStats = RepairStats{};
+
+    // 点群テキストはAssimpを通さずに読み込む
+    if (lowerExtension(filePath) == POINT_CLOUD_TEXT_EXTENSION)
+    {
+        return loadPointCloudText(filePath, mesh, scratch) && finishMesh(mesh, scratch);
+    }
 
     // Assimpインポーターを作成し、ファイルを読み込み
     auto importer = Assimp::Importer{};
     auto scene = loadFileWithAssimp(filePath, importer);
+    return buildMesh(scene, mesh, scratch);
+}
+
+bool ModelLoader::loadFromMemory(const void *data, std::size_t size, const std::string &formatHint, ModelMesh &mesh,
+                                 std::pmr::memory_resource *scratch)
+{
+    TRACE_SCOPE("ModelLoader::loadFromMemory");
+
+    errorMessage.clear();
+    repairStats = RepairStats{};
+
+    // メモリ上のデータをAssimpで読み込み（拡張子ヒントで形式を判別）
+    auto importer = Assimp::Importer{};
+    const aiScene *scene = nullptr;
+    {
+        TRACE_SCOPE("Assimp import");
+        scene = importer.ReadFileFromMemory(data, size, 0, formatHint.c_str());
+    }
+    scene = scene ? applyPostProcessing(importer) : nullptr;
+    if (!scene)
+    {
+        setError("Failed to load 3D model from memory", importer.GetErrorString());
+        return false;
+    }
+
+    return buildMesh(scene, mesh, scratch);
+}
+
+unsigned int ModelLoader::importFlags() noexcept
+{
+    return IMPORT_FLAGS;
+}
+
+bool ModelLoader::isSelfContainedFormat(const std::string &filePath)
+{
+    auto extension = lowerExtension(filePath);
+    return std::find(SELF_CONTAINED_EXTENSIONS.begin(), SELF_CONTAINED_EXTENSIONS.end(), extension) !=
+           SELF_CONTAINED_EXTENSIONS.end();
+}
+
+bool ModelLoader::buildMesh(const aiScene *scene, ModelMesh &mesh, std::pmr::memory_resource *scratch)
+{
     if (!scene)
     {
         return false;
@@ -77,6 +174,16 @@ bool ModelLoader::loadFile(const std::string &filePath, ModelMesh &mesh)
         return false;
     }
 
+    return finishMesh(mesh, scratch);
+}
+
+bool ModelLoader::finishMesh(ModelMesh &mesh, std::pmr::memory_resource *scratch)
+{
+    TRACE_SCOPE("ModelLoader::finishMesh");
+
+    // 不正な三角形を除去し、壊れた法線を再計算（並列）
+    repairStats = repairMesh(mesh, scratch);
+
     // 処理結果の検証
     if (!validateProcessedMesh(mesh))
     {
@@ -87,20 +194,20 @@ bool ModelLoader::loadFile(const std::string &filePath, ModelMesh &mesh)
     calculateBounds(mesh);
     calculateCenterAndScale(mesh);
 
+    // 重複排除・キャッシュキー用のコンテンツハッシュを計算（並列）
+    mesh.contentHash = computeMeshHash(mesh);
+
     return true;
 }
 
 const aiScene* ModelLoader::loadFileWithAssimp(const std::string& filePath, Assimp::Importer& importer)
 {
-    // ファイルを読み込み（自動で最適化処理を適用）
-    auto flags = aiProcess_Triangulate |           // 全てのポリゴンを三角形に変換
-                 aiProcess_GenNormals |            // 法線ベクトルを自動生成
-                 aiProcess_ValidateDataStructure | // データ構造の妥当性を検証
-                 aiProcess_JoinIdenticalVertices | // 重複頂点を統合
-                 aiProcess_SortByPType |           // プリミティブタイプでソート
-                 aiProcess_OptimizeMeshes;         // メッシュを最適化
-    
-    auto scene = importer.ReadFile(filePath, flags);
+    const aiScene *scene = nullptr;
+    {
+        TRACE_SCOPE("Assimp import");
+        scene = importer.ReadFile(filePath, 0);
+    }
+    scene = scene ? applyPostProcessing(importer) : nullptr;
     if (!scene)
     {
         setError("Failed to load 3D model", importer.GetErrorString());
@@ -110,6 +217,13 @@ const aiScene* ModelLoader::loadFileWithAssimp(const std::string& filePath, Assi
     return scene;
 }
 
+const aiScene *ModelLoader::applyPostProcessing(Assimp::Importer &importer)
+{
+    // 読み込みと後処理を分けて呼び、それぞれの所要時間を記録できるようにする
+    TRACE_SCOPE("Assimp post-process");
+    return importer.ApplyPostProcessing(IMPORT_FLAGS);
+}
+
 bool ModelLoader::validateScene(const aiScene* scene)
 {
     if (!scene->HasMeshes())
@@ -122,10 +236,10 @@ bool ModelLoader::validateScene(const aiScene* scene)
 
 bool ModelLoader::validateProcessedMesh(const ModelMesh& mesh)
 {
-    if (mesh.triangles.empty())
+    if (mesh.triangles.empty() && mesh.points.empty())
     {
-        setError("No triangle data could be extracted from the file",
-                 "Model might contain only points/lines or unsupported geometry");
+        setError("No triangle or point data could be extracted from the file",
+                 "Model might contain only lines or unsupported geometry");
         return false;
     }
     return true;
@@ -133,6 +247,8 @@ bool ModelLoader::validateProcessedMesh(const ModelMesh& mesh)
 
 bool ModelLoader::processScene(const aiScene *scene, ModelMesh &mesh)
 {
+    TRACE_SCOPE("ModelLoader::processScene");
+
     // メモリ効率化: 総三角形数を推定してreserve（boost/ranges版）
     auto meshIndices = boost::irange(0u, scene->mNumMeshes);
     auto estimatedTriangles = boost::accumulate(meshIndices | boost::adaptors::transformed([scene](unsigned int i) {
@@ -148,12 +264,6 @@ bool ModelLoader::processScene(const aiScene *scene, ModelMesh &mesh)
 
 bool ModelLoader::processMesh(const aiMesh *aiMesh, ModelMesh &mesh)
 {
-    if (!aiMesh->HasFaces())
-    {
-        setError("Mesh does not contain face data", "Mesh index: " + std::to_string(mesh.triangles.size() / 1000));
-        return false;
-    }
-
     if (!aiMesh->HasPositions())
     {
         setError("Mesh does not contain vertex position data",
@@ -161,6 +271,14 @@ bool ModelLoader::processMesh(const aiMesh *aiMesh, ModelMesh &mesh)
         return false;
     }
 
+    // 点プリミティブのメッシュ（aiProcess_SortByPType で点のみのメッシュに分けられる）と
+    // 面を持たない頂点のみのメッシュ（面要素の無いPLY等）は点として取り込む
+    if (!aiMesh->HasFaces() || (aiMesh->mPrimitiveTypes & aiPrimitiveType_POINT) != 0)
+    {
+        processPoints(aiMesh, mesh);
+        return true;
+    }
+
     // 既存の三角形数を記録（複数メッシュの場合に備えて）
     size_t initialTriangleCount = mesh.triangles.size();
 
@@ -190,15 +308,100 @@ bool ModelLoader::processMesh(const aiMesh *aiMesh, ModelMesh &mesh)
     return true;
 }
 
+void ModelLoader::processPoints(const aiMesh *aiMesh, ModelMesh &mesh)
+{
+    auto appendPoint = [aiMesh, &mesh](unsigned int index) {
+        const auto &vertex = aiMesh->mVertices[index];
+        auto point = glm::vec3{vertex.x, vertex.y, vertex.z};
+        if (isFinitePoint(point)) // 非有限値の点は描画・バウンディングボックスを壊すため除外する
+        {
+            mesh.points.push_back(point);
+        }
+    };
+
+    if (!aiMesh->HasFaces())
+    {
+        mesh.points.reserve(mesh.points.size() + aiMesh->mNumVertices);
+        for (unsigned int i = 0; i < aiMesh->mNumVertices; ++i)
+        {
+            appendPoint(i);
+        }
+        return;
+    }
+
+    mesh.points.reserve(mesh.points.size() + aiMesh->mNumFaces);
+    for (unsigned int i = 0; i < aiMesh->mNumFaces; ++i)
+    {
+        const aiFace &face = aiMesh->mFaces[i];
+        if (face.mNumIndices == 1 && face.mIndices[0] < aiMesh->mNumVertices)
+        {
+            appendPoint(face.mIndices[0]);
+        }
+    }
+}
+
+bool ModelLoader::loadPointCloudText(const std::string &filePath, ModelMesh &mesh, std::pmr::memory_resource *scratch)
+{
+    auto file = std::ifstream{filePath, std::ios::binary};
+    if (!file.is_open())
+    {
+        setError("Cannot read file", filePath);
+        return false;
+    }
+    auto text = std::pmr::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}, scratch};
+
+    // 1行ずつ先頭3列を数値として読む（from_chars はロケールに依存せず高速）
+    auto isSeparator = [](char c) { return c == ' ' || c == '\t' || c == ',' || c == '\r'; };
+    auto lineNumber = std::size_t{0};
+    const auto *position = text.c_str();
+    const auto *end = position + text.size();
+    while (position < end)
+    {
+        ++lineNumber;
+        auto lineEnd = std::find(position, end, '\n');
+        while (position < lineEnd && isSeparator(*position))
+        {
+            ++position;
+        }
+
+        if (position < lineEnd && *position != '#')
+        {
+            auto coordinates = std::array<float, POINT_COMPONENTS>{};
+            for (auto &coordinate : coordinates)
+            {
+                while (position < lineEnd && isSeparator(*position))
+                {
+                    ++position;
+                }
+                auto [next, error] = std::from_chars(position, lineEnd, coordinate);
+                if (error != std::errc{})
+                {
+                    setError("Invalid point cloud text", filePath + " line " + std::to_string(lineNumber));
+                    return false;
+                }
+                position = next;
+            }
+
+            auto point = glm::vec3{coordinates[0], coordinates[1], coordinates[2]};
+            if (isFinitePoint(point))
+            {
+                mesh.points.push_back(point);
+            }
+        }
+        position = lineEnd + 1;
+    }
+    return true;
+}
+
 void ModelLoader::calculateBounds(ModelMesh &mesh)
 {
-    if (mesh.triangles.empty())
+    if (mesh.triangles.empty() && mesh.points.empty())
     {
         return;
     }
 
-    // 最初の三角形で初期化
-    mesh.min_bounds = mesh.max_bounds = mesh.triangles[0].vertices[0];
+    // 最初の頂点（三角形が無い場合は最初の点）で初期化
+    mesh.min_bounds = mesh.max_bounds = mesh.triangles.empty() ? mesh.points[0] : mesh.triangles[0].vertices[0];
 
     // すべての頂点をチェックしてバウンディングボックスを計算（最適化版）
     for (const auto &triangle : mesh.triangles)
@@ -218,11 +421,17 @@ void ModelLoader::calculateBounds(ModelMesh &mesh)
             mesh.max_bounds.z = std::max(mesh.max_bounds.z, vertex.z);
         }
     }
+
+    for (const auto &point : mesh.points)
+    {
+        mesh.min_bounds = glm::min(mesh.min_bounds, point);
+        mesh.max_bounds = glm::max(mesh.max_bounds, point);
+    }
 }
 
 void ModelLoader::calculateCenterAndScale(ModelMesh &mesh)
 {
-    if (mesh.triangles.empty())
+    if (mesh.triangles.empty() && mesh.points.empty())
     {
         return;
     }
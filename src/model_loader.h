@@ -7,9 +7,13 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
 #include <string>
 #include <vector>
 #include <glm/glm.hpp>
+#include "mesh_repair.h"
 
 // 前方宣言
 struct aiScene;
@@ -34,17 +38,57 @@ struct ModelTriangle {
 /**
  * @brief 3Dモデルメッシュ全体を表す構造体
  * 
- * 3Dモデルファイルから読み込んだ全ての三角形と、
+ * 3Dモデルファイルから読み込んだ全ての三角形・点と、
  * 描画に必要な付加情報（バウンディングボックス、中心、スケール）を保持する。
+ * 三角形・点データは std::pmr のメモリリソースから確保される。
+ * ムーブ代入ではメモリリソースは伝播せず、代入先のリソースが維持される。
  */
 struct ModelMesh {
-    std::vector<ModelTriangle> triangles; ///< 三角形データの配列
+    /**
+     * @brief デフォルトのメモリリソースを使用するコンストラクタ
+     */
+    ModelMesh() = default;
+    
+    /**
+     * @brief 三角形・点データの確保先メモリリソースを指定するコンストラクタ
+     * 
+     * ヒュージページや共有メモリ上のリソースを渡すことで、
+     * メッシュ本体の配置先を制御できる。
+     * 
+     * @param resource 三角形・点データの確保に使用するメモリリソース
+     * @pre resource はメッシュより長く生存する
+     */
+    explicit ModelMesh(std::pmr::memory_resource* resource) : triangles{resource}, points{resource} {}
+    
+    std::pmr::vector<ModelTriangle> triangles; ///< 三角形データの配列
+    std::pmr::vector<glm::vec3> points;        ///< 点プリミティブの座標（点群スキャン等、三角形に属さない点）
     
     // 空間情報
     glm::vec3 min_bounds;  ///< バウンディングボックスの最小座標
     glm::vec3 max_bounds;  ///< バウンディングボックスの最大座標
     glm::vec3 center;      ///< メッシュの幾何学的中心
     float scale;           ///< 正規化用のスケール係数
+    
+    // 識別情報
+    std::uint64_t contentHash{0}; ///< 形状のコンテンツハッシュ（ディスクキャッシュのキー、同一形状の再読み込み時のGPUバッファ再利用の判定用）
+};
+
+/**
+ * @brief 頂点を共有するインデックス付きメッシュ
+ * 
+ * 溶接（weldVertices()）によって ModelMesh から生成される。
+ * 隣接関係を使う解析処理や、インデックスバッファによる描画に使用する。
+ */
+struct IndexedMesh {
+    std::vector<glm::vec3> positions;     ///< 共有頂点の座標
+    std::vector<std::uint32_t> indices;   ///< 三角形ごとの頂点インデックス（3つで1三角形）
+    
+    /**
+     * @brief 三角形数を取得する
+     * 
+     * @return 三角形数
+     */
+    std::size_t triangleCount() const noexcept { return indices.size() / 3; }
 };
 
 /**
@@ -57,6 +101,8 @@ struct ModelMesh {
  * 主な機能:
  * - 50+ 3Dモデル形式の自動判別と読み込み
  * - 三角形メッシュデータの抽出と最適化
+ * - 点プリミティブ（PLY等の点群）の抽出と、Assimp非対応のXYZ点群テキストの読み込み
+ * - 不正な三角形の除去と法線の修復
  * - バウンディングボックス計算
  * - メッシュの正規化とセンタリング
  * - 詳細なエラーレポート
@@ -117,17 +163,48 @@ public:
      * @brief 3Dモデルファイルを読み込んでメッシュデータを生成する
      * 
      * 指定された3Dモデルファイルをアジンプライブラリで自動判別して読み込み、
-     * 三角形メッシュデータとして変換する。同時にバウンディングボックス、
-     * 中心座標、スケール係数も計算する。
+     * 三角形メッシュデータとして変換する。点プリミティブは points に格納する。
+     * 拡張子が .xyz の場合は1行1点（x y z、以降の列は無視）の点群テキストとして読み込む。
+     * 同時にバウンディングボックス、中心座標、スケール係数、コンテンツハッシュも計算する。
      * 
      * @param filePath 3Dモデルファイルのパス（相対パス・絶対パス両対応）
      * @param mesh 読み込み結果を格納するModelMeshオブジェクト
+     * @param scratch 読み込み中の作業用データ（点群テキスト・修復用の配列）の確保に使用するメモリリソース
      * @return 読み込み成功時はtrue、失敗時はfalse
      * @pre filePathが有効な3Dモデルファイルを指している
      * @post 成功時はmeshに完全なメッシュデータが格納される
      * @post 失敗時はgetErrorMessage()でエラー詳細を取得可能
+     * @note Assimp内部の確保は scratch を経由しない
+     */
+    bool loadFile(const std::string& filePath, ModelMesh& mesh,
+                  std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+    
+    /**
+     * @brief メモリ上の3Dモデルデータを読み込んでメッシュデータを生成する
+     * 
+     * ファイルI/Oとパース処理を別スレッドで行うために使用する。
+     * loadFile() と同じ後処理（バウンディングボックス等の計算）を行う。
+     * 
+     * @param data ファイル内容の先頭ポインタ
+     * @param size ファイル内容のバイト数
+     * @param formatHint 形式判別用の拡張子（例: "stl"）
+     * @param mesh 読み込み結果を格納するModelMeshオブジェクト
+     * @param scratch 読み込み中の作業用データ（修復用の配列）の確保に使用するメモリリソース
+     * @return 読み込み成功時はtrue、失敗時はfalse
+     * @pre data が単一ファイルで完結する形式（isSelfContainedFormat() が true）の内容である
+     */
+    bool loadFromMemory(const void* data, std::size_t size, const std::string& formatHint, ModelMesh& mesh,
+                        std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+    
+    /**
+     * @brief 外部ファイルを参照せず単一ファイルで完結する形式かどうかを判定する
+     * 
+     * OBJ（MTL参照）やGLTF（外部バッファ参照）などはメモリから読み込めないため false となる。
+     * 
+     * @param filePath 判定するファイルのパス
+     * @return loadFromMemory() で読み込める形式の場合はtrue
      */
-    bool loadFile(const std::string& filePath, ModelMesh& mesh);
+    static bool isSelfContainedFormat(const std::string& filePath);
     
     /**
      * @brief 最後に発生したエラーの詳細メッセージを取得する
@@ -137,33 +214,39 @@ public:
      * @return エラーメッセージ文字列（エラーがない場合は空文字列）
      */
     const std::string& getErrorMessage() const noexcept { return errorMessage; }
-
-private:
-    // エラーハンドリング
-    mutable std::string errorMessage;  ///< 最後に発生したエラーメッセージ
-
+    
     /**
-     * @brief Assimpシーンからメッシュデータを処理する
+     * @brief 最後の読み込みで行ったメッシュ修復の統計を取得する
      * 
-     * @param scene Assimpで読み込んだシーンデータ
-     * @param mesh 出力先のメッシュオブジェクト
-     * @return 処理成功時はtrue、失敗時はfalse
+     * 読み込み時には不正な三角形（退化・重複・非有限値）の除去と
+     * 壊れた法線の再計算が自動で行われる（repairMesh() 参照）。
+     * 
+     * @return 修復処理の結果統計
      */
-    bool processScene(const aiScene* scene, ModelMesh& mesh);
+    const RepairStats& getRepairStats() const noexcept { return repairStats; }
+    
+    // 読み込みの各段階（loadFile() から順に呼ばれる。ベンチマーク等で段階ごとに計測できるよう公開している）
     
     /**
-     * @brief 単一のAssimpメッシュを処理する
+     * @brief 読み込み時にAssimpへ渡す後処理フラグを取得する
      * 
-     * @param aiMesh Assimpメッシュデータ
+     * @return aiPostProcessSteps の論理和
+     */
+    static unsigned int importFlags() noexcept;
+    
+    /**
+     * @brief Assimpシーンからメッシュデータを処理する
+     * 
+     * @param scene Assimpで読み込んだシーンデータ
      * @param mesh 出力先のメッシュオブジェクト
      * @return 処理成功時はtrue、失敗時はfalse
      */
-    bool processMesh(const aiMesh* aiMesh, ModelMesh& mesh);
+    bool processScene(const aiScene* scene, ModelMesh& mesh);
     
     /**
      * @brief メッシュのバウンディングボックスを計算する
      * 
-     * 全ての頂点座標から最小・最大座標を求めてmin_bounds、max_boundsに設定する。
+     * 全ての頂点座標・点から最小・最大座標を求めてmin_bounds、max_boundsに設定する。
      * 
      * @param mesh 計算対象のメッシュオブジェクト
      * @post mesh.min_bounds と mesh.max_bounds が設定される
@@ -180,6 +263,55 @@ private:
      * @post mesh.center と mesh.scale が設定される
      */
     void calculateCenterAndScale(ModelMesh& mesh);
+
+private:
+    // エラーハンドリング
+    mutable std::string errorMessage;  ///< 最後に発生したエラーメッセージ
+    
+    // 修復結果
+    RepairStats repairStats;           ///< 最後の読み込みで行った修復の統計
+
+    /**
+     * @brief 単一のAssimpメッシュを処理する
+     * 
+     * @param aiMesh Assimpメッシュデータ
+     * @param mesh 出力先のメッシュオブジェクト
+     * @return 処理成功時はtrue、失敗時はfalse
+     */
+    bool processMesh(const aiMesh* aiMesh, ModelMesh& mesh);
+    
+    /**
+     * @brief 点プリミティブのAssimpメッシュから点を取り込む
+     * 
+     * 面を持たないメッシュは全頂点を、点の面を持つメッシュは各面の頂点を点として追加する。
+     * 非有限値の座標を持つ点は除外する。
+     * 
+     * @param aiMesh Assimpメッシュデータ
+     * @param mesh 出力先のメッシュオブジェクト（points に追加される）
+     */
+    void processPoints(const aiMesh* aiMesh, ModelMesh& mesh);
+    
+    /**
+     * @brief 点群テキスト（XYZ形式）を読み込む
+     * 
+     * 空行と '#' で始まる行は読み飛ばし、各行の先頭3列を座標とする。
+     * 空白・カンマ区切りのどちらにも対応する。
+     * 
+     * @param filePath 読み込むファイルのパス
+     * @param mesh 出力先のメッシュオブジェクト（points に追加される）
+     * @param scratch ファイル内容の確保に使用するメモリリソース
+     * @return 読み込み成功時はtrue、失敗時はfalse
+     */
+    bool loadPointCloudText(const std::string& filePath, ModelMesh& mesh, std::pmr::memory_resource* scratch);
+    
+    /**
+     * @brief 三角形・点データから後処理（修復・検証・バウンディングボックス・ハッシュ）を行う
+     * 
+     * @param mesh 処理対象のメッシュオブジェクト
+     * @param scratch 修復用の作業配列の確保に使用するメモリリソース
+     * @return 処理成功時はtrue、失敗時はfalse
+     */
+    bool finishMesh(ModelMesh& mesh, std::pmr::memory_resource* scratch);
     
     /**
      * @brief Assimpインポーターを設定し、ファイルを読み込む
@@ -189,6 +321,26 @@ private:
      */
     const aiScene* loadFileWithAssimp(const std::string& filePath, Assimp::Importer& importer);
     
+    /**
+     * @brief 後処理なしで読み込んだシーンに importFlags() の後処理を適用する
+     * 
+     * @param importer シーンを読み込んだインポーター
+     * @return 後処理済みのシーンポインタ（失敗時はnullptr）
+     */
+    static const aiScene* applyPostProcessing(Assimp::Importer& importer);
+    
+    /**
+     * @brief 読み込み済みシーンを検証・変換してメッシュデータを完成させる
+     * 
+     * loadFile() と loadFromMemory() の共通の後処理。
+     * 
+     * @param scene 読み込んだシーン（nullptrの場合は失敗扱い）
+     * @param mesh 出力先のメッシュオブジェクト
+     * @param scratch 修復用の作業配列の確保に使用するメモリリソース
+     * @return 処理成功時はtrue、失敗時はfalse
+     */
+    bool buildMesh(const aiScene* scene, ModelMesh& mesh, std::pmr::memory_resource* scratch);
+    
     /**
      * @brief 読み込んだシーンの基本検証を行う
      * 
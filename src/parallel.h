@@ -0,0 +1,363 @@
+/**
+ * @file parallel.h
+ * @brief メッシュ処理用の並列ループ・リダクション・ソート・コンパクションのヘルパー
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <span>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace parallel {
+
+/// 1スレッドあたりの最小要素数（これ未満ではスレッド生成コストが上回る）
+constexpr std::size_t DEFAULT_MIN_CHUNK{16384};
+
+/**
+ * @brief 使用するスレッド数を取得する
+ *
+ * @return ハードウェアスレッド数（取得できない場合は1）
+ */
+inline std::size_t threadCount()
+{
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief 要素数に応じたチャンク数を計算する
+ *
+ * @param count 要素数
+ * @param minChunk 1チャンクあたりの最小要素数
+ * @return チャンク数（1以上、threadCount()以下）
+ */
+inline std::size_t chunkCount(std::size_t count, std::size_t minChunk = DEFAULT_MIN_CHUNK)
+{
+    auto byWork = (count + minChunk - 1) / std::max<std::size_t>(minChunk, 1);
+    return std::clamp<std::size_t>(byWork, 1, threadCount());
+}
+
+/**
+ * @brief [0, count) を連続したチャンクに分割して並列に処理する
+ *
+ * 最初のチャンクは呼び出しスレッドで実行し、残りはチャンクごとにスレッドを生成する。
+ * スレッドプールを使わないため、ワーカースレッド内から呼び出してもデッドロックしない。
+ * スレッドを生成できなかったチャンクは呼び出しスレッドで順に実行する。
+ *
+ * @tparam Func void(std::size_t begin, std::size_t end, std::size_t chunk) 形式の関数
+ * @param count 要素数
+ * @param func 各チャンクを処理する関数
+ * @param minChunk 1チャンクあたりの最小要素数
+ * @throw func が送出した例外（全チャンクの終了と全スレッドの合流を待ってから、チャンク順で最初のものを再送出する）
+ * @note func は互いに重ならない範囲に対して同時に呼ばれる
+ */
+template <typename Func>
+void forEachChunk(std::size_t count, Func&& func, std::size_t minChunk = DEFAULT_MIN_CHUNK)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    auto chunks = chunkCount(count, minChunk);
+    auto chunkSize = (count + chunks - 1) / chunks;
+
+    // 例外を std::thread の外へ逃がすと std::terminate になるため、チャンクごとに捕捉して合流後に再送出する
+    auto errors = std::vector<std::exception_ptr>(chunks);
+    auto runChunk = [&func, &errors, count, chunkSize](std::size_t chunk) noexcept {
+        auto begin = std::min(count, chunk * chunkSize);
+        auto end = std::min(count, begin + chunkSize);
+        try
+        {
+            func(begin, end, chunk);
+        }
+        catch (...)
+        {
+            errors[chunk] = std::current_exception();
+        }
+    };
+
+    auto threads = std::vector<std::thread>{};
+    threads.reserve(chunks - 1);
+    auto spawned = std::size_t{1};
+    try
+    {
+        for (; spawned < chunks; ++spawned)
+        {
+            threads.emplace_back(runChunk, spawned);
+        }
+    }
+    catch (const std::system_error&)
+    {
+        // スレッド数の上限に達した場合は、残りのチャンクを呼び出しスレッドで実行する
+    }
+
+    runChunk(0);
+    for (auto chunk = spawned; chunk < chunks; ++chunk)
+    {
+        runChunk(chunk);
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const auto& error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+/**
+ * @brief [0, count) の各要素に対して並列に関数を適用する
+ *
+ * @tparam Func void(std::size_t index) 形式の関数
+ * @param count 要素数
+ * @param func 各要素を処理する関数
+ * @param minChunk 1チャンクあたりの最小要素数
+ */
+template <typename Func>
+void forEach(std::size_t count, Func&& func, std::size_t minChunk = DEFAULT_MIN_CHUNK)
+{
+    forEachChunk(
+        count,
+        [&func](std::size_t begin, std::size_t end, std::size_t) {
+            for (auto i = begin; i < end; ++i)
+            {
+                func(i);
+            }
+        },
+        minChunk);
+}
+
+/**
+ * @brief チャンク単位の部分結果を計算し、チャンク順に結合する並列リダクション
+ *
+ * @tparam T 結果の型
+ * @tparam MapChunk T(std::size_t begin, std::size_t end) 形式の関数
+ * @tparam Combine T(T, const T&) 形式の関数
+ * @param count 要素数
+ * @param identity 結果の初期値
+ * @param mapChunk チャンクの部分結果を計算する関数
+ * @param combine 部分結果を結合する関数
+ * @param minChunk 1チャンクあたりの最小要素数
+ * @return 全チャンクの結合結果
+ * @note 結合順序はチャンク順で固定されるため、結果はスレッド数以外に依存しない
+ */
+template <typename T, typename MapChunk, typename Combine>
+T reduce(std::size_t count, T identity, MapChunk&& mapChunk, Combine&& combine,
+         std::size_t minChunk = DEFAULT_MIN_CHUNK)
+{
+    auto partials = std::vector<T>(chunkCount(count, minChunk), identity);
+    forEachChunk(
+        count,
+        [&partials, &mapChunk](std::size_t begin, std::size_t end, std::size_t chunk) {
+            partials[chunk] = mapChunk(begin, end);
+        },
+        minChunk);
+
+    auto result = std::move(identity);
+    for (const auto& partial : partials)
+    {
+        result = combine(std::move(result), partial);
+    }
+    return result;
+}
+
+/**
+ * @brief ランダムアクセス範囲を並列にソートする
+ *
+ * チャンクごとに std::sort で並列ソートした後、隣接チャンクを
+ * std::inplace_merge でペアごとに並列マージする。
+ *
+ * @tparam Iterator ランダムアクセスイテレーター
+ * @tparam Compare 比較関数の型
+ * @param first 範囲の先頭
+ * @param last 範囲の終端
+ * @param compare 比較関数
+ * @param minChunk 1チャンクあたりの最小要素数
+ * @note 安定ソートではない
+ */
+template <typename Iterator, typename Compare>
+void sort(Iterator first, Iterator last, Compare compare, std::size_t minChunk = DEFAULT_MIN_CHUNK)
+{
+    auto count = static_cast<std::size_t>(last - first);
+    auto chunks = chunkCount(count, minChunk);
+    auto chunkSize = (count + chunks - 1) / std::max<std::size_t>(chunks, 1);
+    auto boundary = [first, count, chunkSize](std::size_t chunk) {
+        return first + static_cast<std::ptrdiff_t>(std::min(count, chunk * chunkSize));
+    };
+
+    forEachChunk(
+        count,
+        [&](std::size_t, std::size_t, std::size_t chunk) { std::sort(boundary(chunk), boundary(chunk + 1), compare); },
+        minChunk);
+
+    // 幅を倍にしながら隣接するソート済み区間をマージ
+    for (std::size_t width = 1; width < chunks; width *= 2)
+    {
+        auto pairs = (chunks + 2 * width - 1) / (2 * width);
+        forEachChunk(
+            pairs,
+            [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (auto pair = begin; pair < end; ++pair)
+                {
+                    auto left = pair * 2 * width;
+                    auto middle = std::min(chunks, left + width);
+                    auto right = std::min(chunks, left + 2 * width);
+                    std::inplace_merge(boundary(left), boundary(middle), boundary(right), compare);
+                }
+            },
+            1);
+    }
+}
+
+/**
+ * @brief フラグが立っている要素のみを残すよう配列をその場で詰める（並列ストリームコンパクション）
+ *
+ * 1. チャンクごとに並列でチャンク先頭へ詰める
+ * 2. 各チャンクの残存数の累積和から出力位置を求め、チャンク順に前方へ移動する
+ *
+ * @tparam Container 要素の連続配列（std::vector、std::pmr::vector 等）
+ * @param values 対象の配列
+ * @param keep 要素ごとの残すかどうかのフラグ（values と同じ長さ。std::vector・std::pmr::vector のどちらも渡せる）
+ * @param minChunk 1チャンクあたりの最小要素数
+ * @return 残った要素数
+ * @post values は残った要素のみを元の順序で保持する
+ */
+template <typename Container>
+std::size_t compact(Container& values, std::span<const std::uint8_t> keep, std::size_t minChunk = DEFAULT_MIN_CHUNK)
+{
+    auto count = values.size();
+    auto chunks = chunkCount(count, minChunk);
+    auto chunkSize = (count + chunks - 1) / std::max<std::size_t>(chunks, 1);
+    auto kept = std::vector<std::size_t>(chunks, 0);
+
+    forEachChunk(
+        count,
+        [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+            auto output = begin;
+            for (auto i = begin; i < end; ++i)
+            {
+                if (keep[i])
+                {
+                    if (output != i)
+                    {
+                        values[output] = std::move(values[i]);
+                    }
+                    ++output;
+                }
+            }
+            kept[chunk] = output - begin;
+        },
+        minChunk);
+
+    // 出力位置は常にチャンク先頭以下なので、チャンク順に移動すれば未読の領域を上書きしない
+    auto output = std::size_t{0};
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+    {
+        auto begin = std::min(count, chunk * chunkSize);
+        if (output != begin)
+        {
+            std::move(values.begin() + begin, values.begin() + begin + kept[chunk], values.begin() + output);
+        }
+        output += kept[chunk];
+    }
+
+    values.resize(output);
+    return output;
+}
+
+/**
+ * @brief 区間ごとにまとめた要素番号のリスト（CSR形式）
+ *
+ * バケット b に属する要素は items[offsets[b], offsets[b + 1]) に要素番号順に並ぶ。
+ */
+struct Buckets {
+    std::vector<std::uint32_t> offsets;  ///< バケットごとの開始位置（バケット数 + 1）
+    std::vector<std::uint32_t> items;    ///< 要素番号
+};
+
+/**
+ * @brief 各要素を、その要素が覆う連続したバケットの範囲すべてに登録する（並列区間インデックス）
+ *
+ * 1. チャンクごとにバケット別の件数を数える
+ * 2. バケット優先・チャンク順の累積和で書き込み位置を決める
+ * 3. 各チャンクが自分の書き込み位置へ要素番号を書き込む
+ *
+ * 書き込み位置はチャンク順に決まるため、並列に構築しても各バケット内は要素番号順になる。
+ *
+ * @tparam RangeOf std::pair<std::int64_t, std::int64_t>(std::size_t index) 形式の関数。
+ *         要素が覆うバケットの閉区間 [first, last] を返す（first > last の場合は空、範囲は [0, bucketCount) 内）
+ * @param count 要素数
+ * @param bucketCount バケット数
+ * @param rangeOf 要素が覆うバケットの範囲を返す関数（2回呼ばれるため副作用を持たないこと）
+ * @param minChunk 1チャンクあたりの最小要素数
+ * @return バケットごとの要素番号のリスト
+ */
+template <typename RangeOf>
+Buckets bucketRanges(std::size_t count, std::size_t bucketCount, RangeOf&& rangeOf,
+                     std::size_t minChunk = DEFAULT_MIN_CHUNK)
+{
+    auto chunks = chunkCount(count, minChunk);
+    auto positions = std::vector<std::vector<std::uint32_t>>(chunks, std::vector<std::uint32_t>(bucketCount, 0));
+    forEachChunk(
+        count,
+        [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+            for (auto i = begin; i < end; ++i)
+            {
+                auto [first, last] = rangeOf(i);
+                for (auto bucket = first; bucket <= last; ++bucket)
+                {
+                    ++positions[chunk][bucket];
+                }
+            }
+        },
+        minChunk);
+
+    auto buckets = Buckets{};
+    buckets.offsets.assign(bucketCount + 1, 0);
+    auto total = std::uint32_t{0};
+    for (std::size_t bucket = 0; bucket < bucketCount; ++bucket)
+    {
+        buckets.offsets[bucket] = total;
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+        {
+            auto bucketCountInChunk = positions[chunk][bucket];
+            positions[chunk][bucket] = total;
+            total += bucketCountInChunk;
+        }
+    }
+    buckets.offsets[bucketCount] = total;
+
+    buckets.items.resize(total);
+    forEachChunk(
+        count,
+        [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+            for (auto i = begin; i < end; ++i)
+            {
+                auto [first, last] = rangeOf(i);
+                for (auto bucket = first; bucket <= last; ++bucket)
+                {
+                    buckets.items[positions[chunk][bucket]++] = static_cast<std::uint32_t>(i);
+                }
+            }
+        },
+        minChunk);
+
+    return buckets;
+}
+
+} // namespace parallel
@@ -0,0 +1,81 @@
+#include "process_memory.h"
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <fstream>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+// 内部定数定義
+namespace
+{
+#if defined(__linux__)
+constexpr std::uint64_t MAXRSS_UNIT{1024}; // Linux の ru_maxrss はキロバイト単位
+#elif !defined(_WIN32)
+constexpr std::uint64_t MAXRSS_UNIT{1};    // macOS の ru_maxrss はバイト単位
+#endif
+
+#if defined(_WIN32)
+/**
+ * @brief プロセスのメモリカウンターを取得する
+ */
+bool processMemoryCounters(PROCESS_MEMORY_COUNTERS &counters)
+{
+    return GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) != 0;
+}
+#endif
+} // namespace
+
+std::uint64_t currentResidentBytes()
+{
+#if defined(_WIN32)
+    auto counters = PROCESS_MEMORY_COUNTERS{};
+    return processMemoryCounters(counters) ? counters.WorkingSetSize : 0;
+#elif defined(__linux__)
+    // /proc/self/statm の2番目の値が常駐ページ数
+    auto statm = std::ifstream{"/proc/self/statm"};
+    auto totalPages = std::uint64_t{0};
+    auto residentPages = std::uint64_t{0};
+    if (!(statm >> totalPages >> residentPages))
+    {
+        return 0;
+    }
+    return residentPages * static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
+
+std::uint64_t peakResidentBytes()
+{
+#if defined(_WIN32)
+    auto counters = PROCESS_MEMORY_COUNTERS{};
+    return processMemoryCounters(counters) ? counters.PeakWorkingSetSize : 0;
+#else
+    auto usage = rusage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+    return static_cast<std::uint64_t>(usage.ru_maxrss) * MAXRSS_UNIT;
+#endif
+}
+
+std::uint64_t pageFaultCount()
+{
+#if defined(_WIN32)
+    auto counters = PROCESS_MEMORY_COUNTERS{};
+    return processMemoryCounters(counters) ? counters.PageFaultCount : 0;
+#else
+    auto usage = rusage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+    return static_cast<std::uint64_t>(usage.ru_minflt) + static_cast<std::uint64_t>(usage.ru_majflt);
+#endif
+}
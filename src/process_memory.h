@@ -0,0 +1,34 @@
+/**
+ * @file process_memory.h
+ * @brief プロセスの使用メモリ（常駐セットサイズ）とページフォルト数の取得
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief プロセスの現在の常駐セットサイズ（物理メモリ使用量）を取得する
+ *
+ * @return バイト数（取得できない環境では0）
+ */
+std::uint64_t currentResidentBytes();
+
+/**
+ * @brief プロセス開始以降の常駐セットサイズの最大値（ハイウォーターマーク）を取得する
+ *
+ * @return バイト数（取得できない環境では0）
+ */
+std::uint64_t peakResidentBytes();
+
+/**
+ * @brief プロセス開始以降のページフォルト数（マイナー・メジャーの合計）を取得する
+ *
+ * 新しく確保した領域に初めて触れるとページフォルトが発生するため、
+ * 2時点の差から処理中に物理ページを割り当てた回数の目安が分かる。
+ *
+ * @return フォルト数（取得できない環境では0）
+ */
+std::uint64_t pageFaultCount();
@@ -1,8 +1,10 @@
 #include "shader.h"
+#include "trace.h"
 #include <fstream>
 #include <glm/gtc/type_ptr.hpp>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 // 内部定数定義
 namespace
@@ -112,6 +114,13 @@ void Shader::setVec3(const std::string &name, const glm::vec3 &value) const
     });
 }
 
+void Shader::setVec4(const std::string &name, const glm::vec4 &value) const
+{
+    setUniformImpl(name, value, [](GLint location, const glm::vec4& val) {
+        glUniform4fv(location, 1, &val[0]);
+    });
+}
+
 void Shader::setMat4(const std::string &name, const glm::mat4 &value) const
 {
     setUniformImpl(name, value, [](GLint location, const glm::mat4& val) {
@@ -135,6 +144,8 @@ std::string Shader::loadShaderFile(const std::string &filePath)
 
 unsigned int Shader::compileShader(const std::string &source, GLenum type) const
 {
+    TRACE_SCOPE(type == GL_VERTEX_SHADER ? "Compile vertex shader" : "Compile fragment shader");
+
     auto shader = glCreateShader(type);
     auto *src = source.c_str();
     glShaderSource(shader, 1, &src, nullptr);
@@ -161,6 +172,8 @@ unsigned int Shader::compileShader(const std::string &source, GLenum type) const
 
 bool Shader::linkProgram(unsigned int vertexShader, unsigned int fragmentShader)
 {
+    TRACE_SCOPE("Link shader program");
+
     programID = glCreateProgram();
     glAttachShader(programID, vertexShader);
     glAttachShader(programID, fragmentShader);
@@ -123,6 +123,14 @@ public:
      */
     void setVec3(const std::string& name, const glm::vec3& value) const;
     
+    /**
+     * @brief vec4 型の uniform 変数を設定する
+     * 
+     * @param name uniform 変数名
+     * @param value 設定する値
+     */
+    void setVec4(const std::string& name, const glm::vec4& value) const;
+    
     /**
      * @brief mat4 型の uniform 変数を設定する
      * 
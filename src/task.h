@@ -0,0 +1,493 @@
+/**
+ * @file task.h
+ * @brief C++20 コルーチンによる非同期タスク型の定義
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+template <typename T> class Task;
+class TaskScope;
+
+namespace detail {
+
+/**
+ * @brief Task の promise 共通部分
+ *
+ * 完了時に co_await していた呼び出し元（continuation）へ対称転送で制御を戻す。
+ */
+struct TaskPromiseBase {
+    std::coroutine_handle<> continuation;  ///< 完了時に再開するコルーチン
+    std::exception_ptr exception;          ///< タスク内で送出された例外
+
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept
+        {
+            auto next = handle.promise().continuation;
+            return next ? next : std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { exception = std::current_exception(); }
+};
+
+template <typename T>
+struct TaskPromise : TaskPromiseBase {
+    std::optional<T> value;  ///< タスクの戻り値
+
+    Task<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U&& result) { value.emplace(std::forward<U>(result)); }
+
+    T takeResult()
+    {
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+        return std::move(*value);
+    }
+};
+
+template <>
+struct TaskPromise<void> : TaskPromiseBase {
+    Task<void> get_return_object() noexcept;
+
+    void return_void() noexcept {}
+
+    void takeResult()
+    {
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+};
+
+/**
+ * @brief 結果を待たずに実行を開始する内部用コルーチン型
+ *
+ * 生成時に TaskScope へ登録され、完了時にフレームは自動で破棄されて登録も解除される。
+ * TaskScope::spawn() の実装にのみ使用する。
+ */
+struct DetachedTask {
+    struct promise_type {
+        TaskScope* scope;  ///< フレームを登録するスコープ
+
+        template <typename... Args>
+        explicit promise_type(TaskScope& scope, Args&...) noexcept : scope{&scope} {}
+
+        ~promise_type();
+
+        DetachedTask get_return_object();
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+
+        // タスクの例外は runDetached() 内で捕捉して通知するため、ここに届くのはコールバックの例外のみ
+        void unhandled_exception() const noexcept
+        {
+            try
+            {
+                throw;
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "Error: Exception in task completion callback: " << e.what() << std::endl;
+            }
+            catch (...)
+            {
+                std::cerr << "Error: Unknown exception in task completion callback" << std::endl;
+            }
+        }
+    };
+};
+
+} // namespace detail
+
+/**
+ * @brief 遅延開始型の非同期タスク
+ *
+ * co_await されるまで実行を開始しない。タスク内では scheduleOn() を
+ * co_await することでエグゼキューター間を移動でき、コールバックを使わずに
+ * 「I/O → CPU処理 → GPU転送」のような処理を直線的に記述できる。
+ *
+ * @tparam T タスクの戻り値の型
+ * @note ムーブのみ可能
+ */
+template <typename T>
+class Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle{handle} {}
+
+    Task(Task&& other) noexcept : handle{std::exchange(other.handle, nullptr)} {}
+
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            destroy();
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+
+    ~Task() { destroy(); }
+
+    // コルーチンフレームを所有するためコピー禁止
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    bool await_ready() const noexcept { return !handle || handle.done(); }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+    {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+
+    T await_resume() { return handle.promise().takeResult(); }
+
+private:
+    std::coroutine_handle<promise_type> handle;  ///< 所有するコルーチンフレーム
+
+    void destroy() noexcept
+    {
+        if (handle)
+        {
+            handle.destroy();
+            handle = nullptr;
+        }
+    }
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept
+{
+    return Task<T>{std::coroutine_handle<TaskPromise<T>>::from_promise(*this)};
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept
+{
+    return Task<void>{std::coroutine_handle<TaskPromise<void>>::from_promise(*this)};
+}
+
+template <typename T, typename Callback, typename ErrorCallback>
+DetachedTask runDetached(TaskScope&, Task<T> task, Callback onComplete, ErrorCallback onError)
+{
+    // コールバック自体の例外をタスクの失敗として扱わないよう、捕捉するのは co_await のみとする
+    auto error = std::exception_ptr{};
+    if constexpr (std::is_void_v<T>)
+    {
+        try
+        {
+            co_await task;
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        if (error)
+        {
+            onError(error);
+        }
+        else
+        {
+            onComplete();
+        }
+    }
+    else
+    {
+        auto result = std::optional<T>{};
+        try
+        {
+            result.emplace(co_await task);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        if (error)
+        {
+            onError(error);
+        }
+        else
+        {
+            onComplete(std::move(*result));
+        }
+    }
+}
+
+} // namespace detail
+
+namespace detail {
+
+/**
+ * @brief whenAll() の子タスクの完了を数える共有状態
+ */
+struct WhenAllState {
+    std::atomic<std::size_t> remaining;       ///< 未完了の子タスク数 + 開始処理中の1
+    std::coroutine_handle<> continuation;     ///< 全ての子タスクの完了後に再開する whenAll() のフレーム
+    std::vector<std::exception_ptr> errors;   ///< 子タスクごとの例外
+};
+
+/**
+ * @brief whenAll() の子タスクを実行する内部用コルーチン型
+ *
+ * 完了時にフレームを中断したまま残し、最後に完了した子タスクが whenAll() を対称転送で再開する。
+ * フレームは whenAll() が破棄する。
+ */
+struct WhenAllChild {
+    struct promise_type {
+        WhenAllState* state;  ///< 完了を通知する共有状態
+
+        template <typename... Args>
+        explicit promise_type(WhenAllState& state, Args&...) noexcept : state{&state} {}
+
+        struct FinalAwaiter {
+            bool await_ready() const noexcept { return false; }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) const noexcept
+            {
+                auto* state = handle.promise().state;
+                return state->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1 ? state->continuation
+                                                                                      : std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        WhenAllChild get_return_object() noexcept
+        {
+            return WhenAllChild{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+
+        // タスクの例外は runWhenAllChild() 内で捕捉するため、ここには届かない
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+
+    explicit WhenAllChild(std::coroutine_handle<promise_type> handle) noexcept : handle{handle} {}
+
+    WhenAllChild(WhenAllChild&& other) noexcept : handle{std::exchange(other.handle, nullptr)} {}
+
+    ~WhenAllChild()
+    {
+        if (handle)
+        {
+            handle.destroy();
+        }
+    }
+
+    // コルーチンフレームを所有するためコピー禁止
+    WhenAllChild(const WhenAllChild&) = delete;
+    WhenAllChild& operator=(const WhenAllChild&) = delete;
+    WhenAllChild& operator=(WhenAllChild&&) = delete;
+
+    std::coroutine_handle<promise_type> handle;  ///< 所有するコルーチンフレーム
+};
+
+inline WhenAllChild runWhenAllChild(WhenAllState& state, Task<void>& task, std::size_t index)
+{
+    try
+    {
+        co_await task;
+    }
+    catch (...)
+    {
+        state.errors[index] = std::current_exception();
+    }
+}
+
+/**
+ * @brief 子タスクを順に開始し、全ての完了まで whenAll() を中断する awaitable
+ */
+struct WhenAllAwaiter {
+    WhenAllState& state;
+    std::vector<WhenAllChild>& children;
+
+    bool await_ready() const noexcept { return children.empty(); }
+
+    bool await_suspend(std::coroutine_handle<> awaiting) noexcept
+    {
+        state.continuation = awaiting;
+        for (auto& child : children)
+        {
+            child.handle.resume();
+        }
+
+        // 開始処理中の1を最後に減らした場合は、全ての子タスクが既に完了しているので中断せずに続ける
+        return state.remaining.fetch_sub(1, std::memory_order_acq_rel) != 1;
+    }
+
+    void await_resume() const noexcept {}
+};
+
+} // namespace detail
+
+/**
+ * @brief 複数のタスクを同時に実行中にし、全ての完了を待つ
+ *
+ * 各タスクは呼び出しスレッドで順に開始され、最初の中断（scheduleOn() による移動等）で次のタスクの開始に移る。
+ * 各タスクが別のワーカーへ移れば並行に実行される。呼び出し元は最後に完了したタスクのスレッドで再開する。
+ *
+ * @code
+ * co_await whenAll(std::move(tasks));   // 全ての子タスクの完了後に続きを実行する
+ * @endcode
+ *
+ * @param tasks 実行するタスク
+ * @return 全てのタスクの完了を待つタスク
+ * @throw タスクが送出した例外（全てのタスクの完了を待ってから、タスクの順で最初のものを再送出する）
+ * @note タスク同士は互いに重ならないデータにのみ書き込むこと
+ */
+inline Task<void> whenAll(std::vector<Task<void>> tasks)
+{
+    auto state = detail::WhenAllState{};
+    state.remaining.store(tasks.size() + 1, std::memory_order_relaxed);
+    state.errors.resize(tasks.size());
+
+    auto children = std::vector<detail::WhenAllChild>{};
+    children.reserve(tasks.size());
+    for (std::size_t i = 0; i < tasks.size(); ++i)
+    {
+        children.push_back(detail::runWhenAllChild(state, tasks[i], i));
+    }
+    co_await detail::WhenAllAwaiter{state, children};
+
+    for (const auto& error : state.errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+/**
+ * @brief 結果を待たずに実行中のタスクを所有するスコープ
+ *
+ * spawn() で開始したタスクのフレームを完了まで登録しておき、
+ * 破棄時に中断したままのフレームをまとめて破棄する。
+ * エグゼキューターが停止した後に中断中のフレームがリークしないよう、
+ * タスクを再開しうる全てのエグゼキューターより後に破棄すること。
+ *
+ * @note spawn() はスレッドセーフ
+ */
+class TaskScope {
+public:
+    TaskScope() = default;
+
+    /**
+     * @brief デストラクタ
+     *
+     * destroyPending() で完了していないタスクのフレームを破棄する。
+     *
+     * @pre タスクを再開しうるエグゼキューターは全て停止済みであること
+     */
+    ~TaskScope() { destroyPending(); }
+
+    // フレームを所有するためコピー・ムーブ禁止
+    TaskScope(const TaskScope&) = delete;
+    TaskScope& operator=(const TaskScope&) = delete;
+
+    /**
+     * @brief 完了していないタスクのフレームを破棄する
+     *
+     * co_await 中の Task もフレームの所有関係に従って連鎖的に破棄される。完了コールバックは呼ばれない。
+     * タスクが参照する状態より後にスコープを破棄する所有者は、その状態を破棄する前に呼び出す。
+     *
+     * @pre タスクを再開しうるエグゼキューターは全て停止済みであること
+     */
+    void destroyPending()
+    {
+        // フレームの破棄中に登録解除で再入するため、ロックを保持したまま破棄しない
+        auto remaining = std::unordered_set<void*>{};
+        {
+            auto lock = std::lock_guard<std::mutex>{mutex};
+            remaining.swap(frames);
+        }
+        for (auto* address : remaining)
+        {
+            std::coroutine_handle<>::from_address(address).destroy();
+        }
+    }
+
+    /**
+     * @brief タスクを呼び出しスレッドで開始し、完了時にコールバックを呼ぶ
+     *
+     * 複数のタスクを同時に実行中にしておくための起点として使用する。
+     * コールバックはタスクが最後に実行されていたスレッドで呼ばれる。
+     *
+     * @param task 開始するタスク
+     * @param onComplete 完了時に戻り値を受け取るコールバック
+     * @param onError タスクが例外で終了したときに std::exception_ptr を受け取るコールバック
+     */
+    template <typename T, typename Callback, typename ErrorCallback>
+    void spawn(Task<T> task, Callback onComplete, ErrorCallback onError)
+    {
+        detail::runDetached(*this, std::move(task), std::move(onComplete), std::move(onError));
+    }
+
+private:
+    friend struct detail::DetachedTask::promise_type;
+
+    std::unordered_set<void*> frames;  ///< 完了していないフレームのアドレス
+    std::mutex mutex;                  ///< frames 保護用
+
+    void add(void* address)
+    {
+        auto lock = std::lock_guard<std::mutex>{mutex};
+        frames.insert(address);
+    }
+
+    void remove(void* address) noexcept
+    {
+        auto lock = std::lock_guard<std::mutex>{mutex};
+        frames.erase(address);
+    }
+};
+
+namespace detail {
+
+inline DetachedTask DetachedTask::promise_type::get_return_object()
+{
+    scope->add(std::coroutine_handle<promise_type>::from_promise(*this).address());
+    return {};
+}
+
+inline DetachedTask::promise_type::~promise_type()
+{
+    scope->remove(std::coroutine_handle<promise_type>::from_promise(*this).address());
+}
+
+} // namespace detail
@@ -0,0 +1,192 @@
+#include "trace.h"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <new>
+#include <string_view>
+
+// 内部定数定義
+namespace
+{
+constexpr std::size_t EVENTS_PER_THREAD{1 << 14};  // スレッドごとのリングバッファのイベント数
+constexpr double NANOSECONDS_PER_MICROSECOND{1e3}; // トレース形式の時刻はマイクロ秒
+constexpr int TRACE_PROCESS_ID{1};                 // トレース上のプロセスID
+
+/**
+ * @brief 完了したスコープ1つ分のイベント
+ */
+struct Event
+{
+    const char *name = nullptr; ///< イベント名
+    std::int64_t start = 0;     ///< 開始時刻（ナノ秒）
+    std::int64_t end = 0;       ///< 終了時刻（ナノ秒）
+};
+
+/**
+ * @brief 1スレッド分のリングバッファ
+ *
+ * 書き込むのは所有するスレッドのみで、書き出し時は written を acquire で読んでから要素を読む。
+ * スレッドの終了後もイベントを書き出せるよう、確保したバッファはプロセス終了まで解放しない。
+ */
+struct ThreadBuffer
+{
+    std::array<Event, EVENTS_PER_THREAD> events;   ///< イベント（記録数を容量で割った余りの位置に書き込む）
+    std::atomic<std::uint64_t> written{0};         ///< これまでに記録したイベント数
+    std::atomic<const char *> threadName{nullptr}; ///< スレッド名（未設定の場合はnullptr）
+    std::uint32_t threadId = 0;                    ///< トレース上のスレッドID
+    ThreadBuffer *next = nullptr;                  ///< 登録済みの次のバッファ
+};
+
+std::atomic<ThreadBuffer *> registeredBuffers{nullptr}; // 全スレッドのバッファ（ロックなしの連結リスト）
+std::atomic<std::uint32_t> nextThreadId{1};             // 次に割り当てるスレッドID
+std::atomic<std::int64_t> traceEpoch{0};                // 記録開始時刻（トレースの時刻0）
+std::atomic<std::uint64_t> unregisteredEvents{0};       // バッファの無いスレッドで記録できなかったイベント数
+thread_local ThreadBuffer *localBuffer = nullptr;       // 呼び出し元のスレッドのバッファ
+
+/**
+ * @brief 呼び出し元のスレッドのバッファを確保して登録する
+ *
+ * @return 登録したバッファ（確保に失敗した場合はnullptr）
+ */
+ThreadBuffer *registerThreadBuffer() noexcept
+{
+    auto *buffer = new (std::nothrow) ThreadBuffer{};
+    if (!buffer)
+    {
+        return nullptr;
+    }
+    buffer->threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    buffer->next = registeredBuffers.load(std::memory_order_relaxed);
+    while (!registeredBuffers.compare_exchange_weak(buffer->next, buffer, std::memory_order_release,
+                                                    std::memory_order_relaxed))
+    {
+    }
+    return buffer;
+}
+
+/**
+ * @brief JSON の文字列として書き出す
+ */
+void writeJsonString(std::ostream &out, std::string_view text)
+{
+    out << '"';
+    for (auto c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out << '\\';
+        }
+        out << c;
+    }
+    out << '"';
+}
+
+/**
+ * @brief 時刻をトレースの時刻0からのマイクロ秒に変換する
+ */
+double microsecondsSinceEpoch(std::int64_t nanoseconds, std::int64_t epoch)
+{
+    return static_cast<double>(nanoseconds - epoch) / NANOSECONDS_PER_MICROSECOND;
+}
+} // namespace
+
+namespace trace
+{
+namespace detail
+{
+std::atomic<bool> enabled{false};
+
+void record(const char *name, std::int64_t startNanoseconds, std::int64_t endNanoseconds) noexcept
+{
+    auto *buffer = localBuffer;
+    if (!buffer)
+    {
+        unregisteredEvents.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    auto index = buffer->written.load(std::memory_order_relaxed);
+    buffer->events[index % EVENTS_PER_THREAD] = Event{name, startNanoseconds, endNanoseconds};
+    buffer->written.store(index + 1, std::memory_order_release);
+}
+} // namespace detail
+
+void enable() noexcept
+{
+    auto expected = std::int64_t{0};
+    traceEpoch.compare_exchange_strong(expected, detail::now(), std::memory_order_relaxed);
+    detail::enabled.store(true, std::memory_order_relaxed);
+}
+
+void disable() noexcept
+{
+    detail::enabled.store(false, std::memory_order_relaxed);
+}
+
+void setThreadName(const char *name) noexcept
+{
+    if (!localBuffer && isEnabled())
+    {
+        localBuffer = registerThreadBuffer();
+    }
+    if (localBuffer)
+    {
+        localBuffer->threadName.store(name, std::memory_order_relaxed);
+    }
+}
+
+bool writeChromeTrace(const std::filesystem::path &path, std::string &errorMessage)
+{
+    disable();
+
+    auto file = std::ofstream{path};
+    if (!file)
+    {
+        errorMessage = "Cannot open trace output file: " + path.string();
+        return false;
+    }
+
+    auto epoch = traceEpoch.load(std::memory_order_relaxed);
+    auto dropped = unregisteredEvents.load(std::memory_order_relaxed);
+    auto first = true;
+    auto separator = [&]() -> std::ostream & {
+        file << (first ? "\n" : ",\n");
+        first = false;
+        return file;
+    };
+
+    file << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+    for (auto *buffer = registeredBuffers.load(std::memory_order_acquire); buffer; buffer = buffer->next)
+    {
+        if (auto *name = buffer->threadName.load(std::memory_order_relaxed))
+        {
+            separator() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << TRACE_PROCESS_ID
+                        << ",\"tid\":" << buffer->threadId << ",\"args\":{\"name\":";
+            writeJsonString(file, name);
+            file << "}}";
+        }
+
+        // 容量を超えた分は古いイベントが上書きされている
+        auto written = buffer->written.load(std::memory_order_acquire);
+        auto count = std::min<std::uint64_t>(written, EVENTS_PER_THREAD);
+        dropped += written - count;
+        for (auto i = written - count; i < written; ++i)
+        {
+            const auto &event = buffer->events[i % EVENTS_PER_THREAD];
+            separator() << "{\"name\":";
+            writeJsonString(file, event.name);
+            file << ",\"ph\":\"X\",\"ts\":" << microsecondsSinceEpoch(event.start, epoch)
+                 << ",\"dur\":" << microsecondsSinceEpoch(event.end, event.start) << ",\"pid\":" << TRACE_PROCESS_ID
+                 << ",\"tid\":" << buffer->threadId << "}";
+        }
+    }
+    file << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped_events\":" << dropped << "}}\n";
+
+    if (!file)
+    {
+        errorMessage = "Failed to write trace output file: " + path.string();
+        return false;
+    }
+    return true;
+}
+} // namespace trace
@@ -0,0 +1,127 @@
+/**
+ * @file trace.h
+ * @brief 処理段階の所要時間を記録し Chrome のトレース形式（JSON）で出力する軽量トレース
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+/**
+ * @brief スコープの所要時間を記録するトレース
+ *
+ * 各スレッドは setThreadName() で名前を付けたときに固定長のリングバッファを確保し、以降はロックなしで
+ * 自スレッドのバッファに書き込む（容量を超えると古いイベントから上書きする）。記録時には確保しないため、
+ * 名前を付けていないスレッドのイベントは記録せず、欠落したイベント数に数える。無効時の TRACE_SCOPE は
+ * フラグの読み込みと分岐のみで、時刻の取得も行わない。
+ * 出力した JSON は chrome://tracing や Perfetto（https://ui.perfetto.dev）で表示できる。
+ */
+namespace trace
+{
+namespace detail
+{
+extern std::atomic<bool> enabled; ///< 記録が有効か
+
+/**
+ * @brief 完了したスコープを呼び出し元のスレッドのリングバッファに記録する
+ *
+ * バッファの無いスレッド（setThreadName() を呼んでいないスレッド）では欠落したイベントとして数えるのみ。
+ */
+void record(const char *name, std::int64_t startNanoseconds, std::int64_t endNanoseconds) noexcept;
+
+/**
+ * @brief 記録に使う時刻（ナノ秒）を取得する
+ */
+inline std::int64_t now() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+} // namespace detail
+
+/**
+ * @brief 記録が有効かを取得する
+ */
+inline bool isEnabled() noexcept
+{
+    return detail::enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief 記録を開始する（これ以降に開始したスコープが記録される）
+ */
+void enable() noexcept;
+
+/**
+ * @brief 記録を停止する（記録済みのイベントは保持する）
+ */
+void disable() noexcept;
+
+/**
+ * @brief 呼び出し元のスレッドにトレース上の名前を付け、記録用のバッファを登録する
+ *
+ * 記録が有効な場合のみバッファを確保する（確保に失敗した場合はこのスレッドのイベントを記録しない）。
+ * イベントを記録するスレッドは、enable() の後、最初のスコープの前に呼ぶこと。
+ *
+ * @param name スレッド名（文字列リテラル等、プロセス終了まで有効な文字列）
+ */
+void setThreadName(const char *name) noexcept;
+
+/**
+ * @brief 記録したイベントを Chrome のトレース形式で書き出す
+ *
+ * 記録を停止してから書き出すため、他のスレッドが記録中でないときに呼ぶこと。
+ *
+ * @param path 出力先
+ * @param errorMessage [out] 失敗時のエラーメッセージ
+ * @return 書き出しに成功した場合はtrue
+ */
+bool writeChromeTrace(const std::filesystem::path& path, std::string& errorMessage);
+
+/**
+ * @brief 生成から破棄までを1つのイベントとして記録するスコープ
+ *
+ * コルーチンの co_await をまたぐと開始と終了が別のスレッドになるため、co_await を含まない範囲で使う。
+ */
+class Scope {
+public:
+    /**
+     * @brief 記録が有効な場合のみ開始時刻を取得する
+     *
+     * @param name イベント名（文字列リテラル等、プロセス終了まで有効な文字列）
+     */
+    explicit Scope(const char *name) noexcept
+        : name{isEnabled() ? name : nullptr}, start{this->name ? detail::now() : 0}
+    {
+    }
+
+    ~Scope()
+    {
+        if (name)
+        {
+            detail::record(name, start, detail::now());
+        }
+    }
+
+    // 1回だけ記録するためコピー・ムーブ禁止
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    const char *name;   ///< イベント名（記録しない場合はnullptr）
+    std::int64_t start; ///< 開始時刻（ナノ秒）
+};
+} // namespace trace
+
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+
+/// 現在のスコープの終わりまでを name のイベントとして記録する
+#define TRACE_SCOPE(name) ::trace::Scope TRACE_CONCAT(traceScope, __LINE__){name}
@@ -1,11 +1,25 @@
 #include "viewer.h"
 #include "model_loader.h"
+#include "mesh_bvh.h"
+#include "mesh_cache.h"
+#include "mesh_hash.h"
+#include "mesh_points.h"
+#include "mesh_vertices.h"
+#include "parallel.h"
+#include "trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <numbers>
 #include <sstream>
 #include <array>
-#include <boost/range/adaptor/transformed.hpp>
-#include <boost/range/join.hpp>
-#include <boost/range/algorithm/copy.hpp>
 
 // 内部定数定義
 namespace
@@ -21,18 +35,60 @@ constexpr float FOV_DEGREES{45.0f};
 constexpr float NEAR_PLANE{0.1f};
 constexpr float FAR_PLANE{100.0f};
 constexpr float CAMERA_DISTANCE{8.0f};
+constexpr float CAMERA_ORBIT_START{std::numbers::pi_v<float> / 4.0f}; // 周回の開始角（初期位置と同じ XZ 平面上の45度）
 
 // 描画設定
 constexpr float AXIS_LENGTH{2.0f};
 constexpr float LINE_WIDTH{3.0f};
 constexpr float MODEL_DESIRED_SIZE{1.5f};
 constexpr float SCROLL_SENSITIVITY{0.3f};
+constexpr float OVERLAY_LINE_WIDTH{2.0f};
+constexpr float SLICE_LINE_WIDTH{1.0f};
+constexpr float MODEL_POLYGON_OFFSET_FACTOR{1.0f}; // 面上の輪郭線が隠れないようモデルの面を奥へずらす
+constexpr float MODEL_POLYGON_OFFSET_UNITS{1.0f};
+
+// 断面表示設定
+constexpr int STENCIL_BITS{8};
+constexpr float CLIP_DRAG_SENSITIVITY{0.005f}; // 1ピクセルあたりの平面の移動量
+constexpr float CLIP_OFFSET_LIMIT{2.0f};       // 平面の移動範囲（座標軸の長さ程度）
+constexpr float CAP_HALF_SIZE{4.0f};           // 断面の四角形の半径（正規化後のモデル全体を覆う大きさ）
+constexpr int CAP_VERTICES{6};
+constexpr std::size_t MAX_CULLED_SHELLS{4096}; // これを超えるシェル数では毎フレームのカリングを省略する
+constexpr std::size_t MAX_LOGGED_PART_CONTACTS{10}; // 個別に出力する干渉している部品の組の最大数
+constexpr float SHELL_COLOR_HUE_STEP{0.618034f}; // 隣接シェルの色相が離れるよう黄金比で回す
+constexpr float SHELL_COLOR_SATURATION{0.5f};
+constexpr float SHELL_COLOR_VALUE{0.9f};
+constexpr float HEAT_MAP_MEDIAN_SCALE{2.0f}; // ヒートマップの色の上限（肉厚の中央値に対する倍率）
 
 // 色設定
 constexpr float MODEL_COLOR_R{0.8f};
 constexpr float MODEL_COLOR_G{0.8f};
 constexpr float MODEL_COLOR_B{0.8f};
 
+constexpr float BOUNDARY_EDGE_R{1.0f};     // 境界辺（赤）
+constexpr float BOUNDARY_EDGE_G{0.2f};
+constexpr float BOUNDARY_EDGE_B{0.2f};
+
+constexpr float NON_MANIFOLD_EDGE_R{1.0f}; // 非多様体辺（マゼンタ）
+constexpr float NON_MANIFOLD_EDGE_G{0.0f};
+constexpr float NON_MANIFOLD_EDGE_B{1.0f};
+
+constexpr float SLICE_CONTOUR_R{0.0f};     // スライス輪郭（シアン）
+constexpr float SLICE_CONTOUR_G{0.9f};
+constexpr float SLICE_CONTOUR_B{0.9f};
+
+constexpr float INTERFERENCE_R{1.0f};      // 干渉部の交線（黄）
+constexpr float INTERFERENCE_G{0.9f};
+constexpr float INTERFERENCE_B{0.0f};
+
+constexpr float FEATURE_EDGE_R{0.1f};     // 特徴辺（濃い灰色）
+constexpr float FEATURE_EDGE_G{0.1f};
+constexpr float FEATURE_EDGE_B{0.1f};
+
+constexpr float CLIP_CAP_R{1.0f};          // 断面の塗りつぶし（オレンジ）
+constexpr float CLIP_CAP_G{0.55f};
+constexpr float CLIP_CAP_B{0.2f};
+
 constexpr float BACKGROUND_R{0.2f};
 constexpr float BACKGROUND_G{0.2f};
 constexpr float BACKGROUND_B{0.2f};
@@ -47,7 +103,7 @@ constexpr const char* VERTEX_SHADER_PATH{"shaders/vertex.glsl"};
 constexpr const char* FRAGMENT_SHADER_PATH{"shaders/fragment.glsl"};
 
 // 頂点データ構造
-constexpr int VERTEX_COMPONENTS{9}; // 位置3 + 色3 + 法線3
+constexpr int VERTEX_COMPONENTS{INTERLEAVED_VERTEX_COMPONENTS}; // 位置3 + 色3 + 法線3
 constexpr int NORMAL_COMPONENTS{3}; // 法線ベクトルの要素数
 constexpr int POSITION_COMPONENTS{3};
 constexpr int COLOR_COMPONENTS{3};
@@ -59,14 +115,205 @@ constexpr int AXIS_VERTICES{2}; // 原点と先端
 constexpr int POSITION_ATTRIBUTE_INDEX{0};
 constexpr int COLOR_ATTRIBUTE_INDEX{1};
 constexpr int NORMAL_ATTRIBUTE_INDEX{2};
+constexpr int SCALAR_ATTRIBUTE_INDEX{3}; // 頂点ごとのスカラー値（肉厚）
+constexpr int DEVIATION_ATTRIBUTE_INDEX{4}; // 頂点ごとの量子化した偏差
+constexpr int OCCLUSION_ATTRIBUTE_INDEX{5}; // 頂点ごとの環境遮蔽
+constexpr const char *OCCLUSION_CACHE_KIND{"ao"}; // 環境遮蔽のキャッシュ種別（光線数を付加する）
+constexpr const char *FEATURE_CACHE_KIND{"edges"}; // 特徴辺のキャッシュ種別（しきい値を付加する）
+constexpr float FEATURE_CACHE_ANGLE_SCALE{100.0f}; // キャッシュ種別に付加するしきい値の単位（0.01度）
+constexpr float FEATURE_EDGE_LINE_WIDTH{1.5f};
+constexpr float MODEL_BOUNDING_RADIUS_RATIO{0.8660254f}; // 外接球の半径の上限（最大辺に対する √3/2 倍）
+
+// 非同期読み込み設定
+constexpr std::size_t IO_THREAD_COUNT{2}; // I/O待ちはCPUを使わないため少数で十分
+
+/**
+ * @brief 2つの連続配列の内容がバイト単位で一致するかを判定する
+ *
+ * @param lhs 比較する配列
+ * @param rhs 比較する配列
+ * @return 要素数と全バイトが一致する場合はtrue
+ */
+template <typename Lhs, typename Rhs>
+bool sameBytes(const Lhs &lhs, const Rhs &rhs)
+{
+    return lhs.size() == rhs.size() &&
+           (lhs.empty() || std::memcmp(lhs.data(), rhs.data(), lhs.size() * sizeof(lhs[0])) == 0);
+}
+
+/**
+ * @brief ファイル全体をバイト列として読み込む
+ *
+ * @param filePath 読み込むファイルのパス
+ * @param data [out] 読み込んだバイト列
+ * @return 読み込み成功時はtrue、失敗時はfalse
+ */
+bool readFileBytes(const std::string &filePath, std::pmr::vector<char> &data)
+{
+    TRACE_SCOPE("Read file");
+
+    auto file = std::ifstream{filePath, std::ios::binary | std::ios::ate};
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    auto size = static_cast<std::streamsize>(file.tellg());
+    if (size <= 0)
+    {
+        return false;
+    }
+
+    data.resize(static_cast<std::size_t>(size));
+    file.seekg(0);
+    return static_cast<bool>(file.read(data.data(), size));
+}
+
+/**
+ * @brief 処理を指定したエグゼキューター上で実行するタスクを返す（whenAll() で並行に実行する子タスク用）
+ *
+ * @param executor 実行先のエグゼキューター
+ * @param work 実行する処理（タスクのフレームにムーブされる）
+ * @return 処理の完了で完了するタスク
+ */
+Task<void> runOn(Executor &executor, std::function<void()> work)
+{
+    co_await scheduleOn(executor);
+    work();
+}
+
+/**
+ * @brief HSV色をRGB色に変換する
+ *
+ * @param hue 色相 [0, 1)
+ * @param saturation 彩度 [0, 1]
+ * @param value 明度 [0, 1]
+ * @return RGB色
+ */
+glm::vec3 hsvToRgb(float hue, float saturation, float value)
+{
+    auto h = hue * 6.0f;
+    auto sector = static_cast<int>(h) % 6;
+    auto f = h - std::floor(h);
+    auto p = value * (1.0f - saturation);
+    auto q = value * (1.0f - saturation * f);
+    auto t = value * (1.0f - saturation * (1.0f - f));
+    switch (sector)
+    {
+    case 0:
+        return {value, t, p};
+    case 1:
+        return {q, value, p};
+    case 2:
+        return {p, value, t};
+    case 3:
+        return {p, q, value};
+    case 4:
+        return {t, p, value};
+    default:
+        return {value, p, q};
+    }
+}
+
+/**
+ * @brief シェル番号から表示色を決める
+ */
+glm::vec3 shellColor(std::size_t shell)
+{
+    auto hue = static_cast<float>(shell) * SHELL_COLOR_HUE_STEP;
+    return hsvToRgb(hue - std::floor(hue), SHELL_COLOR_SATURATION, SHELL_COLOR_VALUE);
+}
+
+/**
+ * @brief バウンディングボックスが視錐台と交差する可能性があるか判定する
+ *
+ * 8頂点をクリップ座標に変換し、すべての頂点が同じクリップ平面の外側にある場合のみ
+ * 不可視とする（保守的な判定）。
+ *
+ * @param mvp モデル・ビュー・プロジェクション行列
+ * @param minBounds バウンディングボックスの最小座標
+ * @param maxBounds バウンディングボックスの最大座標
+ * @return 可視の可能性がある場合はtrue
+ */
+bool isBoxInFrustum(const glm::mat4 &mvp, const glm::vec3 &minBounds, const glm::vec3 &maxBounds)
+{
+    auto corners = std::array<glm::vec4, 8>{};
+    for (int i = 0; i < 8; ++i)
+    {
+        corners[i] = mvp * glm::vec4{(i & 1) ? maxBounds.x : minBounds.x, (i & 2) ? maxBounds.y : minBounds.y,
+                                     (i & 4) ? maxBounds.z : minBounds.z, 1.0f};
+    }
+
+    // 各座標軸の正負のクリップ平面（-w <= x,y,z <= w）について判定
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        auto allBelow = std::all_of(corners.begin(), corners.end(),
+                                    [axis](const glm::vec4 &corner) { return corner[axis] < -corner.w; });
+        auto allAbove = std::all_of(corners.begin(), corners.end(),
+                                    [axis](const glm::vec4 &corner) { return corner[axis] > corner.w; });
+        if (allBelow || allAbove)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 2つの時刻の差を秒で求める
+ */
+double secondsBetween(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+    return std::chrono::duration<double>(end - start).count();
+}
+
+/**
+ * @brief ウィンドウを表示できる環境か（X11/Wayland の表示先が設定されているか）を判定する
+ */
+bool hasDisplayServer()
+{
+#if defined(_WIN32) || defined(__APPLE__)
+    return true;
+#else
+    return std::getenv("DISPLAY") != nullptr || std::getenv("WAYLAND_DISPLAY") != nullptr;
+#endif
+}
+
+/**
+ * @brief CPU処理用エグゼキューターのスレッド数を決定する
+ */
+std::size_t cpuThreadCount()
+{
+    return std::max(1u, std::thread::hardware_concurrency());
+}
 } // namespace
 
-STLViewer::STLViewer() : window(nullptr, glfwDestroyWindow), axesVAO(0), axesVBO(0), modelVAO(0), modelVBO(0)
+STLViewer::STLViewer()
+    : window(nullptr, glfwDestroyWindow), ioExecutor(IO_THREAD_COUNT, "io"), cpuExecutor(cpuThreadCount(), "cpu"),
+      weldEnabled(true), weldEpsilon(-1.0f), topologyCheckEnabled(false), topologyReport{}, shellColoringEnabled(false), orientationReport{}, meshMetrics{}, modelCenter{0.0f}, sliceLayerCount(0),
+      wallThicknessEnabled(false), wallThickness{}, heatMapVisible(false), interferenceCheckEnabled(false), interferenceReport{},
+      deviationTolerance(0.0f), deviationBits(16), meshDeviation{}, deviationMapVisible(true),
+      ambientOcclusionRays(0), ambientOcclusion{}, ambientOcclusionVisible(true),
+      featureEdgesEnabled(false), featureAngleDegrees(DEFAULT_FEATURE_ANGLE_DEGREES), featureEdges{}, featureEdgesVisible(true),
+      pointSize(DEFAULT_POINT_SIZE), pointTriangleBudget(DEFAULT_POINT_TRIANGLE_BUDGET), vertexPointsVisible(false),
+      headless(false), loadTimings{},
+      clipPlanes{{{{1.0f, 0.0f, 0.0f}, 0.0f, false}, {{0.0f, 1.0f, 0.0f}, 0.0f, false}, {{0.0f, 0.0f, 1.0f}, 0.0f, false}}},
+      activeClipPlane(0), draggingClipPlane(false), lastCursorY(0.0), axesVAO(0), axesVBO(0),
+      modelVAO(0), modelVBO(0), modelEBO(0), modelScalarVBO(0), modelDeviationVBO(0), modelOcclusionVBO(0), topologyVAO(0), topologyVBO(0), topologyVertexCount(0), sliceVAO(0), sliceVBO(0),
+      sliceVertexCount(0), interferenceVAO(0), interferenceVBO(0), interferenceVertexCount(0),
+      featureEdgeVAO(0), featureEdgeVBO(0), featureEdgeVertexCount(0),
+      pointVAO(0), pointVBO(0), pointCount(0), vertexPointVAO(0), vertexPointVBO(0), vertexPointCount(0), capVAO(0), capVBO(0)
 {
 }
 
 STLViewer::~STLViewer()
 {
+    // 読み込み中のタスクはメッシュ・設定・GLバッファ等のメンバーを参照するため、
+    // それらより前に宣言したエグゼキューターを先に停止して合流させ、中断したままのフレームを破棄する
+    ioExecutor.shutdown();
+    cpuExecutor.shutdown();
+    loadTasks.destroyPending();
+
     // 座標軸用のリソースを削除
     if (axesVAO != 0)
     {
@@ -78,13 +325,21 @@ STLViewer::~STLViewer()
     }
 
     // 3Dモデル用のリソースを削除
-    if (modelVAO != 0)
+    releaseModelBuffers();
+    releaseTopologyOverlayBuffers();
+    releaseSliceOverlayBuffers();
+    releaseInterferenceOverlayBuffers();
+    releaseFeatureEdgeBuffers();
+    releasePointBuffers();
+
+    // 断面の塗りつぶし用のリソースを削除
+    if (capVAO != 0)
     {
-        glDeleteVertexArrays(1, &modelVAO);
+        glDeleteVertexArrays(1, &capVAO);
     }
-    if (modelVBO != 0)
+    if (capVBO != 0)
     {
-        glDeleteBuffers(1, &modelVBO);
+        glDeleteBuffers(1, &capVBO);
     }
 
     // std::unique_ptrが自動でglfwDestroyWindowを呼び出す
@@ -109,6 +364,16 @@ bool STLViewer::init()
 
 bool STLViewer::initializeGLFW()
 {
+    // ヘッドレス実行で表示先が無い場合は、null プラットフォーム上に OSMesa でコンテキストを作る
+    auto offscreenContext = false;
+#ifdef GLFW_PLATFORM_NULL
+    if (headless && !hasDisplayServer())
+    {
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+        offscreenContext = true;
+    }
+#endif
+
     if (!glfwInit())
     {
         logError("Failed to initialize GLFW", __func__);
@@ -118,6 +383,15 @@ bool STLViewer::initializeGLFW()
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, OPENGL_VERSION_MAJOR);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, OPENGL_VERSION_MINOR);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_STENCIL_BITS, STENCIL_BITS); // 断面の塗りつぶしに使用
+    if (headless)
+    {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    }
+    if (offscreenContext)
+    {
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+    }
 
     window.reset(glfwCreateWindow(WINDOW_WIDTH, WINDOW_HEIGHT, "STL Viewer", nullptr, nullptr));
     if (!window)
@@ -128,190 +402,1514 @@ bool STLViewer::initializeGLFW()
     }
 
     glfwMakeContextCurrent(window.get());
+
+    // OpenGLコンテキストを持つこのスレッドが renderExecutor のジョブを実行する
+    trace::setThreadName("render");
+    return true;
+}
+
+bool STLViewer::initializeOpenGL()
+{
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+    {
+        logError("Failed to initialize GLAD", __func__);
+        return false;
+    }
+
+    // 深度テストを有効化
+    glEnable(GL_DEPTH_TEST);
+
+    // 背面カリングの設定（有効化は向きを修正できた閉じたメッシュの描画時のみ）
+    glCullFace(GL_BACK);
+    glFrontFace(GL_CCW);
+    return true;
+}
+
+void STLViewer::setupCallbacks()
+{
+    // ウィンドウユーザーポインターを設定
+    glfwSetWindowUserPointer(window.get(), this);
+
+    // マウスコールバックを設定
+    glfwSetScrollCallback(window.get(), scroll_callback);
+
+    // キーボードコールバックを設定
+    glfwSetKeyCallback(window.get(), key_callback);
+
+    // クリップ平面のドラッグ用コールバックを設定
+    glfwSetMouseButtonCallback(window.get(), mouse_button_callback);
+    glfwSetCursorPosCallback(window.get(), cursor_pos_callback);
+}
+
+bool STLViewer::loadSTL(const std::string &filename)
+{
+    // 非同期タスクを開始し、完了するまで描画スレッドのジョブを処理する
+    auto finished = false;
+    auto result = false;
+    loadTasks.spawn(
+        loadSTLAsync(filename),
+        [&finished, &result](bool success) {
+            result = success;
+            finished = true;
+        },
+        [this, &finished, &result](std::exception_ptr error) {
+            // 読み込み中の例外（巨大ファイルでの bad_alloc 等）は失敗として報告し、ビューアーは継続する
+            try
+            {
+                std::rethrow_exception(error);
+            }
+            catch (const std::exception &e)
+            {
+                logError(std::string{"Exception while loading model: "} + e.what(), "loadSTL");
+            }
+            catch (...)
+            {
+                logError("Unknown exception while loading model", "loadSTL");
+            }
+            result = false;
+            finished = true;
+        });
+
+    while (!finished)
+    {
+        renderExecutor.waitAndRunPending();
+    }
+    return result;
+}
+
+Task<bool> STLViewer::loadSTLAsync(std::string filename)
+{
+    // 段階の境界の時刻（各段階は別のスレッドで実行される）
+    auto loadStart = std::chrono::steady_clock::now();
+    auto readEnd = loadStart;
+    auto timings = LoadTimings{};
+
+    // 表示中のメッシュと同じメモリリソースに構築し、最後のムーブを要素コピーなしで行う
+    auto loader = ModelLoader{};
+    auto loaded = LoadedModel{mesh.triangles.get_allocator().resource()};
+    auto succeeded = false;
+    auto errorDetail = std::string{};
+
+    // ファイル内容は読み込みの分岐内で解放し、以降の解析・転送の段階とはピークが重ならないようにする
+    if (ModelLoader::isSelfContainedFormat(filename))
+    {
+        // I/O: ファイル全体をメモリに読み込む
+        co_await scheduleOn(ioExecutor);
+        auto fileData = std::pmr::vector<char>{};
+        auto readSucceeded = readFileBytes(filename, fileData);
+        readEnd = std::chrono::steady_clock::now();
+        if (readSucceeded)
+        {
+            // CPU: メモリ上のデータをパース・後処理（拡張子はドットを除いてヒントに使う）
+            co_await scheduleOn(cpuExecutor);
+            auto formatHint = std::filesystem::path{filename}.extension().string().substr(1);
+            succeeded = loader.loadFromMemory(fileData.data(), fileData.size(), formatHint, loaded.mesh);
+            errorDetail = loader.getErrorMessage();
+        }
+        else
+        {
+            errorDetail = "Cannot read file: " + filename;
+        }
+    }
+    else
+    {
+        // CPU: 外部ファイルを参照する形式はAssimpにI/Oも任せる
+        co_await scheduleOn(cpuExecutor);
+        succeeded = loader.loadFile(filename, loaded.mesh);
+        errorDetail = loader.getErrorMessage();
+    }
+
+    loaded.repairStats = loader.getRepairStats();
+    auto parseEnd = std::chrono::steady_clock::now();
+
+    // CPU: 溶接と有効な解析（点のみのメッシュは溶接・解析しない）
+    if (succeeded && weldEnabled && !loaded.mesh.triangles.empty())
+    {
+        co_await analyzeLoadedMesh(loaded);
+    }
+
+    auto analyzeEnd = std::chrono::steady_clock::now();
+
+    // CPU: 点描画用の間引き順の生成
+    if (succeeded)
+    {
+        orderLoadedPoints(loaded);
+    }
+
+    auto pointsEnd = std::chrono::steady_clock::now();
+
+    // GPU: 以降のOpenGL呼び出しは描画スレッドで行う（失敗時も描画スレッドで完了させる）
+    co_await scheduleOn(renderExecutor);
+    auto uploadStart = std::chrono::steady_clock::now();
+
+    // 以降は co_await を含まないため、完了まで描画スレッドの1つのイベントとして記録する
+    TRACE_SCOPE("Upload to GPU");
+
+    if (!succeeded)
+    {
+        auto oss = std::ostringstream{};
+        oss << "Failed to load 3D model file: " << errorDetail;
+        logError(oss.str(), __func__);
+        co_return false;
+    }
+
+    if (!applyLoadedModel(loaded))
+    {
+        co_return false;
+    }
+
+    auto loadEnd = std::chrono::steady_clock::now();
+    timings.read = secondsBetween(loadStart, readEnd);
+    timings.parse = secondsBetween(readEnd, parseEnd);
+    timings.analyze = secondsBetween(parseEnd, analyzeEnd);
+    timings.points = secondsBetween(analyzeEnd, pointsEnd);
+    timings.dispatch = secondsBetween(pointsEnd, uploadStart);
+    timings.upload = secondsBetween(uploadStart, loadEnd);
+    timings.total = secondsBetween(loadStart, loadEnd);
+    loadTimings = timings;
+
+    co_return true;
+}
+
+Task<void> STLViewer::analyzeLoadedMesh(LoadedModel &loaded)
+{
+    // 近接頂点を溶接し、三角形をシェル順（シェルごとに連続した描画範囲）に並べて面の向きを外向きに統一する
+    // 偏差解析の参照メッシュの読み込み（I/O）と溶接はこれと並行に行う
+    auto edges = EdgeTable{};
+    auto referenceMesh = IndexedMesh{};
+    auto welding = std::vector<Task<void>>{};
+    welding.push_back(runOn(cpuExecutor, [this, &loaded, &edges]() {
+        TRACE_SCOPE("Weld");
+        loaded.orientation = weldAndOrientMesh(loaded.mesh, weldEpsilon, loaded.indexedMesh, loaded.shells, edges);
+    }));
+    if (!deviationReferencePath.empty())
+    {
+        welding.push_back(loadDeviationReference(referenceMesh, loaded.deviationError));
+    }
+    co_await whenAll(std::move(welding));
+
+    // 頂点番号に対応づけた派生データは、向き修正後のメッシュのハッシュをキーにキャッシュする
+    auto indexedHash = std::uint64_t{0};
+    if (featureEdgesEnabled || ambientOcclusionRays > 0)
+    {
+        TRACE_SCOPE("Hash indexed mesh");
+        indexedHash = computeIndexedMeshHash(loaded.indexedMesh);
+    }
+
+    // 以降の解析は溶接後のメッシュを読むだけで互いに独立しているため、子タスクとして並行に実行する
+    // （各解析は loaded の別々のメンバーにのみ書き込み、キャッシュのエラーは解析ごとに受け取る）
+    auto featureCacheError = std::string{};
+    auto occlusionCacheError = std::string{};
+    auto analyses = std::vector<Task<void>>{};
+
+    // 向き修正後の面から表面積・体積・重心を計算
+    analyses.push_back(runOn(cpuExecutor, [&loaded]() {
+        TRACE_SCOPE("Metrics");
+        loaded.metrics = computeMeshMetrics(loaded.indexedMesh);
+    }));
+
+    // 溶接と同じ辺テーブルで水密性・多様体性を解析
+    if (topologyCheckEnabled)
+    {
+        analyses.push_back(runOn(cpuExecutor, [&loaded, &edges]() {
+            TRACE_SCOPE("Topology");
+            loaded.topologyReport = analyzeTopology(loaded.indexedMesh, edges);
+        }));
+    }
+
+    if (featureEdgesEnabled)
+    {
+        analyses.push_back(runOn(cpuExecutor, [this, &loaded, &edges, indexedHash, &featureCacheError]() {
+            TRACE_SCOPE("Feature edges");
+            featureCacheError = loadFeatureEdges(loaded, edges, indexedHash);
+        }));
+    }
+
+    // 層ごとに並列にスライスして輪郭を生成
+    if (sliceLayerCount > 0)
+    {
+        analyses.push_back(runOn(cpuExecutor, [this, &loaded]() {
+            TRACE_SCOPE("Slice");
+            loaded.slices = sliceMesh(loaded.indexedMesh, sliceLayerCount);
+        }));
+    }
+
+    // BVHは肉厚解析と環境遮蔽で共有するため、両者は1つの子タスクで順に行う（必要になった時点で一度だけ構築する）
+    if (wallThicknessEnabled || ambientOcclusionRays > 0)
+    {
+        analyses.push_back(runOn(cpuExecutor, [this, &loaded, indexedHash, &occlusionCacheError]() {
+            TRACE_SCOPE("Thickness and occlusion");
+            auto bvh = MeshBvh{};
+            if (wallThicknessEnabled)
+            {
+                bvh = buildMeshBvh(loaded.indexedMesh);
+                loaded.thickness = computeWallThickness(loaded.indexedMesh, bvh);
+            }
+            if (ambientOcclusionRays > 0)
+            {
+                occlusionCacheError = loadAmbientOcclusion(loaded, bvh, indexedHash);
+            }
+        }));
+    }
+
+    // シェルごとのBVH同士を走査して部品間の干渉を調べる
+    if (interferenceCheckEnabled)
+    {
+        analyses.push_back(runOn(cpuExecutor, [&loaded]() {
+            TRACE_SCOPE("Interference");
+            loaded.interference = checkShellInterference(loaded.indexedMesh, loaded.shells);
+        }));
+    }
+
+    // 各頂点から参照面までの符号付き距離を求める（参照メッシュの読み込みに失敗した場合は行わない）
+    if (!deviationReferencePath.empty() && loaded.deviationError.empty())
+    {
+        analyses.push_back(runOn(cpuExecutor, [this, &loaded, &referenceMesh]() {
+            TRACE_SCOPE("Deviation");
+            loaded.deviation = computeDeviation(loaded.indexedMesh, referenceMesh, deviationTolerance);
+        }));
+    }
+
+    co_await whenAll(std::move(analyses));
+    loaded.cacheError = !featureCacheError.empty() ? featureCacheError : occlusionCacheError;
+}
+
+std::string STLViewer::loadFeatureEdges(LoadedModel &loaded, const EdgeTable &edges, std::uint64_t indexedHash) const
+{
+    // キャッシュから読み込み、無ければ辺テーブルの二面角から抽出して保存する
+    auto cache = MeshCache{};
+    auto kind = FEATURE_CACHE_KIND + std::to_string(std::lround(featureAngleDegrees * FEATURE_CACHE_ANGLE_SCALE));
+    auto payload = std::vector<char>{};
+    if (cache.load(indexedHash, kind, payload) &&
+        deserializeFeatureEdges(payload, loaded.indexedMesh.positions.size(), loaded.features))
+    {
+        return {};
+    }
+
+    loaded.features = extractFeatureEdges(loaded.indexedMesh, edges, featureAngleDegrees);
+    if (!cache.store(indexedHash, kind, serializeFeatureEdges(loaded.features)))
+    {
+        return cache.getErrorMessage();
+    }
+    return {};
+}
+
+std::string STLViewer::loadAmbientOcclusion(LoadedModel &loaded, MeshBvh &bvh, std::uint64_t indexedHash) const
+{
+    // キャッシュから読み込み、無ければ光線追跡で焼き込んで保存する
+    // 遮蔽距離はキャッシュのヘッダーと照合し、異なる条件で焼き込んだ結果は使わない
+    auto cache = MeshCache{};
+    auto kind = OCCLUSION_CACHE_KIND + std::to_string(ambientOcclusionRays);
+    auto radius = automaticOcclusionRadius(loaded.indexedMesh);
+    auto payload = std::vector<char>{};
+    if (cache.load(indexedHash, kind, payload) &&
+        deserializeAmbientOcclusion(payload, loaded.indexedMesh.positions.size(), ambientOcclusionRays, radius,
+                                    loaded.occlusion))
+    {
+        return {};
+    }
+
+    if (bvh.empty())
+    {
+        bvh = buildMeshBvh(loaded.indexedMesh);
+    }
+    loaded.occlusion = bakeAmbientOcclusion(loaded.indexedMesh, bvh, ambientOcclusionRays, radius);
+    if (!cache.store(indexedHash, kind, serializeAmbientOcclusion(loaded.occlusion)))
+    {
+        return cache.getErrorMessage();
+    }
+    return {};
+}
+
+Task<void> STLViewer::loadDeviationReference(IndexedMesh &referenceMesh, std::string &error)
+{
+    // 参照メッシュは読み込むメッシュと同じ手順（I/Oエグゼキューターで読み、CPUでパース）で読み込む
+    auto referenceLoader = ModelLoader{};
+    auto referenceModel = ModelMesh{};
+    auto succeeded = false;
+    if (ModelLoader::isSelfContainedFormat(deviationReferencePath))
+    {
+        co_await scheduleOn(ioExecutor);
+        auto fileData = std::pmr::vector<char>{};
+        if (!readFileBytes(deviationReferencePath, fileData))
+        {
+            error = "Failed to load reference model: Cannot read file: " + deviationReferencePath;
+            co_return;
+        }
+
+        co_await scheduleOn(cpuExecutor);
+        auto formatHint = std::filesystem::path{deviationReferencePath}.extension().string().substr(1);
+        succeeded = referenceLoader.loadFromMemory(fileData.data(), fileData.size(), formatHint, referenceModel);
+    }
+    else
+    {
+        co_await scheduleOn(cpuExecutor);
+        succeeded = referenceLoader.loadFile(deviationReferencePath, referenceModel);
+    }
+
+    if (!succeeded)
+    {
+        error = "Failed to load reference model: " + referenceLoader.getErrorMessage();
+        co_return;
+    }
+
+    // 同じ手順で溶接・向き修正する
+    TRACE_SCOPE("Weld reference");
+    auto referenceShells = ShellDecomposition{};
+    auto referenceEdges = EdgeTable{};
+    weldAndOrientMesh(referenceModel, weldEpsilon, referenceMesh, referenceShells, referenceEdges);
+}
+
+void STLViewer::orderLoadedPoints(LoadedModel &loaded) const
+{
+    TRACE_SCOPE("Order points");
+
+    // 点群と、三角形数が上限を超えるメッシュの頂点を空間的に均等な間引き順に並べる
+    // （溶接無効時は共有頂点が重複しないよう三角形の重心を点とする）
+    loaded.pointCloud = orderPointsForSubsampling(loaded.mesh.points);
+    if (loaded.mesh.triangles.size() <= pointTriangleBudget)
+    {
+        return;
+    }
+
+    if (!loaded.indexedMesh.positions.empty())
+    {
+        loaded.vertexPoints = orderPointsForSubsampling(loaded.indexedMesh.positions);
+        return;
+    }
+
+    const auto &triangles = loaded.mesh.triangles;
+    auto centroids = std::vector<glm::vec3>(triangles.size());
+    parallel::forEach(triangles.size(), [&](std::size_t i) {
+        const auto &vertices = triangles[i].vertices;
+        centroids[i] = (vertices[0] + vertices[1] + vertices[2]) * (1.0f / TRIANGLE_VERTICES);
+    });
+    loaded.vertexPoints = orderPointsForSubsampling(centroids);
+}
+
+bool STLViewer::applyLoadedModel(LoadedModel &loaded)
+{
+    logRepairStats(loaded.repairStats);
+
+    // 転送済みのバッファと内容がバイト単位で一致する場合のみGPUバッファを再利用する。
+    // コンテンツハッシュは三角形の順序や溶接設定によらないため、一致しても描画範囲やインデックスが
+    // 異なりうる。頂点属性（肉厚・偏差・遮蔽）はバッファと一緒に転送するため、どちらかが持つ場合は再利用しない
+    auto hasVertexAttributes = modelScalarVBO != 0 || modelDeviationVBO != 0 || modelOcclusionVBO != 0 ||
+                               !loaded.thickness.vertexThickness.empty() || !loaded.deviation.vertexDeviation.empty() ||
+                               !loaded.occlusion.vertexAccessibility.empty();
+    auto reuseModelBuffers = modelVAO != 0 && !hasVertexAttributes && loaded.mesh.contentHash == mesh.contentHash &&
+                             sameBytes(loaded.indexedMesh.positions, indexedMesh.positions) &&
+                             sameBytes(loaded.indexedMesh.indices, indexedMesh.indices) &&
+                             (!loaded.indexedMesh.indices.empty() || sameBytes(loaded.mesh.triangles, mesh.triangles));
+    mesh = std::move(loaded.mesh);
+    indexedMesh = std::move(loaded.indexedMesh);
+    topologyReport = std::move(loaded.topologyReport);
+    shellDecomposition = std::move(loaded.shells);
+    shellVisibility.assign(shellDecomposition.shells.size(), 1);
+    orientationReport = loaded.orientation;
+    meshMetrics = loaded.metrics;
+    wallThickness = std::move(loaded.thickness);
+    interferenceReport = std::move(loaded.interference);
+    meshDeviation = std::move(loaded.deviation);
+    ambientOcclusion = std::move(loaded.occlusion);
+    featureEdges = std::move(loaded.features);
+
+    // 閉じたメッシュは体積重心を中心に表示する（開いたメッシュの体積重心は意味を持たない）
+    auto hasVolumeCentroid = !shellDecomposition.shells.empty() && orientationReport.canCullBackFaces() &&
+                             meshMetrics.volume > 0.0;
+    modelCenter = hasVolumeCentroid ? glm::vec3{meshMetrics.centroid} : mesh.center;
+    if (!shellDecomposition.shells.empty())
+    {
+        logShells(shellDecomposition);
+        logOrientationReport(orientationReport);
+    }
+
+    // シェーダー設定（初回のみ）
+    if (!shader.isValid() && !setupShaders())
+    {
+        return false;
+    }
+
+    // 座標軸バッファ設定（初回のみ）
+    if (axesVAO == 0 && !setupAxesBuffers())
+    {
+        return false;
+    }
+
+    // 断面の塗りつぶし用バッファ設定（初回のみ）
+    if (capVAO == 0 && !setupCapBuffers())
+    {
+        return false;
+    }
+
+    // 3Dモデルバッファ設定（既存のバッファは解放して作り直す）
+    if (!reuseModelBuffers)
+    {
+        releaseModelBuffers();
+        if (!setupModelBuffers())
+        {
+            return false;
+        }
+    }
+
+    setupAnalysisOverlays(loaded);
+
+    // 点群・頂点の点描画の設定（点は位置のみを転送し、描画点数は毎フレーム画面上の大きさから決める）
+    releasePointBuffers();
+    setupPointBuffers(loaded.pointCloud, loaded.vertexPoints);
+    if (pointCount > 0 || vertexPointCount > 0)
+    {
+        logPointRendering(mesh.triangles.size());
+    }
+
+    // キャッシュへの書き込みに失敗しても結果は表示に使える（次回の読み込みで再計算される）
+    if (!loaded.cacheError.empty())
+    {
+        logError(loaded.cacheError, __func__);
+    }
+
+    // カメラ設定
+    setupCamera();
     return true;
 }
 
-bool STLViewer::initializeOpenGL()
+void STLViewer::setupAnalysisOverlays(const LoadedModel &loaded)
+{
+    // 前回の読み込みのオーバーレイは、今回解析しない場合も含めて解放する
+    releaseTopologyOverlayBuffers();
+    releaseSliceOverlayBuffers();
+    releaseInterferenceOverlayBuffers();
+    releaseFeatureEdgeBuffers();
+
+    // 溶接に依存する解析（インデックス付きメッシュが必要）は、溶接無効時に省略した旨をまとめて通知する
+    if (!weldEnabled)
+    {
+        logSkippedAnalyses();
+    }
+    if (indexedMesh.indices.empty())
+    {
+        return;
+    }
+
+    // 問題のある辺のオーバーレイ設定
+    if (topologyCheckEnabled)
+    {
+        logTopologyReport(topologyReport);
+        setupTopologyOverlayBuffers();
+    }
+
+    // スライス輪郭のオーバーレイ設定
+    if (sliceLayerCount > 0)
+    {
+        setupSliceOverlayBuffers(loaded.slices);
+    }
+
+    // 肉厚解析の結果（ヒートマップ用の頂点属性はモデルバッファと一緒に転送済み）
+    if (wallThicknessEnabled)
+    {
+        logWallThickness(wallThickness);
+    }
+
+    // 干渉部の交線のオーバーレイ設定
+    if (interferenceCheckEnabled)
+    {
+        logInterferenceReport(interferenceReport);
+        setupInterferenceOverlayBuffers();
+    }
+
+    // 偏差解析の結果（量子化した偏差はモデルバッファと一緒に転送済み）
+    if (!deviationReferencePath.empty())
+    {
+        if (!loaded.deviationError.empty())
+        {
+            logError(loaded.deviationError, __func__);
+        }
+        else
+        {
+            logDeviation(meshDeviation);
+        }
+    }
+
+    // 環境遮蔽の焼き込み結果（頂点属性はモデルバッファと一緒に転送済み）
+    if (ambientOcclusionRays > 0)
+    {
+        logAmbientOcclusion(ambientOcclusion);
+    }
+
+    // 特徴辺の線の設定
+    if (featureEdgesEnabled)
+    {
+        logFeatureEdges(featureEdges);
+        setupFeatureEdgeBuffers();
+    }
+}
+
+bool STLViewer::setupShaders()
+{
+    TRACE_SCOPE("STLViewer::setupShaders");
+
+    if (!shader.create(VERTEX_SHADER_PATH, FRAGMENT_SHADER_PATH))
+    {
+        auto oss = std::ostringstream{};
+        oss << "Failed to create shader: " << shader.getErrorMessage();
+        logError(oss.str(), __func__);
+        return false;
+    }
+
+    shader.use();
+
+    // 環境遮蔽の属性を持たない描画（座標軸・オーバーレイ等）は遮蔽なしとする
+    glVertexAttrib1f(OCCLUSION_ATTRIBUTE_INDEX, 1.0f);
+
+    return true;
+}
+
+bool STLViewer::setupAxesBuffers()
+{
+    auto vertices = createAxesVertices();
+    return createAxesOpenGLBuffers(vertices);
+}
+
+bool STLViewer::setupModelBuffers()
+{
+    // 溶接済みの場合は共有頂点とインデックスで転送する
+    if (!indexedMesh.indices.empty())
+    {
+        return createIndexedModelBuffers();
+    }
+
+    auto vertices = convertSTLToVertices();
+    return createModelBuffers(vertices);
+}
+
+std::pmr::vector<float> STLViewer::convertSTLToVertices() const
+{
+    TRACE_SCOPE("STLViewer::convertSTLToVertices");
+    return createInterleavedVertices(mesh, glm::vec3{MODEL_COLOR_R, MODEL_COLOR_G, MODEL_COLOR_B},
+                                     std::pmr::get_default_resource());
+}
+
+bool STLViewer::createModelBuffers(std::span<const float> vertices)
+{
+    auto buffers = createOpenGLBuffers(vertices);
+    modelVAO = buffers.VAO;
+    modelVBO = buffers.VBO;
+    return true;
+}
+
+bool STLViewer::createIndexedModelBuffers()
+{
+    glGenVertexArrays(1, &modelVAO);
+    glGenBuffers(1, &modelVBO);
+    glGenBuffers(1, &modelEBO);
+
+    glBindVertexArray(modelVAO);
+
+    // 頂点は位置のみ（色は定数属性、法線はフラグメントシェーダーで面から算出）
+    glBindBuffer(GL_ARRAY_BUFFER, modelVBO);
+    {
+        TRACE_SCOPE("glBufferData (positions)");
+        glBufferData(GL_ARRAY_BUFFER, indexedMesh.positions.size() * sizeof(glm::vec3),
+                     indexedMesh.positions.data(), GL_STATIC_DRAW);
+    }
+    glVertexAttribPointer(POSITION_ATTRIBUTE_INDEX, POSITION_COMPONENTS, GL_FLOAT, GL_FALSE,
+                          POSITION_COMPONENTS * sizeof(float), (void *)0);
+    glEnableVertexAttribArray(POSITION_ATTRIBUTE_INDEX);
+
+    // 肉厚解析時は頂点ごとの肉厚を別バッファで転送する（反対側の面が無い頂点は最大値として表示する）
+    if (!wallThickness.vertexThickness.empty())
+    {
+        auto scalars = wallThickness.vertexThickness;
+        std::replace_if(
+            scalars.begin(), scalars.end(), [](float value) { return std::isinf(value); }, wallThickness.maximum);
+
+        glGenBuffers(1, &modelScalarVBO);
+        glBindBuffer(GL_ARRAY_BUFFER, modelScalarVBO);
+        glBufferData(GL_ARRAY_BUFFER, scalars.size() * sizeof(float), scalars.data(), GL_STATIC_DRAW);
+        glVertexAttribPointer(SCALAR_ATTRIBUTE_INDEX, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void *)0);
+        glEnableVertexAttribArray(SCALAR_ATTRIBUTE_INDEX);
+    }
+
+    // 偏差表示時は頂点ごとの偏差を符号付き正規化整数に量子化して転送する（floatの1/4または1/2の大きさ）
+    if (!meshDeviation.vertexDeviation.empty())
+    {
+        glGenBuffers(1, &modelDeviationVBO);
+        glBindBuffer(GL_ARRAY_BUFFER, modelDeviationVBO);
+        if (deviationBits == 8)
+        {
+            auto packed = packDeviation8(meshDeviation);
+            glBufferData(GL_ARRAY_BUFFER, packed.size() * sizeof(std::int8_t), packed.data(), GL_STATIC_DRAW);
+            glVertexAttribPointer(DEVIATION_ATTRIBUTE_INDEX, 1, GL_BYTE, GL_TRUE, sizeof(std::int8_t), (void *)0);
+        }
+        else
+        {
+            auto packed = packDeviation16(meshDeviation);
+            glBufferData(GL_ARRAY_BUFFER, packed.size() * sizeof(std::int16_t), packed.data(), GL_STATIC_DRAW);
+            glVertexAttribPointer(DEVIATION_ATTRIBUTE_INDEX, 1, GL_SHORT, GL_TRUE, sizeof(std::int16_t), (void *)0);
+        }
+        glEnableVertexAttribArray(DEVIATION_ATTRIBUTE_INDEX);
+    }
+
+    // 環境遮蔽は焼き込んだ8ビットの値をそのまま正規化整数として転送する
+    if (!ambientOcclusion.vertexAccessibility.empty())
+    {
+        const auto &accessibility = ambientOcclusion.vertexAccessibility;
+        glGenBuffers(1, &modelOcclusionVBO);
+        glBindBuffer(GL_ARRAY_BUFFER, modelOcclusionVBO);
+        glBufferData(GL_ARRAY_BUFFER, accessibility.size() * sizeof(std::uint8_t), accessibility.data(),
+                     GL_STATIC_DRAW);
+        glVertexAttribPointer(OCCLUSION_ATTRIBUTE_INDEX, 1, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(std::uint8_t),
+                              (void *)0);
+        glEnableVertexAttribArray(OCCLUSION_ATTRIBUTE_INDEX);
+    }
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, modelEBO);
+    {
+        TRACE_SCOPE("glBufferData (indices)");
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexedMesh.indices.size() * sizeof(std::uint32_t),
+                     indexedMesh.indices.data(), GL_STATIC_DRAW);
+    }
+
+    glBindVertexArray(0);
+    return true;
+}
+
+void STLViewer::setWeld(bool enabled, float epsilon)
+{
+    weldEnabled = enabled;
+    weldEpsilon = epsilon;
+}
+
+void STLViewer::setTopologyCheck(bool enabled)
+{
+    topologyCheckEnabled = enabled;
+}
+
+void STLViewer::setSlicing(std::size_t layerCount)
+{
+    sliceLayerCount = layerCount;
+}
+
+void STLViewer::setWallThickness(bool enabled)
+{
+    wallThicknessEnabled = enabled;
+}
+
+void STLViewer::setInterferenceCheck(bool enabled)
+{
+    interferenceCheckEnabled = enabled;
+}
+
+void STLViewer::setDeviationReference(const std::string &referencePath, float tolerance, int bits)
+{
+    deviationReferencePath = referencePath;
+    deviationTolerance = tolerance;
+    deviationBits = bits;
+}
+
+void STLViewer::setAmbientOcclusion(int rayCount)
+{
+    ambientOcclusionRays = rayCount;
+}
+
+void STLViewer::setFeatureEdges(bool enabled, float angleDegrees)
+{
+    featureEdgesEnabled = enabled;
+    featureAngleDegrees = angleDegrees;
+}
+
+void STLViewer::setHeadless(bool enabled)
+{
+    headless = enabled;
+}
+
+void STLViewer::setPointRendering(float size, std::size_t triangleBudget)
+{
+    pointSize = size;
+    pointTriangleBudget = triangleBudget;
+}
+
+std::vector<float> STLViewer::createTopologyOverlayVertices() const
+{
+    // 問題のある辺を線分として生成（位置3つ + 色3つ + 法線3つ = 9つの値）
+    auto vertices = std::vector<float>{};
+    vertices.reserve((topologyReport.boundaryEdgeVertices.size() + topologyReport.nonManifoldEdgeVertices.size()) *
+                     VERTEX_COMPONENTS);
+
+    auto appendEdges = [this, &vertices](const std::vector<std::uint32_t> &edgeVertices, const glm::vec3 &color) {
+        for (auto index : edgeVertices)
+        {
+            const auto &position = indexedMesh.positions[index];
+            vertices.insert(vertices.end(), {position.x, position.y, position.z, color.x, color.y, color.z, 0.0f,
+                                             0.0f, 1.0f});
+        }
+    };
+    appendEdges(topologyReport.boundaryEdgeVertices, glm::vec3{BOUNDARY_EDGE_R, BOUNDARY_EDGE_G, BOUNDARY_EDGE_B});
+    appendEdges(topologyReport.nonManifoldEdgeVertices,
+                glm::vec3{NON_MANIFOLD_EDGE_R, NON_MANIFOLD_EDGE_G, NON_MANIFOLD_EDGE_B});
+
+    return vertices;
+}
+
+bool STLViewer::setupTopologyOverlayBuffers()
+{
+    auto vertices = createTopologyOverlayVertices();
+    if (vertices.empty())
+    {
+        return true;
+    }
+
+    auto buffers = createOpenGLBuffers(vertices);
+    topologyVAO = buffers.VAO;
+    topologyVBO = buffers.VBO;
+    topologyVertexCount = static_cast<int>(vertices.size() / VERTEX_COMPONENTS);
+    return true;
+}
+
+void STLViewer::releaseTopologyOverlayBuffers()
+{
+    if (topologyVAO != 0)
+    {
+        glDeleteVertexArrays(1, &topologyVAO);
+        topologyVAO = 0;
+    }
+    if (topologyVBO != 0)
+    {
+        glDeleteBuffers(1, &topologyVBO);
+        topologyVBO = 0;
+    }
+    topologyVertexCount = 0;
+}
+
+std::vector<float> STLViewer::createSliceOverlayVertices(const std::vector<SliceLayer> &layers) const
+{
+    // 輪郭の各辺を線分として生成（位置3つ + 色3つ + 法線3つ = 9つの値）
+    auto vertices = std::vector<float>{};
+    auto appendPoint = [&vertices](const glm::vec2 &point, float z) {
+        vertices.insert(vertices.end(),
+                        {point.x, point.y, z, SLICE_CONTOUR_R, SLICE_CONTOUR_G, SLICE_CONTOUR_B, 0.0f, 0.0f, 1.0f});
+    };
+
+    for (const auto &layer : layers)
+    {
+        for (const auto &contour : layer.contours)
+        {
+            const auto &points = contour.points;
+            auto edgeCount = contour.closed ? points.size() : points.size() - 1;
+            for (std::size_t i = 0; i < edgeCount && points.size() > 1; ++i)
+            {
+                appendPoint(points[i], layer.z);
+                appendPoint(points[(i + 1) % points.size()], layer.z);
+            }
+        }
+    }
+
+    return vertices;
+}
+
+bool STLViewer::setupSliceOverlayBuffers(const std::vector<SliceLayer> &layers)
+{
+    auto vertices = createSliceOverlayVertices(layers);
+    if (vertices.empty())
+    {
+        return true;
+    }
+
+    auto buffers = createOpenGLBuffers(vertices);
+    sliceVAO = buffers.VAO;
+    sliceVBO = buffers.VBO;
+    sliceVertexCount = static_cast<int>(vertices.size() / VERTEX_COMPONENTS);
+    return true;
+}
+
+void STLViewer::releaseSliceOverlayBuffers()
+{
+    if (sliceVAO != 0)
+    {
+        glDeleteVertexArrays(1, &sliceVAO);
+        sliceVAO = 0;
+    }
+    if (sliceVBO != 0)
+    {
+        glDeleteBuffers(1, &sliceVBO);
+        sliceVBO = 0;
+    }
+    sliceVertexCount = 0;
+}
+
+std::vector<float> STLViewer::createInterferenceOverlayVertices() const
+{
+    // 交差する三角形の組ごとの交線を線分として生成（位置3つ + 色3つ + 法線3つ = 9つの値）
+    auto vertices = std::vector<float>{};
+    vertices.reserve(interferenceReport.triangleContactCount() * 2 * VERTEX_COMPONENTS);
+    auto appendPoint = [&vertices](const glm::vec3 &point) {
+        vertices.insert(vertices.end(),
+                        {point.x, point.y, point.z, INTERFERENCE_R, INTERFERENCE_G, INTERFERENCE_B, 0.0f, 0.0f, 1.0f});
+    };
+
+    for (const auto &partContact : interferenceReport.contacts)
+    {
+        for (const auto &contact : partContact.contacts)
+        {
+            appendPoint(contact.segmentStart);
+            appendPoint(contact.segmentEnd);
+        }
+    }
+
+    return vertices;
+}
+
+bool STLViewer::setupInterferenceOverlayBuffers()
+{
+    auto vertices = createInterferenceOverlayVertices();
+    if (vertices.empty())
+    {
+        return true;
+    }
+
+    auto buffers = createOpenGLBuffers(vertices);
+    interferenceVAO = buffers.VAO;
+    interferenceVBO = buffers.VBO;
+    interferenceVertexCount = static_cast<int>(vertices.size() / VERTEX_COMPONENTS);
+    return true;
+}
+
+void STLViewer::releaseInterferenceOverlayBuffers()
+{
+    if (interferenceVAO != 0)
+    {
+        glDeleteVertexArrays(1, &interferenceVAO);
+        interferenceVAO = 0;
+    }
+    if (interferenceVBO != 0)
+    {
+        glDeleteBuffers(1, &interferenceVBO);
+        interferenceVBO = 0;
+    }
+    interferenceVertexCount = 0;
+}
+
+std::vector<float> STLViewer::createFeatureEdgeVertices() const
+{
+    // 特徴辺を線分として生成（位置3つ + 色3つ + 法線3つ = 9つの値）
+    auto vertices = std::vector<float>{};
+    vertices.reserve(featureEdges.edgeVertices.size() * VERTEX_COMPONENTS);
+    for (auto index : featureEdges.edgeVertices)
+    {
+        const auto &position = indexedMesh.positions[index];
+        vertices.insert(vertices.end(), {position.x, position.y, position.z, FEATURE_EDGE_R, FEATURE_EDGE_G,
+                                         FEATURE_EDGE_B, 0.0f, 0.0f, 1.0f});
+    }
+
+    return vertices;
+}
+
+bool STLViewer::setupFeatureEdgeBuffers()
+{
+    auto vertices = createFeatureEdgeVertices();
+    if (vertices.empty())
+    {
+        return true;
+    }
+
+    auto buffers = createOpenGLBuffers(vertices);
+    featureEdgeVAO = buffers.VAO;
+    featureEdgeVBO = buffers.VBO;
+    featureEdgeVertexCount = static_cast<int>(vertices.size() / VERTEX_COMPONENTS);
+    return true;
+}
+
+void STLViewer::setupPointBuffers(std::span<const glm::vec3> points, std::span<const glm::vec3> vertexPoints)
+{
+    if (!points.empty())
+    {
+        auto buffers = createPointBuffers(points);
+        pointVAO = buffers.VAO;
+        pointVBO = buffers.VBO;
+        pointCount = points.size();
+    }
+    if (!vertexPoints.empty())
+    {
+        auto buffers = createPointBuffers(vertexPoints);
+        vertexPointVAO = buffers.VAO;
+        vertexPointVBO = buffers.VBO;
+        vertexPointCount = vertexPoints.size();
+    }
+
+    // 三角形数が上限を超えるメッシュは頂点の点描画から始める（Pキーで三角形の描画に切り替える）
+    vertexPointsVisible = vertexPointCount > 0;
+}
+
+void STLViewer::releasePointBuffers()
+{
+    for (auto vao : {&pointVAO, &vertexPointVAO})
+    {
+        if (*vao != 0)
+        {
+            glDeleteVertexArrays(1, vao);
+            *vao = 0;
+        }
+    }
+    for (auto vbo : {&pointVBO, &vertexPointVBO})
+    {
+        if (*vbo != 0)
+        {
+            glDeleteBuffers(1, vbo);
+            *vbo = 0;
+        }
+    }
+    pointCount = 0;
+    vertexPointCount = 0;
+}
+
+void STLViewer::releaseFeatureEdgeBuffers()
+{
+    if (featureEdgeVAO != 0)
+    {
+        glDeleteVertexArrays(1, &featureEdgeVAO);
+        featureEdgeVAO = 0;
+    }
+    if (featureEdgeVBO != 0)
+    {
+        glDeleteBuffers(1, &featureEdgeVBO);
+        featureEdgeVBO = 0;
+    }
+    featureEdgeVertexCount = 0;
+}
+
+void STLViewer::releaseModelBuffers()
+{
+    if (modelVAO != 0)
+    {
+        glDeleteVertexArrays(1, &modelVAO);
+        modelVAO = 0;
+    }
+    if (modelVBO != 0)
+    {
+        glDeleteBuffers(1, &modelVBO);
+        modelVBO = 0;
+    }
+    if (modelEBO != 0)
+    {
+        glDeleteBuffers(1, &modelEBO);
+        modelEBO = 0;
+    }
+    if (modelScalarVBO != 0)
+    {
+        glDeleteBuffers(1, &modelScalarVBO);
+        modelScalarVBO = 0;
+    }
+    if (modelDeviationVBO != 0)
+    {
+        glDeleteBuffers(1, &modelDeviationVBO);
+        modelDeviationVBO = 0;
+    }
+    if (modelOcclusionVBO != 0)
+    {
+        glDeleteBuffers(1, &modelOcclusionVBO);
+        modelOcclusionVBO = 0;
+    }
+}
+
+void STLViewer::setupCamera()
+{
+    // カメラをさらに遠くに配置
+    cameraPos = glm::vec3{CAMERA_DISTANCE, CAMERA_DISTANCE, CAMERA_DISTANCE};
+    cameraFront = glm::normalize(glm::vec3{0.0f, 0.0f, 0.0f} - cameraPos); // 原点を向く
+    cameraUp = glm::vec3{0.0f, 1.0f, 0.0f};
+    
+    // ライトの設定
+    lightPos = glm::vec3{2.0f, 2.0f, 2.0f};
+    lightColor = glm::vec3{1.0f, 1.0f, 1.0f}; // 白色光
+}
+
+void STLViewer::orbitCamera(float angle)
+{
+    // 初期位置と同じ距離・高さを保ったままY軸周りに回し、常に原点を向ける
+    auto radius = CAMERA_DISTANCE * std::sqrt(2.0f);
+    cameraPos = glm::vec3{radius * std::cos(angle), CAMERA_DISTANCE, radius * std::sin(angle)};
+    cameraFront = glm::normalize(-cameraPos);
+}
+
+std::string STLViewer::getRendererName() const
+{
+    const auto *renderer = reinterpret_cast<const char *>(glGetString(GL_RENDERER));
+    return renderer ? renderer : "";
+}
+
+std::vector<double> STLViewer::renderBenchmarkFrames(int frameCount)
+{
+    // 垂直同期を無効にし、フレームの所要時間が画面の更新間隔に揃わないようにする
+    glfwSwapInterval(0);
+
+    auto frameSeconds = std::vector<double>{};
+    frameSeconds.reserve(static_cast<std::size_t>(std::max(frameCount, 0)));
+    for (int frame = 0; frame < frameCount && !glfwWindowShouldClose(window.get()); ++frame)
+    {
+        auto start = std::chrono::steady_clock::now();
+        renderExecutor.runPending();
+        auto progress = static_cast<float>(frame) / static_cast<float>(frameCount);
+        orbitCamera(CAMERA_ORBIT_START + 2.0f * std::numbers::pi_v<float> * progress);
+        render();
+        glfwSwapBuffers(window.get());
+
+        // コマンドの発行ではなく描画の完了までを計測する
+        glFinish();
+        glfwPollEvents();
+        frameSeconds.push_back(secondsBetween(start, std::chrono::steady_clock::now()));
+    }
+
+    setupCamera();
+    return frameSeconds;
+}
+
+void STLViewer::run()
+{
+
+    while (!glfwWindowShouldClose(window.get()))
+    {
+        // 非同期読み込みの描画スレッド側処理（GPU転送など）を実行
+        renderExecutor.runPending();
+
+        // 入力処理
+        processInput();
+
+        // レンダリング
+        render();
+
+        // バッファをスワップ
+        glfwSwapBuffers(window.get());
+
+        // イベントを処理
+        glfwPollEvents();
+    }
+}
+
+void STLViewer::render()
+{
+    glClearColor(BACKGROUND_R, BACKGROUND_G, BACKGROUND_B, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+    shader.use();
+    updateMatrices();
+    sendClipPlanesToShader();
+
+    renderAxes();
+
+    // モデルとオーバーレイはクリップ平面で切断する（座標軸は切断しない）
+    // 特徴辺は座標軸と同じ線の描画の続きとしてモデルより先に描き、裏側の辺はモデルの深度で隠す
+    setClipDistancesEnabled(true);
+    renderFeatureEdges();
+    renderModel();
+    renderPoints();
+    renderClipCaps();
+    renderSliceOverlay();
+    renderTopologyOverlay();
+    renderInterferenceOverlay();
+    setClipDistancesEnabled(false);
+}
+
+void STLViewer::renderAxes()
+{
+    // 座標軸を描画（アイデンティティ行列を使用）
+    auto axesModel = glm::mat4{1.0f};
+    shader.setMat4("model", axesModel);
+    shader.setBool("useFaceNormals", false);
+
+    glLineWidth(LINE_WIDTH);
+    glBindVertexArray(axesVAO);
+    glDrawArrays(GL_LINES, 0, AXES_COUNT * AXIS_VERTICES);
+    glBindVertexArray(0);
+}
+
+void STLViewer::renderModel()
+{
+    // 頂点の点描画中は三角形を描画しない（点は renderPoints() で描画する）
+    if (vertexPointsVisible && vertexPointCount > 0)
+    {
+        return;
+    }
+
+    // 3Dモデルを描画（変換されたモデル行列を使用）
+    shader.setMat4("model", model);
+
+    // スライス輪郭・特徴辺は面上にあるため、面を奥へずらして線が隠れないようにする
+    if (sliceVertexCount > 0 || (featureEdgesVisible && featureEdgeVertexCount > 0))
+    {
+        glEnable(GL_POLYGON_OFFSET_FILL);
+        glPolygonOffset(MODEL_POLYGON_OFFSET_FACTOR, MODEL_POLYGON_OFFSET_UNITS);
+    }
+
+    glBindVertexArray(modelVAO);
+    if (modelEBO != 0)
+    {
+        // 溶接済みメッシュ: 色は定数属性で与え、法線はシェーダーで面から算出する
+        shader.setBool("useFaceNormals", true);
+
+        // 肉厚のヒートマップ: 色の範囲の上限は中央値の数倍に抑え、薄い部分の差を見やすくする
+        auto heatMapEnabled = heatMapVisible && modelScalarVBO != 0;
+        shader.setBool("heatMapEnabled", heatMapEnabled);
+        if (heatMapEnabled)
+        {
+            shader.setFloat("scalarMin", wallThickness.minimum);
+            shader.setFloat("scalarMax", std::min(wallThickness.maximum, wallThickness.median * HEAT_MAP_MEDIAN_SCALE));
+        }
+
+        // 偏差の色分け: 量子化した値は [-1, 1] で届くため、段数を掛けると許容差の倍数になる
+        auto deviationMapEnabled = deviationMapVisible && modelDeviationVBO != 0;
+        shader.setBool("deviationMapEnabled", deviationMapEnabled);
+        if (deviationMapEnabled)
+        {
+            shader.setInt("deviationBands", DEVIATION_BAND_COUNT);
+        }
+
+        // 環境遮蔽: 非表示時は属性配列を無効にし、定数属性（遮蔽なし）を使わせる
+        if (modelOcclusionVBO != 0)
+        {
+            if (ambientOcclusionVisible)
+            {
+                glEnableVertexAttribArray(OCCLUSION_ATTRIBUTE_INDEX);
+            }
+            else
+            {
+                glDisableVertexAttribArray(OCCLUSION_ATTRIBUTE_INDEX);
+            }
+        }
+
+        // 向きの揃った閉じたメッシュは裏面が見えないため、背面の描画を省略する
+        auto cullBackFaces = orientationReport.canCullBackFaces();
+        if (cullBackFaces)
+        {
+            glEnable(GL_CULL_FACE);
+        }
+        renderShells();
+        if (cullBackFaces)
+        {
+            glDisable(GL_CULL_FACE);
+        }
+        shader.setBool("heatMapEnabled", false);
+        shader.setBool("deviationMapEnabled", false);
+    }
+    else
+    {
+        shader.setBool("useFaceNormals", false);
+        glDrawArrays(GL_TRIANGLES, 0, mesh.triangles.size() * TRIANGLE_VERTICES);
+    }
+    glBindVertexArray(0);
+    glDisable(GL_POLYGON_OFFSET_FILL);
+}
+
+void STLViewer::renderShells()
+{
+    const auto &shells = shellDecomposition.shells;
+    auto cullShells = shells.size() > 1 && shells.size() <= MAX_CULLED_SHELLS;
+    auto mvp = projection * view * model;
+
+    // 単色表示では隣接する描画対象のシェルを1回の描画呼び出しにまとめる
+    auto runBegin = std::size_t{0};
+    auto runEnd = std::size_t{0};
+    auto flush = [&runBegin, &runEnd]() {
+        if (runEnd > runBegin)
+        {
+            glDrawElements(GL_TRIANGLES, static_cast<GLsizei>((runEnd - runBegin) * TRIANGLE_VERTICES),
+                           GL_UNSIGNED_INT, (void *)(runBegin * TRIANGLE_VERTICES * sizeof(std::uint32_t)));
+        }
+        runBegin = runEnd;
+    };
+
+    glVertexAttrib3f(COLOR_ATTRIBUTE_INDEX, MODEL_COLOR_R, MODEL_COLOR_G, MODEL_COLOR_B);
+    for (std::size_t s = 0; s < shells.size(); ++s)
+    {
+        const auto &shell = shells[s];
+        auto visible = shellVisibility[s] && (!cullShells || isBoxInFrustum(mvp, shell.minBounds, shell.maxBounds));
+        if (!visible || shellColoringEnabled)
+        {
+            flush();
+        }
+        if (!visible)
+        {
+            runBegin = runEnd = shell.firstTriangle + shell.triangleCount;
+            continue;
+        }
+
+        if (shellColoringEnabled)
+        {
+            auto color = shellColor(s);
+            glVertexAttrib3f(COLOR_ATTRIBUTE_INDEX, color.x, color.y, color.z);
+        }
+        runEnd = shell.firstTriangle + shell.triangleCount;
+    }
+    flush();
+}
+
+void STLViewer::toggleShellVisibility(std::size_t shell)
 {
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+    if (shell < shellVisibility.size())
     {
-        logError("Failed to initialize GLAD", __func__);
-        return false;
+        shellVisibility[shell] = !shellVisibility[shell];
     }
+}
 
-    // 深度テストを有効化
-    glEnable(GL_DEPTH_TEST);
-    return true;
+void STLViewer::showAllShells()
+{
+    std::fill(shellVisibility.begin(), shellVisibility.end(), 1);
 }
 
-void STLViewer::setupCallbacks()
+void STLViewer::renderFeatureEdges()
 {
-    // ウィンドウユーザーポインターを設定
-    glfwSetWindowUserPointer(window.get(), this);
+    if (!featureEdgesVisible || featureEdgeVertexCount == 0)
+    {
+        return;
+    }
 
-    // マウスコールバックを設定
-    glfwSetScrollCallback(window.get(), scroll_callback);
+    // 座標軸と同じ線の描画（頂点形式・シェーダー）でモデル行列のみ切り替える
+    shader.setMat4("model", model);
+    shader.setBool("useFaceNormals", false);
+
+    glLineWidth(FEATURE_EDGE_LINE_WIDTH);
+    glBindVertexArray(featureEdgeVAO);
+    glDrawArrays(GL_LINES, 0, featureEdgeVertexCount);
+    glBindVertexArray(0);
 }
 
-bool STLViewer::loadSTL(const std::string &filename)
+void STLViewer::renderPoints()
 {
-    auto loader = ModelLoader{};
-    if (!loader.loadFile(filename, mesh))
+    auto showVertexPoints = vertexPointsVisible && vertexPointCount > 0;
+    if (pointCount == 0 && !showVertexPoints)
     {
-        auto oss = std::ostringstream{};
-        oss << "Failed to load 3D model file: " << loader.getErrorMessage();
-        logError(oss.str(), __func__);
-        return false;
+        return;
     }
 
-    // シェーダー設定
-    if (!setupShaders())
+    // 点スプライトは画面上で一定の大きさの円として描き、フラグメントシェーダーで球として陰影を付ける
+    shader.setMat4("model", model);
+    shader.setBool("useFaceNormals", false);
+    shader.setBool("pointSpritesEnabled", true);
+    shader.setFloat("pointSize", pointSize);
+    glEnable(GL_PROGRAM_POINT_SIZE);
+    glVertexAttrib3f(COLOR_ATTRIBUTE_INDEX, MODEL_COLOR_R, MODEL_COLOR_G, MODEL_COLOR_B);
+
+    // 点は間引き順に並んでいるため、隙間なく見える点数だけ先頭から描画する（遠いほど少なくなる）
+    auto radius = projectedModelRadius();
+    auto drawPoints = [this, radius](unsigned int vao, std::size_t count) {
+        glBindVertexArray(vao);
+        glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(visiblePointCount(count, radius, pointSize)));
+    };
+    if (pointCount > 0)
     {
-        return false;
+        drawPoints(pointVAO, pointCount);
     }
-
-    // 座標軸バッファ設定
-    if (!setupAxesBuffers())
+    if (showVertexPoints)
     {
-        return false;
+        drawPoints(vertexPointVAO, vertexPointCount);
     }
+    glBindVertexArray(0);
 
-    // 3Dモデルバッファ設定
-    if (!setupModelBuffers())
+    glDisable(GL_PROGRAM_POINT_SIZE);
+    shader.setBool("pointSpritesEnabled", false);
+}
+
+float STLViewer::projectedModelRadius() const
+{
+    // モデルは最大辺が MODEL_DESIRED_SIZE になるよう拡大縮小されて原点に置かれる
+    auto radius = MODEL_DESIRED_SIZE * MODEL_BOUNDING_RADIUS_RATIO;
+    auto distance = glm::length(cameraPos);
+    if (distance <= radius)
     {
-        return false;
+        return std::numeric_limits<float>::max(); // カメラが外接球の内側にある場合は全点を描画させる
     }
 
-    // カメラ設定
-    setupCamera();
-
-    return true;
+    // 外接球の見かけの半径（視野角の正接）を画面の高さのピクセル数に換算する
+    auto tangent = radius / std::sqrt(distance * distance - radius * radius);
+    return tangent / std::tan(glm::radians(FOV_DEGREES) * 0.5f) * static_cast<float>(WINDOW_HEIGHT) * 0.5f;
 }
 
-bool STLViewer::setupShaders()
+void STLViewer::renderSliceOverlay()
 {
-
-    if (!shader.create(VERTEX_SHADER_PATH, FRAGMENT_SHADER_PATH))
+    if (sliceVertexCount == 0)
     {
-        auto oss = std::ostringstream{};
-        oss << "Failed to create shader: " << shader.getErrorMessage();
-        logError(oss.str(), __func__);
-        return false;
+        return;
     }
 
-    shader.use();
+    // スライス輪郭は裏側の層が隠れるよう深度テストありで描画する
+    shader.setMat4("model", model);
+    shader.setBool("useFaceNormals", false);
 
-    return true;
+    glLineWidth(SLICE_LINE_WIDTH);
+    glBindVertexArray(sliceVAO);
+    glDrawArrays(GL_LINES, 0, sliceVertexCount);
+    glBindVertexArray(0);
 }
 
-bool STLViewer::setupAxesBuffers()
+bool STLViewer::setupCapBuffers()
 {
-    auto vertices = createAxesVertices();
-    return createAxesOpenGLBuffers(vertices);
+    // XY平面上の正方形（位置3つ + 色3つ + 法線3つ = 9つの値）。createCapMatrix()で断面へ配置する
+    auto vertices = std::vector<float>{};
+    vertices.reserve(CAP_VERTICES * VERTEX_COMPONENTS);
+    for (const auto &corner : {glm::vec2{-1.0f, -1.0f}, glm::vec2{1.0f, -1.0f}, glm::vec2{1.0f, 1.0f},
+                               glm::vec2{-1.0f, -1.0f}, glm::vec2{1.0f, 1.0f}, glm::vec2{-1.0f, 1.0f}})
+    {
+        vertices.insert(vertices.end(),
+                        {corner.x, corner.y, 0.0f, CLIP_CAP_R, CLIP_CAP_G, CLIP_CAP_B, 0.0f, 0.0f, 1.0f});
+    }
+
+    auto buffers = createOpenGLBuffers(vertices);
+    capVAO = buffers.VAO;
+    capVBO = buffers.VBO;
+    return true;
 }
 
-bool STLViewer::setupModelBuffers()
+void STLViewer::sendClipPlanesToShader() const
 {
-    auto vertices = convertSTLToVertices();
-    return createModelBuffers(vertices);
+    for (std::size_t i = 0; i < clipPlanes.size(); ++i)
+    {
+        const auto &plane = clipPlanes[i];
+        shader.setVec4("clipPlanes[" + std::to_string(i) + "]", glm::vec4{plane.normal, plane.offset});
+    }
 }
 
-std::vector<float> STLViewer::convertSTLToVertices() const
+void STLViewer::setClipDistancesEnabled(bool enabled) const
 {
-    // 3Dモデルデータを頂点配列に変換（位置3つ + 色3つ + 法線3つ = 9つの値）
-    auto vertices = std::vector<float>{};
-    vertices.reserve(mesh.triangles.size() * TRIANGLE_VERTICES * VERTEX_COMPONENTS);
-
-    // 各三角形の頂点データをOpenGL用の配列形式に変換
-    for (const auto& triangle : mesh.triangles) {
-        auto vertexData = triangle.vertices 
-            | boost::adaptors::transformed([&triangle](const auto& vertex) {
-                return std::array<float, VERTEX_COMPONENTS>{
-                    vertex.x, vertex.y, vertex.z,                    // 位置
-                    MODEL_COLOR_R, MODEL_COLOR_G, MODEL_COLOR_B,     // 色  
-                    triangle.normal.x, triangle.normal.y, triangle.normal.z  // 法線
-                };
-            });
-        
-        for (const auto& vertexArray : vertexData) {
-            vertices.insert(vertices.end(), vertexArray.begin(), vertexArray.end());
+    for (std::size_t i = 0; i < clipPlanes.size(); ++i)
+    {
+        if (enabled && clipPlanes[i].enabled)
+        {
+            glEnable(GL_CLIP_DISTANCE0 + static_cast<GLenum>(i));
+        }
+        else
+        {
+            glDisable(GL_CLIP_DISTANCE0 + static_cast<GLenum>(i));
         }
     }
-
-    return vertices;
 }
 
-bool STLViewer::createModelBuffers(const std::vector<float> &vertices)
+bool STLViewer::hasEnabledClipPlanes() const
 {
-    auto buffers = createOpenGLBuffers(vertices);
-    modelVAO = buffers.VAO;
-    modelVBO = buffers.VBO;
-    return true;
+    return std::any_of(clipPlanes.begin(), clipPlanes.end(), [](const ClipPlane &plane) { return plane.enabled; });
 }
 
-void STLViewer::setupCamera()
+glm::mat4 STLViewer::createCapMatrix(const ClipPlane &plane) const
 {
-    // カメラをさらに遠くに配置
-    cameraPos = glm::vec3{CAMERA_DISTANCE, CAMERA_DISTANCE, CAMERA_DISTANCE};
-    cameraFront = glm::normalize(glm::vec3{0.0f, 0.0f, 0.0f} - cameraPos); // 原点を向く
-    cameraUp = glm::vec3{0.0f, 1.0f, 0.0f};
-    
-    // ライトの設定
-    lightPos = glm::vec3{2.0f, 2.0f, 2.0f};
-    lightColor = glm::vec3{1.0f, 1.0f, 1.0f}; // 白色光
+    // 四角形のZ軸を断面の外向き（切り取られた側 = -normal）に合わせる
+    auto w = -plane.normal;
+    auto helper = std::abs(w.x) < 0.9f ? glm::vec3{1.0f, 0.0f, 0.0f} : glm::vec3{0.0f, 1.0f, 0.0f};
+    auto u = glm::normalize(glm::cross(helper, w));
+    auto v = glm::cross(w, u);
+
+    auto matrix = glm::mat4{1.0f};
+    matrix[0] = glm::vec4{u * CAP_HALF_SIZE, 0.0f};
+    matrix[1] = glm::vec4{v * CAP_HALF_SIZE, 0.0f};
+    matrix[2] = glm::vec4{w, 0.0f};
+    matrix[3] = glm::vec4{-plane.normal * plane.offset, 1.0f}; // 原点に最も近い平面上の点
+    return matrix;
 }
 
-void STLViewer::run()
+void STLViewer::renderClipCaps()
 {
-
-    while (!glfwWindowShouldClose(window.get()))
+    // 断面の内外判定は閉じたメッシュでのみ成り立つ
+    if (!hasEnabledClipPlanes() || modelEBO == 0 || !orientationReport.canCullBackFaces())
     {
-        // 入力処理
-        processInput();
-
-        // レンダリング
-        render();
+        return;
+    }
 
-        // バッファをスワップ
-        glfwSwapBuffers(window.get());
+    glEnable(GL_STENCIL_TEST);
+    for (std::size_t i = 0; i < clipPlanes.size(); ++i)
+    {
+        if (!clipPlanes[i].enabled)
+        {
+            continue;
+        }
 
-        // イベントを処理
-        glfwPollEvents();
+        // 1. 切断後のモデルの面を数え、視線上の面の数が奇数の画素（断面の内側）に印を付ける
+        glClear(GL_STENCIL_BUFFER_BIT);
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        glDepthMask(GL_FALSE);
+        glDisable(GL_DEPTH_TEST);
+        glStencilFunc(GL_ALWAYS, 0, 1);
+        glStencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
+
+        shader.setMat4("model", model);
+        glBindVertexArray(modelVAO);
+        renderShells();
+        glBindVertexArray(0);
+
+        // 2. 印の付いた画素にだけ断面の四角形を描く（自身の平面では切断しない）
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        glDepthMask(GL_TRUE);
+        glEnable(GL_DEPTH_TEST);
+        glStencilFunc(GL_NOTEQUAL, 0, 1);
+        glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+        glDisable(GL_CLIP_DISTANCE0 + static_cast<GLenum>(i));
+
+        shader.setMat4("model", createCapMatrix(clipPlanes[i]));
+        shader.setBool("useFaceNormals", false);
+        glBindVertexArray(capVAO);
+        glDrawArrays(GL_TRIANGLES, 0, CAP_VERTICES);
+        glBindVertexArray(0);
+
+        glEnable(GL_CLIP_DISTANCE0 + static_cast<GLenum>(i));
     }
+    glDisable(GL_STENCIL_TEST);
 }
 
-void STLViewer::render()
+void STLViewer::toggleClipPlane(std::size_t axis)
 {
-    glClearColor(BACKGROUND_R, BACKGROUND_G, BACKGROUND_B, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    if (axis >= clipPlanes.size())
+    {
+        return;
+    }
+    clipPlanes[axis].enabled = !clipPlanes[axis].enabled;
+    activeClipPlane = axis;
+}
 
-    shader.use();
-    updateMatrices();
+void STLViewer::flipActiveClipPlane()
+{
+    auto &plane = clipPlanes[activeClipPlane];
+    plane.normal = -plane.normal;
+    plane.offset = -plane.offset;
+}
 
-    renderAxes();
-    renderModel();
+void STLViewer::moveActiveClipPlane(float distance)
+{
+    auto &plane = clipPlanes[activeClipPlane];
+    plane.offset = std::clamp(plane.offset + distance, -CLIP_OFFSET_LIMIT, CLIP_OFFSET_LIMIT);
 }
 
-void STLViewer::renderAxes()
+void STLViewer::renderTopologyOverlay()
 {
-    // 座標軸を描画（アイデンティティ行列を使用）
-    auto axesModel = glm::mat4{1.0f};
-    shader.setMat4("model", axesModel);
+    if (topologyVertexCount == 0)
+    {
+        return;
+    }
 
-    glLineWidth(LINE_WIDTH);
-    glBindVertexArray(axesVAO);
-    glDrawArrays(GL_LINES, 0, AXES_COUNT * AXIS_VERTICES);
+    // 問題のある辺はモデルに隠れないよう深度テストなしで重ねて描画する
+    shader.setMat4("model", model);
+    shader.setBool("useFaceNormals", false);
+
+    glDisable(GL_DEPTH_TEST);
+    glLineWidth(OVERLAY_LINE_WIDTH);
+    glBindVertexArray(topologyVAO);
+    glDrawArrays(GL_LINES, 0, topologyVertexCount);
     glBindVertexArray(0);
+    glEnable(GL_DEPTH_TEST);
 }
 
-void STLViewer::renderModel()
+void STLViewer::renderInterferenceOverlay()
 {
-    // 3Dモデルを描画（変換されたモデル行列を使用）
+    if (interferenceVertexCount == 0)
+    {
+        return;
+    }
+
+    // 交線はモデルの内部にも生じるため、深度テストなしで重ねて描画する
     shader.setMat4("model", model);
+    shader.setBool("useFaceNormals", false);
 
-    glBindVertexArray(modelVAO);
-    glDrawArrays(GL_TRIANGLES, 0, mesh.triangles.size() * TRIANGLE_VERTICES);
+    glDisable(GL_DEPTH_TEST);
+    glLineWidth(OVERLAY_LINE_WIDTH);
+    glBindVertexArray(interferenceVAO);
+    glDrawArrays(GL_LINES, 0, interferenceVertexCount);
     glBindVertexArray(0);
+    glEnable(GL_DEPTH_TEST);
 }
 
 void STLViewer::updateMatrices()
@@ -346,8 +1944,9 @@ void STLViewer::updateModelMatrix()
     auto scale = desiredSize / maxDimension;
 
     // 順序を変更: 1. スケール → 2. 平行移動
+    // （平行移動はスケール前の座標に適用されるため、中心をそのまま原点へ移す）
     model = glm::scale(model, glm::vec3{scale});
-    model = glm::translate(model, -mesh.center * scale);
+    model = glm::translate(model, -modelCenter);
 }
 
 void STLViewer::sendMatricesToShader() const
@@ -406,7 +2005,7 @@ std::vector<float> STLViewer::createAxesVertices() const
     };
 }
 
-bool STLViewer::createAxesOpenGLBuffers(const std::vector<float>& vertices)
+bool STLViewer::createAxesOpenGLBuffers(std::span<const float> vertices)
 {
     auto buffers = createOpenGLBuffers(vertices);
     axesVAO = buffers.VAO;
@@ -422,7 +2021,7 @@ void STLViewer::processInput()
     }
 }
 
-STLViewer::BufferPair STLViewer::createOpenGLBuffers(const std::vector<float>& vertices)
+STLViewer::BufferPair STLViewer::createOpenGLBuffers(std::span<const float> vertices)
 {
     BufferPair buffers{};
     
@@ -433,7 +2032,10 @@ STLViewer::BufferPair STLViewer::createOpenGLBuffers(const std::vector<float>& v
     glBindVertexArray(buffers.VAO);
 
     glBindBuffer(GL_ARRAY_BUFFER, buffers.VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    {
+        TRACE_SCOPE("glBufferData (vertices)");
+        glBufferData(GL_ARRAY_BUFFER, vertices.size_bytes(), vertices.data(), GL_STATIC_DRAW);
+    }
 
     // 頂点属性を設定（共通関数使用）
     setupVertexAttributes();
@@ -443,6 +2045,172 @@ STLViewer::BufferPair STLViewer::createOpenGLBuffers(const std::vector<float>& v
     return buffers;
 }
 
+STLViewer::BufferPair STLViewer::createPointBuffers(std::span<const glm::vec3> points)
+{
+    BufferPair buffers{};
+    glGenVertexArrays(1, &buffers.VAO);
+    glGenBuffers(1, &buffers.VBO);
+
+    glBindVertexArray(buffers.VAO);
+
+    // 頂点は位置のみ（色・法線は定数属性）
+    glBindBuffer(GL_ARRAY_BUFFER, buffers.VBO);
+    {
+        TRACE_SCOPE("glBufferData (points)");
+        glBufferData(GL_ARRAY_BUFFER, points.size_bytes(), points.data(), GL_STATIC_DRAW);
+    }
+    glVertexAttribPointer(POSITION_ATTRIBUTE_INDEX, POSITION_COMPONENTS, GL_FLOAT, GL_FALSE,
+                          POSITION_COMPONENTS * sizeof(float), (void *)0);
+    glEnableVertexAttribArray(POSITION_ATTRIBUTE_INDEX);
+
+    glBindVertexArray(0);
+    return buffers;
+}
+
+void STLViewer::logRepairStats(const RepairStats &stats) const
+{
+    if (stats.removedTriangles() == 0 && stats.recomputedNormals == 0)
+    {
+        return;
+    }
+
+    std::cout << "[Mesh repair] Removed " << stats.removedTriangles() << " triangles (non-finite "
+              << stats.nonFiniteTriangles << ", degenerate " << stats.degenerateTriangles << ", duplicate "
+              << stats.duplicateTriangles << "), recomputed " << stats.recomputedNormals << " normals" << std::endl;
+}
+
+void STLViewer::logSkippedAnalyses() const
+{
+    auto skipped = std::vector<std::string>{};
+    if (topologyCheckEnabled)
+    {
+        skipped.emplace_back("topology check");
+    }
+    if (sliceLayerCount > 0)
+    {
+        skipped.emplace_back("slicing");
+    }
+    if (wallThicknessEnabled)
+    {
+        skipped.emplace_back("wall thickness");
+    }
+    if (interferenceCheckEnabled)
+    {
+        skipped.emplace_back("interference check");
+    }
+    if (!deviationReferencePath.empty())
+    {
+        skipped.emplace_back("deviation analysis");
+    }
+    if (ambientOcclusionRays > 0)
+    {
+        skipped.emplace_back("ambient occlusion");
+    }
+    if (featureEdgesEnabled)
+    {
+        skipped.emplace_back("feature edges");
+    }
+
+    if (skipped.empty())
+    {
+        return;
+    }
+
+    std::cerr << "[Weld] Vertex welding is disabled (--no-weld); skipped ";
+    for (std::size_t i = 0; i < skipped.size(); ++i)
+    {
+        std::cerr << (i == 0 ? "" : ", ") << skipped[i];
+    }
+    std::cerr << " (remove --no-weld to enable them)" << std::endl;
+}
+
+void STLViewer::logTopologyReport(const TopologyReport &report) const
+{
+    std::cout << "[Topology] " << (report.isClosed() ? "Closed" : "Open") << ", "
+              << (report.isManifold() ? "manifold" : "non-manifold") << ": " << report.edgeCount << " edges, "
+              << report.boundaryEdges << " boundary, " << report.nonManifoldEdges << " non-manifold, "
+              << report.inconsistentEdges << " inconsistently oriented; " << report.nonManifoldVertices
+              << " non-manifold vertices" << std::endl;
+}
+
+void STLViewer::logShells(const ShellDecomposition &decomposition) const
+{
+    const auto &shells = decomposition.shells;
+    auto largest = std::max_element(shells.begin(), shells.end(), [](const MeshShell &lhs, const MeshShell &rhs) {
+        return lhs.triangleCount < rhs.triangleCount;
+    });
+    std::cout << "[Shells] " << shells.size() << " shells, largest has " << largest->triangleCount << " triangles"
+              << std::endl;
+}
+
+void STLViewer::logOrientationReport(const OrientationReport &report) const
+{
+    std::cout << "[Orientation] Flipped " << report.flippedTriangles << " triangles (" << report.invertedPatches
+              << " of " << report.patches << " patches turned outward, " << report.cavityShells
+              << " cavity shells turned inward), " << report.conflictingEdges
+              << " conflicting edges, " << report.openEdges << " open edges; back-face culling "
+              << (report.canCullBackFaces() ? "enabled" : "disabled") << std::endl;
+}
+
+void STLViewer::logWallThickness(const WallThickness &thickness) const
+{
+    std::cout << "[Thickness] Min " << thickness.minimum << ", median " << thickness.median << ", max "
+              << thickness.maximum << "; " << thickness.unmeasuredTriangles << " triangles without opposite surface"
+              << std::endl;
+}
+
+void STLViewer::logInterferenceReport(const InterferenceReport &report) const
+{
+    std::cout << "[Interference] " << report.contacts.size() << " intersecting part pairs ("
+              << report.triangleContactCount() << " triangle pairs) among " << report.partCount << " shells, "
+              << report.candidatePairs << " pairs with overlapping bounds" << std::endl;
+    for (std::size_t i = 0; i < std::min(report.contacts.size(), MAX_LOGGED_PART_CONTACTS); ++i)
+    {
+        const auto &contact = report.contacts[i];
+        std::cout << "[Interference]   shell " << contact.firstPart << " <-> shell " << contact.secondPart << ": "
+                  << contact.contacts.size() << " triangle pairs" << std::endl;
+    }
+}
+
+void STLViewer::logDeviation(const MeshDeviation &deviation) const
+{
+    auto count = deviation.vertexDeviation.size();
+    auto percentage = count > 0 ? 100.0 * static_cast<double>(deviation.withinTolerance) / static_cast<double>(count) : 0.0;
+    std::cout << "[Deviation] Min " << deviation.minimum << ", max " << deviation.maximum << ", mean "
+              << deviation.mean << ", RMS " << deviation.rms << "; " << deviation.withinTolerance << " of " << count
+              << " vertices (" << percentage << "%) within +/-" << deviation.tolerance << std::endl;
+}
+
+void STLViewer::logAmbientOcclusion(const AmbientOcclusion &occlusion) const
+{
+    std::cout << "[Occlusion] " << (occlusion.cached ? "Loaded from cache" : "Baked") << ": "
+              << occlusion.vertexAccessibility.size() << " vertices, " << occlusion.rayCount << " rays/vertex, radius "
+              << occlusion.radius << ", mean accessibility " << occlusion.meanAccessibility * 100.0f << "%"
+              << std::endl;
+}
+
+void STLViewer::logFeatureEdges(const FeatureEdges &features) const
+{
+    std::cout << "[Features] " << (features.cached ? "Loaded from cache" : "Extracted") << ": "
+              << features.edgeCount() << " edges (" << features.creaseEdges << " creases above "
+              << features.angleDegrees << " degrees, " << features.outlineEdges << " boundary/non-manifold)"
+              << std::endl;
+}
+
+void STLViewer::logPointRendering(std::size_t triangleCount) const
+{
+    if (pointCount > 0)
+    {
+        std::cout << "[Points] " << pointCount << " point primitives drawn as " << pointSize << " px sprites"
+                  << std::endl;
+    }
+    if (vertexPointCount > 0)
+    {
+        std::cout << "[Points] " << triangleCount << " triangles exceed the budget of " << pointTriangleBudget
+                  << "; drawing " << vertexPointCount << " vertices as points (press P to toggle)" << std::endl;
+    }
+}
+
 void STLViewer::logError(const std::string &message, const std::string &functionName) const
 {
     if (!functionName.empty())
@@ -465,3 +2233,83 @@ void scroll_callback(GLFWwindow *window, double xoffset, double yoffset)
     float sensitivity = SCROLL_SENSITIVITY;
     viewer->cameraPos += viewer->cameraFront * static_cast<float>(yoffset) * sensitivity;
 }
+
+void key_callback(GLFWwindow *window, int key, int scancode, int action, int mods)
+{
+    STLViewer *viewer = static_cast<STLViewer *>(glfwGetWindowUserPointer(window));
+    if (!viewer || action != GLFW_PRESS)
+        return;
+
+    // C: シェルごとの色分け、1-9: 各シェルの表示切り替え、0: 全シェルを表示
+    if (key == GLFW_KEY_C)
+    {
+        viewer->shellColoringEnabled = !viewer->shellColoringEnabled;
+    }
+    else if (key >= GLFW_KEY_1 && key <= GLFW_KEY_9)
+    {
+        viewer->toggleShellVisibility(static_cast<std::size_t>(key - GLFW_KEY_1));
+    }
+    else if (key == GLFW_KEY_0)
+    {
+        viewer->showAllShells();
+    }
+    // X/Y/Z: 各軸に垂直なクリップ平面の切り替え、F: 操作中の平面の向きを反転
+    else if (key == GLFW_KEY_X || key == GLFW_KEY_Y || key == GLFW_KEY_Z)
+    {
+        viewer->toggleClipPlane(static_cast<std::size_t>(key == GLFW_KEY_X ? 0 : key == GLFW_KEY_Y ? 1 : 2));
+    }
+    else if (key == GLFW_KEY_F)
+    {
+        viewer->flipActiveClipPlane();
+    }
+    // H: 肉厚のヒートマップ表示の切り替え、D: 偏差の色分け表示の切り替え
+    else if (key == GLFW_KEY_H)
+    {
+        viewer->heatMapVisible = !viewer->heatMapVisible;
+    }
+    else if (key == GLFW_KEY_D)
+    {
+        viewer->deviationMapVisible = !viewer->deviationMapVisible;
+    }
+    // O: 環境遮蔽による陰影の切り替え、E: 特徴辺の表示の切り替え
+    else if (key == GLFW_KEY_O)
+    {
+        viewer->ambientOcclusionVisible = !viewer->ambientOcclusionVisible;
+    }
+    else if (key == GLFW_KEY_E)
+    {
+        viewer->featureEdgesVisible = !viewer->featureEdgesVisible;
+    }
+    // P: 三角形数の多いメッシュの頂点の点描画と三角形の描画の切り替え
+    else if (key == GLFW_KEY_P)
+    {
+        viewer->vertexPointsVisible = !viewer->vertexPointsVisible;
+    }
+}
+
+void mouse_button_callback(GLFWwindow *window, int button, int action, int mods)
+{
+    STLViewer *viewer = static_cast<STLViewer *>(glfwGetWindowUserPointer(window));
+    if (!viewer || button != GLFW_MOUSE_BUTTON_RIGHT)
+        return;
+
+    // 右ドラッグで操作中のクリップ平面を法線方向に移動する
+    viewer->draggingClipPlane = action == GLFW_PRESS;
+    if (viewer->draggingClipPlane)
+    {
+        auto xpos = 0.0;
+        glfwGetCursorPos(window, &xpos, &viewer->lastCursorY);
+    }
+}
+
+void cursor_pos_callback(GLFWwindow *window, double xpos, double ypos)
+{
+    STLViewer *viewer = static_cast<STLViewer *>(glfwGetWindowUserPointer(window));
+    if (!viewer || !viewer->draggingClipPlane)
+        return;
+
+    // 上へドラッグすると平面が法線と逆方向へ進み、残る側が小さくなる
+    auto deltaY = static_cast<float>(ypos - viewer->lastCursorY);
+    viewer->lastCursorY = ypos;
+    viewer->moveActiveClipPlane(deltaY * CLIP_DRAG_SENSITIVITY);
+}
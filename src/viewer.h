@@ -9,13 +9,66 @@
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <array>
 #include <string>
 #include <memory>
+#include <vector>
+#include <memory_resource>
+#include <span>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include "executor.h"
+#include "mesh_deviation.h"
+#include "mesh_features.h"
+#include "mesh_interference.h"
+#include "mesh_metrics.h"
+#include "mesh_occlusion.h"
+#include "mesh_orientation.h"
+#include "mesh_shells.h"
+#include "mesh_slicer.h"
+#include "mesh_thickness.h"
+#include "mesh_topology.h"
 #include "model_loader.h"
 #include "shader.h"
+#include "task.h"
+
+struct MeshBvh;
+
+/**
+ * @brief マウススクロールコールバック関数（カメラのズーム）
+ */
+void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
+
+/**
+ * @brief キーボードコールバック関数（シェルの表示切り替え）
+ */
+void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods);
+
+/**
+ * @brief マウスボタンコールバック関数（クリップ平面のドラッグ開始・終了）
+ */
+void mouse_button_callback(GLFWwindow* window, int button, int action, int mods);
+
+/**
+ * @brief カーソル移動コールバック関数（クリップ平面のドラッグ）
+ */
+void cursor_pos_callback(GLFWwindow* window, double xpos, double ypos);
+
+/**
+ * @brief 直近の読み込みの段階ごとの所要時間（秒）
+ *
+ * 各段階は別々のスレッドで実行されるため、段階の境界の時刻の差として求める。
+ */
+struct LoadTimings {
+    double read = 0.0;     ///< ファイル全体の読み込み（I/Oスレッド、外部ファイルを参照する形式では0）
+    double parse = 0.0;    ///< Assimpの読み込み・後処理と三角形配列への変換・修復・ハッシュ
+    double analyze = 0.0;  ///< 溶接・シェル分解・向き修正と有効な解析（スライス・肉厚等）
+    double points = 0.0;   ///< 点群・頂点の点描画の間引き順の生成
+    double dispatch = 0.0; ///< 描画スレッドでジョブが実行されるまでの待ち時間
+    double upload = 0.0;   ///< シェーダーの作成・GPUバッファへの転送・オーバーレイの設定
+    double total = 0.0;    ///< 読み込み全体
+};
 
 /**
  * @brief 3Dモデルを表示するビューアークラス
@@ -29,6 +82,19 @@
  * - 3D座標軸の表示
  * - マウススクロールによるズーム
  * - 自動カメラ配置（モデルが画面中央に表示される）
+ * - コルーチンによる非同期読み込み（I/O・CPU処理・GPU転送を別スレッドで実行）
+ * - 水密性・多様体性チェックと問題のある辺のオーバーレイ表示
+ * - 連結成分（シェル）ごとの表示切り替え・色分け・視錐台カリング
+ * - 面の向きの統一と、閉じたメッシュでの背面カリング
+ * - Z方向の等間隔スライスによる層輪郭のオーバーレイ表示
+ * - GPUクリップ平面による断面表示とステンシルによる断面の塗りつぶし
+ * - BVHの光線追跡による肉厚解析とヒートマップ表示
+ * - BVH同士の走査によるシェル（部品）間の干渉チェックと交線のオーバーレイ表示
+ * - 参照メッシュに対する頂点ごとの偏差の許容差段階による色分け表示
+ * - 光線追跡で焼き込んだ頂点ごとの環境遮蔽による陰影（結果はディスクキャッシュに保存）
+ * - 二面角による特徴辺（稜線）の抽出と線表示（結果はディスクキャッシュに保存）
+ * - 点群（点プリミティブ）の点スプライト描画と、三角形数の多いメッシュの頂点の点描画
+ *   （画面上の大きさに応じて空間的に均等に間引く）
  * 
  * @note OpenGL 3.3 Core Profileを使用
  * @note GLFWによるウィンドウ管理
@@ -40,13 +106,144 @@ private:
     // ウィンドウ・コンテキスト管理
     std::unique_ptr<GLFWwindow, void(*)(GLFWwindow*)> window;
     
+    // 実行中の読み込みタスク（全エグゼキューターの停止後に、中断したままのフレームを破棄する）
+    TaskScope loadTasks;
+    
+    // 非同期読み込み用エグゼキューター
+    // （ワーカーが描画スレッドへジョブを投入するため、renderExecutorを先に宣言して後に破棄する）
+    // タスクが参照する後続のメンバーはこれらより先に破棄されるため、デストラクタの最初に
+    // ワーカーを停止して loadTasks の中断したままのフレームを破棄する
+    RenderThreadExecutor renderExecutor; // 描画スレッド（OpenGL呼び出し）
+    ThreadPoolExecutor ioExecutor;       // ファイルI/O
+    ThreadPoolExecutor cpuExecutor;      // パース・後処理
+    
     // シェーダー・描画リソース
     Shader shader;
     ModelMesh mesh;
+    IndexedMesh indexedMesh;            // 溶接済みメッシュ（溶接無効時は空）
+    
+    // 頂点溶接設定
+    bool weldEnabled;
+    float weldEpsilon;                  // 負の場合は自動設定
+    
+    // 水密性・多様体性チェック
+    bool topologyCheckEnabled;
+    TopologyReport topologyReport;
+    
+    // シェル（連結成分）ごとの描画制御（溶接時のみ）
+    ShellDecomposition shellDecomposition;
+    std::vector<std::uint8_t> shellVisibility; // シェルごとの表示フラグ
+    bool shellColoringEnabled;                 // シェルごとに色分けするか
+    
+    // 面の向き修正の結果（溶接時のみ、閉じたメッシュでは背面カリングを行う）
+    OrientationReport orientationReport;
+    
+    // 幾何特性と表示の中心（閉じたメッシュでは体積重心、それ以外はバウンディングボックスの中心）
+    MeshMetrics meshMetrics;
+    glm::vec3 modelCenter;
+    
+    // スライスプレビュー（0の場合は無効）
+    std::size_t sliceLayerCount;
+    
+    // 肉厚解析（溶接時のみ、頂点ごとの肉厚をヒートマップで表示する）
+    bool wallThicknessEnabled;
+    WallThickness wallThickness;
+    bool heatMapVisible;
+    
+    // シェル（部品）間の干渉チェック（溶接時のみ）
+    bool interferenceCheckEnabled;
+    InterferenceReport interferenceReport;
+    
+    // 参照メッシュに対する偏差表示（溶接時のみ、参照メッシュのパスが空の場合は無効）
+    std::string deviationReferencePath;
+    float deviationTolerance;
+    int deviationBits;                  // 頂点属性に量子化するビット数（8または16）
+    MeshDeviation meshDeviation;
+    bool deviationMapVisible;
+    
+    // 頂点ごとの環境遮蔽（溶接時のみ、光線数が0の場合は無効）
+    int ambientOcclusionRays;
+    AmbientOcclusion ambientOcclusion;
+    bool ambientOcclusionVisible;
+    
+    // 特徴辺（稜線）の表示（溶接時のみ）
+    bool featureEdgesEnabled;
+    float featureAngleDegrees;
+    FeatureEdges featureEdges;
+    bool featureEdgesVisible;
+    
+    // 点群・頂点の点描画（点は先頭から任意の数だけ描くと空間的に均等な間引きになる順で転送する）
+    float pointSize;                    // 点スプライトの大きさ（ピクセル）
+    std::size_t pointTriangleBudget;    // これを超える三角形数のメッシュは頂点を点として描画する
+    bool vertexPointsVisible;           // 三角形の代わりに頂点を点として描画するか
+    
+    // ヘッドレス実行（ウィンドウを表示せずに描画する。計測用）と直近の読み込みの段階ごとの所要時間
+    bool headless;
+    LoadTimings loadTimings;
+    
+    /**
+     * @brief 読み込みタスクの各段階が生成する結果
+     * 
+     * CPUエグゼキューター上の段階で埋め、描画スレッドで applyLoadedModel() が表示中の状態へ移す。
+     */
+    struct LoadedModel {
+        explicit LoadedModel(std::pmr::memory_resource* resource) : mesh{resource} {}
+        
+        ModelMesh mesh;
+        IndexedMesh indexedMesh;            // 溶接済みメッシュ（溶接無効時は空）
+        RepairStats repairStats{};
+        TopologyReport topologyReport{};
+        ShellDecomposition shells;
+        OrientationReport orientation{};
+        MeshMetrics metrics{};
+        std::vector<SliceLayer> slices;
+        WallThickness thickness{};
+        InterferenceReport interference{};
+        MeshDeviation deviation{};
+        std::string deviationError;         // 参照メッシュの読み込みに失敗した場合のエラー
+        AmbientOcclusion occlusion{};
+        FeatureEdges features{};
+        std::vector<glm::vec3> pointCloud;  // 間引き順に並べた点群
+        std::vector<glm::vec3> vertexPoints; // 間引き順に並べた頂点（三角形数が上限を超える場合のみ）
+        std::string cacheError;             // キャッシュへの書き込みに失敗した場合のエラー
+    };
+    
+    /**
+     * @brief 断面表示用のクリップ平面（ワールド座標、dot(normal, p) + offset >= 0 の側を残す）
+     */
+    struct ClipPlane {
+        glm::vec3 normal;
+        float offset;
+        bool enabled;
+    };
+    
+    // 断面表示（平面の移動はuniformの更新のみで、バッファは再構築しない）
+    static constexpr std::size_t MAX_CLIP_PLANES{3}; // vertex.glsl の MAX_CLIP_PLANES と一致させる
+    std::array<ClipPlane, MAX_CLIP_PLANES> clipPlanes;
+    std::size_t activeClipPlane;        // ドラッグ・反転の対象となる平面
+    bool draggingClipPlane;
+    double lastCursorY;
     
     // OpenGL バッファオブジェクト
     unsigned int axesVAO, axesVBO;      // 座標軸用
     unsigned int modelVAO, modelVBO;    // 3Dモデル用
+    unsigned int modelEBO;              // 3Dモデル用インデックス（溶接時のみ）
+    unsigned int modelScalarVBO;        // 3Dモデル用の頂点ごとの肉厚（肉厚解析時のみ）
+    unsigned int modelDeviationVBO;     // 3Dモデル用の頂点ごとの量子化した偏差（偏差表示時のみ）
+    unsigned int modelOcclusionVBO;     // 3Dモデル用の頂点ごとの環境遮蔽（焼き込み時のみ）
+    unsigned int topologyVAO, topologyVBO; // 問題のある辺のオーバーレイ用
+    int topologyVertexCount;
+    unsigned int sliceVAO, sliceVBO;    // スライス輪郭のオーバーレイ用
+    int sliceVertexCount;
+    unsigned int interferenceVAO, interferenceVBO; // 干渉部の交線のオーバーレイ用
+    int interferenceVertexCount;
+    unsigned int featureEdgeVAO, featureEdgeVBO; // 特徴辺の線用
+    int featureEdgeVertexCount;
+    unsigned int pointVAO, pointVBO;    // 点群用（位置のみ）
+    std::size_t pointCount;
+    unsigned int vertexPointVAO, vertexPointVBO; // 頂点の点描画用（位置のみ、三角形数が上限を超える場合のみ）
+    std::size_t vertexPointCount;
+    unsigned int capVAO, capVBO;        // 断面の塗りつぶし用の四角形
     
     // カメラシステム
     glm::vec3 cameraPos;
@@ -64,25 +261,67 @@ private:
     
     // プライベートメソッド
     void setupCamera();
+    void orbitCamera(float angle);
     void updateMatrices();
     void updateViewProjectionMatrices();
     void updateModelMatrix();
     void sendMatricesToShader() const;
+    Task<void> analyzeLoadedMesh(LoadedModel& loaded); // 溶接・向き修正と有効な解析（CPU、解析は並行）
+    std::string loadFeatureEdges(LoadedModel& loaded, const EdgeTable& edges, std::uint64_t indexedHash) const;
+    std::string loadAmbientOcclusion(LoadedModel& loaded, MeshBvh& bvh, std::uint64_t indexedHash) const;
+    Task<void> loadDeviationReference(IndexedMesh& referenceMesh, std::string& error); // 参照メッシュの読み込み（I/O→CPU）
+    void orderLoadedPoints(LoadedModel& loaded) const; // 点描画用の間引き順の生成（CPU）
+    bool applyLoadedModel(LoadedModel& loaded);        // 表示中の状態への反映とGPU転送（描画スレッド）
+    void setupAnalysisOverlays(const LoadedModel& loaded);
     bool setupShaders();
     bool setupAxesBuffers();
     bool setupModelBuffers();
-    std::vector<float> convertSTLToVertices() const;
-    bool createModelBuffers(const std::vector<float>& vertices);
+    void releaseModelBuffers();
+    std::pmr::vector<float> convertSTLToVertices() const;
+    bool createModelBuffers(std::span<const float> vertices);
+    bool createIndexedModelBuffers();
     void setupVertexAttributes(); // 共通の頂点属性設定
     std::vector<float> createAxesVertices() const; // 座標軸頂点データ生成
-    bool createAxesOpenGLBuffers(const std::vector<float>& vertices); // 座標軸OpenGLバッファ作成
+    bool createAxesOpenGLBuffers(std::span<const float> vertices); // 座標軸OpenGLバッファ作成
     bool initializeGLFW();
     bool initializeOpenGL();
     void setupCallbacks();
     void render();
     void renderAxes();
     void renderModel();
+    void renderShells();
+    void toggleShellVisibility(std::size_t shell);
+    void showAllShells();
+    void renderTopologyOverlay();
+    bool setupTopologyOverlayBuffers();
+    void releaseTopologyOverlayBuffers();
+    std::vector<float> createTopologyOverlayVertices() const; // 問題のある辺の頂点データ生成
+    void renderSliceOverlay();
+    bool setupSliceOverlayBuffers(const std::vector<SliceLayer>& layers);
+    void releaseSliceOverlayBuffers();
+    std::vector<float> createSliceOverlayVertices(const std::vector<SliceLayer>& layers) const; // 層輪郭の頂点データ生成
+    void renderInterferenceOverlay();
+    bool setupInterferenceOverlayBuffers();
+    void releaseInterferenceOverlayBuffers();
+    std::vector<float> createInterferenceOverlayVertices() const; // 交線の頂点データ生成
+    void renderFeatureEdges();
+    bool setupFeatureEdgeBuffers();
+    void releaseFeatureEdgeBuffers();
+    std::vector<float> createFeatureEdgeVertices() const; // 特徴辺の頂点データ生成
+    void renderPoints();
+    void setupPointBuffers(std::span<const glm::vec3> points, std::span<const glm::vec3> vertexPoints);
+    void releasePointBuffers();
+    float projectedModelRadius() const; // モデルの外接球の画面上の半径（ピクセル）
     void processInput();
+    bool setupCapBuffers();
+    void sendClipPlanesToShader() const;
+    void setClipDistancesEnabled(bool enabled) const;
+    bool hasEnabledClipPlanes() const;
+    void renderClipCaps();
+    glm::mat4 createCapMatrix(const ClipPlane& plane) const;
+    void toggleClipPlane(std::size_t axis);
+    void flipActiveClipPlane();
+    void moveActiveClipPlane(float distance);
 
 public:
     /**
@@ -126,6 +365,186 @@ public:
      */
     bool loadSTL(const std::string& filename);
     
+    /**
+     * @brief 3Dモデルファイルを非同期に読み込むタスクを返す
+     * 
+     * ファイル読み込みはI/Oエグゼキューター、パースと後処理はCPUエグゼキューター、
+     * OpenGLバッファへの転送は描画スレッドで行う。タスクは必ず描画スレッド上で完了する。
+     * 複数の読み込みを同時に実行中にできる（後に完了したものが表示される）。
+     * ファイル内容はパース完了時に、転送用の頂点配列は転送完了時に解放し、両者が同時に残らないようにする
+     * （一時データは既定のメモリリソースから確保する。アリーナでは確保回数・ページフォルト数とも減らなかった）。
+     * メッシュ本体は現在のメッシュと同じメモリリソースに構築する。
+     * 
+     * @param filename 3Dモデルファイルのパス
+     * @return 読み込み成功時にtrueを返すタスク
+     * @pre init()が正常に完了している
+     * @note 描画スレッドのジョブは run() のループ内で処理される
+     */
+    Task<bool> loadSTLAsync(std::string filename);
+    
+    /**
+     * @brief 読み込み時の頂点溶接を設定する
+     * 
+     * 溶接を有効にすると、近接頂点を統合したインデックス付きメッシュを
+     * 位置のみの頂点バッファとインデックスバッファで描画する（面法線はシェーダーで算出）。
+     * 
+     * @param enabled 溶接を行う場合はtrue
+     * @param epsilon 溶接許容誤差（モデル座標単位、負の場合はモデルサイズから自動設定）
+     * @pre 読み込み中のタスクが無いこと（次回以降の読み込みに適用される）
+     */
+    void setWeld(bool enabled, float epsilon);
+    
+    /**
+     * @brief 読み込み時の水密性・多様体性チェックを設定する
+     * 
+     * 有効にすると、読み込み時に辺テーブルを構築して境界辺・非多様体辺を数え、
+     * 結果を標準出力へ出力するとともに、該当する辺をモデルに重ねて描画する
+     * （境界辺は赤、非多様体辺はマゼンタ）。
+     * 
+     * @param enabled チェックを行う場合はtrue
+     * @pre 頂点溶接が有効であること（溶接無効時はチェックされない）
+     * @pre 読み込み中のタスクが無いこと（次回以降の読み込みに適用される）
+     */
+    void setTopologyCheck(bool enabled);
+    
+    /**
+     * @brief 読み込み時のスライスプレビューを設定する
+     * 
+     * 有効にすると、読み込み時にモデルをZ方向に等間隔の平面でスライスし、
+     * 各層の輪郭をモデルに重ねて描画する。
+     * 
+     * @param layerCount 層数（0の場合はスライスしない）
+     * @pre 頂点溶接が有効であること（溶接無効時はスライスされない）
+     * @pre 読み込み中のタスクが無いこと（次回以降の読み込みに適用される）
+     */
+    void setSlicing(std::size_t layerCount);
+    
+    /**
+     * @brief 読み込み時のシェル間の干渉チェックを設定する
+     * 
+     * 有効にすると、読み込み時に各シェルを1つの部品とみなしてシェルごとにBVHを構築し、
+     * 交差する三角形の組を部品の組ごとに標準出力へ出力するとともに、
+     * 交線をモデルに重ねて描画する（黄色）。
+     * 
+     * @param enabled チェックを行う場合はtrue
+     * @pre 頂点溶接が有効であること（溶接無効時はチェックされない）
+     * @pre 読み込み中のタスクが無いこと（次回以降の読み込みに適用される）
+     */
+    void setInterferenceCheck(bool enabled);
+    
+    /**
+     * @brief 読み込み時の参照メッシュに対する偏差解析を設定する
+     * 
+     * 有効にすると、読み込み時に参照メッシュも読み込み、モデルの各頂点から参照面までの
+     * 符号付き距離（外側が正）を並列に求める。偏差は符号付き正規化整数に量子化して頂点属性で転送し、
+     * 許容差以内を緑、外側を黄〜赤、内側を水色〜青として許容差の倍数ごとに段階的に色分けする。
+     * Dキーで色分け表示を切り替えられる。
+     * 
+     * @param referencePath 参照メッシュのファイルパス（空の場合は解析しない）
+     * @param tolerance 許容差（モデル座標系の長さ）
+     * @param bits 量子化のビット数（8または16）
+     * @pre 頂点溶接が有効であること（溶接無効時は解析されない）
+     * @pre 2つのメッシュが同じ座標系に位置合わせ済みであること
+     * @pre 読み込み中のタスクが無いこと（次回以降の読み込みに適用される）
+     */
+    void setDeviationReference(const std::string& referencePath, float tolerance, int bits);
+    
+    /**
+     * @brief 読み込み時の環境遮蔽の焼き込みを設定する
+     * 
+     * 有効にすると、読み込み時に各頂点の法線側の半球へ光線を飛ばして遮られなかった光の割合を求め、
+     * 8ビットの正規化整数の頂点属性として転送し、フラグメントシェーダーで環境光・拡散光に掛ける。
+     * 結果は溶接後のメッシュのハッシュをキーとしてディスクキャッシュに保存し、同じメッシュの
+     * 2回目以降の読み込みでは光線追跡を省略する。Oキーで陰影の有無を切り替えられる。
+     * 
+     * @param rayCount 頂点ごとの光線数（0の場合は焼き込まない）
+     * @pre 頂点溶接が有効であること（溶接無効時は焼き込まれない）
+     * @pre 読み込み中のタスクが無いこと（次回以降の読み込みに適用される）
+     */
+    void setAmbientOcclusion(int rayCount);
+    
+    /**
+     * @brief 読み込み時の特徴辺（稜線）の抽出を設定する
+     * 
+     * 有効にすると、読み込み時に辺テーブルから隣接面の二面角がしきい値を超える辺と境界辺を並列に抽出し、
+     * 座標軸と同じ線の描画経路でモデルに重ねて表示する。抽出結果は溶接後のメッシュのハッシュと
+     * しきい値をキーとしてディスクキャッシュに保存する。Eキーで表示を切り替えられる。
+     * 
+     * @param enabled trueの場合は抽出する
+     * @param angleDegrees 二面角のしきい値（度）
+     * @pre 頂点溶接が有効であること（溶接無効時は抽出されない）
+     * @pre 読み込み中のタスクが無いこと（次回以降の読み込みに適用される）
+     */
+    void setFeatureEdges(bool enabled, float angleDegrees);
+    
+    /**
+     * @brief 点群・頂点の点描画を設定する
+     * 
+     * 点プリミティブ（PLY・XYZ等の点群）は常に点スプライト（画面上で一定の大きさの円、
+     * 球として陰影付け）で描画する。三角形数が triangleBudget を超えるメッシュは、
+     * 溶接後の頂点（溶接無効時は三角形の重心）を点として描画する表示を既定とし、
+     * Pキーで三角形の描画と切り替えられる。点は空間的に均等な間引きとなる順に並べて転送し、
+     * 毎フレーム画面上のモデルの大きさから隙間なく見える点数だけを先頭から描画する。
+     * 
+     * @param size 点スプライトの大きさ（ピクセル）
+     * @param triangleBudget 頂点を点として描画する三角形数の上限
+     * @pre 読み込み中のタスクが無いこと（次回以降の読み込みに適用される）
+     */
+    void setPointRendering(float size, std::size_t triangleBudget);
+    
+    /**
+     * @brief 読み込み時の肉厚解析を設定する
+     * 
+     * 有効にすると、読み込み時にBVHを構築して各三角形から法線の逆方向へ光線を飛ばし、
+     * 反対側の面までの距離を肉厚として求める。頂点ごとの肉厚（接する三角形の最小値）は
+     * Hキーでヒートマップ表示（薄い部分が赤、厚い部分が青）に切り替えられる。
+     * 
+     * @param enabled 解析を行う場合はtrue
+     * @pre 頂点溶接が有効であること（溶接無効時は解析されない）
+     * @pre 読み込み中のタスクが無いこと（次回以降の読み込みに適用される）
+     */
+    void setWallThickness(bool enabled);
+    
+    /**
+     * @brief ウィンドウを表示せずに描画するヘッドレス実行を設定する
+     * 
+     * 非表示のウィンドウに描画する。表示先（X11/Wayland）が無い環境では、GLFW 3.4 以降であれば
+     * null プラットフォームと OSMesa のコンテキスト（Mesa のソフトウェアラスタライザー）を使う。
+     * 
+     * @param enabled ヘッドレス実行する場合はtrue
+     * @pre init() より前に呼び出すこと
+     */
+    void setHeadless(bool enabled);
+    
+    /**
+     * @brief 直近に完了した読み込みの段階ごとの所要時間を取得する
+     */
+    const LoadTimings& getLoadTimings() const noexcept { return loadTimings; }
+    
+    /**
+     * @brief 表示中のメッシュの三角形数を取得する
+     */
+    std::size_t getTriangleCount() const noexcept { return mesh.triangles.size(); }
+    
+    /**
+     * @brief 描画に使われているOpenGLの実装名（GL_RENDERER）を取得する
+     * 
+     * @pre init() が正常に完了している
+     */
+    std::string getRendererName() const;
+    
+    /**
+     * @brief カメラをモデルの周りに1周させながら指定数のフレームを描画し、各フレームの所要時間を返す
+     * 
+     * 通常の描画と同じ render() を使い、垂直同期を無効にしてフレームごとに描画の完了（glFinish）を待つ。
+     * カメラは初期位置と同じ距離・高さでY軸周りに回し、終了後は初期位置に戻す。
+     * 
+     * @param frameCount 描画するフレーム数
+     * @return フレームごとの所要時間（秒、ウィンドウが閉じられた場合は途中まで）
+     * @pre init()とloadSTL()が正常に完了している
+     */
+    std::vector<double> renderBenchmarkFrames(int frameCount);
+    
     /**
      * @brief メインループを開始する
      * 
@@ -145,6 +564,21 @@ public:
      */
     friend void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
 
+    /**
+     * @brief キーボードコールバック関数をフレンドとして宣言
+     * 
+     * GLFWのキーコールバックからシェルの表示設定にアクセスするため。
+     */
+    friend void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods);
+
+    /**
+     * @brief マウスコールバック関数をフレンドとして宣言
+     * 
+     * GLFWのマウスコールバックからクリップ平面の操作にアクセスするため。
+     */
+    friend void mouse_button_callback(GLFWwindow* window, int button, int action, int mods);
+    friend void cursor_pos_callback(GLFWwindow* window, double xpos, double ypos);
+
 private:
     /**
      * @brief OpenGLバッファのペア（VAO + VBO）
@@ -162,7 +596,17 @@ private:
      * @param vertices 頂点データ
      * @return 作成されたVAOとVBOのペア
      */
-    BufferPair createOpenGLBuffers(const std::vector<float>& vertices);
+    BufferPair createOpenGLBuffers(std::span<const float> vertices);
+    
+    /**
+     * @brief 位置のみの点データからOpenGLバッファ（VAO + VBO）を作成する
+     * 
+     * 色・法線は定数属性で与える（点スプライトの法線はフラグメントシェーダーで算出）。
+     * 
+     * @param points 点の座標
+     * @return 作成されたVAOとVBOのペア
+     */
+    BufferPair createPointBuffers(std::span<const glm::vec3> points);
     
     /**
      * @brief エラーメッセージをログに出力する
@@ -171,4 +615,81 @@ private:
      * @param functionName エラーが発生した関数名
      */
     void logError(const std::string& message, const std::string& functionName = "") const;
+    
+    /**
+     * @brief 読み込み時のメッシュ修復結果を出力する（修復が無い場合は何も出力しない）
+     * 
+     * @param stats 修復処理の結果統計
+     */
+    void logRepairStats(const RepairStats& stats) const;
+    
+    /**
+     * @brief 溶接無効（--no-weld）のために省略した解析を標準エラー出力へ出力する
+     * 
+     * 有効化されている解析のうち、溶接済みメッシュを必要とするものを1行に列挙する（無ければ何も出力しない）。
+     */
+    void logSkippedAnalyses() const;
+    
+    /**
+     * @brief 水密性・多様体性の解析結果を出力する
+     * 
+     * @param report 解析結果
+     */
+    void logTopologyReport(const TopologyReport& report) const;
+    
+    /**
+     * @brief シェル分解の結果を出力する
+     * 
+     * @param decomposition シェル分解の結果
+     */
+    void logShells(const ShellDecomposition& decomposition) const;
+    
+    /**
+     * @brief 面の向き修正の結果と背面カリングの可否を出力する
+     * 
+     * @param report 向き修正の結果統計
+     */
+    void logOrientationReport(const OrientationReport& report) const;
+    
+    /**
+     * @brief 肉厚解析の結果（最小・中央値・最大と、反対側の面が無い三角形数）を出力する
+     * 
+     * @param thickness 肉厚解析の結果
+     */
+    void logWallThickness(const WallThickness& thickness) const;
+    
+    /**
+     * @brief 干渉チェックの結果（干渉している部品の組と交差する三角形数）を出力する
+     * 
+     * @param report 干渉チェックの結果
+     */
+    void logInterferenceReport(const InterferenceReport& report) const;
+    
+    /**
+     * @brief 偏差解析の結果（最小・最大・平均・二乗平均平方根と許容差以内の頂点の割合）を出力する
+     * 
+     * @param deviation 偏差解析の結果
+     */
+    void logDeviation(const MeshDeviation& deviation) const;
+    
+    /**
+     * @brief 環境遮蔽の焼き込み結果（光線数・遮蔽距離・平均の明るさとキャッシュの利用有無）を出力する
+     * 
+     * @param occlusion 焼き込み結果
+     */
+    void logAmbientOcclusion(const AmbientOcclusion& occlusion) const;
+    
+    /**
+     * @brief 特徴辺の抽出結果（稜線・境界辺の数としきい値、キャッシュの利用有無）を出力する
+     * 
+     * @param features 抽出結果
+     */
+    void logFeatureEdges(const FeatureEdges& features) const;
+    
+    /**
+     * @brief 点描画の設定（点群の点数、頂点の点描画の有無と点数）を出力する
+     * 
+     * @param triangleCount メッシュの三角形数
+     */
+    void logPointRendering(std::size_t triangleCount) const;
 };
\ No newline at end of file
@@ -0,0 +1,207 @@
+/**
+ * @file executor_test.cpp
+ * @brief エグゼキューターとタスクの所有者の破棄（executor.h / task.h）のテスト
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <latch>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "executor.h"
+#include "task.h"
+
+namespace {
+
+/**
+ * @brief STLViewer と同じ宣言順でタスク・エグゼキューター・タスクが参照する状態を持つ所有者
+ *
+ * state はエグゼキューターより後に宣言するため先に破棄される。
+ * デストラクタの最初でワーカーを合流させ、中断したままのフレームを破棄する。
+ */
+struct LoadOwner {
+    TaskScope tasks;
+    RenderThreadExecutor render;
+    ThreadPoolExecutor io{1, "io"};
+    ThreadPoolExecutor cpu{1, "cpu"};
+    std::vector<int> state = std::vector<int>(1024, 0);
+
+    ~LoadOwner()
+    {
+        io.shutdown();
+        cpu.shutdown();
+        tasks.destroyPending();
+    }
+};
+
+/**
+ * @brief 生存中のフレーム数を数える（フレームの破棄でデストラクタが呼ばれる）
+ */
+struct FrameCounter {
+    std::atomic<int>& count;
+
+    explicit FrameCounter(std::atomic<int>& count) : count{count} { ++count; }
+    ~FrameCounter() { --count; }
+};
+
+/**
+ * @brief I/O → CPU → 描画スレッドの順に移動する読み込みタスク
+ */
+Task<void> load(LoadOwner& owner, std::latch& started, std::atomic<int>& frames)
+{
+    auto counter = FrameCounter{frames};
+    co_await scheduleOn(owner.io);
+    co_await scheduleOn(owner.cpu);
+    started.count_down();
+
+    // 所有者の破棄が始まった後も CPU ワーカー上で所有者の状態を使い続ける
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    owner.state.assign(1024, 1);
+
+    // 描画ループはもう動かないため、ここで中断したまま破棄される
+    co_await scheduleOn(owner.render);
+    owner.state.clear();
+}
+
+TEST(Executor, DestroyingOwnerDuringLoadJoinsWorkersAndDropsFrames)
+{
+    auto frames = std::atomic<int>{0};
+    auto completed = false;
+    auto failed = false;
+    auto started = std::latch{1};
+
+    auto owner = std::make_unique<LoadOwner>();
+    owner->tasks.spawn(
+        load(*owner, started, frames), [&]() { completed = true; }, [&](std::exception_ptr) { failed = true; });
+    started.wait();
+    owner.reset();
+
+    EXPECT_EQ(frames.load(), 0);
+    EXPECT_FALSE(completed);
+    EXPECT_FALSE(failed);
+}
+
+TEST(Executor, ShutdownRunsQueuedJobsAndIgnoresLaterOnes)
+{
+    auto executed = std::atomic<int>{0};
+    auto pool = ThreadPoolExecutor{2, "cpu"};
+    for (auto i = 0; i < 100; ++i)
+    {
+        pool.post([&]() { ++executed; });
+    }
+    pool.shutdown();
+    EXPECT_EQ(executed.load(), 100);
+
+    pool.post([&]() { ++executed; });
+    pool.shutdown();
+    EXPECT_EQ(executed.load(), 100);
+}
+
+/**
+ * @brief CPU ワーカーへ移動してから処理を行う子タスク
+ */
+Task<void> work(ThreadPoolExecutor& cpu, std::latch& together, std::vector<int>& results, int index)
+{
+    co_await scheduleOn(cpu);
+
+    // 全ての子タスクが同時に実行中でなければ合流できない
+    together.arrive_and_wait();
+    results[index] = index + 1;
+}
+
+/**
+ * @brief whenAll() の完了を待つタスク（完了後に done を立てる）
+ */
+Task<void> runAll(std::vector<Task<void>> tasks, std::latch& done)
+{
+    co_await whenAll(std::move(tasks));
+    done.count_down();
+}
+
+TEST(Executor, WhenAllRunsTasksConcurrently)
+{
+    auto cpu = ThreadPoolExecutor{3, "cpu"};
+    auto together = std::latch{3};
+    auto results = std::vector<int>(3, 0);
+    auto tasks = std::vector<Task<void>>{};
+    for (auto i = 0; i < 3; ++i)
+    {
+        tasks.push_back(work(cpu, together, results, i));
+    }
+
+    auto done = std::latch{1};
+    auto scope = TaskScope{};
+    auto failed = false;
+    scope.spawn(runAll(std::move(tasks), done), []() {}, [&](std::exception_ptr) { failed = true; });
+    done.wait();
+    cpu.shutdown();
+
+    EXPECT_FALSE(failed);
+    EXPECT_EQ(results, (std::vector<int>{1, 2, 3}));
+}
+
+/**
+ * @brief CPU ワーカーへ移動し、delayMs だけ待って完了を数え、throws なら例外を送出する子タスク
+ */
+Task<void> finishOrThrow(ThreadPoolExecutor& cpu, std::atomic<int>& finished, int delayMs, bool throws)
+{
+    co_await scheduleOn(cpu);
+    std::this_thread::sleep_for(std::chrono::milliseconds{delayMs});
+    ++finished;
+    if (throws)
+    {
+        throw std::runtime_error{"task " + std::to_string(delayMs)};
+    }
+}
+
+TEST(Executor, WhenAllRethrowsFirstErrorAfterAllTasksFinish)
+{
+    auto cpu = ThreadPoolExecutor{3, "cpu"};
+    auto finished = std::atomic<int>{0};
+    auto tasks = std::vector<Task<void>>{};
+    tasks.push_back(finishOrThrow(cpu, finished, 50, false));
+    tasks.push_back(finishOrThrow(cpu, finished, 30, true));
+    tasks.push_back(finishOrThrow(cpu, finished, 1, true));
+
+    auto error = std::string{};
+    auto finishedAtError = 0;
+    auto done = std::latch{1};
+    auto scope = TaskScope{};
+    scope.spawn(
+        whenAll(std::move(tasks)), [&]() { done.count_down(); },
+        [&](std::exception_ptr exception) {
+            finishedAtError = finished.load();
+            try
+            {
+                std::rethrow_exception(exception);
+            }
+            catch (const std::runtime_error& e)
+            {
+                error = e.what();
+            }
+            done.count_down();
+        });
+    done.wait();
+    cpu.shutdown();
+
+    EXPECT_EQ(finishedAtError, 3);
+    EXPECT_EQ(error, "task 30");
+}
+
+TEST(Executor, WhenAllOfNoTasksCompletesImmediately)
+{
+    auto completed = false;
+    auto scope = TaskScope{};
+    scope.spawn(whenAll({}), [&]() { completed = true; }, [](std::exception_ptr) {});
+    EXPECT_TRUE(completed);
+}
+
+} // namespace
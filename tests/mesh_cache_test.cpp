@@ -0,0 +1,90 @@
+/**
+ * @file mesh_cache_test.cpp
+ * @brief コンテンツハッシュをキーとするディスクキャッシュ（mesh_cache.h）のテスト
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "mesh_cache.h"
+
+namespace {
+
+constexpr std::uint64_t HASH{0x0123456789abcdefULL};  // テスト用のコンテンツハッシュ
+
+/**
+ * @brief テストごとに空のキャッシュディレクトリを用意し、終了時に削除する
+ */
+class MeshCacheTest : public ::testing::Test {
+protected:
+    std::filesystem::path directory;
+
+    void SetUp() override
+    {
+        directory = std::filesystem::temp_directory_path() /
+                    ("stl_viewer_cache_test_" + std::string{::testing::UnitTest::GetInstance()->current_test_info()->name()});
+        std::filesystem::remove_all(directory);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(directory); }
+
+    /**
+     * @brief エントリのヘッダーのペイロード長を書き換える
+     */
+    void overwritePayloadSize(const MeshCache &cache, std::uint64_t payloadSize)
+    {
+        auto file = std::fstream{cache.entryPath(HASH, "test"), std::ios::binary | std::ios::in | std::ios::out};
+        file.seekp(2 * sizeof(std::uint32_t));
+        file.write(reinterpret_cast<const char *>(&payloadSize), sizeof(payloadSize));
+    }
+};
+
+TEST_F(MeshCacheTest, RoundTripsPayload)
+{
+    auto cache = MeshCache{directory};
+    auto payload = std::vector<char>{'m', 'e', 's', 'h'};
+    ASSERT_TRUE(cache.store(HASH, "test", payload));
+
+    auto loaded = std::vector<char>{};
+    EXPECT_TRUE(cache.load(HASH, "test", loaded));
+    EXPECT_EQ(loaded, payload);
+    EXPECT_TRUE(cache.getErrorMessage().empty());
+}
+
+TEST_F(MeshCacheTest, RejectsPayloadSizeBeyondFileWithoutAllocating)
+{
+    auto cache = MeshCache{directory};
+    ASSERT_TRUE(cache.store(HASH, "test", std::vector<char>(16, 'x')));
+
+    // 壊れたヘッダーの長さ（約1EB）をそのまま確保すると std::bad_alloc になる
+    overwritePayloadSize(cache, std::uint64_t{1} << 60);
+    auto loaded = std::vector<char>{};
+    EXPECT_FALSE(cache.load(HASH, "test", loaded));
+    EXPECT_TRUE(loaded.empty());
+    EXPECT_FALSE(cache.getErrorMessage().empty());
+
+    overwritePayloadSize(cache, 17);
+    EXPECT_FALSE(cache.load(HASH, "test", loaded));
+    EXPECT_FALSE(cache.getErrorMessage().empty());
+}
+
+TEST_F(MeshCacheTest, MissingEntryClearsPreviousError)
+{
+    auto cache = MeshCache{directory};
+    ASSERT_TRUE(cache.store(HASH, "test", std::vector<char>(16, 'x')));
+    overwritePayloadSize(cache, 17);
+    auto loaded = std::vector<char>{};
+    ASSERT_FALSE(cache.load(HASH, "test", loaded));
+    ASSERT_FALSE(cache.getErrorMessage().empty());
+
+    EXPECT_FALSE(cache.load(HASH + 1, "test", loaded));
+    EXPECT_TRUE(cache.getErrorMessage().empty());
+}
+
+} // namespace
@@ -0,0 +1,96 @@
+/**
+ * @file mesh_deviation_test.cpp
+ * @brief 偏差解析（mesh_deviation.h）のテスト
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+
+#include "mesh_deviation.h"
+#include "mesh_fixtures.h"
+
+namespace {
+
+constexpr float DISTANCE_TOLERANCE{1e-5f};  // 箱（平面）に対する距離の許容誤差
+
+/**
+ * @brief 頂点だけを持つ評価用メッシュを作る（偏差は頂点ごとに求めるため三角形は不要）
+ */
+IndexedMesh pointMesh(std::vector<glm::vec3> points)
+{
+    auto mesh = IndexedMesh{};
+    mesh.positions = std::move(points);
+    return mesh;
+}
+
+TEST(MeshDeviation, BoxFaceEdgeAndCornerSigns)
+{
+    auto reference = fixtures::weld(fixtures::makeBox({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f})).indexed;
+    // 面・辺・頂点それぞれの外側と内側（最近点が辺や頂点にある点は面の法線だけでは符号を誤りやすい）
+    auto mesh = pointMesh({
+        {0.5f, 0.5f, 1.1f},   // 面の外側
+        {0.5f, 0.5f, 0.9f},   // 面の内側
+        {1.1f, 1.1f, 0.5f},   // 辺の外側
+        {0.9f, 0.9f, 0.5f},   // 辺の内側
+        {1.1f, 1.1f, 1.1f},   // 頂点の外側
+        {0.9f, 0.9f, 0.9f},   // 頂点の内側
+        {1.1f, 0.5f, 1.05f},  // 辺の外側（2面から等距離でない）
+    });
+    auto deviation = computeDeviation(mesh, reference, 0.05f);
+    const auto &values = deviation.vertexDeviation;
+    ASSERT_EQ(values.size(), mesh.positions.size());
+
+    EXPECT_NEAR(values[0], 0.1f, DISTANCE_TOLERANCE);
+    EXPECT_NEAR(values[1], -0.1f, DISTANCE_TOLERANCE);
+    EXPECT_NEAR(values[2], std::sqrt(2.0f) * 0.1f, DISTANCE_TOLERANCE);
+    EXPECT_NEAR(values[3], -0.1f, DISTANCE_TOLERANCE);
+    EXPECT_NEAR(values[4], std::sqrt(3.0f) * 0.1f, DISTANCE_TOLERANCE);
+    EXPECT_NEAR(values[5], -0.1f, DISTANCE_TOLERANCE);
+    EXPECT_NEAR(values[6], std::sqrt(0.1f * 0.1f + 0.05f * 0.05f), DISTANCE_TOLERANCE);
+
+    EXPECT_NEAR(deviation.minimum, -0.1f, DISTANCE_TOLERANCE);
+    EXPECT_NEAR(deviation.maximum, std::sqrt(3.0f) * 0.1f, DISTANCE_TOLERANCE);
+    EXPECT_EQ(deviation.withinTolerance, 0u);
+}
+
+TEST(MeshDeviation, ScaledBoxCornersHaveOffsetSign)
+{
+    auto reference = fixtures::weld(fixtures::makeBox({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f})).indexed;
+    auto grown = fixtures::weld(fixtures::makeBox({-0.1f, -0.1f, -0.1f}, {1.1f, 1.1f, 1.1f})).indexed;
+    auto shrunk = fixtures::weld(fixtures::makeBox({0.1f, 0.1f, 0.1f}, {0.9f, 0.9f, 0.9f})).indexed;
+
+    for (auto value : computeDeviation(grown, reference, 0.01f).vertexDeviation)
+    {
+        EXPECT_NEAR(value, std::sqrt(3.0f) * 0.1f, DISTANCE_TOLERANCE);
+    }
+    for (auto value : computeDeviation(shrunk, reference, 0.01f).vertexDeviation)
+    {
+        EXPECT_NEAR(value, -0.1f, DISTANCE_TOLERANCE);
+    }
+}
+
+TEST(MeshDeviation, SpheresOffsetByRadius)
+{
+    constexpr auto STACKS = 24;
+    constexpr auto SLICES = 48;
+    constexpr auto OFFSET = 0.05f;
+    auto reference = fixtures::weld(fixtures::makeSphere(1.0f, STACKS, SLICES)).indexed;
+    auto larger = fixtures::weld(fixtures::makeSphere(1.0f + OFFSET, STACKS, SLICES)).indexed;
+    auto smaller = fixtures::weld(fixtures::makeSphere(1.0f - OFFSET, STACKS, SLICES)).indexed;
+
+    // 同じ分割の球の頂点は参照の頂点の真上（真下）にあるため、距離は OFFSET 以下で面の食い込み分だけ小さい
+    auto outside = computeDeviation(larger, reference, OFFSET);
+    EXPECT_GT(outside.minimum, 0.0f);
+    EXPECT_LE(outside.maximum, OFFSET + DISTANCE_TOLERANCE);
+    EXPECT_NEAR(outside.mean, OFFSET, 0.1f * OFFSET);
+    EXPECT_EQ(outside.withinTolerance, larger.positions.size());
+
+    auto inside = computeDeviation(smaller, reference, OFFSET);
+    EXPECT_LT(inside.maximum, 0.0f);
+    EXPECT_GE(inside.minimum, -OFFSET - DISTANCE_TOLERANCE);
+    EXPECT_NEAR(inside.mean, -OFFSET, 0.1f * OFFSET);
+}
+
+} // namespace
@@ -0,0 +1,86 @@
+/**
+ * @file mesh_distance_test.cpp
+ * @brief 最近点・面間の最小距離（mesh_distance.h）のテスト
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+
+#include "mesh_bvh.h"
+#include "mesh_distance.h"
+#include "mesh_fixtures.h"
+#include "mesh_interference.h"
+
+namespace {
+
+constexpr float DISTANCE_TOLERANCE{1e-5f};  // 距離・座標の許容誤差
+
+MeshBvh boxBvh(const glm::vec3& lo, const glm::vec3& hi, IndexedMesh& indexed)
+{
+    indexed = fixtures::weld(fixtures::makeBox(lo, hi)).indexed;
+    return buildMeshBvh(indexed);
+}
+
+TEST(MeshDistance, ClosestPointOnBoxFaceEdgeAndCorner)
+{
+    auto indexed = IndexedMesh{};
+    auto bvh = boxBvh({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}, indexed);
+
+    auto face = findClosestPoint(bvh, {0.5f, 0.5f, 1.5f});
+    ASSERT_TRUE(face.found());
+    EXPECT_NEAR(face.distance, 0.5f, DISTANCE_TOLERANCE);
+    EXPECT_NEAR(face.point.z, 1.0f, DISTANCE_TOLERANCE);
+
+    auto edge = findClosestPoint(bvh, {2.0f, 2.0f, 0.5f});
+    ASSERT_TRUE(edge.found());
+    EXPECT_NEAR(edge.distance, std::sqrt(2.0f), DISTANCE_TOLERANCE);
+    EXPECT_NEAR(edge.point.z, 0.5f, DISTANCE_TOLERANCE);
+
+    auto corner = findClosestPoint(bvh, {-1.0f, -1.0f, -1.0f});
+    ASSERT_TRUE(corner.found());
+    EXPECT_NEAR(corner.distance, std::sqrt(3.0f), DISTANCE_TOLERANCE);
+
+    EXPECT_FALSE(findClosestPoint(bvh, {0.5f, 0.5f, 3.0f}, 1.0f).found());
+}
+
+TEST(MeshDistance, SeparatedBoxesAreGapApart)
+{
+    auto firstMesh = IndexedMesh{};
+    auto secondMesh = IndexedMesh{};
+    auto first = boxBvh({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}, firstMesh);
+    auto second = boxBvh({1.5f, 0.0f, 0.0f}, {2.5f, 1.0f, 1.0f}, secondMesh);
+
+    EXPECT_FALSE(findFirstTriangleContact(first, second).has_value());
+
+    auto distance = findMinimumDistance(first, second);
+    ASSERT_TRUE(distance.found());
+    EXPECT_NEAR(distance.distance, 0.5f, DISTANCE_TOLERANCE);
+    EXPECT_NEAR(distance.firstPoint.x, 1.0f, DISTANCE_TOLERANCE);
+    EXPECT_NEAR(distance.secondPoint.x, 1.5f, DISTANCE_TOLERANCE);
+}
+
+TEST(MeshDistance, OverlappingBoxesAreZeroApart)
+{
+    auto firstMesh = IndexedMesh{};
+    auto secondMesh = IndexedMesh{};
+    auto first = boxBvh({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}, firstMesh);
+    auto second = boxBvh({0.5f, 0.25f, 0.25f}, {1.5f, 0.75f, 0.75f}, secondMesh);
+
+    // 最初の交差は全ての交差の1つで、距離は0
+    auto contacts = findTriangleContacts(first, second);
+    auto firstContact = findFirstTriangleContact(first, second);
+    ASSERT_TRUE(firstContact.has_value());
+    EXPECT_TRUE(std::any_of(contacts.begin(), contacts.end(), [&](const TriangleContact& contact) {
+        return contact.firstTriangle == firstContact->firstTriangle &&
+               contact.secondTriangle == firstContact->secondTriangle;
+    }));
+
+    auto distance = findMinimumDistance(first, second);
+    ASSERT_TRUE(distance.found());
+    EXPECT_EQ(distance.distance, 0.0f);
+}
+
+} // namespace
@@ -0,0 +1,153 @@
+/**
+ * @file mesh_fixtures.h
+ * @brief テスト用の解析的な形状（箱・球）の生成
+ * @author STL Viewer Team
+ * @version 1.0
+ *
+ * 距離や符号の期待値を式で求められる形状を、読み込み直後と同じ三角形の配列として生成する。
+ * 三角形は外側から見て反時計回りで、溶接前の状態（三角形ごとに頂点を持つ）となる。
+ */
+
+#pragma once
+
+#include <cmath>
+#include <numbers>
+#include <utility>
+#include <glm/glm.hpp>
+
+#include "mesh_orientation.h"
+#include "mesh_shells.h"
+#include "mesh_topology.h"
+#include "model_loader.h"
+
+namespace fixtures {
+
+/**
+ * @brief 三角形を追加する（法線は巻き順から求める）
+ */
+inline void addTriangle(ModelMesh& mesh, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+{
+    auto triangle = ModelTriangle{};
+    triangle.normal = glm::normalize(glm::cross(b - a, c - a));
+    triangle.vertices[0] = a;
+    triangle.vertices[1] = b;
+    triangle.vertices[2] = c;
+    mesh.triangles.push_back(triangle);
+}
+
+/**
+ * @brief 四角形を2つの三角形として追加する（a → b → c → d が外側から見て反時計回り）
+ */
+inline void addQuad(ModelMesh& mesh, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec3& d)
+{
+    addTriangle(mesh, a, b, c);
+    addTriangle(mesh, a, c, d);
+}
+
+/**
+ * @brief バウンディングボックス・中心・スケールを読み込み時と同じ方法で設定する
+ */
+inline void finishMesh(ModelMesh& mesh)
+{
+    auto loader = ModelLoader{};
+    loader.calculateBounds(mesh);
+    loader.calculateCenterAndScale(mesh);
+}
+
+/**
+ * @brief 軸に平行な箱の三角形を追加する（12三角形）
+ */
+inline void addBox(ModelMesh& mesh, const glm::vec3& lo, const glm::vec3& hi)
+{
+    addQuad(mesh, {lo.x, lo.y, lo.z}, {lo.x, lo.y, hi.z}, {lo.x, hi.y, hi.z}, {lo.x, hi.y, lo.z});  // -X
+    addQuad(mesh, {hi.x, lo.y, lo.z}, {hi.x, hi.y, lo.z}, {hi.x, hi.y, hi.z}, {hi.x, lo.y, hi.z});  // +X
+    addQuad(mesh, {lo.x, lo.y, lo.z}, {hi.x, lo.y, lo.z}, {hi.x, lo.y, hi.z}, {lo.x, lo.y, hi.z});  // -Y
+    addQuad(mesh, {lo.x, hi.y, lo.z}, {lo.x, hi.y, hi.z}, {hi.x, hi.y, hi.z}, {hi.x, hi.y, lo.z});  // +Y
+    addQuad(mesh, {lo.x, lo.y, lo.z}, {lo.x, hi.y, lo.z}, {hi.x, hi.y, lo.z}, {hi.x, lo.y, lo.z});  // -Z
+    addQuad(mesh, {lo.x, lo.y, hi.z}, {hi.x, lo.y, hi.z}, {hi.x, hi.y, hi.z}, {lo.x, hi.y, hi.z});  // +Z
+}
+
+/**
+ * @brief 軸に平行な箱を生成する（12三角形、溶接後は8頂点）
+ */
+inline ModelMesh makeBox(const glm::vec3& lo, const glm::vec3& hi)
+{
+    auto mesh = ModelMesh{};
+    addBox(mesh, lo, hi);
+    finishMesh(mesh);
+    return mesh;
+}
+
+/**
+ * @brief 原点を中心とする UV 球の頂点座標を求める（極は厳密に軸上に置く）
+ */
+inline glm::vec3 spherePoint(float radius, int stack, int slice, int stacks, int slices)
+{
+    if (stack == 0 || stack == stacks)
+    {
+        return {0.0f, stack == 0 ? radius : -radius, 0.0f};
+    }
+    auto theta = std::numbers::pi * stack / stacks;
+    auto phi = 2.0 * std::numbers::pi * (slice % slices) / slices;
+    return glm::vec3{std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)} * radius;
+}
+
+/**
+ * @brief 原点を中心とする UV 球を生成する
+ *
+ * 溶接後の頂点数は (stacks - 1) × slices + 2、三角形数は 2 × slices × (stacks - 1) となる。
+ * 頂点は全て球面上にあるため、面は球の内側に入る（最大で半径 × (1 - cos(π / stacks) cos(π / slices)) 程度）。
+ */
+inline ModelMesh makeSphere(float radius, int stacks, int slices)
+{
+    auto mesh = ModelMesh{};
+    auto addOutward = [&](glm::vec3 a, glm::vec3 b, glm::vec3 c) {
+        if (glm::dot(glm::cross(b - a, c - a), a + b + c) < 0.0f)
+        {
+            std::swap(b, c);
+        }
+        addTriangle(mesh, a, b, c);
+    };
+    for (auto stack = 0; stack < stacks; ++stack)
+    {
+        for (auto slice = 0; slice < slices; ++slice)
+        {
+            auto a = spherePoint(radius, stack, slice, stacks, slices);
+            auto b = spherePoint(radius, stack + 1, slice, stacks, slices);
+            auto c = spherePoint(radius, stack + 1, slice + 1, stacks, slices);
+            auto d = spherePoint(radius, stack, slice + 1, stacks, slices);
+            if (stack != 0)
+            {
+                addOutward(a, b, d);
+            }
+            if (stack != stacks - 1)
+            {
+                addOutward(b, c, d);
+            }
+        }
+    }
+    finishMesh(mesh);
+    return mesh;
+}
+
+/**
+ * @brief 溶接・シェル分解・向き修正の結果
+ */
+struct WeldedMesh {
+    IndexedMesh indexed;
+    ShellDecomposition shells;
+    EdgeTable edges;
+    OrientationReport orientation;
+};
+
+/**
+ * @brief 読み込み後と同じ前処理（weldAndOrientMesh()、許容誤差は自動設定）を行う
+ */
+inline WeldedMesh weld(const ModelMesh& mesh)
+{
+    auto result = WeldedMesh{};
+    result.orientation = weldAndOrientMesh(mesh, -1.0f, result.indexed, result.shells, result.edges);
+    return result;
+}
+
+} // namespace fixtures
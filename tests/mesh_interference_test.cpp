@@ -0,0 +1,86 @@
+/**
+ * @file mesh_interference_test.cpp
+ * @brief 干渉チェック（mesh_interference.h）のテスト
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "mesh_bvh.h"
+#include "mesh_fixtures.h"
+#include "mesh_interference.h"
+
+namespace {
+
+constexpr float CONTACT_TOLERANCE{1e-5f};  // 交線の座標の許容誤差
+
+MeshBvh boxBvh(const glm::vec3& lo, const glm::vec3& hi, IndexedMesh& indexed)
+{
+    indexed = fixtures::weld(fixtures::makeBox(lo, hi)).indexed;
+    return buildMeshBvh(indexed);
+}
+
+TEST(MeshInterference, OverlappingBoxesIntersectInsideOverlap)
+{
+    auto firstMesh = IndexedMesh{};
+    auto secondMesh = IndexedMesh{};
+    auto first = boxBvh({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}, firstMesh);
+    auto second = boxBvh({0.5f, 0.25f, 0.25f}, {1.5f, 0.75f, 0.75f}, secondMesh);
+    auto contacts = findTriangleContacts(first, second);
+
+    ASSERT_FALSE(contacts.empty());
+    for (const auto &contact : contacts)
+    {
+        for (const auto &point : {contact.segmentStart, contact.segmentEnd})
+        {
+            // 交線は1つ目の箱の +X 面（x = 1）上で、2つ目の箱の断面の縁にある
+            EXPECT_NEAR(point.x, 1.0f, CONTACT_TOLERANCE);
+            EXPECT_GE(point.y, 0.25f - CONTACT_TOLERANCE);
+            EXPECT_LE(point.y, 0.75f + CONTACT_TOLERANCE);
+            EXPECT_GE(point.z, 0.25f - CONTACT_TOLERANCE);
+            EXPECT_LE(point.z, 0.75f + CONTACT_TOLERANCE);
+        }
+    }
+}
+
+TEST(MeshInterference, SeparatedBoxesDoNotIntersect)
+{
+    auto firstMesh = IndexedMesh{};
+    auto secondMesh = IndexedMesh{};
+    auto first = boxBvh({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}, firstMesh);
+    auto second = boxBvh({1.5f, 0.0f, 0.0f}, {2.5f, 1.0f, 1.0f}, secondMesh);
+
+    EXPECT_TRUE(findTriangleContacts(first, second).empty());
+
+    auto parts = std::vector<MeshBvh>{};
+    parts.push_back(std::move(first));
+    parts.push_back(std::move(second));
+    auto report = checkInterference(parts);
+    EXPECT_EQ(report.partCount, 2u);
+    EXPECT_TRUE(report.contacts.empty());
+}
+
+TEST(MeshInterference, TouchingBoxesReportFaceContact)
+{
+    // 2つ目の箱は1つ目の +X 面に面で接する（同一平面上の三角形同士の接触）
+    auto mesh = fixtures::makeBox({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f});
+    fixtures::addBox(mesh, {1.0f, 0.25f, 0.25f}, {2.0f, 0.75f, 0.75f});
+    fixtures::finishMesh(mesh);
+    auto welded = fixtures::weld(mesh);
+    ASSERT_EQ(welded.shells.shells.size(), 2u);
+
+    auto report = checkShellInterference(welded.indexed, welded.shells);
+    EXPECT_EQ(report.partCount, 2u);
+    ASSERT_EQ(report.contacts.size(), 1u);
+    EXPECT_EQ(report.contacts[0].firstPart, 0u);
+    EXPECT_EQ(report.contacts[0].secondPart, 1u);
+    ASSERT_GT(report.triangleContactCount(), 0u);
+    for (const auto &contact : report.contacts[0].contacts)
+    {
+        EXPECT_NEAR(contact.segmentStart.x, 1.0f, CONTACT_TOLERANCE);
+        EXPECT_NEAR(contact.segmentEnd.x, 1.0f, CONTACT_TOLERANCE);
+    }
+}
+
+} // namespace
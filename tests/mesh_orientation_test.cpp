@@ -0,0 +1,131 @@
+/**
+ * @file mesh_orientation_test.cpp
+ * @brief 面の向きの統一（mesh_orientation.h）のテスト
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#include <gtest/gtest.h>
+#include <utility>
+
+#include "mesh_fixtures.h"
+#include "mesh_metrics.h"
+
+namespace {
+
+TEST(MeshOrientation, FlipsSingleReversedTriangle)
+{
+    auto mesh = fixtures::makeBox({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f});
+    std::swap(mesh.triangles[3].vertices[1], mesh.triangles[3].vertices[2]);
+    auto welded = fixtures::weld(mesh);
+
+    EXPECT_EQ(welded.orientation.flippedTriangles, 1u);
+    EXPECT_EQ(welded.orientation.invertedPatches, 0u);
+    EXPECT_EQ(analyzeTopology(welded.indexed, welded.edges).inconsistentEdges, 0u);
+}
+
+TEST(MeshOrientation, TurnsInsideOutBoxOutward)
+{
+    auto mesh = fixtures::makeBox({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f});
+    for (auto &triangle : mesh.triangles)
+    {
+        std::swap(triangle.vertices[1], triangle.vertices[2]);
+    }
+    auto welded = fixtures::weld(mesh);
+
+    EXPECT_EQ(welded.orientation.patches, 1u);
+    EXPECT_EQ(welded.orientation.invertedPatches, 1u);
+
+    // 向き修正後は全ての面の法線が箱の中心から外を向く
+    const auto &indexed = welded.indexed;
+    auto center = glm::vec3{0.5f, 0.5f, 0.5f};
+    for (auto triangle = std::size_t{0}; triangle < indexed.triangleCount(); ++triangle)
+    {
+        const auto &a = indexed.positions[indexed.indices[triangle * 3]];
+        const auto &b = indexed.positions[indexed.indices[triangle * 3 + 1]];
+        const auto &c = indexed.positions[indexed.indices[triangle * 3 + 2]];
+        EXPECT_GT(glm::dot(glm::cross(b - a, c - a), (a + b + c) / 3.0f - center), 0.0f);
+    }
+}
+
+/**
+ * @brief 全ての三角形の法線と、三角形の重心から基準点へ向かうベクトルの内積の符号を数える
+ *
+ * @return {基準点から離れる向きの三角形数, 基準点へ向かう三角形数}
+ */
+std::pair<std::size_t, std::size_t> countFacing(const IndexedMesh &mesh, std::size_t first, std::size_t count,
+                                                const glm::vec3 &center)
+{
+    auto away = std::size_t{0};
+    auto toward = std::size_t{0};
+    for (auto triangle = first; triangle < first + count; ++triangle)
+    {
+        const auto &a = mesh.positions[mesh.indices[triangle * 3]];
+        const auto &b = mesh.positions[mesh.indices[triangle * 3 + 1]];
+        const auto &c = mesh.positions[mesh.indices[triangle * 3 + 2]];
+        auto facing = glm::dot(glm::cross(b - a, c - a), (a + b + c) / 3.0f - center);
+        (facing > 0.0f ? away : toward) += 1;
+    }
+    return {away, toward};
+}
+
+TEST(MeshOrientation, TurnsCavityOfHollowBoxInward)
+{
+    // 外壁と空洞の壁をどちらも外向きに書き出した中空の箱（よくある書き出しの誤り）
+    auto mesh = ModelMesh{};
+    fixtures::addBox(mesh, {0.0f, 0.0f, 0.0f}, {3.0f, 3.0f, 3.0f});
+    fixtures::addBox(mesh, {1.0f, 1.0f, 1.0f}, {2.0f, 2.0f, 2.0f});
+    fixtures::finishMesh(mesh);
+    auto welded = fixtures::weld(mesh);
+
+    ASSERT_EQ(welded.shells.shells.size(), 2u);
+    EXPECT_EQ(welded.orientation.cavityShells, 1u);
+    EXPECT_EQ(welded.orientation.flippedTriangles, 12u);
+    EXPECT_TRUE(welded.orientation.canCullBackFaces());
+
+    // 外壁は外向き、空洞の壁は空洞の中心へ向く（どちらも実体から見て外向き）
+    auto center = glm::vec3{1.5f, 1.5f, 1.5f};
+    for (const auto &shell : welded.shells.shells)
+    {
+        auto cavity = shell.maxBounds.x < 2.5f;
+        auto [away, toward] = countFacing(welded.indexed, shell.firstTriangle, shell.triangleCount, center);
+        EXPECT_EQ(away, cavity ? 0u : 12u);
+        EXPECT_EQ(toward, cavity ? 12u : 0u);
+    }
+
+    EXPECT_NEAR(computeMeshMetrics(welded.indexed).volume, 26.0, 1e-9);
+}
+
+TEST(MeshOrientation, KeepsCorrectCavityAndAlternatesByNestingDepth)
+{
+    // 箱の空洞の中に浮かぶ箱: 深さ0と2は外向き、深さ1の空洞は内向き（最初から正しく内向きに書き出されている）
+    auto mesh = ModelMesh{};
+    fixtures::addBox(mesh, {0.0f, 0.0f, 0.0f}, {5.0f, 5.0f, 5.0f});
+    fixtures::addBox(mesh, {1.0f, 1.0f, 1.0f}, {4.0f, 4.0f, 4.0f});
+    for (auto triangle = mesh.triangles.size() - 12; triangle < mesh.triangles.size(); ++triangle)
+    {
+        std::swap(mesh.triangles[triangle].vertices[1], mesh.triangles[triangle].vertices[2]);
+    }
+    fixtures::addBox(mesh, {2.0f, 2.0f, 2.0f}, {3.0f, 3.0f, 3.0f});
+    fixtures::finishMesh(mesh);
+    auto welded = fixtures::weld(mesh);
+
+    ASSERT_EQ(welded.shells.shells.size(), 3u);
+    EXPECT_EQ(welded.orientation.cavityShells, 1u);
+    EXPECT_EQ(welded.orientation.flippedTriangles, 0u);
+    EXPECT_NEAR(computeMeshMetrics(welded.indexed).volume, 125.0 - 27.0 + 1.0, 1e-9);
+}
+
+TEST(MeshOrientation, LeavesSeparateBoxesOutward)
+{
+    auto mesh = ModelMesh{};
+    fixtures::addBox(mesh, {0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f});
+    fixtures::addBox(mesh, {2.0f, 0.0f, 0.0f}, {3.0f, 1.0f, 1.0f});
+    fixtures::finishMesh(mesh);
+    auto welded = fixtures::weld(mesh);
+
+    EXPECT_EQ(welded.orientation.cavityShells, 0u);
+    EXPECT_NEAR(computeMeshMetrics(welded.indexed).volume, 2.0, 1e-9);
+}
+
+} // namespace
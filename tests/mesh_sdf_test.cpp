@@ -0,0 +1,110 @@
+/**
+ * @file mesh_sdf_test.cpp
+ * @brief 符号付き距離場（mesh_sdf.h）のテスト
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+
+#include "mesh_fixtures.h"
+#include "mesh_sdf.h"
+
+namespace {
+
+/**
+ * @brief 軸に平行な箱の厳密な符号付き距離
+ */
+float boxDistance(const glm::vec3& point, const glm::vec3& lo, const glm::vec3& hi)
+{
+    auto center = (lo + hi) * 0.5f;
+    auto q = glm::abs(point - center) - (hi - lo) * 0.5f;
+    auto outside = glm::length(glm::max(q, 0.0f));
+    auto inside = std::min(std::max(q.x, std::max(q.y, q.z)), 0.0f);
+    return outside + inside;
+}
+
+TEST(MeshSdf, BoxSignAndNarrowBandDistance)
+{
+    auto lo = glm::vec3{0.0f, 0.0f, 0.0f};
+    auto hi = glm::vec3{1.0f, 1.0f, 1.0f};
+    auto settings = SignedDistanceSettings{};
+    settings.resolution = 32;
+    auto field = computeSignedDistanceField(fixtures::makeBox(lo, hi), settings);
+    const auto &layout = field.layout;
+    ASSERT_EQ(field.distances.size(),
+              static_cast<std::size_t>(layout.dimensions.x) * layout.dimensions.y * layout.dimensions.z);
+    EXPECT_GT(field.bandPoints, 0u);
+
+    auto band = settings.bandWidth * layout.voxelSize;
+    for (auto z = 0; z < layout.dimensions.z; ++z)
+    {
+        for (auto y = 0; y < layout.dimensions.y; ++y)
+        {
+            for (auto x = 0; x < layout.dimensions.x; ++x)
+            {
+                auto expected = boxDistance(layout.voxelCenter(x, y, z), lo, hi);
+                auto actual = field.at(x, y, z);
+                if (std::abs(expected) > 1e-4f)
+                {
+                    EXPECT_EQ(actual < 0.0f, expected < 0.0f) << "at " << x << ", " << y << ", " << z;
+                }
+                if (std::abs(expected) < band * 0.9f)
+                {
+                    EXPECT_NEAR(actual, expected, 1e-4f) << "at " << x << ", " << y << ", " << z;
+                }
+            }
+        }
+    }
+}
+
+TEST(MeshSdf, BoxCenterIsDeepestInside)
+{
+    auto settings = SignedDistanceSettings{};
+    settings.resolution = 32;
+    auto field = computeSignedDistanceField(fixtures::makeBox({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}), settings);
+
+    auto minimum = *std::min_element(field.distances.begin(), field.distances.end());
+    EXPECT_NEAR(minimum, -0.5f, field.layout.voxelSize);
+}
+
+TEST(MeshSdf, SphereSignAndDistance)
+{
+    constexpr auto RADIUS = 1.0f;
+    auto settings = SignedDistanceSettings{};
+    settings.resolution = 48;
+    auto field = computeSignedDistanceField(fixtures::makeSphere(RADIUS, 32, 64), settings);
+    const auto &layout = field.layout;
+
+    // 帯の内側は面までの厳密な距離で、面は球の内側に最大で半径の約0.6%入る。
+    // 帯の外側は1次精度の掃引で求めるため、距離の相対誤差で見る
+    auto band = settings.bandWidth * layout.voxelSize;
+    auto facetTolerance = 0.01f * RADIUS;
+    for (auto z = 0; z < layout.dimensions.z; ++z)
+    {
+        for (auto y = 0; y < layout.dimensions.y; ++y)
+        {
+            for (auto x = 0; x < layout.dimensions.x; ++x)
+            {
+                auto expected = glm::length(layout.voxelCenter(x, y, z)) - RADIUS;
+                auto actual = field.at(x, y, z);
+                if (std::abs(expected) > facetTolerance)
+                {
+                    EXPECT_EQ(actual < 0.0f, expected < 0.0f) << "at " << x << ", " << y << ", " << z;
+                }
+                if (std::abs(expected) < band * 0.9f)
+                {
+                    EXPECT_NEAR(actual, expected, facetTolerance) << "at " << x << ", " << y << ", " << z;
+                }
+                else
+                {
+                    EXPECT_NEAR(actual, expected, 0.1f * std::abs(expected)) << "at " << x << ", " << y << ", " << z;
+                }
+            }
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,29 @@
+/**
+ * @file mesh_shells_test.cpp
+ * @brief シェル分解（mesh_shells.h）のテスト
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "mesh_fixtures.h"
+
+namespace {
+
+TEST(MeshShells, SeparatesTouchingBoxes)
+{
+    // 2つ目の箱は1つ目の +X 面に接するが、頂点は共有しない
+    auto mesh = fixtures::makeBox({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f});
+    fixtures::addBox(mesh, {1.0f, 0.25f, 0.25f}, {2.0f, 0.75f, 0.75f});
+    fixtures::finishMesh(mesh);
+    auto welded = fixtures::weld(mesh);
+
+    ASSERT_EQ(welded.shells.shells.size(), 2u);
+    EXPECT_EQ(welded.shells.shells[0].triangleCount, 12u);
+    EXPECT_EQ(welded.shells.shells[1].triangleCount, 12u);
+    EXPECT_EQ(welded.shells.shells[0].maxBounds.x, 1.0f);
+    EXPECT_EQ(welded.shells.shells[1].minBounds.x, 1.0f);
+}
+
+} // namespace
@@ -0,0 +1,111 @@
+/**
+ * @file mesh_topology_test.cpp
+ * @brief 水密性・多様体性の解析（mesh_topology.h）のテスト
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+
+#include "mesh_fixtures.h"
+
+namespace {
+
+TEST(MeshTopology, ClosedBoxIsManifold)
+{
+    auto welded = fixtures::weld(fixtures::makeBox({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}));
+    auto report = analyzeTopology(welded.indexed, welded.edges);
+
+    EXPECT_EQ(report.edgeCount, 18u);
+    EXPECT_EQ(report.boundaryEdges, 0u);
+    EXPECT_EQ(report.nonManifoldEdges, 0u);
+    EXPECT_EQ(report.inconsistentEdges, 0u);
+    EXPECT_EQ(report.nonManifoldVertices, 0u);
+    EXPECT_TRUE(report.isManifold());
+
+    // オイラー標数 V - E + F = 2（球と同相な閉曲面）
+    auto euler = static_cast<long long>(welded.indexed.positions.size()) - static_cast<long long>(report.edgeCount) +
+                 static_cast<long long>(welded.indexed.triangleCount());
+    EXPECT_EQ(euler, 2);
+}
+
+TEST(MeshTopology, SphereIsClosed)
+{
+    auto welded = fixtures::weld(fixtures::makeSphere(1.0f, 12, 24));
+    auto report = analyzeTopology(welded.indexed, welded.edges);
+
+    EXPECT_EQ(report.boundaryEdges, 0u);
+    EXPECT_EQ(report.nonManifoldEdges, 0u);
+    EXPECT_EQ(report.inconsistentEdges, 0u);
+    EXPECT_EQ(report.nonManifoldVertices, 0u);  // 極の頂点は24個の三角形に囲まれる
+    EXPECT_EQ(welded.orientation.flippedTriangles, 0u);
+}
+
+TEST(MeshTopology, MissingTriangleLeavesBoundary)
+{
+    auto mesh = fixtures::makeBox({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f});
+    mesh.triangles.pop_back();
+    auto welded = fixtures::weld(mesh);
+    auto report = analyzeTopology(welded.indexed, welded.edges);
+
+    EXPECT_EQ(report.boundaryEdges, 3u);
+    EXPECT_EQ(report.boundaryEdgeVertices.size(), 6u);
+    EXPECT_EQ(report.nonManifoldEdges, 0u);
+    EXPECT_EQ(report.nonManifoldVertices, 0u);
+    EXPECT_TRUE(report.isManifold());
+}
+
+TEST(MeshTopology, BowTieVertexIsNonManifold)
+{
+    // 2つの三角形が1頂点のみを共有する（辺は全て境界辺）
+    auto mesh = ModelMesh{};
+    fixtures::addTriangle(mesh, {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f});
+    fixtures::addTriangle(mesh, {0.0f, 0.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}, {0.0f, -1.0f, 0.0f});
+    fixtures::finishMesh(mesh);
+    auto welded = fixtures::weld(mesh);
+    auto report = analyzeTopology(welded.indexed, welded.edges);
+
+    ASSERT_EQ(welded.indexed.positions.size(), 5u);
+    EXPECT_EQ(report.boundaryEdges, 6u);
+    EXPECT_EQ(report.nonManifoldEdges, 0u);
+    EXPECT_EQ(report.nonManifoldVertices, 1u);
+    EXPECT_FALSE(report.isManifold());
+}
+
+TEST(MeshTopology, BoxesTouchingAtCornerAreClosedButNotManifold)
+{
+    auto mesh = ModelMesh{};
+    fixtures::addBox(mesh, {0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f});
+    fixtures::addBox(mesh, {1.0f, 1.0f, 1.0f}, {2.0f, 2.0f, 2.0f});
+    fixtures::finishMesh(mesh);
+    auto welded = fixtures::weld(mesh);
+    auto report = analyzeTopology(welded.indexed, welded.edges);
+
+    ASSERT_EQ(welded.indexed.positions.size(), 15u);
+    EXPECT_TRUE(report.isClosed());
+    EXPECT_EQ(report.nonManifoldEdges, 0u);
+    EXPECT_EQ(report.nonManifoldVertices, 1u);
+    EXPECT_FALSE(report.isManifold());
+}
+
+TEST(MeshTopology, VertexCornersListEveryCornerOnce)
+{
+    auto welded = fixtures::weld(fixtures::makeBox({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}));
+    auto corners = buildVertexCorners(welded.indexed);
+
+    ASSERT_EQ(corners.cornerOffsets.size(), welded.indexed.positions.size() + 1);
+    ASSERT_EQ(corners.corners.size(), welded.indexed.indices.size());
+    for (auto vertex = std::size_t{0}; vertex < welded.indexed.positions.size(); ++vertex)
+    {
+        auto begin = corners.corners.begin() + corners.cornerOffsets[vertex];
+        auto end = corners.corners.begin() + corners.cornerOffsets[vertex + 1];
+        EXPECT_TRUE(std::is_sorted(begin, end));
+        for (auto it = begin; it != end; ++it)
+        {
+            EXPECT_EQ(welded.indexed.indices[*it], vertex);
+        }
+    }
+}
+
+} // namespace
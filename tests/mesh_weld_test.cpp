@@ -0,0 +1,96 @@
+/**
+ * @file mesh_weld_test.cpp
+ * @brief 頂点溶接（mesh_weld.h）のテスト
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "mesh_fixtures.h"
+#include "mesh_weld.h"
+
+namespace {
+
+TEST(MeshWeld, BoxWeldsToEightVertices)
+{
+    auto mesh = fixtures::makeBox({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f});
+    auto indexed = IndexedMesh{};
+    auto stats = weldVertices(mesh, automaticWeldEpsilon(mesh), indexed);
+
+    EXPECT_EQ(stats.inputVertices, 36u);
+    EXPECT_EQ(stats.outputVertices, 8u);
+    EXPECT_EQ(stats.collapsedTriangles, 0u);
+    EXPECT_EQ(indexed.positions.size(), 8u);
+    EXPECT_EQ(indexed.triangleCount(), 12u);
+}
+
+TEST(MeshWeld, SphereWeldsSeamAndPoles)
+{
+    constexpr auto STACKS = 12;
+    constexpr auto SLICES = 24;
+    auto mesh = fixtures::makeSphere(1.0f, STACKS, SLICES);
+    auto indexed = IndexedMesh{};
+    auto stats = weldVertices(mesh, automaticWeldEpsilon(mesh), indexed);
+
+    EXPECT_EQ(stats.outputVertices, static_cast<std::size_t>((STACKS - 1) * SLICES + 2));
+    EXPECT_EQ(indexed.triangleCount(), static_cast<std::size_t>(2 * SLICES * (STACKS - 1)));
+}
+
+TEST(MeshWeld, MergesVerticesWithinEpsilon)
+{
+    constexpr auto EPSILON = 1e-3f;
+    auto mesh = fixtures::makeBox({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f});
+    mesh.triangles[0].vertices[0] += glm::vec3{0.4f * EPSILON, 0.0f, 0.0f};
+    auto indexed = IndexedMesh{};
+    auto stats = weldVertices(mesh, EPSILON, indexed);
+
+    EXPECT_EQ(stats.outputVertices, 8u);
+}
+
+TEST(MeshWeld, KeepsVerticesBeyondEpsilon)
+{
+    constexpr auto EPSILON = 1e-3f;
+    auto mesh = fixtures::makeBox({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f});
+    mesh.triangles[0].vertices[0] += glm::vec3{0.0f, 0.0f, -10.0f * EPSILON};
+    fixtures::finishMesh(mesh);
+    auto indexed = IndexedMesh{};
+    auto stats = weldVertices(mesh, EPSILON, indexed);
+
+    EXPECT_EQ(stats.outputVertices, 9u);
+}
+
+TEST(MeshWeld, RemovesTrianglesCollapsedByWelding)
+{
+    constexpr auto EPSILON = 1e-3f;
+    auto mesh = fixtures::makeBox({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f});
+    fixtures::addTriangle(mesh, {0.0f, 0.0f, 0.0f}, {0.1f * EPSILON, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f});
+    auto indexed = IndexedMesh{};
+    auto stats = weldVertices(mesh, EPSILON, indexed);
+
+    EXPECT_EQ(stats.collapsedTriangles, 1u);
+    EXPECT_EQ(indexed.triangleCount(), 12u);
+    EXPECT_EQ(indexed.positions.size(), 8u);
+}
+
+TEST(MeshWeld, MergesSignedZeros)
+{
+    auto mesh = fixtures::makeBox({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f});
+    for (auto &triangle : mesh.triangles)
+    {
+        for (auto &vertex : triangle.vertices)
+        {
+            if (vertex.x == 0.0f)
+            {
+                vertex.x = -0.0f;
+                break;
+            }
+        }
+    }
+    auto indexed = IndexedMesh{};
+    auto stats = weldVertices(mesh, 0.0f, indexed);
+
+    EXPECT_EQ(stats.outputVertices, 8u);
+}
+
+} // namespace
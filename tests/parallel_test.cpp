@@ -0,0 +1,97 @@
+/**
+ * @file parallel_test.cpp
+ * @brief 並列ループ・リダクションのヘルパー（parallel.h）のテスト
+ * @author STL Viewer Team
+ * @version 1.0
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#include "parallel.h"
+
+namespace {
+
+/// チャンクを最大数まで分割させるための要素数
+std::size_t splitCount()
+{
+    return parallel::threadCount() * 4;
+}
+
+TEST(Parallel, ForEachChunkCoversEveryElementOnce)
+{
+    auto count = splitCount();
+    auto visits = std::vector<std::atomic<int>>(count);
+    parallel::forEachChunk(
+        count,
+        [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (auto i = begin; i < end; ++i)
+            {
+                ++visits[i];
+            }
+        },
+        1);
+
+    for (const auto& visit : visits)
+    {
+        EXPECT_EQ(visit.load(), 1);
+    }
+}
+
+TEST(Parallel, ForEachChunkFinishesAllChunksBeforeRethrowing)
+{
+    auto count = splitCount();
+    auto chunks = parallel::chunkCount(count, 1);
+    auto finished = std::atomic<std::size_t>{0};
+
+    // 最後のチャンクだけが失敗しても、他のチャンクは最後まで実行されてから例外が届く
+    EXPECT_THROW(parallel::forEachChunk(
+                     count,
+                     [&](std::size_t, std::size_t, std::size_t chunk) {
+                         if (chunk + 1 == chunks)
+                         {
+                             throw std::runtime_error{"last"};
+                         }
+                         ++finished;
+                     },
+                     1),
+                 std::runtime_error);
+    EXPECT_EQ(finished.load(), chunks - 1);
+}
+
+TEST(Parallel, ForEachChunkRethrowsTheFirstChunksException)
+{
+    auto message = std::string{};
+    try
+    {
+        parallel::forEachChunk(
+            splitCount(), [](std::size_t, std::size_t, std::size_t chunk) { throw std::runtime_error{std::to_string(chunk)}; },
+            1);
+    }
+    catch (const std::runtime_error& e)
+    {
+        message = e.what();
+    }
+    EXPECT_EQ(message, "0");
+}
+
+TEST(Parallel, ReducePropagatesExceptions)
+{
+    auto count = splitCount();
+    EXPECT_THROW(parallel::reduce(
+                     count, 0,
+                     [count](std::size_t, std::size_t end) -> int {
+                         if (end == count)
+                         {
+                             throw std::out_of_range{"chunk"};
+                         }
+                         return 1;
+                     },
+                     [](int a, int b) { return a + b; }, 1),
+                 std::out_of_range);
+}
+
+} // namespace
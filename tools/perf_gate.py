@@ -0,0 +1,363 @@
+#!/usr/bin/env python3
+"""
+Performance regression gate
+
+Compares benchmark JSON output against a committed baseline and exits with a
+non-zero status when any metric regresses beyond its tolerance.
+
+Supported inputs:
+  - Google Benchmark JSON from stl_bench (--benchmark_out=<file> --benchmark_out_format=json)
+  - Render benchmark JSON from stl_viewer --benchmark --benchmark-output <file>
+
+Repeated runs (several input files, or --benchmark_repetitions inside one
+Google Benchmark file) are reduced to the median, and their median absolute
+deviation (MAD) widens the threshold so that noisy metrics do not fail the gate.
+
+Examples:
+  # Record a baseline from five runs and commit it
+  python tools/perf_gate.py --write-baseline bench/baselines/render.json run1.json ... run5.json
+
+  # Compare new runs against the baseline
+  python tools/perf_gate.py --baseline bench/baselines/render.json new1.json ... new5.json
+"""
+
+from __future__ import annotations
+
+import argparse
+import fnmatch
+import json
+import math
+import statistics
+import sys
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Any
+
+# Exit codes
+EXIT_OK = 0
+EXIT_REGRESSION = 1
+EXIT_ERROR = 2
+
+# Default tolerance file (relative to the repository root)
+PROJECT_ROOT = Path(__file__).parent.parent
+DEFAULT_TOLERANCES_PATH = PROJECT_ROOT / "bench" / "perf_tolerances.json"
+
+# Scale factor that turns a MAD into a standard deviation estimate for normal noise
+MAD_TO_SIGMA = 1.4826
+
+# Google Benchmark time units converted to milliseconds
+TIME_UNIT_TO_MS = {"ns": 1e-6, "us": 1e-3, "ms": 1.0, "s": 1e3}
+
+# Render benchmark fields describing the run rather than measuring it
+RENDER_METADATA_KEYS = ("model", "renderer", "triangles", "frames")
+
+# Metric name suffixes where larger values are better
+HIGHER_IS_BETTER_SUFFIXES = ("fps", "/s", "per_second")
+
+BASELINE_FORMAT = "stl_viewer.perf_baseline/1"
+
+
+@dataclass
+class Tolerance:
+    """Regression threshold for one metric."""
+
+    relative: float = 0.05
+    absolute: float = 0.0
+    noise_sigmas: float = 3.0
+    direction: str = "lower"
+    ignore: bool = False
+
+
+@dataclass
+class Summary:
+    """Median and median absolute deviation of repeated samples."""
+
+    median: float
+    mad: float
+    samples: int
+
+
+@dataclass
+class Comparison:
+    """Result of comparing one metric against the baseline."""
+
+    name: str
+    status: str
+    baseline: Summary | None
+    current: Summary | None
+    change: float | None = None
+    threshold: float | None = None
+
+
+class GateError(Exception):
+    """Raised for unreadable or inconsistent inputs."""
+
+
+def load_json(path: Path) -> dict[str, Any]:
+    """Load a JSON object from a file."""
+    try:
+        with path.open(encoding="utf-8") as file:
+            data = json.load(file)
+    except (OSError, json.JSONDecodeError) as e:
+        raise GateError(f"Cannot read {path}: {e}") from e
+    if not isinstance(data, dict):
+        raise GateError(f"{path} does not contain a JSON object")
+    return data
+
+
+def detect_kind(data: dict[str, Any]) -> str:
+    """Return "microbench" for Google Benchmark output, "render" for stl_viewer --benchmark output."""
+    if "benchmarks" in data:
+        return "microbench"
+    if "frame_ms" in data:
+        return "render"
+    raise GateError("Unknown benchmark JSON (expected Google Benchmark or stl_viewer --benchmark output)")
+
+
+def extract_microbench(data: dict[str, Any]) -> dict[str, list[float]]:
+    """Collect real time in milliseconds per benchmark, one sample per repetition."""
+    samples: dict[str, list[float]] = {}
+    for entry in data["benchmarks"]:
+        # Aggregates (mean/median/stddev) are recomputed from the individual repetitions
+        if entry.get("run_type", "iteration") != "iteration" or entry.get("error_occurred"):
+            continue
+        name = entry.get("run_name", entry["name"])
+        scale = TIME_UNIT_TO_MS.get(entry.get("time_unit", "ns"))
+        if scale is None:
+            raise GateError(f"Unknown time unit in {name}: {entry.get('time_unit')}")
+        samples.setdefault(f"{name}.real_time_ms", []).append(entry["real_time"] * scale)
+    return samples
+
+
+def extract_render(data: dict[str, Any]) -> dict[str, list[float]]:
+    """Flatten the render benchmark report into dotted metric names."""
+    samples: dict[str, list[float]] = {}
+    for key, value in data.items():
+        if key in RENDER_METADATA_KEYS:
+            continue
+        if isinstance(value, dict):
+            for field, number in value.items():
+                samples[f"{key}.{field}"] = [float(number)]
+        elif isinstance(value, (int, float)):
+            samples[key] = [float(value)]
+    return samples
+
+
+def load_runs(paths: list[Path]) -> tuple[str, dict[str, Any], dict[str, list[float]]]:
+    """Load repeated runs of the same benchmark and merge their samples per metric."""
+    kind = ""
+    metadata: dict[str, Any] = {}
+    merged: dict[str, list[float]] = {}
+    for path in paths:
+        data = load_json(path)
+        run_kind = detect_kind(data)
+        if kind and run_kind != kind:
+            raise GateError(f"{path} is a {run_kind} result but earlier inputs are {kind} results")
+        kind = run_kind
+
+        if kind == "render":
+            run_metadata = {key: data[key] for key in RENDER_METADATA_KEYS if key in data and key != "frames"}
+            if metadata and run_metadata != metadata:
+                raise GateError(f"{path} was measured with a different model or renderer: {run_metadata}")
+            metadata = run_metadata
+            samples = extract_render(data)
+        else:
+            samples = extract_microbench(data)
+
+        for name, values in samples.items():
+            merged.setdefault(name, []).extend(values)
+    return kind, metadata, merged
+
+
+def summarize(values: list[float]) -> Summary:
+    """Reduce repeated samples to their median and MAD."""
+    median = statistics.median(values)
+    mad = statistics.median(abs(value - median) for value in values)
+    return Summary(median=median, mad=mad, samples=len(values))
+
+
+def load_tolerances(path: Path) -> tuple[Tolerance, list[tuple[str, dict[str, Any]]]]:
+    """Load the default tolerance and the ordered per-metric overrides."""
+    data = load_json(path)
+    default = Tolerance(**data.get("default", {}))
+    rules = [(rule.pop("pattern"), rule) for rule in (dict(rule) for rule in data.get("metrics", []))]
+    return default, rules
+
+
+def tolerance_for(name: str, default: Tolerance, rules: list[tuple[str, dict[str, Any]]]) -> Tolerance:
+    """Return the tolerance of the first rule whose pattern matches the metric name."""
+    direction = "higher" if name.endswith(HIGHER_IS_BETTER_SUFFIXES) else default.direction
+    tolerance = Tolerance(default.relative, default.absolute, default.noise_sigmas, direction, default.ignore)
+    for pattern, rule in rules:
+        if fnmatch.fnmatchcase(name, pattern):
+            for field, value in rule.items():
+                setattr(tolerance, field, value)
+            break
+    return tolerance
+
+
+def compare_metric(name: str, baseline: Summary | None, current: Summary | None, tolerance: Tolerance) -> Comparison:
+    """Classify one metric as ok, regressed, improved, new or missing."""
+    if tolerance.ignore:
+        return Comparison(name, "ignored", baseline, current)
+    if baseline is None:
+        return Comparison(name, "new", baseline, current)
+    if current is None:
+        return Comparison(name, "missing", baseline, current)
+
+    # Positive "worse" means the metric moved in the bad direction
+    difference = current.median - baseline.median
+    worse = difference if tolerance.direction == "lower" else -difference
+    scale = abs(baseline.median)
+    noise = tolerance.noise_sigmas * MAD_TO_SIGMA * math.hypot(baseline.mad, current.mad)
+    threshold = max(tolerance.relative * scale, tolerance.absolute, noise)
+    change = difference / scale if scale > 0.0 else None
+    relative_threshold = threshold / scale if scale > 0.0 else None
+
+    if worse > threshold:
+        status = "REGRESSION"
+    elif -worse > threshold:
+        status = "improved"
+    else:
+        status = "ok"
+    return Comparison(name, status, baseline, current, change, relative_threshold)
+
+
+def format_number(value: float) -> str:
+    """Format a metric value with four significant digits."""
+    return f"{value:.4g}"
+
+
+def format_summary(summary: Summary | None) -> str:
+    """Format a median with its MAD when there are repeated samples."""
+    if summary is None:
+        return "-"
+    if summary.samples > 1:
+        return f"{format_number(summary.median)} ±{format_number(summary.mad)}"
+    return format_number(summary.median)
+
+
+def print_table(comparisons: list[Comparison], show_all: bool) -> None:
+    """Print the comparison as an aligned table (unchanged metrics are hidden unless show_all)."""
+    rows = [("Metric", "Baseline", "Current", "Change", "Threshold", "Status")]
+    for comparison in comparisons:
+        if not show_all and comparison.status in ("ok", "ignored"):
+            continue
+        change = "-" if comparison.change is None else f"{comparison.change * 100.0:+.1f}%"
+        threshold = "-" if comparison.threshold is None else f"±{comparison.threshold * 100.0:.1f}%"
+        rows.append(
+            (
+                comparison.name,
+                format_summary(comparison.baseline),
+                format_summary(comparison.current),
+                change,
+                threshold,
+                comparison.status,
+            )
+        )
+
+    if len(rows) == 1:
+        print("All metrics are within tolerance")
+        return
+
+    widths = [max(len(row[column]) for row in rows) for column in range(len(rows[0]))]
+    for index, row in enumerate(rows):
+        cells = [row[0].ljust(widths[0])] + [cell.rjust(width) for cell, width in zip(row[1:-1], widths[1:-1])]
+        print("  ".join(cells + [row[-1]]))
+        if index == 0:
+            print("  ".join("-" * width for width in widths))
+
+
+def write_baseline(path: Path, kind: str, metadata: dict[str, Any], samples: dict[str, list[float]]) -> None:
+    """Write the median and MAD of the given runs as a baseline file."""
+    metrics = {}
+    for name in sorted(samples):
+        summary = summarize(samples[name])
+        metrics[name] = {"median": summary.median, "mad": summary.mad, "samples": summary.samples}
+    baseline = {"format": BASELINE_FORMAT, "kind": kind, "metadata": metadata, "metrics": metrics}
+    path.parent.mkdir(parents=True, exist_ok=True)
+    with path.open("w", encoding="utf-8") as file:
+        json.dump(baseline, file, indent=2, sort_keys=True)
+        file.write("\n")
+
+
+def load_baseline(paths: list[Path]) -> tuple[str, dict[str, Any], dict[str, Summary]]:
+    """Load a baseline written by --write-baseline, or summarize raw benchmark runs used as a baseline."""
+    if len(paths) == 1:
+        data = load_json(paths[0])
+        if data.get("format") == BASELINE_FORMAT:
+            metrics = {
+                name: Summary(median=entry["median"], mad=entry["mad"], samples=entry["samples"])
+                for name, entry in data["metrics"].items()
+            }
+            return data["kind"], data.get("metadata", {}), metrics
+
+    kind, metadata, samples = load_runs(paths)
+    return kind, metadata, {name: summarize(values) for name, values in samples.items()}
+
+
+def parse_arguments() -> argparse.Namespace:
+    """Parse command line arguments."""
+    parser = argparse.ArgumentParser(
+        description="Compare benchmark JSON (stl_bench or stl_viewer --benchmark) against a baseline"
+    )
+    parser.add_argument("runs", nargs="+", type=Path, help="Benchmark JSON files of repeated runs")
+    mode = parser.add_mutually_exclusive_group(required=True)
+    mode.add_argument(
+        "--baseline", action="append", type=Path, help="Baseline file (or raw runs, may be repeated)"
+    )
+    mode.add_argument("--write-baseline", type=Path, help="Write the runs as a new baseline file and exit")
+    parser.add_argument(
+        "--tolerances",
+        type=Path,
+        default=DEFAULT_TOLERANCES_PATH,
+        help=f"Per-metric tolerance file (default: {DEFAULT_TOLERANCES_PATH.relative_to(PROJECT_ROOT)})",
+    )
+    parser.add_argument("--all", action="store_true", help="Show unchanged metrics in the table")
+    parser.add_argument(
+        "--fail-on-missing", action="store_true", help="Treat baseline metrics absent from the runs as regressions"
+    )
+    return parser.parse_args()
+
+
+def main() -> int:
+    """Run the regression gate."""
+    args = parse_arguments()
+    try:
+        kind, metadata, samples = load_runs(args.runs)
+        if args.write_baseline:
+            write_baseline(args.write_baseline, kind, metadata, samples)
+            print(f"Wrote {kind} baseline with {len(samples)} metrics to {args.write_baseline}")
+            return EXIT_OK
+
+        baseline_kind, baseline_metadata, baseline = load_baseline(args.baseline)
+        if baseline_kind != kind:
+            raise GateError(f"Baseline is a {baseline_kind} result but the runs are {kind} results")
+        default, rules = load_tolerances(args.tolerances)
+    except GateError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return EXIT_ERROR
+
+    # Results from a different model or renderer are not comparable
+    if baseline_metadata and metadata and baseline_metadata != metadata:
+        print(f"Warning: baseline was measured with {baseline_metadata}, runs with {metadata}", file=sys.stderr)
+
+    current = {name: summarize(values) for name, values in samples.items()}
+    comparisons = [
+        compare_metric(name, baseline.get(name), current.get(name), tolerance_for(name, default, rules))
+        for name in sorted(set(baseline) | set(current))
+    ]
+    print_table(comparisons, args.all)
+
+    counts: dict[str, int] = {}
+    for comparison in comparisons:
+        counts[comparison.status] = counts.get(comparison.status, 0) + 1
+    print()
+    print(", ".join(f"{count} {status}" for status, count in sorted(counts.items())))
+
+    failed = counts.get("REGRESSION", 0) > 0 or (args.fail_on_missing and counts.get("missing", 0) > 0)
+    return EXIT_REGRESSION if failed else EXIT_OK
+
+
+if __name__ == "__main__":
+    sys.exit(main())
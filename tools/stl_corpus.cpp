@@ -0,0 +1,319 @@
+/**
+ * @file stl_corpus.cpp
+ * @brief 読み込み・ベンチマーク検証用の合成メッシュのコーパス生成ツール
+ * @author STL Viewer Team
+ * @version 1.0
+ *
+ * シードから決定的に生成した合成メッシュをバイナリ/ASCII STL・OBJ・PLY・GLB で書き出す。
+ * 1ファイルを書き出すモードと、三角形数・形式・病的なケース（トライアングルスープ・多数のシェル・
+ * 面積0の三角形・NaN・"solid" で始まるバイナリSTL）を網羅した標準コーパスを書き出すモードがある。
+ *
+ * 使用例:
+ *   stl_corpus --output big.stl --triangles 100000000 --sharing 0.5 --shells 4 --seed 7
+ *   stl_corpus --corpus-dir D:/stl_corpus --max-triangles 10000000
+ */
+
+#include <algorithm>
+#include <boost/program_options.hpp>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "mesh_synthetic.h"
+
+namespace po = boost::program_options;
+
+// アプリケーション定数
+namespace {
+    constexpr std::uint64_t DEFAULT_MAX_CORPUS_TRIANGLES = 1'000'000; ///< 標準コーパスの既定の最大三角形数
+    constexpr std::uint64_t MAX_ASCII_CORPUS_TRIANGLES = 10'000'000;  ///< 標準コーパスで ASCII STL を書き出す上限
+    constexpr std::uint64_t PATHOLOGICAL_TRIANGLES = 100'000;         ///< 病的なケースの三角形数
+    constexpr std::uint64_t MANY_SHELLS = 1000;                       ///< 多数のシェルのケースのシェル数
+    constexpr float PATHOLOGICAL_DEGENERATE_RATIO = 0.1f;             ///< 面積0のケースの面積0の三角形の割合
+    constexpr float PATHOLOGICAL_NON_FINITE_RATIO = 0.01f;            ///< NaNのケースの NaN を含む三角形の割合
+
+    /// 標準コーパスの三角形数（--max-triangles 以下のもののみ書き出す）
+    constexpr std::array<std::uint64_t, 6> CORPUS_TRIANGLE_COUNTS{
+        1'000, 100'000, 1'000'000, 10'000'000, 50'000'000, 100'000'000};
+}
+
+/**
+ * @brief ツールの設定を格納する構造体
+ */
+struct CorpusConfig
+{
+    std::string outputPath;                                 ///< 1ファイルを書き出す場合の出力先
+    std::string formatName;                                 ///< 書き出し形式名（空の場合は拡張子から決める）
+    std::string corpusDirectory;                            ///< 標準コーパスの出力先（空の場合は1ファイルのみ）
+    std::uint64_t maxTriangles = DEFAULT_MAX_CORPUS_TRIANGLES; ///< 標準コーパスの最大三角形数
+    SyntheticSettings settings;                             ///< 1ファイルを書き出す場合の生成設定
+};
+
+/**
+ * @brief 標準コーパスの1ファイル分の設定
+ */
+struct CorpusEntry
+{
+    std::string name;           ///< ファイル名の先頭（生成設定と拡張子を除く）
+    SyntheticFormat format;     ///< 書き出し形式
+    SyntheticSettings settings; ///< 生成設定
+};
+
+/**
+ * @brief 使用方法を表示する
+ */
+void printUsage(const po::options_description &desc, const char *programName)
+{
+    std::cout << "Usage: " << programName << " --output <file> --triangles <count> [options]" << std::endl;
+    std::cout << "       " << programName << " --corpus-dir <directory> [--max-triangles <count>] [--seed <seed>]"
+              << std::endl;
+    std::cout << desc << std::endl;
+}
+
+/**
+ * @brief コマンドライン引数を解析して設定に格納する
+ *
+ * @param argc 引数の数
+ * @param argv 引数の配列
+ * @param config [out] 解析結果を格納する設定構造体
+ * @return 解析成功時はtrue、失敗またはヘルプ表示時はfalse
+ */
+bool parseCommandLine(int argc, char *argv[], CorpusConfig &config)
+{
+    auto desc = po::options_description{"STL Corpus Options"};
+    desc.add_options()("help,h", "Show this help message")(
+        "output,o", po::value<std::string>(&config.outputPath), "Output file path")(
+        "format", po::value<std::string>(&config.formatName),
+        "Output format: stl, stl-ascii, obj, ply or glb (default: from the file extension, .stl is binary)")(
+        "triangles", po::value<std::uint64_t>(&config.settings.triangleCount), "Exact number of triangles")(
+        "shells", po::value<std::uint64_t>(&config.settings.shellCount)->default_value(1),
+        "Number of disconnected shells")(
+        "sharing", po::value<float>(&config.settings.vertexSharing)->default_value(1.0f),
+        "Fraction of triangles that share vertices with their neighbors (0: triangle soup)")(
+        "degenerate", po::value<float>(&config.settings.degenerateRatio)->default_value(0.0f),
+        "Fraction of zero-area triangles")(
+        "nan", po::value<float>(&config.settings.nonFiniteRatio)->default_value(0.0f),
+        "Fraction of triangles with a NaN vertex")(
+        "solid-header", "Start the binary STL header with \"solid\"")(
+        "seed", po::value<std::uint64_t>(&config.settings.seed)->default_value(DEFAULT_SYNTHETIC_SEED),
+        "Random seed (the same seed always produces identical files)")(
+        "corpus-dir", po::value<std::string>(&config.corpusDirectory),
+        "Write the standard corpus (sizes x formats and pathological cases) into this directory")(
+        "max-triangles", po::value<std::uint64_t>(&config.maxTriangles)->default_value(DEFAULT_MAX_CORPUS_TRIANGLES),
+        "Largest triangle count written to the standard corpus");
+
+    auto vm = po::variables_map{};
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+    }
+    catch (const po::error &e)
+    {
+        std::cerr << "Error parsing command line: " << e.what() << std::endl;
+        printUsage(desc, argv[0]);
+        return false;
+    }
+
+    // ヘルプ表示
+    if (vm.count("help"))
+    {
+        printUsage(desc, argv[0]);
+        return false;
+    }
+
+    config.settings.solidHeader = vm.count("solid-header") > 0;
+    if (config.corpusDirectory.empty() && (config.outputPath.empty() || !vm.count("triangles")))
+    {
+        std::cerr << "Error: --output and --triangles (or --corpus-dir) are required." << std::endl;
+        printUsage(desc, argv[0]);
+        return false;
+    }
+    if (!config.formatName.empty() && !parseSyntheticFormat(config.formatName))
+    {
+        std::cerr << "Error: Unknown format: " << config.formatName << std::endl;
+        return false;
+    }
+    for (auto ratio : {config.settings.vertexSharing, config.settings.degenerateRatio, config.settings.nonFiniteRatio})
+    {
+        if (!(ratio >= 0.0f && ratio <= 1.0f))
+        {
+            std::cerr << "Error: --sharing, --degenerate and --nan must be between 0 and 1." << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 出力先の拡張子から書き出し形式を決める
+ */
+std::optional<SyntheticFormat> formatFromExtension(const std::filesystem::path &path)
+{
+    auto extension = path.extension().string();
+    if (extension == ".stl")
+    {
+        return SyntheticFormat::BinaryStl;
+    }
+    return parseSyntheticFormat(extension.empty() ? extension : extension.substr(1));
+}
+
+/**
+ * @brief 合成メッシュを1ファイル書き出して結果を表示する
+ *
+ * 途中で中断しても壊れたファイルが残らないよう、一時ファイルに書き出してから名前を変更する。
+ *
+ * @return 書き出しに成功した場合はtrue
+ */
+bool writeMesh(const SyntheticSettings &settings, SyntheticFormat format, const std::filesystem::path &path)
+{
+    auto start = std::chrono::steady_clock::now();
+    auto mesh = SyntheticMesh{settings};
+    auto temporary = path;
+    temporary += ".tmp";
+    auto errorMessage = std::string{};
+    if (!writeSyntheticMesh(mesh, format, temporary, errorMessage))
+    {
+        std::cerr << "Error: " << path.string() << ": " << errorMessage << std::endl;
+        auto ignored = std::error_code{};
+        std::filesystem::remove(temporary, ignored);
+        return false;
+    }
+
+    auto error = std::error_code{};
+    std::filesystem::rename(temporary, path, error);
+    if (error)
+    {
+        std::cerr << "Error: Cannot rename " << temporary.string() << ": " << error.message() << std::endl;
+        return false;
+    }
+
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "[Corpus] " << path.string() << ": " << mesh.triangleCount() << " triangles, " << mesh.vertexCount()
+              << " vertices, " << std::filesystem::file_size(path) << " bytes (" << elapsed << " s)" << std::endl;
+    return true;
+}
+
+/**
+ * @brief 標準コーパスの内容を列挙する
+ *
+ * 三角形数ごとに全形式を、病的なケースは PATHOLOGICAL_TRIANGLES（最大三角形数で頭打ち）で書き出す。
+ * ファイル名には syntheticSettingsTag() でシードを含む生成設定を全て付けるため、
+ * 設定の異なるファイルを取り違えて再利用することはない。
+ */
+std::vector<CorpusEntry> corpusEntries(const CorpusConfig &config)
+{
+    auto base = SyntheticSettings{};
+    base.seed = config.settings.seed;
+
+    auto entries = std::vector<CorpusEntry>{};
+    for (auto triangles : CORPUS_TRIANGLE_COUNTS)
+    {
+        if (triangles > config.maxTriangles)
+        {
+            continue;
+        }
+        auto settings = base;
+        settings.triangleCount = triangles;
+        auto prefix = "grid_" + std::to_string(triangles);
+        entries.push_back({prefix + "_stl_binary", SyntheticFormat::BinaryStl, settings});
+        if (triangles <= MAX_ASCII_CORPUS_TRIANGLES)
+        {
+            entries.push_back({prefix + "_stl_ascii", SyntheticFormat::AsciiStl, settings});
+        }
+        entries.push_back({prefix + "_obj", SyntheticFormat::Obj, settings});
+        entries.push_back({prefix + "_ply_binary", SyntheticFormat::BinaryPly, settings});
+        entries.push_back({prefix + "_glb", SyntheticFormat::Glb, settings});
+    }
+
+    // 病的なケース
+    auto pathological = base;
+    pathological.triangleCount = std::min(PATHOLOGICAL_TRIANGLES, config.maxTriangles);
+    auto soup = pathological;
+    soup.vertexSharing = 0.0f;
+    auto shells = pathological;
+    shells.shellCount = MANY_SHELLS;
+    auto degenerate = pathological;
+    degenerate.degenerateRatio = PATHOLOGICAL_DEGENERATE_RATIO;
+    auto nonFinite = pathological;
+    nonFinite.nonFiniteRatio = PATHOLOGICAL_NON_FINITE_RATIO;
+    auto solidHeader = pathological;
+    solidHeader.solidHeader = true;
+    entries.push_back({"soup_stl_binary", SyntheticFormat::BinaryStl, soup});
+    entries.push_back({"soup_obj", SyntheticFormat::Obj, soup});
+    entries.push_back({"shells_stl_binary", SyntheticFormat::BinaryStl, shells});
+    entries.push_back({"degenerate_stl_binary", SyntheticFormat::BinaryStl, degenerate});
+    entries.push_back({"degenerate_ply_binary", SyntheticFormat::BinaryPly, degenerate});
+    entries.push_back({"nan_stl_binary", SyntheticFormat::BinaryStl, nonFinite});
+    entries.push_back({"nan_stl_ascii", SyntheticFormat::AsciiStl, nonFinite});
+    entries.push_back({"nan_obj", SyntheticFormat::Obj, nonFinite});
+    entries.push_back({"solid_header_stl_binary", SyntheticFormat::BinaryStl, solidHeader});
+    return entries;
+}
+
+/**
+ * @brief 標準コーパスを書き出す（生成設定まで一致する既存のファイルは再利用する）
+ *
+ * @return 全てのファイルを用意できた場合はtrue
+ */
+bool writeCorpus(const CorpusConfig &config)
+{
+    auto directory = std::filesystem::path{config.corpusDirectory};
+    auto error = std::error_code{};
+    std::filesystem::create_directories(directory, error);
+    if (error)
+    {
+        std::cerr << "Error: Cannot create " << directory.string() << ": " << error.message() << std::endl;
+        return false;
+    }
+
+    auto success = true;
+    for (const auto &entry : corpusEntries(config))
+    {
+        auto path = directory / (entry.name + "_" + syntheticSettingsTag(entry.settings) +
+                                 std::string{syntheticFormatExtension(entry.format)});
+        if (std::filesystem::exists(path, error))
+        {
+            std::cout << "[Corpus] " << path.string() << ": exists" << std::endl;
+            continue;
+        }
+        success = writeMesh(entry.settings, entry.format, path) && success;
+    }
+    return success;
+}
+
+/**
+ * @brief メイン関数
+ *
+ * @param argc 引数の数
+ * @param argv 引数の配列
+ * @return 正常終了時はEXIT_SUCCESS、エラー時はEXIT_FAILURE
+ */
+int main(int argc, char *argv[])
+{
+    auto config = CorpusConfig{};
+    if (!parseCommandLine(argc, argv, config))
+    {
+        return EXIT_FAILURE;
+    }
+
+    if (!config.corpusDirectory.empty())
+    {
+        return writeCorpus(config) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    auto path = std::filesystem::path{config.outputPath};
+    auto format = config.formatName.empty() ? formatFromExtension(path) : parseSyntheticFormat(config.formatName);
+    if (!format)
+    {
+        std::cerr << "Error: Cannot determine the output format from " << path.string() << "; use --format" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return writeMesh(config.settings, *format, path) ? EXIT_SUCCESS : EXIT_FAILURE;
+}